@@ -300,6 +300,14 @@ void                            _clutter_actor_pop_clone_paint
 
 guint32                         _clutter_actor_get_pick_id                              (ClutterActor *self);
 
+guint                           _clutter_actor_get_children_layout_age                  (ClutterActor *self);
+gboolean                        _clutter_actor_has_fixed_size                           (ClutterActor       *self,
+                                                                                         ClutterOrientation  orientation);
+guint64                         _clutter_actor_get_allocation_serial                    (ClutterActor *self);
+void                            _clutter_actor_get_constraint_sources                   (ClutterActor *self,
+                                                                                         GPtrArray    *sources);
+gboolean                        _clutter_actor_relayout_boundary                        (ClutterActor *self);
+
 void                            _clutter_actor_shader_pre_paint                         (ClutterActor *actor,
                                                                                          gboolean      repeat);
 void                            _clutter_actor_shader_post_paint                        (ClutterActor *actor);
@@ -308,6 +316,7 @@ ClutterActorAlign               _clutter_actor_get_effective_x_align
 
 void                            _clutter_actor_handle_event                             (ClutterActor       *actor,
                                                                                          const ClutterEvent *event);
+void                            _clutter_actor_set_has_event_hooks                      (ClutterActor       *self);
 
 void                            _clutter_actor_attach_clone                             (ClutterActor *actor,
                                                                                          ClutterActor *clone);
@@ -608,6 +608,7 @@
 #include "config.h"
 
 #include <math.h>
+#include <string.h>
 
 #include <gobject/gvaluecollector.h>
 
@@ -723,6 +724,26 @@ struct _ClutterActorPrivate
    */
   gint age;
 
+  /* incremented whenever the layout of the children may have
+   * changed: when a child is added, removed, shown or hidden,
+   * or when a child queues a relayout
+   */
+  guint children_layout_age;
+
+  /* the children in paint order, for indexed access; built lazily,
+   * and only valid while child_index_age is the same as age
+   */
+  GPtrArray *child_index;
+  gint child_index_age;
+
+  /* the position of the actor inside the child index of its parent */
+  guint index_in_parent;
+
+  /* the value of the allocation serial when the allocation of
+   * the actor last changed; see _clutter_actor_get_allocation_serial()
+   */
+  guint64 allocation_serial;
+
   gchar *name; /* a non-unique name, used for debugging */
 
   gint32 pick_id; /* per-stage unique id, used for picking */
@@ -840,6 +861,19 @@ struct _ClutterActorPrivate
   guint needs_compute_expand        : 1;
   guint needs_x_expand              : 1;
   guint needs_y_expand              : 1;
+  /* the allocation was set by a layout-only animation, without
+   * laying out the children
+   */
+  guint allocation_interpolated     : 1;
+  guint relayout_boundary           : 1;
+  /* the child index was handed out by get_children_snapshot(), and
+   * cannot be modified anymore
+   */
+  guint child_index_shared          : 1;
+  /* emission hooks are set on the event signals of this actor, so
+   * the emission cannot be skipped even without handlers
+   */
+  guint has_event_hooks             : 1;
 };
 
 enum
@@ -970,6 +1004,8 @@ enum
   PROP_MAGNIFICATION_FILTER,
   PROP_CONTENT_REPEAT,
 
+  PROP_RELAYOUT_BOUNDARY,
+
   PROP_LAST
 };
 
@@ -1003,12 +1039,19 @@ enum
   TRANSITIONS_COMPLETED,
   TOUCH_EVENT,
   TRANSITION_STOPPED,
+  CHILDREN_CHANGED,
 
   LAST_SIGNAL
 };
 
 static guint actor_signals[LAST_SIGNAL] = { 0, };
 
+/* the number of emission hooks added with
+ * clutter_actor_add_event_emission_hook(); while there is any, the
+ * events are emitted on every actor of the chain
+ */
+static guint n_event_emission_hooks = 0;
+
 typedef struct _TransitionClosure
 {
   ClutterActor *actor;
@@ -1106,6 +1149,12 @@ static GQuark quark_actor_layout_info = 0;
 static GQuark quark_actor_transform_info = 0;
 static GQuark quark_actor_animation_info = 0;
 
+/* incremented each time the allocation of an actor changes */
+static guint64 last_allocation_serial = 0;
+
+/* incremented each time a queued relayout invalidates an actor */
+static guint64 relayout_invalidation_count = 0;
+
 G_DEFINE_TYPE_WITH_CODE (ClutterActor,
                          clutter_actor,
                          G_TYPE_INITIALLY_UNOWNED,
@@ -1836,7 +1885,10 @@ clutter_actor_real_hide (ClutterActor *self)
    */
   if (priv->parent != NULL &&
       (!(priv->parent->flags & CLUTTER_ACTOR_NO_LAYOUT)))
-    clutter_actor_queue_relayout (priv->parent);
+    {
+      priv->parent->priv->children_layout_age += 1;
+      clutter_actor_queue_relayout (priv->parent);
+    }
 }
 
 /**
@@ -2497,6 +2549,7 @@ clutter_actor_set_allocation_internal (ClutterActor           *self,
                     _clutter_actor_get_debug_name (self));
 
       priv->transform_valid = FALSE;
+      priv->allocation_serial = ++last_allocation_serial;
 
       g_object_notify_by_pspec (obj, obj_props[PROP_ALLOCATION]);
 
@@ -2717,6 +2770,49 @@ clutter_actor_real_queue_redraw (ClutterActor *self,
     }
 }
 
+/* queues a relayout of the children of @self, without invalidating
+ * the size of @self and of its ancestors, if @self is a relayout
+ * boundary with a valid size; returns %FALSE if the relayout has to
+ * be propagated to the ancestors instead
+ */
+static gboolean
+clutter_actor_queue_boundary_relayout (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+  ClutterActor *stage;
+
+  if (CLUTTER_ACTOR_IN_DESTRUCTION (self))
+    return FALSE;
+
+  if (!priv->relayout_boundary)
+    return FALSE;
+
+  /* the size of the actor, or whether it expands, is being computed
+   * again, which requires a relayout of its parent anyway
+   */
+  if (priv->needs_width_request ||
+      priv->needs_height_request ||
+      priv->needs_compute_expand)
+    return FALSE;
+
+  stage = _clutter_actor_get_stage_internal (self);
+  if (stage == NULL || stage == self)
+    return FALSE;
+
+  /* already queued */
+  if (priv->needs_allocation)
+    return TRUE;
+
+  CLUTTER_NOTE (LAYOUT, "Stopping the relayout at the boundary '%s'",
+                _clutter_actor_get_debug_name (self));
+
+  priv->needs_allocation = TRUE;
+
+  _clutter_stage_queue_relayout_boundary (CLUTTER_STAGE (stage), self);
+
+  return TRUE;
+}
+
 static void
 clutter_actor_real_queue_relayout (ClutterActor *self)
 {
@@ -2736,9 +2832,18 @@ clutter_actor_real_queue_relayout (ClutterActor *self)
   memset (priv->height_requests, 0,
           N_CACHED_SIZE_REQUESTS * sizeof (SizeRequest));
 
-  /* We need to go all the way up the hierarchy */
+  relayout_invalidation_count += 1;
+
+  /* We need to go all the way up the hierarchy, unless the parent
+   * is a relayout boundary
+   */
   if (priv->parent != NULL)
-    _clutter_actor_queue_only_relayout (priv->parent);
+    {
+      priv->parent->priv->children_layout_age += 1;
+
+      if (!clutter_actor_queue_boundary_relayout (priv->parent))
+        _clutter_actor_queue_only_relayout (priv->parent);
+    }
 }
 
 /**
@@ -3519,6 +3624,98 @@ _clutter_actor_get_pick_id (ClutterActor *self)
   return self->priv->pick_id;
 }
 
+/*< private >
+ * _clutter_actor_get_children_layout_age:
+ * @self: a #ClutterActor
+ *
+ * Retrieves a counter that changes whenever the layout of the children
+ * of @self may have changed, that is when a child is added, removed,
+ * shown or hidden, or queues a relayout. Layout managers can use it to
+ * know whether the values they computed from the children are still
+ * valid; changes to @self alone, like its size, do not change it.
+ *
+ * Return value: the age of the layout of the children
+ */
+guint
+_clutter_actor_get_children_layout_age (ClutterActor *self)
+{
+  return self->priv->children_layout_age;
+}
+
+/*< private >
+ * _clutter_actor_get_allocation_serial:
+ * @self: a #ClutterActor
+ *
+ * Retrieves a serial number that increases each time the allocation
+ * of any actor changes, as it was when the allocation of @self last
+ * changed. Comparing it with the serial passed to
+ * _clutter_stage_add_constrained_actor() tells whether @self was
+ * allocated again after a constraint used its allocation.
+ *
+ * Return value: the allocation serial of @self
+ */
+guint64
+_clutter_actor_get_allocation_serial (ClutterActor *self)
+{
+  return self->priv->allocation_serial;
+}
+
+/*< private >
+ * _clutter_actor_get_constraint_sources:
+ * @self: a #ClutterActor
+ * @sources: (element-type ClutterActor): the array to add the sources to
+ *
+ * Adds the source actors of the enabled constraints of @self
+ * to @sources.
+ */
+void
+_clutter_actor_get_constraint_sources (ClutterActor *self,
+                                       GPtrArray    *sources)
+{
+  const GList *l;
+
+  if (self->priv->constraints == NULL)
+    return;
+
+  for (l = _clutter_meta_group_peek_metas (self->priv->constraints);
+       l != NULL;
+       l = l->next)
+    {
+      ClutterActor *source;
+
+      if (!clutter_actor_meta_get_enabled (l->data))
+        continue;
+
+      source = clutter_constraint_get_source (l->data);
+      if (source != NULL && source != self)
+        g_ptr_array_add (sources, source);
+    }
+}
+
+/*< private >
+ * _clutter_actor_has_fixed_size:
+ * @self: a #ClutterActor
+ * @orientation: the orientation of the size
+ *
+ * Checks whether both the minimum and natural sizes of @self in the
+ * given @orientation have been set, in which case the preferred size
+ * does not depend on the size in the other orientation, nor on the
+ * contents of @self.
+ *
+ * Return value: %TRUE if the size of @self is fixed
+ */
+gboolean
+_clutter_actor_has_fixed_size (ClutterActor       *self,
+                               ClutterOrientation  orientation)
+{
+  ClutterActorPrivate *priv = self->priv;
+
+  if (orientation == CLUTTER_ORIENTATION_HORIZONTAL)
+    return priv->min_width_set && priv->natural_width_set;
+  else
+    return priv->min_height_set && priv->natural_height_set;
+}
+
 /* This is the same as clutter_actor_add_effect except that it doesn't
    queue a redraw and it doesn't notify on the effect property */
 static void
@@ -4151,6 +4348,188 @@ remove_child (ClutterActor *self,
   child->priv->next_sibling = NULL;
 }
 
+/* containers with fewer children than this walk the list of children
+ * for indexed access, instead of building the child index
+ */
+#define CHILD_INDEX_MIN_CHILDREN        16
+
+static inline gboolean
+clutter_actor_has_child_index (ClutterActor *self)
+{
+  return self->priv->child_index != NULL &&
+         self->priv->child_index_age == self->priv->age;
+}
+
+/*< private >
+ * clutter_actor_ensure_child_index:
+ * @self: a #ClutterActor
+ *
+ * Builds the index of the children of @self, if it is not valid.
+ *
+ * Return value: (transfer none): the children of @self, in order
+ */
+static GPtrArray *
+clutter_actor_ensure_child_index (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+  ClutterActor *iter;
+  guint i;
+
+  if (clutter_actor_has_child_index (self))
+    return priv->child_index;
+
+  /* the array of a snapshot is left untouched */
+  if (priv->child_index_shared)
+    {
+      g_ptr_array_unref (priv->child_index);
+      priv->child_index = NULL;
+      priv->child_index_shared = FALSE;
+    }
+
+  if (priv->child_index == NULL)
+    priv->child_index = g_ptr_array_sized_new (priv->n_children);
+  else
+    g_ptr_array_set_size (priv->child_index, 0);
+
+  for (iter = priv->first_child, i = 0;
+       iter != NULL;
+       iter = iter->priv->next_sibling, i += 1)
+    {
+      iter->priv->index_in_parent = i;
+      g_ptr_array_add (priv->child_index, iter);
+    }
+
+  priv->child_index_age = priv->age;
+
+  return priv->child_index;
+}
+
+/*< private >
+ * clutter_actor_child_index_insert:
+ * @self: a #ClutterActor
+ * @child: the child that was just inserted
+ *
+ * Updates the child index of @self after @child was inserted, if the
+ * index was valid before the insertion and @child was appended; the
+ * age of @self must have been incremented once.
+ *
+ * Containers are usually populated by appending children, so this
+ * keeps the index valid without shifting the positions of the other
+ * children; any other change invalidates the index, which is then
+ * built again by the next indexed read.
+ */
+static void
+clutter_actor_child_index_insert (ClutterActor *self,
+                                  ClutterActor *child)
+{
+  ClutterActorPrivate *priv = self->priv;
+
+  if (priv->child_index == NULL ||
+      priv->child_index_shared ||
+      priv->child_index_age != priv->age - 1 ||
+      child->priv->next_sibling != NULL)
+    return;
+
+  child->priv->index_in_parent = priv->child_index->len;
+  g_ptr_array_add (priv->child_index, child);
+
+  priv->child_index_age = priv->age;
+}
+
+/*< private >
+ * clutter_actor_child_index_remove:
+ * @self: a #ClutterActor
+ * @child: the child that was just removed
+ *
+ * Updates the child index of @self after @child was removed, if the
+ * index was valid before the removal and @child was the last child;
+ * the age of @self must have been incremented once.
+ */
+static void
+clutter_actor_child_index_remove (ClutterActor *self,
+                                  ClutterActor *child)
+{
+  ClutterActorPrivate *priv = self->priv;
+
+  if (priv->child_index == NULL ||
+      priv->child_index_shared ||
+      priv->child_index_age != priv->age - 1 ||
+      child->priv->index_in_parent != priv->child_index->len - 1)
+    return;
+
+  g_ptr_array_set_size (priv->child_index, priv->child_index->len - 1);
+
+  priv->child_index_age = priv->age;
+}
+
+/*< private >
+ * clutter_actor_find_child_at_index:
+ * @self: a #ClutterActor
+ * @index_: a valid position in the list of children
+ *
+ * Retrieves the child of @self at @index_ using the child index if it
+ * is valid, or by walking the list of children from the closest end
+ * otherwise; the child index is never built.
+ *
+ * Return value: (transfer none): the child at @index_
+ */
+static ClutterActor *
+clutter_actor_find_child_at_index (ClutterActor *self,
+                                   gint          index_)
+{
+  ClutterActorPrivate *priv = self->priv;
+  ClutterActor *iter;
+  gint i;
+
+  if (clutter_actor_has_child_index (self))
+    return g_ptr_array_index (priv->child_index, index_);
+
+  if (index_ < priv->n_children / 2)
+    {
+      for (iter = priv->first_child, i = 0;
+           i < index_;
+           iter = iter->priv->next_sibling, i += 1)
+        ;
+    }
+  else
+    {
+      for (iter = priv->last_child, i = priv->n_children - 1;
+           i > index_;
+           iter = iter->priv->prev_sibling, i -= 1)
+        ;
+    }
+
+  return iter;
+}
+
+/*< private >
+ * clutter_actor_get_child_at_index_internal:
+ * @self: a #ClutterActor
+ * @index_: the position in the list of children
+ *
+ * Retrieves the child of @self at @index_, building the child index
+ * for large containers.
+ *
+ * Return value: (transfer none): the child at @index_, or %NULL
+ */
+static ClutterActor *
+clutter_actor_get_child_at_index_internal (ClutterActor *self,
+                                           gint          index_)
+{
+  ClutterActorPrivate *priv = self->priv;
+
+  if (index_ <= 0)
+    return priv->first_child;
+
+  if (index_ >= priv->n_children)
+    return NULL;
+
+  if (priv->n_children >= CHILD_INDEX_MIN_CHILDREN)
+    return g_ptr_array_index (clutter_actor_ensure_child_index (self), index_);
+
+  return clutter_actor_find_child_at_index (self, index_);
+}
+
 typedef enum {
   REMOVE_CHILD_DESTROY_META       = 1 << 0,
   REMOVE_CHILD_EMIT_PARENT_SET    = 1 << 1,
@@ -4268,6 +4647,9 @@ clutter_actor_remove_child_internal (ClutterActor                 *self,
   self->priv->n_children -= 1;
 
   self->priv->age += 1;
+  self->priv->children_layout_age += 1;
+
+  clutter_actor_child_index_remove (self, child);
 
   /* if the child that got removed was visible and set to
    * expand then we want to reset the parent's state in
@@ -5318,6 +5700,10 @@ clutter_actor_set_property (GObject      *object,
       clutter_actor_set_content_repeat (actor, g_value_get_flags (value));
       break;
 
+    case PROP_RELAYOUT_BOUNDARY:
+      clutter_actor_set_relayout_boundary (actor, g_value_get_boolean (value));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -5883,6 +6269,10 @@ clutter_actor_get_property (GObject    *object,
       g_value_set_flags (value, priv->content_repeat);
       break;
 
+    case PROP_RELAYOUT_BOUNDARY:
+      g_value_set_boolean (value, priv->relayout_boundary);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -5980,6 +6370,9 @@ clutter_actor_finalize (GObject *object)
 
   g_free (priv->name);
 
+  if (priv->child_index != NULL)
+    g_ptr_array_unref (priv->child_index);
+
 #ifdef CLUTTER_ENABLE_DEBUG
   g_free (priv->debug_name);
 #endif
@@ -7853,6 +8246,26 @@ clutter_actor_class_init (ClutterActorClass *klass)
                         G_PARAM_READWRITE |
                         G_PARAM_STATIC_STRINGS);
 
+  /**
+   * ClutterActor:relayout-boundary:
+   *
+   * Whether the size of the actor does not depend on its children,
+   * in which case a relayout queued by one of its children does not
+   * propagate to the ancestors of the actor.
+   *
+   * Actors are not relayout boundaries unless this property is set,
+   * even if they have a fixed size.
+   *
+   * Since: 1.28
+   */
+  obj_props[PROP_RELAYOUT_BOUNDARY] =
+    g_param_spec_boolean ("relayout-boundary",
+                          P_("Relayout Boundary"),
+                          P_("Whether the size of the actor does not depend on its children"),
+                          FALSE,
+                          G_PARAM_READWRITE |
+                          G_PARAM_STATIC_STRINGS);
+
   g_object_class_install_properties (object_class, PROP_LAST, obj_props);
 
   /**
@@ -8014,6 +8427,11 @@ clutter_actor_class_init (ClutterActorClass *klass)
    * properly in the presence of #ClutterClone actors. Applications will
    * not normally need to connect to this signal.
    *
+   * Since 1.28, the relayout does not propagate past an actor set as a
+   * relayout boundary with clutter_actor_set_relayout_boundary(): the
+   * signal is emitted on the actors up to the boundary, but not on the
+   * boundary and its ancestors.
+   *
    * Since: 1.2
    */
   actor_signals[QUEUE_RELAYOUT] =
@@ -8463,6 +8881,34 @@ clutter_actor_class_init (ClutterActorClass *klass)
                   G_TYPE_STRING,
                   G_TYPE_BOOLEAN);
 
+  /**
+   * ClutterActor::children-changed:
+   * @actor: the #ClutterActor whose children changed
+   * @n_added: the number of children added to @actor
+   * @n_removed: the number of children removed from @actor
+   *
+   * The ::children-changed signal is emitted once by each call to
+   * clutter_actor_add_children() and clutter_actor_remove_children(),
+   * after all the children have been added or removed, and after the
+   * #ClutterContainer::actor-added or #ClutterContainer::actor-removed
+   * signals for each of them.
+   *
+   * Handlers that only need to know that the list of children changed
+   * can use this signal instead of the per-child signals.
+   *
+   * Since: 1.28
+   */
+  actor_signals[CHILDREN_CHANGED] =
+    g_signal_new (I_("children-changed"),
+                  G_TYPE_FROM_CLASS (object_class),
+                  G_SIGNAL_RUN_LAST,
+                  0,
+                  NULL, NULL,
+                  _clutter_marshal_VOID__UINT_UINT,
+                  G_TYPE_NONE, 2,
+                  G_TYPE_UINT,
+                  G_TYPE_UINT);
+
   /**
    * ClutterActor::touch-event:
    * @actor: a #ClutterActor
@@ -9067,10 +9513,62 @@ clutter_actor_queue_redraw_with_clip (ClutterActor                *self,
 void
 clutter_actor_queue_relayout (ClutterActor *self)
 {
+  guint64 n_invalidated = relayout_invalidation_count;
+  ClutterActor *stage;
+
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
 
   _clutter_actor_queue_only_relayout (self);
   clutter_actor_queue_redraw (self);
+
+  n_invalidated = relayout_invalidation_count - n_invalidated;
+  stage = _clutter_actor_get_stage_internal (self);
+
+  if (n_invalidated > 0 && stage != NULL)
+    {
+      CLUTTER_NOTE (LAYOUT, "Queued relayout of '%s' invalidated %" G_GUINT64_FORMAT " actors",
+                    _clutter_actor_get_debug_name (self),
+                    n_invalidated);
+
+      _clutter_stage_count_queued_relayout (CLUTTER_STAGE (stage), n_invalidated);
+    }
+}
+
+/*< private >
+ * _clutter_actor_relayout_boundary:
+ * @self: a #ClutterActor
+ *
+ * Allocates the children of a relayout boundary queued by
+ * clutter_actor_queue_relayout(), using the current allocation
+ * of @self.
+ *
+ * Return value: %TRUE if the children of @self were allocated
+ */
+gboolean
+_clutter_actor_relayout_boundary (ClutterActor *self)
+{
+  ClutterActorPrivate *priv = self->priv;
+  ClutterActor *iter;
+
+  if (!priv->needs_allocation || CLUTTER_ACTOR_IN_DESTRUCTION (self))
+    return FALSE;
+
+  /* if an ancestor was not allocated, for instance because it is
+   * hidden, the boundary will be allocated together with it
+   */
+  for (iter = priv->parent; iter != NULL; iter = iter->priv->parent)
+    {
+      if (iter->priv->needs_allocation)
+        return FALSE;
+    }
+
+  CLUTTER_NOTE (LAYOUT, "Allocating the children of the boundary '%s'",
+                _clutter_actor_get_debug_name (self));
+
+  clutter_actor_allocate_internal (self, &priv->allocation,
+                                   priv->allocation_flags & ~CLUTTER_ABSOLUTE_ORIGIN_CHANGED);
+
+  return TRUE;
 }
 
 /**
@@ -9947,6 +10445,8 @@ clutter_actor_allocate_internal (ClutterActor           *self,
 {
   ClutterActorClass *klass;
 
+  self->priv->allocation_interpolated = FALSE;
+
   CLUTTER_SET_PRIVATE_FLAGS (self, CLUTTER_IN_RELAYOUT);
 
   CLUTTER_NOTE (LAYOUT, "Calling %s::allocate()",
@@ -9962,10 +10462,42 @@ clutter_actor_allocate_internal (ClutterActor           *self,
    */
 }
 
-/**
- * clutter_actor_allocate:
- * @self: A #ClutterActor
- * @box: new allocation of the actor, in parent-relative coordinates
+/* sets an allocation computed by the transition of the :allocation
+ * property; if the layout manager of the parent only animates the
+ * layout, the children are laid out once the transition stops,
+ * instead of on each frame
+ */
+static void
+clutter_actor_set_transition_allocation (ClutterActor          *self,
+                                         const ClutterActorBox *allocation)
+{
+  ClutterActorPrivate *priv = self->priv;
+  ClutterActorBox signal_box;
+
+  if (priv->parent == NULL ||
+      priv->parent->priv->layout_manager == NULL ||
+      !clutter_layout_manager_get_layout_only_animations (priv->parent->priv->layout_manager) ||
+      clutter_actor_get_transition (self, "allocation") == NULL)
+    {
+      clutter_actor_allocate_internal (self, allocation, priv->allocation_flags);
+      return;
+    }
+
+  if (!clutter_actor_set_allocation_internal (self, allocation, priv->allocation_flags))
+    return;
+
+  priv->allocation_interpolated = TRUE;
+
+  signal_box = priv->allocation;
+  g_signal_emit (self, actor_signals[ALLOCATION_CHANGED], 0,
+                 &signal_box,
+                 priv->allocation_flags);
+}
+
+/**
+ * clutter_actor_allocate:
+ * @self: A #ClutterActor
+ * @box: new allocation of the actor, in parent-relative coordinates
  * @flags: flags that control the allocation
  *
  * Assigns the size of a #ClutterActor from the given @box.
@@ -10000,9 +10532,12 @@ clutter_actor_allocate (ClutterActor           *self,
   gboolean origin_changed, child_moved, size_changed;
   gboolean stage_allocation_changed;
   ClutterActorPrivate *priv;
+  ClutterActor *stage;
 
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
-  if (G_UNLIKELY (_clutter_actor_get_stage_internal (self) == NULL))
+
+  stage = _clutter_actor_get_stage_internal (self);
+  if (G_UNLIKELY (stage == NULL))
     {
       g_warning ("Spurious clutter_actor_allocate called for actor %p/%s "
                  "which isn't a descendent of the stage!\n",
@@ -10021,6 +10556,14 @@ clutter_actor_allocate (ClutterActor           *self,
    */
   clutter_actor_update_constraints (self, &real_allocation);
 
+  /* the stage applies the constraints again after the relayout if
+   * one of their sources is allocated after this point
+   */
+  if (priv->constraints != NULL)
+    _clutter_stage_add_constrained_actor (CLUTTER_STAGE (stage), self,
+                                          box, flags,
+                                          last_allocation_serial);
+
   /* adjust the allocation depending on the align/margin properties */
   clutter_actor_adjust_allocation (self, &real_allocation);
 
@@ -12624,28 +13167,21 @@ insert_child_at_index (ClutterActor *self,
     }
   else
     {
-      ClutterActor *iter;
-      int i;
-
-      for (iter = self->priv->first_child, i = 0;
-           iter != NULL;
-           iter = iter->priv->next_sibling, i += 1)
-        {
-          if (index_ == i)
-            {
-              ClutterActor *tmp = iter->priv->prev_sibling;
+      ClutterActor *iter, *tmp;
 
-              child->priv->prev_sibling = tmp;
-              child->priv->next_sibling = iter;
+      /* the insertion invalidates the child index, so building it here
+       * would be wasted if the next change is another insertion
+       */
+      iter = clutter_actor_find_child_at_index (self, index_);
+      tmp = iter->priv->prev_sibling;
 
-              iter->priv->prev_sibling = child;
+      child->priv->prev_sibling = tmp;
+      child->priv->next_sibling = iter;
 
-              if (tmp != NULL)
-                tmp->priv->next_sibling = child;
+      iter->priv->prev_sibling = child;
 
-              break;
-            }
-        }
+      if (tmp != NULL)
+        tmp->priv->next_sibling = child;
     }
 
   if (child->priv->prev_sibling == NULL)
@@ -12753,42 +13289,24 @@ typedef enum {
 } ClutterActorAddChildFlags;
 
 /*< private >
- * clutter_actor_add_child_internal:
+ * clutter_actor_check_add_child:
  * @self: a #ClutterActor
  * @child: a #ClutterActor
- * @flags: control flags for actions
- * @add_func: delegate function
- * @data: (closure): data to pass to @add_func
  *
- * Adds @child to the list of children of @self.
- *
- * The actual insertion inside the list is delegated to @add_func: this
- * function will just set up the state, perform basic checks, and emit
- * signals.
+ * Checks whether @child can be added to the children of @self, and
+ * warns if it cannot.
  *
- * The @flags argument is used to perform additional operations.
+ * Return value: %TRUE if @child can be added
  */
-static inline void
-clutter_actor_add_child_internal (ClutterActor              *self,
-                                  ClutterActor              *child,
-                                  ClutterActorAddChildFlags  flags,
-                                  ClutterActorAddChildFunc   add_func,
-                                  gpointer                   data)
+static gboolean
+clutter_actor_check_add_child (ClutterActor *self,
+                               ClutterActor *child)
 {
-  ClutterTextDirection text_dir;
-  gboolean create_meta;
-  gboolean emit_parent_set, emit_actor_added;
-  gboolean check_state;
-  gboolean notify_first_last;
-  gboolean show_on_set_parent;
-  ClutterActor *old_first_child, *old_last_child;
-  GObject *obj;
-
   if (self == child)
     {
       g_warning ("Cannot add the actor '%s' to itself.",
                   _clutter_actor_get_debug_name (self));
-      return;
+      return FALSE;
     }
 
   if (child->priv->parent != NULL)
@@ -12797,7 +13315,7 @@ clutter_actor_add_child_internal (ClutterActor              *self,
                  "use clutter_actor_remove_child() first.",
                  _clutter_actor_get_debug_name (child),
                  _clutter_actor_get_debug_name (child->priv->parent));
-      return;
+      return FALSE;
     }
 
   if (CLUTTER_ACTOR_IS_TOPLEVEL (child))
@@ -12805,7 +13323,7 @@ clutter_actor_add_child_internal (ClutterActor              *self,
       g_warning ("The actor '%s' is a top-level actor, and cannot be "
                  "a child of another actor.",
                  _clutter_actor_get_debug_name (child));
-      return;
+      return FALSE;
     }
 
   /* the following check disallows calling methods that change the stacking
@@ -12853,9 +13371,47 @@ clutter_actor_add_child_internal (ClutterActor              *self,
       g_warning ("The actor '%s' is currently being destroyed, and "
                  "cannot be added as a child of another actor.",
                  _clutter_actor_get_debug_name (child));
-      return;
+      return FALSE;
     }
 
+  return TRUE;
+}
+
+/*< private >
+ * clutter_actor_add_child_internal:
+ * @self: a #ClutterActor
+ * @child: a #ClutterActor
+ * @flags: control flags for actions
+ * @add_func: delegate function
+ * @data: (closure): data to pass to @add_func
+ *
+ * Adds @child to the list of children of @self.
+ *
+ * The actual insertion inside the list is delegated to @add_func: this
+ * function will just set up the state, perform basic checks, and emit
+ * signals.
+ *
+ * The @flags argument is used to perform additional operations.
+ */
+static inline void
+clutter_actor_add_child_internal (ClutterActor              *self,
+                                  ClutterActor              *child,
+                                  ClutterActorAddChildFlags  flags,
+                                  ClutterActorAddChildFunc   add_func,
+                                  gpointer                   data)
+{
+  ClutterTextDirection text_dir;
+  gboolean create_meta;
+  gboolean emit_parent_set, emit_actor_added;
+  gboolean check_state;
+  gboolean notify_first_last;
+  gboolean show_on_set_parent;
+  ClutterActor *old_first_child, *old_last_child;
+  GObject *obj;
+
+  if (!clutter_actor_check_add_child (self, child))
+    return;
+
   create_meta = (flags & ADD_CHILD_CREATE_META) != 0;
   emit_parent_set = (flags & ADD_CHILD_EMIT_PARENT_SET) != 0;
   emit_actor_added = (flags & ADD_CHILD_EMIT_ACTOR_ADDED) != 0;
@@ -12885,6 +13441,9 @@ clutter_actor_add_child_internal (ClutterActor              *self,
   self->priv->n_children += 1;
 
   self->priv->age += 1;
+  self->priv->children_layout_age += 1;
+
+  clutter_actor_child_index_insert (self, child);
 
   /* if push_internal() has been called then we automatically set
    * the flag on the actor
@@ -13011,6 +13570,270 @@ clutter_actor_add_child (ClutterActor *self,
                                     NULL);
 }
 
+typedef struct {
+  ClutterActor *actor;
+  float z_position;
+} SortedChild;
+
+static gint
+compare_sorted_child (gconstpointer a,
+                      gconstpointer b,
+                      gpointer      dummy G_GNUC_UNUSED)
+{
+  const SortedChild *child_a = a;
+  const SortedChild *child_b = b;
+
+  if (child_a->z_position < child_b->z_position)
+    return -1;
+
+  if (child_a->z_position > child_b->z_position)
+    return 1;
+
+  return 0;
+}
+
+/**
+ * clutter_actor_add_children:
+ * @self: a #ClutterActor
+ * @children: (array length=n_children): the actors to add
+ * @n_children: the number of actors in @children
+ *
+ * Adds each actor in @children to the children of @self.
+ *
+ * The resulting list of children is the same as calling
+ * clutter_actor_add_child() on each actor in @children, in order; the
+ * children are sorted by their #ClutterActor:z-position once, and
+ * inserted in the list of children of @self in a single pass. The state
+ * of the children is updated once they have all been inserted, and
+ * @self queues at most one relayout and one redraw.
+ *
+ * This function will emit the #ClutterContainer::actor-added signal
+ * on @self for each child, followed by a single
+ * #ClutterActor::children-changed signal, as soon as all the children
+ * are inside the list of children; then the #ClutterActor::parent-set
+ * signal is emitted on each child, and the children are mapped and
+ * shown as needed.
+ *
+ * Unlike clutter_actor_add_child(), which emits
+ * #ClutterContainer::actor-added after the state of the child has been
+ * updated, the handlers of #ClutterContainer::actor-added are called
+ * before the children are mapped. In exchange, each child removed from
+ * @self by a signal handler during this function has been reported as
+ * added before being reported as removed.
+ *
+ * Since: 1.28
+ */
+void
+clutter_actor_add_children (ClutterActor        *self,
+                            ClutterActor * const *children,
+                            guint                n_children)
+{
+  ClutterActorPrivate *priv;
+  ClutterActor *old_first_child, *old_last_child;
+  ClutterActor *iter;
+  ClutterTextDirection text_dir;
+  SortedChild *sorted;
+  gboolean needs_compute_expand = FALSE;
+  gboolean needs_relayout = FALSE;
+  gboolean needs_redraw = FALSE;
+  guint actor_added_id;
+  guint i, n_sorted, n_added;
+  GObject *obj;
+
+  g_return_if_fail (CLUTTER_IS_ACTOR (self));
+  g_return_if_fail (children != NULL || n_children == 0);
+
+  if (n_children == 0)
+    return;
+
+  priv = self->priv;
+
+  obj = G_OBJECT (self);
+  g_object_freeze_notify (obj);
+
+  old_first_child = priv->first_child;
+  old_last_child = priv->last_child;
+
+  sorted = g_new (SortedChild, n_children);
+
+  /* setting the parent claims each child, so that an actor appearing
+   * twice inside @children is only added once
+   */
+  for (i = 0, n_sorted = 0; i < n_children; i++)
+    {
+      ClutterActor *child = children[i];
+
+      if (!CLUTTER_IS_ACTOR (child))
+        {
+          g_critical ("%s: the element %u of the children is not "
+                      "a ClutterActor",
+                      G_STRFUNC, i);
+          continue;
+        }
+
+      if (!clutter_actor_check_add_child (self, child))
+        continue;
+
+      clutter_container_create_child_meta (CLUTTER_CONTAINER (self), child);
+
+      g_object_ref_sink (child);
+      child->priv->parent = self;
+      child->priv->next_sibling = NULL;
+      child->priv->prev_sibling = NULL;
+
+      /* keep the child alive until the end, in case a signal handler
+       * removes it from @self
+       */
+      g_object_ref (child);
+
+      sorted[n_sorted].actor = child;
+      sorted[n_sorted].z_position =
+        _clutter_actor_get_transform_info_or_defaults (child)->z_position;
+      n_sorted += 1;
+    }
+
+  /* the sort is stable, so children at the same depth keep the order
+   * in which they were passed
+   */
+  g_qsort_with_data (sorted, n_sorted, sizeof (SortedChild),
+                     compare_sorted_child,
+                     NULL);
+
+  /* merge the sorted children with the list of children; just like
+   * insert_child_at_depth(), each child is inserted after all the
+   * children at the same depth
+   */
+  iter = priv->first_child;
+  for (i = 0; i < n_sorted; i++)
+    {
+      ClutterActor *child = sorted[i].actor;
+      ClutterActor *tmp;
+
+      while (iter != NULL &&
+             _clutter_actor_get_transform_info_or_defaults (iter)->z_position <= sorted[i].z_position)
+        iter = iter->priv->next_sibling;
+
+      if (iter != NULL)
+        {
+          tmp = iter->priv->prev_sibling;
+
+          child->priv->next_sibling = iter;
+          iter->priv->prev_sibling = child;
+        }
+      else
+        {
+          tmp = priv->last_child;
+
+          child->priv->next_sibling = NULL;
+          priv->last_child = child;
+        }
+
+      child->priv->prev_sibling = tmp;
+
+      if (tmp != NULL)
+        tmp->priv->next_sibling = child;
+      else
+        priv->first_child = child;
+    }
+
+  priv->n_children += n_sorted;
+
+  priv->age += 1;
+  priv->children_layout_age += 1;
+
+  /* the children are reported before their state is updated, so that a
+   * child removed by a ::parent-set handler is reported as added first
+   */
+  actor_added_id = g_signal_lookup ("actor-added", CLUTTER_TYPE_CONTAINER);
+  for (i = 0, n_added = 0; i < n_sorted; i++)
+    {
+      if (sorted[i].actor->priv->parent != self)
+        continue;
+
+      g_signal_emit (self, actor_added_id, 0, sorted[i].actor);
+      n_added += 1;
+    }
+
+  if (n_added > 0)
+    g_signal_emit (self, actor_signals[CHILDREN_CHANGED], 0, n_added, 0);
+
+  text_dir = clutter_actor_get_text_direction (self);
+
+  /* the state of the children is only updated once they are all
+   * inside the list of children
+   */
+  for (i = 0; i < n_sorted; i++)
+    {
+      ClutterActor *child = sorted[i].actor;
+
+      /* a handler may have removed the child already */
+      if (child->priv->parent != self)
+        continue;
+
+      if (priv->internal_child)
+        CLUTTER_SET_PRIVATE_FLAGS (child, CLUTTER_INTERNAL_CHILD);
+
+      if (CLUTTER_ACTOR_IS_VISIBLE (child) &&
+          (child->priv->needs_compute_expand ||
+           child->priv->needs_x_expand ||
+           child->priv->needs_y_expand))
+        needs_compute_expand = TRUE;
+
+      if (!CLUTTER_ACTOR_IN_REPARENT (child))
+        g_signal_emit (child, actor_signals[PARENT_SET], 0, NULL);
+
+      /* a handler may have removed the child already */
+      if (child->priv->parent != self)
+        continue;
+
+      clutter_actor_update_map_state (child, MAP_STATE_CHECK);
+      clutter_actor_set_text_direction (child, text_dir);
+
+      if (child->priv->show_on_set_parent)
+        clutter_actor_show (child);
+
+      if (child->priv->parent != self)
+        continue;
+
+      if (CLUTTER_ACTOR_IS_MAPPED (child))
+        needs_redraw = TRUE;
+
+      if (child->priv->needs_width_request ||
+          child->priv->needs_height_request ||
+          child->priv->needs_allocation)
+        {
+          child->priv->needs_width_request = TRUE;
+          child->priv->needs_height_request = TRUE;
+          child->priv->needs_allocation = TRUE;
+
+          needs_relayout = TRUE;
+        }
+    }
+
+  if (needs_compute_expand)
+    clutter_actor_queue_compute_expand (self);
+
+  /* a single redraw of the parent covers all the mapped children */
+  if (needs_redraw)
+    clutter_actor_queue_redraw (self);
+
+  if (needs_relayout)
+    _clutter_actor_queue_only_relayout (self);
+
+  if (old_first_child != priv->first_child)
+    g_object_notify_by_pspec (obj, obj_props[PROP_FIRST_CHILD]);
+
+  if (old_last_child != priv->last_child)
+    g_object_notify_by_pspec (obj, obj_props[PROP_LAST_CHILD]);
+
+  g_object_thaw_notify (obj);
+
+  for (i = 0; i < n_sorted; i++)
+    g_object_unref (sorted[i].actor);
+
+  g_free (sorted);
+}
+
 /**
  * clutter_actor_insert_child_at_index:
  * @self: a #ClutterActor
@@ -13205,35 +14028,166 @@ clutter_actor_get_paint_visibility (ClutterActor *actor)
   return CLUTTER_ACTOR_IS_MAPPED (actor);
 }
 
-/**
- * clutter_actor_remove_child:
- * @self: a #ClutterActor
- * @child: a #ClutterActor
- *
- * Removes @child from the children of @self.
- *
- * This function will release the reference added by
- * clutter_actor_add_child(), so if you want to keep using @child
- * you will have to acquire a referenced on it before calling this
- * function.
- *
- * This function will emit the #ClutterContainer::actor-removed
- * signal on @self.
- *
- * Since: 1.10
- */
-void
-clutter_actor_remove_child (ClutterActor *self,
-                            ClutterActor *child)
-{
-  g_return_if_fail (CLUTTER_IS_ACTOR (self));
-  g_return_if_fail (CLUTTER_IS_ACTOR (child));
-  g_return_if_fail (self != child);
-  g_return_if_fail (child->priv->parent != NULL);
-  g_return_if_fail (child->priv->parent == self);
+/**
+ * clutter_actor_remove_child:
+ * @self: a #ClutterActor
+ * @child: a #ClutterActor
+ *
+ * Removes @child from the children of @self.
+ *
+ * This function will release the reference added by
+ * clutter_actor_add_child(), so if you want to keep using @child
+ * you will have to acquire a referenced on it before calling this
+ * function.
+ *
+ * This function will emit the #ClutterContainer::actor-removed
+ * signal on @self.
+ *
+ * Since: 1.10
+ */
+void
+clutter_actor_remove_child (ClutterActor *self,
+                            ClutterActor *child)
+{
+  g_return_if_fail (CLUTTER_IS_ACTOR (self));
+  g_return_if_fail (CLUTTER_IS_ACTOR (child));
+  g_return_if_fail (self != child);
+  g_return_if_fail (child->priv->parent != NULL);
+  g_return_if_fail (child->priv->parent == self);
+
+  clutter_actor_remove_child_internal (self, child,
+                                       REMOVE_CHILD_DEFAULT_FLAGS);
+}
+
+/**
+ * clutter_actor_remove_children:
+ * @self: a #ClutterActor
+ * @children: (array length=n_children): the children of @self to remove
+ * @n_children: the number of actors in @children
+ *
+ * Removes each actor in @children from the children of @self.
+ *
+ * The result is the same as calling clutter_actor_remove_child() on
+ * each actor in @children, in order; the children are unlinked from
+ * @self first, and @self queues at most one relayout.
+ *
+ * This function will emit the #ClutterContainer::actor-removed signal
+ * on @self for each child, after all the children have been removed,
+ * followed by a single #ClutterActor::children-changed signal.
+ *
+ * Since: 1.28
+ */
+void
+clutter_actor_remove_children (ClutterActor        *self,
+                               ClutterActor * const *children,
+                               guint                n_children)
+{
+  ClutterActorPrivate *priv;
+  ClutterActor *old_first_child, *old_last_child;
+  ClutterActor **removed;
+  gboolean needs_compute_expand = FALSE;
+  gboolean needs_relayout = FALSE;
+  guint actor_removed_id;
+  guint i, n_removed;
+  GObject *obj;
+
+  g_return_if_fail (CLUTTER_IS_ACTOR (self));
+  g_return_if_fail (children != NULL || n_children == 0);
+
+  if (n_children == 0)
+    return;
+
+  priv = self->priv;
+
+  obj = G_OBJECT (self);
+  g_object_freeze_notify (obj);
+
+  old_first_child = priv->first_child;
+  old_last_child = priv->last_child;
+
+  removed = g_new (ClutterActor *, n_children);
+
+  /* unlinking resets the parent, so that an actor appearing twice
+   * inside @children is only removed once
+   */
+  for (i = 0, n_removed = 0; i < n_children; i++)
+    {
+      ClutterActor *child = children[i];
+
+      if (!CLUTTER_IS_ACTOR (child) || child->priv->parent != self)
+        {
+          g_warning ("The element %u of the children is not a child "
+                     "of the actor '%s'.",
+                     i,
+                     _clutter_actor_get_debug_name (self));
+          continue;
+        }
+
+      _clutter_actor_stop_transitions (child);
+
+      clutter_container_destroy_child_meta (CLUTTER_CONTAINER (self), child);
+
+      if (CLUTTER_ACTOR_IS_MAPPED (child))
+        needs_relayout = TRUE;
+
+      /* see clutter_actor_remove_child_internal() for the ordering */
+      clutter_actor_update_map_state (child, MAP_STATE_MAKE_UNREALIZED);
+
+      _clutter_actor_traverse (child,
+                               0,
+                               invalidate_queue_redraw_entry,
+                               NULL,
+                               NULL);
+
+      remove_child (self, child);
+
+      if (CLUTTER_ACTOR_IS_VISIBLE (child) &&
+          (child->priv->needs_compute_expand ||
+           child->priv->needs_x_expand ||
+           child->priv->needs_y_expand))
+        needs_compute_expand = TRUE;
+
+      removed[n_removed++] = child;
+    }
+
+  priv->n_children -= n_removed;
+
+  priv->age += 1;
+  priv->children_layout_age += 1;
+
+  if (needs_compute_expand)
+    clutter_actor_queue_compute_expand (self);
+
+  for (i = 0; i < n_removed; i++)
+    {
+      if (!CLUTTER_ACTOR_IN_REPARENT (removed[i]))
+        g_signal_emit (removed[i], actor_signals[PARENT_SET], 0, self);
+    }
+
+  if (needs_relayout)
+    clutter_actor_queue_relayout (self);
+
+  /* we need to emit the signal before dropping the references */
+  actor_removed_id = g_signal_lookup ("actor-removed", CLUTTER_TYPE_CONTAINER);
+  for (i = 0; i < n_removed; i++)
+    g_signal_emit (self, actor_removed_id, 0, removed[i]);
+
+  if (n_removed > 0)
+    g_signal_emit (self, actor_signals[CHILDREN_CHANGED], 0, 0, n_removed);
+
+  if (old_first_child != priv->first_child)
+    g_object_notify_by_pspec (obj, obj_props[PROP_FIRST_CHILD]);
+
+  if (old_last_child != priv->last_child)
+    g_object_notify_by_pspec (obj, obj_props[PROP_LAST_CHILD]);
+
+  g_object_thaw_notify (obj);
+
+  /* remove the references we acquired when adding the children */
+  for (i = 0; i < n_removed; i++)
+    g_object_unref (removed[i]);
 
-  clutter_actor_remove_child_internal (self, child,
-                                       REMOVE_CHILD_DEFAULT_FLAGS);
+  g_free (removed);
 }
 
 /**
@@ -13671,6 +14625,8 @@ clutter_actor_set_child_at_index (ClutterActor *self,
                                   ClutterActor *child,
                                   gint          index_)
 {
+  ClutterActorPrivate *priv;
+
   g_return_if_fail (CLUTTER_IS_ACTOR (self));
   g_return_if_fail (CLUTTER_IS_ACTOR (child));
   g_return_if_fail (child->priv->parent == self);
@@ -13680,12 +14636,70 @@ clutter_actor_set_child_at_index (ClutterActor *self,
       CLUTTER_ACTOR_IN_DESTRUCTION (child))
     return;
 
+  priv = self->priv;
+
   g_object_ref (child);
-  clutter_actor_remove_child_internal (self, child, 0);
-  clutter_actor_add_child_internal (self, child,
-                                    ADD_CHILD_NOTIFY_FIRST_LAST,
-                                    insert_child_at_index,
-                                    GINT_TO_POINTER (index_));
+
+  if (clutter_actor_has_child_index (self) && !priv->child_index_shared)
+    {
+      GPtrArray *child_index = priv->child_index;
+      InsertBetweenData data;
+      guint old_position, new_position, i;
+
+      /* move @child inside the index, and use it to find the new
+       * siblings, instead of walking the list of children
+       */
+      old_position = child->priv->index_in_parent;
+      if (index_ < 0 || index_ >= priv->n_children - 1)
+        new_position = priv->n_children - 1;
+      else
+        new_position = index_;
+
+      g_ptr_array_remove_index (child_index, old_position);
+      g_ptr_array_insert (child_index, new_position, child);
+
+      for (i = MIN (old_position, new_position);
+           i <= MAX (old_position, new_position);
+           i++)
+        {
+          ClutterActor *iter = g_ptr_array_index (child_index, i);
+
+          iter->priv->index_in_parent = i;
+        }
+
+      data.prev_sibling = new_position > 0
+                        ? g_ptr_array_index (child_index, new_position - 1)
+                        : NULL;
+      data.next_sibling = new_position + 1 < child_index->len
+                        ? g_ptr_array_index (child_index, new_position + 1)
+                        : NULL;
+
+      /* the index is already up to date, so it is taken out while the
+       * child is moved
+       */
+      priv->child_index = NULL;
+
+      clutter_actor_remove_child_internal (self, child, 0);
+      clutter_actor_add_child_internal (self, child,
+                                        ADD_CHILD_NOTIFY_FIRST_LAST,
+                                        insert_child_between,
+                                        &data);
+
+      if (priv->child_index != NULL)
+        g_ptr_array_unref (priv->child_index);
+
+      priv->child_index = child_index;
+      priv->child_index_age = priv->age;
+    }
+  else
+    {
+      clutter_actor_remove_child_internal (self, child, 0);
+      clutter_actor_add_child_internal (self, child,
+                                        ADD_CHILD_NOTIFY_FIRST_LAST,
+                                        insert_child_at_index,
+                                        GINT_TO_POINTER (index_));
+    }
+
   g_object_unref (child);
 
   clutter_actor_queue_relayout (self);
@@ -13823,6 +14837,244 @@ clutter_actor_lower_bottom (ClutterActor *self)
  * Event handling
  */
 
+static gint
+clutter_actor_get_event_signal (ClutterEventType event_type)
+{
+  switch (event_type)
+    {
+    case CLUTTER_BUTTON_PRESS:
+      return BUTTON_PRESS_EVENT;
+    case CLUTTER_BUTTON_RELEASE:
+      return BUTTON_RELEASE_EVENT;
+    case CLUTTER_SCROLL:
+      return SCROLL_EVENT;
+    case CLUTTER_KEY_PRESS:
+      return KEY_PRESS_EVENT;
+    case CLUTTER_KEY_RELEASE:
+      return KEY_RELEASE_EVENT;
+    case CLUTTER_MOTION:
+      return MOTION_EVENT;
+    case CLUTTER_ENTER:
+      return ENTER_EVENT;
+    case CLUTTER_LEAVE:
+      return LEAVE_EVENT;
+    case CLUTTER_TOUCH_BEGIN:
+    case CLUTTER_TOUCH_END:
+    case CLUTTER_TOUCH_UPDATE:
+    case CLUTTER_TOUCH_CANCEL:
+      return TOUCH_EVENT;
+    case CLUTTER_NOTHING:
+    case CLUTTER_DELETE:
+    case CLUTTER_DESTROY_NOTIFY:
+    case CLUTTER_CLIENT_MESSAGE:
+    default:
+      return -1;
+    }
+}
+
+static gboolean
+clutter_actor_emit_event (ClutterActor       *actor,
+                          const ClutterEvent *event,
+                          gboolean            capture)
+{
+  gboolean retval = FALSE;
+  gint signal_num;
+
+  if (capture)
+    {
+      g_signal_emit (actor, actor_signals[CAPTURED_EVENT], 0,
+		     event,
+                     &retval);
+
+      /* the stage calls the event handlers of the actions after
+       * the signal handlers, like a handler connected "after"
+       */
+      if (!retval && CLUTTER_ACTOR_IS_TOPLEVEL (actor))
+        retval = _clutter_stage_dispatch_event_handlers (CLUTTER_STAGE (actor),
+                                                         event);
+
+      return retval;
+    }
+
+  g_signal_emit (actor, actor_signals[EVENT], 0, event, &retval);
+
+  if (!retval)
+    {
+      signal_num = clutter_actor_get_event_signal (event->type);
+
+      if (signal_num != -1)
+	g_signal_emit (actor, actor_signals[signal_num], 0,
+		       event, &retval);
+    }
+
+  return retval;
+}
+
+/*< private >
+ * clutter_actor_has_event_handlers:
+ * @self: a #ClutterActor
+ * @signal_num: the type-specific event signal, or -1
+ *
+ * Checks whether emitting an event on @self can have any effect, that
+ * is whether @self has a class handler or a connected handler, even a
+ * blocked one, for the #ClutterActor::captured-event, the
+ * #ClutterActor::event or the type-specific event signal.
+ *
+ * The handlers are tracked by GObject for each instance, so this does
+ * not need any bookkeeping of its own; the emission hooks are not, and
+ * are tracked by clutter_actor_add_event_emission_hook() instead.
+ */
+static gboolean
+clutter_actor_has_event_handlers (ClutterActor *self,
+                                  gint          signal_num)
+{
+  ClutterActorClass *klass = CLUTTER_ACTOR_GET_CLASS (self);
+  gpointer class_handler;
+
+  if (self->priv->has_event_hooks || n_event_emission_hooks > 0)
+    return TRUE;
+
+  if (klass->event != NULL || klass->captured_event != NULL)
+    return TRUE;
+
+  switch (signal_num)
+    {
+    case BUTTON_PRESS_EVENT:
+      class_handler = klass->button_press_event;
+      break;
+    case BUTTON_RELEASE_EVENT:
+      class_handler = klass->button_release_event;
+      break;
+    case SCROLL_EVENT:
+      class_handler = klass->scroll_event;
+      break;
+    case KEY_PRESS_EVENT:
+      class_handler = klass->key_press_event;
+      break;
+    case KEY_RELEASE_EVENT:
+      class_handler = klass->key_release_event;
+      break;
+    case MOTION_EVENT:
+      class_handler = klass->motion_event;
+      break;
+    case ENTER_EVENT:
+      class_handler = klass->enter_event;
+      break;
+    case LEAVE_EVENT:
+      class_handler = klass->leave_event;
+      break;
+    case TOUCH_EVENT:
+      class_handler = klass->touch_event;
+      break;
+    default:
+      class_handler = NULL;
+      break;
+    }
+
+  if (class_handler != NULL)
+    return TRUE;
+
+  if (g_signal_has_handler_pending (self, actor_signals[CAPTURED_EVENT], 0, TRUE) ||
+      g_signal_has_handler_pending (self, actor_signals[EVENT], 0, TRUE))
+    return TRUE;
+
+  return signal_num != -1 &&
+         g_signal_has_handler_pending (self, actor_signals[signal_num], 0, TRUE);
+}
+
+typedef struct _EventEmissionHook
+{
+  GSignalEmissionHook func;
+  gpointer data;
+  GDestroyNotify destroy;
+} EventEmissionHook;
+
+static gboolean
+event_emission_hook_invoke (GSignalInvocationHint *ihint,
+                            guint                  n_param_values,
+                            const GValue          *param_values,
+                            gpointer               data)
+{
+  EventEmissionHook *hook = data;
+
+  return hook->func (ihint, n_param_values, param_values, hook->data);
+}
+
+static void
+event_emission_hook_free (gpointer data)
+{
+  EventEmissionHook *hook = data;
+
+  /* also called when the hook removes itself by returning %FALSE */
+  n_event_emission_hooks -= 1;
+
+  if (hook->destroy != NULL)
+    hook->destroy (hook->data);
+
+  g_slice_free (EventEmissionHook, hook);
+}
+
+/**
+ * clutter_actor_add_event_emission_hook:
+ * @signal_id: the identifier of an event signal of #ClutterActor
+ * @detail: the detail on which to call the hook
+ * @hook_func: (scope notified): a #GSignalEmissionHook function
+ * @hook_data: (closure): data for @hook_func
+ * @data_destroy: (destroy): a #GDestroyNotify for @hook_data
+ *
+ * Adds an emission hook to one of the event signals of #ClutterActor,
+ * like g_signal_add_emission_hook().
+ *
+ * When routing an event, Clutter does not emit the event signals on
+ * the actors that have no handler for them; emission hooks cannot be
+ * queried, so a hook added directly with g_signal_add_emission_hook()
+ * only sees the events emitted on actors that have a class handler or
+ * a connected handler for the signal. While a hook added with this
+ * function exists, the events are emitted on every actor receiving
+ * them instead.
+ *
+ * The hook is removed with g_signal_remove_emission_hook().
+ *
+ * Return value: the hook id, for later use with
+ *   g_signal_remove_emission_hook()
+ *
+ * Since: 1.28
+ */
+gulong
+clutter_actor_add_event_emission_hook (guint               signal_id,
+                                       GQuark              detail,
+                                       GSignalEmissionHook hook_func,
+                                       gpointer            hook_data,
+                                       GDestroyNotify      data_destroy)
+{
+  EventEmissionHook *hook;
+  gulong hook_id;
+
+  g_return_val_if_fail (signal_id > 0, 0);
+  g_return_val_if_fail (hook_func != NULL, 0);
+
+  hook = g_slice_new (EventEmissionHook);
+  hook->func = hook_func;
+  hook->data = hook_data;
+  hook->destroy = data_destroy;
+
+  n_event_emission_hooks += 1;
+
+  hook_id = g_signal_add_emission_hook (signal_id, detail,
+                                        event_emission_hook_invoke,
+                                        hook,
+                                        event_emission_hook_free);
+
+  /* the hook was rejected, and its data is not going to be freed */
+  if (hook_id == 0)
+    {
+      n_event_emission_hooks -= 1;
+      g_slice_free (EventEmissionHook, hook);
+    }
+
+  return hook_id;
+}
+
 /**
  * clutter_actor_event:
  * @actor: a #ClutterActor
@@ -13844,74 +15096,15 @@ clutter_actor_event (ClutterActor       *actor,
                      const ClutterEvent *event,
 		     gboolean            capture)
 {
-  gboolean retval = FALSE;
-  gint signal_num = -1;
+  gboolean retval;
 
   g_return_val_if_fail (CLUTTER_IS_ACTOR (actor), FALSE);
   g_return_val_if_fail (event != NULL, FALSE);
 
   g_object_ref (actor);
 
-  if (capture)
-    {
-      g_signal_emit (actor, actor_signals[CAPTURED_EVENT], 0,
-		     event,
-                     &retval);
-      goto out;
-    }
-
-  g_signal_emit (actor, actor_signals[EVENT], 0, event, &retval);
-
-  if (!retval)
-    {
-      switch (event->type)
-	{
-	case CLUTTER_NOTHING:
-	  break;
-	case CLUTTER_BUTTON_PRESS:
-	  signal_num = BUTTON_PRESS_EVENT;
-	  break;
-	case CLUTTER_BUTTON_RELEASE:
-	  signal_num = BUTTON_RELEASE_EVENT;
-	  break;
-	case CLUTTER_SCROLL:
-	  signal_num = SCROLL_EVENT;
-	  break;
-	case CLUTTER_KEY_PRESS:
-	  signal_num = KEY_PRESS_EVENT;
-	  break;
-	case CLUTTER_KEY_RELEASE:
-	  signal_num = KEY_RELEASE_EVENT;
-	  break;
-	case CLUTTER_MOTION:
-	  signal_num = MOTION_EVENT;
-	  break;
-	case CLUTTER_ENTER:
-	  signal_num = ENTER_EVENT;
-	  break;
-	case CLUTTER_LEAVE:
-	  signal_num = LEAVE_EVENT;
-	  break;
-        case CLUTTER_TOUCH_BEGIN:
-        case CLUTTER_TOUCH_END:
-        case CLUTTER_TOUCH_UPDATE:
-        case CLUTTER_TOUCH_CANCEL:
-          signal_num = TOUCH_EVENT;
-          break;
-	case CLUTTER_DELETE:
-	case CLUTTER_DESTROY_NOTIFY:
-	case CLUTTER_CLIENT_MESSAGE:
-	default:
-	  signal_num = -1;
-	  break;
-	}
-
-      if (signal_num != -1)
-	g_signal_emit (actor, actor_signals[signal_num], 0,
-		       event, &retval);
-    }
+  retval = clutter_actor_emit_event (actor, event, capture);
 
-out:
   g_object_unref (actor);
 
   return retval;
@@ -14967,9 +16160,7 @@ clutter_actor_set_animatable_property (ClutterActor *actor,
       break;
 
     case PROP_ALLOCATION:
-      clutter_actor_allocate_internal (actor,
-                                       g_value_get_boxed (value),
-                                       actor->priv->allocation_flags);
+      clutter_actor_set_transition_allocation (actor, g_value_get_boxed (value));
       clutter_actor_queue_redraw (actor);
       break;
 
@@ -17151,6 +18342,66 @@ clutter_actor_get_clip_to_allocation (ClutterActor *self)
   return self->priv->clip_to_allocation;
 }
 
+/**
+ * clutter_actor_set_relayout_boundary:
+ * @self: a #ClutterActor
+ * @is_boundary: whether @self is a relayout boundary
+ *
+ * Sets whether the size of @self does not depend on its children.
+ *
+ * A relayout queued by a child of a relayout boundary, for instance
+ * because its preferred size changed, does not invalidate the size of
+ * the boundary and of its ancestors; only the children of the boundary
+ * are allocated again, within the current allocation of the boundary.
+ *
+ * Actors with a fixed minimum and natural width and height, for
+ * instance by using clutter_actor_set_size(), are good candidates, as
+ * are actors whose size is determined by their parent without depending
+ * on their children. Since the ancestors of @self are not notified of
+ * the relayouts queued by its children, through the
+ * #ClutterActor::queue-relayout signal, actors are not relayout
+ * boundaries unless this function is called.
+ *
+ * Since: 1.28
+ */
+void
+clutter_actor_set_relayout_boundary (ClutterActor *self,
+                                     gboolean      is_boundary)
+{
+  ClutterActorPrivate *priv;
+
+  g_return_if_fail (CLUTTER_IS_ACTOR (self));
+
+  is_boundary = !!is_boundary;
+
+  priv = self->priv;
+
+  if (priv->relayout_boundary != is_boundary)
+    {
+      priv->relayout_boundary = is_boundary;
+
+      g_object_notify_by_pspec (G_OBJECT (self), obj_props[PROP_RELAYOUT_BOUNDARY]);
+    }
+}
+
+/**
+ * clutter_actor_get_relayout_boundary:
+ * @self: a #ClutterActor
+ *
+ * Retrieves the value set using clutter_actor_set_relayout_boundary().
+ *
+ * Return value: %TRUE if @self was set as a relayout boundary
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_actor_get_relayout_boundary (ClutterActor *self)
+{
+  g_return_val_if_fail (CLUTTER_IS_ACTOR (self), FALSE);
+
+  return self->priv->relayout_boundary;
+}
+
 /**
  * clutter_actor_add_effect:
  * @self: a #ClutterActor
@@ -17784,18 +19035,45 @@ ClutterActor *
 clutter_actor_get_child_at_index (ClutterActor *self,
                                   gint          index_)
 {
-  ClutterActor *iter;
-  int i;
-
   g_return_val_if_fail (CLUTTER_IS_ACTOR (self), NULL);
   g_return_val_if_fail (index_ <= self->priv->n_children, NULL);
 
-  for (iter = self->priv->first_child, i = 0;
-       iter != NULL && i < index_;
-       iter = iter->priv->next_sibling, i += 1)
-    ;
+  return clutter_actor_get_child_at_index_internal (self, index_);
+}
 
-  return iter;
+/**
+ * clutter_actor_get_children_snapshot:
+ * @self: a #ClutterActor
+ *
+ * Retrieves an array with the children of @self, in paint order.
+ *
+ * The array is a snapshot: it is not modified when the children of
+ * @self change, so it is safe to add or remove children while walking
+ * it. The snapshot does not hold references on the children, though,
+ * so an actor removed from @self must not be used after it has been
+ * destroyed.
+ *
+ * Unlike clutter_actor_get_children(), this function does not copy
+ * the children if they did not change since the last call: the array
+ * is shared with the index that @self uses for the indexed access to
+ * its children.
+ *
+ * Return value: (transfer container) (element-type ClutterActor): the
+ *   children of @self. Use g_ptr_array_unref() when done
+ *
+ * Since: 1.28
+ */
+GPtrArray *
+clutter_actor_get_children_snapshot (ClutterActor *self)
+{
+  GPtrArray *child_index;
+
+  g_return_val_if_fail (CLUTTER_IS_ACTOR (self), NULL);
+
+  child_index = clutter_actor_ensure_child_index (self);
+  self->priv->child_index_shared = TRUE;
+
+  return g_ptr_array_ref (child_index);
 }
 
 /*< private >
@@ -19041,6 +20319,26 @@ on_transition_stopped (ClutterTransition *transition,
   /* reset the caches used by animations */
   clutter_actor_store_content_box (actor, NULL);
 
+  /* lay out the children of an actor whose allocation was animated
+   * by a layout-only animation, at the allocation it reached
+   */
+  if (actor->priv->allocation_interpolated &&
+      strcmp (clos->name, "allocation") == 0 &&
+      _clutter_actor_get_stage_internal (actor) != NULL)
+    {
+      ClutterActorBox allocation = actor->priv->allocation;
+
+      if (is_finished)
+        {
+          ClutterInterval *interval = clutter_transition_get_interval (transition);
+
+          allocation = *(ClutterActorBox *) g_value_get_boxed (clutter_interval_peek_final_value (interval));
+        }
+
+      clutter_actor_allocate_internal (actor, &allocation, actor->priv->allocation_flags);
+      clutter_actor_queue_redraw (actor);
+    }
+
   info = _clutter_actor_get_animation_info (actor);
 
   /* we need copies because we emit the signal after the
@@ -20533,13 +21831,19 @@ clutter_actor_get_content_repeat (ClutterActor *self)
   return self->priv->content_repeat;
 }
 
+#define N_CACHED_EMITTERS       64
+
 void
 _clutter_actor_handle_event (ClutterActor       *self,
                              const ClutterEvent *event)
 {
-  GPtrArray *event_tree;
+  ClutterActor *cached_emitters[N_CACHED_EMITTERS];
+  ClutterActor **emitters = cached_emitters;
+  guint emitters_size = N_CACHED_EMITTERS;
+  gint n_emitters = 0;
   ClutterActor *iter;
   gboolean is_key_event;
+  gint signal_num;
   gint i = 0;
 
   /* XXX - for historical reasons that are now lost in the mists of time,
@@ -20549,40 +21853,76 @@ _clutter_actor_handle_event (ClutterActor       *self,
   is_key_event = event->type == CLUTTER_KEY_PRESS ||
                  event->type == CLUTTER_KEY_RELEASE;
 
-  event_tree = g_ptr_array_sized_new (64);
-  g_ptr_array_set_free_func (event_tree, (GDestroyNotify) g_object_unref);
+  signal_num = clutter_actor_get_event_signal (event->type);
 
-  /* build the list of of emitters for the event */
+  /* build the list of of emitters for the event; the actors without
+   * handlers for the event are skipped, as emitting the signals on
+   * them would have no effect. The stage is always part of the
+   * chain, as it dispatches the event handlers of the actions
+   */
   iter = self;
   while (iter != NULL)
     {
       ClutterActor *parent = iter->priv->parent;
 
-      if (CLUTTER_ACTOR_IS_REACTIVE (iter) || /* an actor must be reactive */
-          parent == NULL ||                       /* unless it's the stage */
-          is_key_event)                          /* or this is a key event */
+      if (parent == NULL ||                         /* the stage */
+          ((CLUTTER_ACTOR_IS_REACTIVE (iter) ||   /* a reactive actor */
+            is_key_event) &&                     /* or any for key events */
+           clutter_actor_has_event_handlers (iter, signal_num)))
         {
+          if (G_UNLIKELY (n_emitters == emitters_size))
+            {
+              emitters_size *= 2;
+
+              if (emitters == cached_emitters)
+                {
+                  emitters = g_new (ClutterActor *, emitters_size);
+                  memcpy (emitters, cached_emitters, sizeof (cached_emitters));
+                }
+              else
+                emitters = g_renew (ClutterActor *, emitters, emitters_size);
+            }
+
           /* keep a reference on the actor, so that it remains valid
-           * for the duration of the signal emission
+           * for the duration of the signal emission; only the actors
+           * in the chain need one
            */
-          g_ptr_array_add (event_tree, g_object_ref (iter));
+          emitters[n_emitters++] = g_object_ref (iter);
         }
 
       iter = parent;
     }
 
   /* Capture: from top-level downwards */
-  for (i = event_tree->len - 1; i >= 0; i--)
-    if (clutter_actor_event (g_ptr_array_index (event_tree, i), event, TRUE))
+  for (i = n_emitters - 1; i >= 0; i--)
+    if (clutter_actor_emit_event (emitters[i], event, TRUE))
       goto done;
 
   /* Bubble: from source upwards */
-  for (i = 0; i < event_tree->len; i++)
-    if (clutter_actor_event (g_ptr_array_index (event_tree, i), event, FALSE))
+  for (i = 0; i < n_emitters; i++)
+    if (clutter_actor_emit_event (emitters[i], event, FALSE))
       goto done;
 
 done:
-  g_ptr_array_free (event_tree, TRUE);
+  for (i = 0; i < n_emitters; i++)
+    g_object_unref (emitters[i]);
+
+  if (emitters != cached_emitters)
+    g_free (emitters);
+}
+
+/*< private >
+ * _clutter_actor_set_has_event_hooks:
+ * @self: a #ClutterActor
+ *
+ * Marks @self as the emitter watched by an emission hook on one of
+ * its signals; since emission hooks cannot be queried, the events are
+ * always emitted on @self from then on.
+ */
+void
+_clutter_actor_set_has_event_hooks (ClutterActor *self)
+{
+  self->priv->has_event_hooks = TRUE;
 }
 
 static void
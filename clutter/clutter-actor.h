@@ -433,6 +433,11 @@ void                            clutter_actor_get_allocation_vertices
                                                                                  ClutterVertex                verts[]);
 CLUTTER_AVAILABLE_IN_ALL
 gboolean                        clutter_actor_has_allocation                    (ClutterActor                *self);
+CLUTTER_AVAILABLE_IN_1_28
+void                            clutter_actor_set_relayout_boundary             (ClutterActor                *self,
+                                                                                 gboolean                     is_boundary);
+CLUTTER_AVAILABLE_IN_1_28
+gboolean                        clutter_actor_get_relayout_boundary             (ClutterActor                *self);
 CLUTTER_AVAILABLE_IN_ALL
 void                            clutter_actor_set_size                          (ClutterActor                *self,
                                                                                  gfloat                       width,
@@ -641,6 +646,12 @@ CLUTTER_AVAILABLE_IN_ALL
 gboolean                        clutter_actor_event                             (ClutterActor               *actor,
                                                                                  const ClutterEvent         *event,
                                                                                  gboolean                    capture);
+CLUTTER_AVAILABLE_IN_1_28
+gulong                          clutter_actor_add_event_emission_hook           (guint                       signal_id,
+                                                                                 GQuark                      detail,
+                                                                                 GSignalEmissionHook         hook_func,
+                                                                                 gpointer                    hook_data,
+                                                                                 GDestroyNotify              data_destroy);
 CLUTTER_AVAILABLE_IN_ALL
 gboolean                        clutter_actor_has_pointer                       (ClutterActor               *self);
 
@@ -662,6 +673,10 @@ ClutterTextDirection            clutter_actor_get_text_direction
 CLUTTER_AVAILABLE_IN_1_10
 void                            clutter_actor_add_child                         (ClutterActor               *self,
                                                                                  ClutterActor               *child);
+CLUTTER_AVAILABLE_IN_1_28
+void                            clutter_actor_add_children                      (ClutterActor               *self,
+                                                                                 ClutterActor * const       *children,
+                                                                                 guint                       n_children);
 CLUTTER_AVAILABLE_IN_1_10
 void                            clutter_actor_insert_child_at_index             (ClutterActor               *self,
                                                                                  ClutterActor               *child,
@@ -681,12 +696,18 @@ void                            clutter_actor_replace_child
 CLUTTER_AVAILABLE_IN_1_10
 void                            clutter_actor_remove_child                      (ClutterActor               *self,
                                                                                  ClutterActor               *child);
+CLUTTER_AVAILABLE_IN_1_28
+void                            clutter_actor_remove_children                   (ClutterActor               *self,
+                                                                                 ClutterActor * const       *children,
+                                                                                 guint                       n_children);
 CLUTTER_AVAILABLE_IN_1_10
 void                            clutter_actor_remove_all_children               (ClutterActor               *self);
 CLUTTER_AVAILABLE_IN_1_10
 void                            clutter_actor_destroy_all_children              (ClutterActor               *self);
 CLUTTER_AVAILABLE_IN_1_10
 GList *                         clutter_actor_get_children                      (ClutterActor               *self);
+CLUTTER_AVAILABLE_IN_1_28
+GPtrArray *                     clutter_actor_get_children_snapshot             (ClutterActor               *self);
 CLUTTER_AVAILABLE_IN_1_10
 gint                            clutter_actor_get_n_children                    (ClutterActor               *self);
 CLUTTER_AVAILABLE_IN_1_10
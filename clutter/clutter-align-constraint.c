@@ -42,10 +42,11 @@
 
 #include "clutter-actor-meta-private.h"
 #include "clutter-actor-private.h"
-#include "clutter-constraint.h"
+#include "clutter-constraint-private.h"
 #include "clutter-debug.h"
 #include "clutter-enum-types.h"
 #include "clutter-private.h"
+#include "clutter-stage-private.h"
 
 #include <math.h>
 
@@ -91,8 +92,20 @@ source_position_changed (ClutterActor           *actor,
                          ClutterAllocationFlags  flags,
                          ClutterAlignConstraint *align)
 {
-  if (align->actor != NULL)
-    clutter_actor_queue_relayout (align->actor);
+  ClutterActor *stage;
+
+  if (align->actor == NULL)
+    return;
+
+  /* if the actor was already allocated during this relayout, the
+   * stage will apply the constraint again once the source is done
+   */
+  stage = _clutter_actor_get_stage_internal (align->actor);
+  if (stage != NULL &&
+      _clutter_stage_has_constrained_actor (CLUTTER_STAGE (stage), align->actor))
+    return;
+
+  clutter_actor_queue_relayout (align->actor);
 }
 
 static void
@@ -253,6 +266,12 @@ clutter_align_constraint_get_property (GObject    *gobject,
     }
 }
 
+static ClutterActor *
+clutter_align_constraint_get_constraint_source (ClutterConstraint *constraint)
+{
+  return CLUTTER_ALIGN_CONSTRAINT (constraint)->source;
+}
+
 static void
 clutter_align_constraint_class_init (ClutterAlignConstraintClass *klass)
 {
@@ -263,6 +282,8 @@ clutter_align_constraint_class_init (ClutterAlignConstraintClass *klass)
   meta_class->set_actor = clutter_align_constraint_set_actor;
 
   constraint_class->update_allocation = clutter_align_constraint_update_allocation;
+  clutter_constraint_class_set_source_func (constraint_class,
+                                            clutter_align_constraint_get_constraint_source);
 
   /**
    * ClutterAlignConstraint:source:
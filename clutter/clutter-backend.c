@@ -95,6 +95,9 @@
 #ifdef CLUTTER_INPUT_MIR
 #include "mir/clutter-device-manager-mir.h"
 #endif
+#ifdef CLUTTER_WINDOWING_HEADLESS
+#include "headless/clutter-backend-headless.h"
+#endif
 
 #ifdef CLUTTER_HAS_WAYLAND_COMPOSITOR_SUPPORT
 #include <cogl/cogl-wayland-server.h>
@@ -131,6 +134,9 @@ clutter_backend_dispose (GObject *gobject)
   /* clear the events still in the queue of the main context */
   _clutter_clear_events_queue ();
 
+  /* cancel the glyph cache warm-up, which needs the backend */
+  _clutter_clear_glyph_cache_warm_up ();
+
   /* remove all event translators */
   g_clear_pointer (&backend->event_translators, g_list_free);
 
@@ -276,6 +282,12 @@ clutter_backend_do_real_create_context (ClutterBackend  *backend,
 
   CLUTTER_NOTE (BACKEND, "Connecting the renderer");
   cogl_renderer_set_driver (backend->cogl_renderer, driver_id);
+
+  /* the no-op driver cannot present anything, so do not let Cogl pick
+   * a windowing system that would need a display connection
+   */
+  if (driver_id == COGL_DRIVER_NOP)
+    cogl_renderer_set_winsys_id (backend->cogl_renderer, COGL_WINSYS_ID_STUB);
   if (!cogl_renderer_connect (backend->cogl_renderer, &internal_error))
     goto error;
 
@@ -366,6 +378,7 @@ static const struct {
   { "gl", "OpenGL legacy profile", COGL_DRIVER_GL },
   { "gles2", "OpenGL ES 2.0", COGL_DRIVER_GLES2 },
   { "any", "Default Cogl driver", COGL_DRIVER_ANY },
+  { "nop", "No-op driver", COGL_DRIVER_NOP },
 };
 
 static const char *allowed_drivers;
@@ -405,6 +418,13 @@ clutter_backend_real_create_context (ClutterBackend  *backend,
           if (!allow_any && !is_any && !strstr (driver_name, all_known_drivers[j].driver_name))
             continue;
 
+          /* the no-op driver does not render anything, so it is never
+           * part of the default list and has to be asked for by name
+           */
+          if (all_known_drivers[j].driver_id == COGL_DRIVER_NOP &&
+              !g_str_equal (all_known_drivers[j].driver_name, driver_name))
+            continue;
+
           if ((allow_any && is_any) ||
               (is_any && strstr (allowed_drivers, all_known_drivers[j].driver_name)) ||
               g_str_equal (all_known_drivers[j].driver_name, driver_name))
@@ -556,6 +576,9 @@ static const struct {
 #endif
 #ifdef CLUTTER_WINDOWING_MIR
   { CLUTTER_WINDOWING_MIR, clutter_backend_mir_new },
+#endif
+#ifdef CLUTTER_WINDOWING_HEADLESS
+  { CLUTTER_WINDOWING_HEADLESS, clutter_backend_headless_new },
 #endif
   { NULL, NULL },
 };
@@ -687,6 +710,14 @@ clutter_backend_real_init_events (ClutterBackend *backend)
       _clutter_events_mir_init (backend);
     }
   else
+#endif
+#ifdef CLUTTER_INPUT_HEADLESS
+  if (clutter_check_windowing_backend (CLUTTER_WINDOWING_HEADLESS) &&
+      (input_backend == NULL || input_backend == I_(CLUTTER_INPUT_HEADLESS)))
+    {
+      _clutter_events_headless_init (backend);
+    }
+  else
 #endif
   if (input_backend != NULL)
     {
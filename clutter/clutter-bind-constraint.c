@@ -90,7 +90,7 @@
 
 #include "clutter-actor-meta-private.h"
 #include "clutter-actor-private.h"
-#include "clutter-constraint.h"
+#include "clutter-constraint-private.h"
 #include "clutter-debug.h"
 #include "clutter-enum-types.h"
 #include "clutter-private.h"
@@ -314,6 +314,12 @@ clutter_bind_constraint_get_property (GObject    *gobject,
     }
 }
 
+static ClutterActor *
+clutter_bind_constraint_get_constraint_source (ClutterConstraint *constraint)
+{
+  return CLUTTER_BIND_CONSTRAINT (constraint)->source;
+}
+
 static void
 clutter_bind_constraint_class_init (ClutterBindConstraintClass *klass)
 {
@@ -328,6 +334,8 @@ clutter_bind_constraint_class_init (ClutterBindConstraintClass *klass)
   meta_class->set_actor = clutter_bind_constraint_set_actor;
 
   constraint_class->update_allocation = clutter_bind_constraint_update_allocation;
+  clutter_constraint_class_set_source_func (constraint_class,
+                                            clutter_bind_constraint_get_constraint_source);
   /**
    * ClutterBindConstraint:source:
    *
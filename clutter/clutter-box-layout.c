@@ -53,6 +53,7 @@
 #endif
 
 #include <math.h>
+#include <string.h>
 
 #define CLUTTER_DISABLE_DEPRECATION_WARNINGS
 #include "deprecated/clutter-container.h"
@@ -74,10 +75,37 @@
 typedef struct _ClutterBoxChild         ClutterBoxChild;
 typedef struct _ClutterLayoutMetaClass  ClutterBoxChildClass;
 
+/* the visible children of the box, and their sizes in the orientation
+ * of the box, stored as parallel arrays that are owned by the layout
+ * and reused by each request and allocation
+ */
+typedef struct _BoxChildren
+{
+  ClutterActor **actors;
+  ClutterBoxChild **metas;
+  guint8 *expand;
+
+  /* the requested sizes */
+  gfloat *minimum;
+  gfloat *natural;
+
+  /* the sizes assigned to the children */
+  gfloat *sizes;
+
+  /* scratch space for sorting the children by gap */
+  guint *spreading;
+
+  guint n_children;
+  guint n_expand;
+  guint n_allocated;
+} BoxChildren;
+
 struct _ClutterBoxLayoutPrivate
 {
   ClutterContainer *container;
 
+  BoxChildren children;
+
   guint spacing;
 
   gulong easing_mode;
@@ -88,6 +116,7 @@ struct _ClutterBoxLayoutPrivate
   guint is_pack_start  : 1;
   guint use_animations : 1;
   guint is_homogeneous : 1;
+  guint children_busy  : 1;
 };
 
 struct _ClutterBoxChild
@@ -144,21 +173,8 @@ G_DEFINE_TYPE_WITH_PRIVATE (ClutterBoxLayout,
                             CLUTTER_TYPE_LAYOUT_MANAGER)
 
 
-typedef struct _RequestedSize
-{
-  ClutterActor *actor;
-
-  gfloat minimum_size;
-  gfloat natural_size;
-} RequestedSize;
-
-static gint distribute_natural_allocation (gint                  extra_space,
-					   guint                 n_requested_sizes,
-					   RequestedSize        *sizes);
-static void count_expand_children         (ClutterLayoutManager *layout,
-					   ClutterContainer     *container,
-					   gint                 *visible_children,
-					   gint                 *expand_children);
+static gint distribute_natural_allocation (gint         extra_space,
+                                           BoxChildren *children);
 
 /*
  * ClutterBoxChild
@@ -464,45 +480,158 @@ get_child_size (ClutterActor       *actor,
     clutter_actor_get_preferred_height (actor, for_size, min_size_p, natural_size_p);
 }
 
-/* Handle the request in the orientation of the box (i.e. width request of horizontal box) */
 static void
-get_preferred_size_for_orientation (ClutterBoxLayout   *self,
-				    ClutterActor       *container,
-				    gfloat              for_size,
-				    gfloat             *min_size_p,
-				    gfloat             *natural_size_p)
+box_children_clear (BoxChildren *children)
+{
+  g_free (children->actors);
+  g_free (children->metas);
+  g_free (children->expand);
+  g_free (children->minimum);
+  g_free (children->natural);
+  g_free (children->sizes);
+  g_free (children->spreading);
+
+  memset (children, 0, sizeof (BoxChildren));
+}
+
+/* returns the arrays of the layout, unless they are being used by a
+ * request or allocation that is still running; this happens if, for
+ * instance, the size of the container is requested by a handler of
+ * the ClutterActor::allocation-changed signal of one of its children
+ */
+static BoxChildren *
+box_children_acquire (ClutterBoxLayout *self)
 {
   ClutterBoxLayoutPrivate *priv = self->priv;
+
+  if (priv->children_busy)
+    return g_slice_new0 (BoxChildren);
+
+  priv->children_busy = TRUE;
+
+  return &priv->children;
+}
+
+static void
+box_children_release (ClutterBoxLayout *self,
+                      BoxChildren      *children)
+{
+  ClutterBoxLayoutPrivate *priv = self->priv;
+
+  if (children == &priv->children)
+    {
+      priv->children_busy = FALSE;
+      return;
+    }
+
+  box_children_clear (children);
+  g_slice_free (BoxChildren, children);
+}
+
+/* collects the visible children of @container, with their layout
+ * properties, in a single pass over the list of children
+ */
+static void
+box_children_collect (ClutterBoxLayout *self,
+                      BoxChildren      *children,
+                      ClutterActor     *container)
+{
+  ClutterLayoutManager *layout = CLUTTER_LAYOUT_MANAGER (self);
+  ClutterBoxLayoutPrivate *priv = self->priv;
   ClutterActorIter iter;
   ClutterActor *child;
-  gint n_children = 0;
-  gfloat minimum, natural;
+  guint n_children;
 
-  minimum = natural = 0;
+  n_children = clutter_actor_get_n_children (container);
+  if (n_children > children->n_allocated)
+    {
+      guint n_allocated = MAX (n_children, children->n_allocated * 2);
+
+      children->actors = g_renew (ClutterActor *, children->actors, n_allocated);
+      children->metas = g_renew (ClutterBoxChild *, children->metas, n_allocated);
+      children->expand = g_renew (guint8, children->expand, n_allocated);
+      children->minimum = g_renew (gfloat, children->minimum, n_allocated);
+      children->natural = g_renew (gfloat, children->natural, n_allocated);
+      children->sizes = g_renew (gfloat, children->sizes, n_allocated);
+      children->spreading = g_renew (guint, children->spreading, n_allocated);
+      children->n_allocated = n_allocated;
+    }
+
+  children->n_children = 0;
+  children->n_expand = 0;
 
   clutter_actor_iter_init (&iter, container);
   while (clutter_actor_iter_next (&iter, &child))
     {
-      gfloat child_min = 0, child_nat = 0;
+      ClutterLayoutMeta *meta;
+      guint i;
 
       if (!clutter_actor_is_visible (child))
-	continue;
+        continue;
+
+      meta = clutter_layout_manager_get_child_meta (layout,
+                                                    CLUTTER_CONTAINER (container),
+                                                    child);
 
-      n_children++;
+      i = children->n_children++;
 
-      get_child_size (child, priv->orientation,
-		      for_size, &child_min, &child_nat);
+      children->actors[i] = child;
+      children->metas[i] = CLUTTER_BOX_CHILD (meta);
+      children->expand[i] = clutter_actor_needs_expand (child, priv->orientation) ||
+                            children->metas[i]->expand;
 
-      minimum += child_min;
-      natural += child_nat;
+      if (children->expand[i])
+        children->n_expand += 1;
     }
+}
+
+/* requests the size of all the collected children */
+static void
+box_children_measure (BoxChildren        *children,
+                      ClutterOrientation  orientation,
+                      gfloat              for_size)
+{
+  guint i;
+
+  for (i = 0; i < children->n_children; i++)
+    get_child_size (children->actors[i], orientation, for_size,
+                    &children->minimum[i],
+                    &children->natural[i]);
+}
 
-  if (n_children > 1)
+/* Handle the request in the orientation of the box (i.e. width request of horizontal box) */
+static void
+get_preferred_size_for_orientation (ClutterBoxLayout   *self,
+				    ClutterActor       *container,
+				    gfloat              for_size,
+				    gfloat             *min_size_p,
+				    gfloat             *natural_size_p)
+{
+  ClutterBoxLayoutPrivate *priv = self->priv;
+  BoxChildren *children;
+  gfloat minimum, natural;
+  guint i;
+
+  minimum = natural = 0;
+
+  children = box_children_acquire (self);
+  box_children_collect (self, children, container);
+  box_children_measure (children, priv->orientation, for_size);
+
+  for (i = 0; i < children->n_children; i++)
+    {
+      minimum += children->minimum[i];
+      natural += children->natural[i];
+    }
+
+  if (children->n_children > 1)
     {
-      minimum += priv->spacing * (n_children - 1);
-      natural += priv->spacing * (n_children - 1);
+      minimum += priv->spacing * (children->n_children - 1);
+      natural += priv->spacing * (children->n_children - 1);
     }
 
+  box_children_release (self, children);
+
   if (min_size_p)
     *min_size_p = minimum;
 
@@ -517,10 +646,9 @@ get_base_size_for_opposite_orientation (ClutterBoxLayout   *self,
 					gfloat             *natural_size_p)
 {
   ClutterBoxLayoutPrivate *priv = self->priv;
-  ClutterActorIter iter;
-  ClutterActor *child;
-  gint n_children = 0;
+  BoxChildren *children;
   gfloat minimum, natural;
+  guint i;
   ClutterOrientation opposite_orientation =
     priv->orientation == CLUTTER_ORIENTATION_HORIZONTAL
     ? CLUTTER_ORIENTATION_VERTICAL
@@ -528,22 +656,18 @@ get_base_size_for_opposite_orientation (ClutterBoxLayout   *self,
 
   minimum = natural = 0;
 
-  clutter_actor_iter_init (&iter, container);
-  while (clutter_actor_iter_next (&iter, &child))
-    {
-      gfloat child_min = 0, child_nat = 0;
+  children = box_children_acquire (self);
+  box_children_collect (self, children, container);
+  box_children_measure (children, opposite_orientation, -1);
 
-      if (!clutter_actor_is_visible (child))
-	continue;
-
-      n_children++;
-
-      get_child_size (child, opposite_orientation, -1, &child_min, &child_nat);
-
-      minimum = MAX (minimum, child_min);
-      natural = MAX (natural, child_nat);
+  for (i = 0; i < children->n_children; i++)
+    {
+      minimum = MAX (minimum, children->minimum[i]);
+      natural = MAX (natural, children->natural[i]);
     }
 
+  box_children_release (self, children);
+
   if (min_size_p)
     *min_size_p = minimum;
 
@@ -568,14 +692,10 @@ get_preferred_size_for_opposite_orientation (ClutterBoxLayout   *self,
 					     gfloat             *min_size_p,
 					     gfloat             *natural_size_p)
 {
-  ClutterLayoutManager *layout = CLUTTER_LAYOUT_MANAGER (self);
   ClutterBoxLayoutPrivate *priv = self->priv;
-  ClutterContainer *real_container = CLUTTER_CONTAINER (container);
-  ClutterActor *child;
-  ClutterActorIter iter;
-  gint nvis_children = 0, n_extra_widgets = 0;
-  gint nexpand_children = 0, i;
-  RequestedSize *sizes;
+  BoxChildren *children;
+  gint nvis_children, n_extra_widgets = 0;
+  gint nexpand_children, i;
   gfloat minimum, natural, size, extra = 0;
   ClutterOrientation opposite_orientation =
     priv->orientation == CLUTTER_ORIENTATION_HORIZONTAL
@@ -584,11 +704,16 @@ get_preferred_size_for_opposite_orientation (ClutterBoxLayout   *self,
 
   minimum = natural = 0;
 
-  count_expand_children (layout, real_container,
-			 &nvis_children, &nexpand_children);
+  children = box_children_acquire (self);
+  box_children_collect (self, children, container);
+
+  nvis_children = children->n_children;
+  nexpand_children = children->n_expand;
 
   if (nvis_children < 1)
     {
+      box_children_release (self, children);
+
       if (min_size_p)
 	*min_size_p = 0;
 
@@ -599,22 +724,13 @@ get_preferred_size_for_opposite_orientation (ClutterBoxLayout   *self,
     }
 
   /* First collect the requested sizes in the natural orientation of the box */
-  sizes  = g_newa (RequestedSize, nvis_children);
-  size   = for_size;
+  box_children_measure (children, priv->orientation, -1);
 
-  i = 0;
-  clutter_actor_iter_init (&iter, container);
-  while (clutter_actor_iter_next (&iter, &child))
+  size = for_size;
+  for (i = 0; i < nvis_children; i++)
     {
-      if (!clutter_actor_is_visible (child))
-	continue;
-
-      get_child_size (child, priv->orientation, -1,
-		      &sizes[i].minimum_size,
-		      &sizes[i].natural_size);
-
-      size -= sizes[i].minimum_size;
-      i++;
+      children->sizes[i] = children->minimum[i];
+      size -= children->minimum[i];
     }
 
   if (priv->is_homogeneous)
@@ -626,7 +742,7 @@ get_preferred_size_for_opposite_orientation (ClutterBoxLayout   *self,
   else
     {
       /* Bring children up to size first */
-      size = distribute_natural_allocation (MAX (0, size), nvis_children, sizes);
+      size = distribute_natural_allocation (MAX (0, size), children);
 
       /* Calculate space which hasn't distributed yet,
        * and is available for expanding children.
@@ -639,66 +755,48 @@ get_preferred_size_for_opposite_orientation (ClutterBoxLayout   *self,
     }
 
   /* Distribute expand space to children */
-  i = 0;
-  clutter_actor_iter_init (&iter, container);
-  while (clutter_actor_iter_next (&iter, &child))
+  for (i = 0; i < nvis_children; i++)
     {
-      ClutterLayoutMeta *meta;
-      ClutterBoxChild   *box_child;
-
-      /* If widget is not visible, skip it. */
-      if (!clutter_actor_is_visible (child))
-        continue;
-
-      meta      = clutter_layout_manager_get_child_meta (layout, real_container, child);
-      box_child = CLUTTER_BOX_CHILD (meta);
-
       if (priv->is_homogeneous)
 	{
-	  sizes[i].minimum_size = extra;
+	  children->sizes[i] = extra;
 
           if (n_extra_widgets > 0)
             {
-              sizes[i].minimum_size++;
+              children->sizes[i]++;
               n_extra_widgets--;
             }
 	}
       else
 	{
-          if (clutter_actor_needs_expand (child, priv->orientation) || box_child->expand)
+          if (children->expand[i])
             {
-              sizes[i].minimum_size += extra;
+              children->sizes[i] += extra;
 
               if (n_extra_widgets > 0)
                 {
-                  sizes[i].minimum_size++;
+                  children->sizes[i]++;
                   n_extra_widgets--;
                 }
             }
 	}
-      i++;
     }
 
   /* Virtual allocation finished, now we can finally ask for the right size-for-size */
-  i = 0;
-  clutter_actor_iter_init (&iter, container);
-  while (clutter_actor_iter_next (&iter, &child))
+  for (i = 0; i < nvis_children; i++)
     {
       gfloat child_min = 0, child_nat = 0;
 
-      if (!clutter_actor_is_visible (child))
-        continue;
-
-      get_child_size (child, opposite_orientation,
-		      sizes[i].minimum_size,
+      get_child_size (children->actors[i], opposite_orientation,
+		      children->sizes[i],
 		      &child_min, &child_nat);
 
       minimum = MAX (minimum, child_min);
       natural = MAX (natural, child_nat);
-
-      i++;
     }
 
+  box_children_release (self, children);
+
   if (min_size_p)
     *min_size_p = minimum;
 
@@ -706,22 +804,14 @@ get_preferred_size_for_opposite_orientation (ClutterBoxLayout   *self,
     *natural_size_p = natural;
 }
 
-
 static void
 allocate_box_child (ClutterBoxLayout       *self,
-                    ClutterContainer       *container,
                     ClutterActor           *child,
+                    ClutterBoxChild        *box_child,
                     ClutterActorBox        *child_box,
                     ClutterAllocationFlags  flags)
 {
   ClutterBoxLayoutPrivate *priv = self->priv;
-  ClutterBoxChild *box_child;
-  ClutterLayoutMeta *meta;
-
-  meta = clutter_layout_manager_get_child_meta (CLUTTER_LAYOUT_MANAGER (self),
-                                                container,
-                                                child);
-  box_child = CLUTTER_BOX_CHILD (meta);
 
   CLUTTER_NOTE (LAYOUT, "Allocation for %s { %.2f, %.2f, %.2f, %.2f }",
                 _clutter_actor_get_debug_name (child),
@@ -802,55 +892,21 @@ clutter_box_layout_get_preferred_height (ClutterLayoutManager *layout,
 					min_height_p, natural_height_p);
 }
 
-static void
-count_expand_children (ClutterLayoutManager *layout,
-                       ClutterContainer     *container,
-                       gint                 *visible_children,
-                       gint                 *expand_children)
-{
-  ClutterBoxLayoutPrivate *priv = CLUTTER_BOX_LAYOUT (layout)->priv;
-  ClutterActor *actor, *child;
-  ClutterActorIter iter;
-
-  actor = CLUTTER_ACTOR (container);
-
-  *visible_children = *expand_children = 0;
-
-  clutter_actor_iter_init (&iter, actor);
-  while (clutter_actor_iter_next (&iter, &child))
-    {
-      if (clutter_actor_is_visible (child))
-        {
-          ClutterLayoutMeta *meta;
-
-          *visible_children += 1;
-
-          meta = clutter_layout_manager_get_child_meta (layout,
-                                                        container,
-                                                        child);
-
-          if (clutter_actor_needs_expand (child, priv->orientation) ||
-              CLUTTER_BOX_CHILD (meta)->expand)
-            *expand_children += 1;
-        }
-    }
-}
-
 /* Pulled from gtksizerequest.c from Gtk+ */
 static gint
 compare_gap (gconstpointer p1,
              gconstpointer p2,
              gpointer      data)
 {
-  RequestedSize *sizes = data;
+  const BoxChildren *children = data;
   const guint *c1 = p1;
   const guint *c2 = p2;
 
-  const gint d1 = MAX (sizes[*c1].natural_size -
-                       sizes[*c1].minimum_size,
+  const gint d1 = MAX (children->natural[*c1] -
+                       children->sizes[*c1],
                        0);
-  const gint d2 = MAX (sizes[*c2].natural_size -
-                       sizes[*c2].minimum_size,
+  const gint d2 = MAX (children->natural[*c2] -
+                       children->sizes[*c2],
                        0);
 
   gint delta = (d2 - d1);
@@ -865,16 +921,15 @@ compare_gap (gconstpointer p1,
  * distribute_natural_allocation:
  * @extra_space: Extra space to redistribute among children after subtracting
  *   minimum sizes and any child padding from the overall allocation
- * @n_requested_sizes: Number of requests to fit into the allocation
- * @sizes: An array of structs with a client pointer and a minimum/natural size
+ * @children: the children, with their sizes set to their minimum size
  *   in the orientation of the allocation.
  *
- * Distributes @extra_space to child @sizes by bringing smaller
- * children up to natural size first.
+ * Distributes @extra_space to the sizes of @children by bringing
+ * smaller children up to natural size first.
  *
- * The remaining space will be added to the @minimum_size member of the
- * RequestedSize struct. If all sizes reach their natural size then
- * the remaining space is returned.
+ * The remaining space will be added to the @sizes array of @children.
+ * If all sizes reach their natural size then the remaining space is
+ * returned.
  *
  * Returns: The remainder of @extra_space after redistributing space
  * to @sizes.
@@ -882,16 +937,42 @@ compare_gap (gconstpointer p1,
  * Pulled from gtksizerequest.c from Gtk+
  */
 static gint
-distribute_natural_allocation (gint           extra_space,
-                               guint          n_requested_sizes,
-                               RequestedSize *sizes)
+distribute_natural_allocation (gint         extra_space,
+                               BoxChildren *children)
 {
-  guint *spreading;
+  guint  n_requested_sizes = children->n_children;
+  guint *spreading = children->spreading;
+  gfloat *sizes = children->sizes;
+  gint   total_gap = 0;
   gint   i;
 
   g_return_val_if_fail (extra_space >= 0, 0);
 
-  spreading = g_newa (guint, n_requested_sizes);
+  if (extra_space == 0)
+    return 0;
+
+  for (i = 0; i < n_requested_sizes; i++)
+    {
+      gint gap = children->natural[i] - sizes[i];
+
+      total_gap += MAX (gap, 0);
+    }
+
+  /* If there is enough space for every child to reach its natural
+   * size, the order in which the space is distributed does not
+   * matter, and we can avoid sorting the children.
+   */
+  if (total_gap <= extra_space)
+    {
+      for (i = 0; i < n_requested_sizes; i++)
+        {
+          gint gap = children->natural[i] - sizes[i];
+
+          sizes[i] += MAX (gap, 0);
+        }
+
+      return extra_space - total_gap;
+    }
 
   for (i = 0; i < n_requested_sizes; i++)
     spreading[i] = i;
@@ -916,7 +997,7 @@ distribute_natural_allocation (gint           extra_space,
   /* Sort descending by gap and position. */
   g_qsort_with_data (spreading,
                      n_requested_sizes, sizeof (guint),
-                     compare_gap, sizes);
+                     compare_gap, children);
 
   /* Distribute available space.
    * This master piece of a loop was conceived by Behdad Esfahbod.
@@ -928,12 +1009,12 @@ distribute_natural_allocation (gint           extra_space,
        * ensures that space is distributed equally.
        */
       gint glue = (extra_space + i) / (i + 1);
-      gint gap = sizes[(spreading[i])].natural_size
-               - sizes[(spreading[i])].minimum_size;
+      gint gap = children->natural[(spreading[i])]
+               - sizes[(spreading[i])];
 
       gint extra = MIN (glue, gap);
 
-      sizes[spreading[i]].minimum_size += extra;
+      sizes[spreading[i]] += extra;
 
       extra_space -= extra;
     }
@@ -949,15 +1030,14 @@ clutter_box_layout_allocate (ClutterLayoutManager   *layout,
                              const ClutterActorBox  *box,
                              ClutterAllocationFlags  flags)
 {
-  ClutterBoxLayoutPrivate *priv = CLUTTER_BOX_LAYOUT (layout)->priv;
-  ClutterActor *actor, *child;
+  ClutterBoxLayout *self = CLUTTER_BOX_LAYOUT (layout);
+  ClutterBoxLayoutPrivate *priv = self->priv;
+  BoxChildren *children;
   gint nvis_children;
   gint nexpand_children;
   gboolean is_rtl;
-  ClutterActorIter iter;
 
   ClutterActorBox child_allocation;
-  RequestedSize *sizes;
 
   gint size;
   gint extra;
@@ -965,7 +1045,11 @@ clutter_box_layout_allocate (ClutterLayoutManager   *layout,
   gint x = 0, y = 0, i;
   gfloat child_size;
 
-  count_expand_children (layout, container, &nvis_children, &nexpand_children);
+  children = box_children_acquire (self);
+  box_children_collect (self, children, CLUTTER_ACTOR (container));
+
+  nvis_children = children->n_children;
+  nexpand_children = children->n_expand;
 
   CLUTTER_NOTE (LAYOUT, "BoxLayout for %s: visible=%d, expand=%d",
                 _clutter_actor_get_debug_name (CLUTTER_ACTOR (container)),
@@ -974,45 +1058,32 @@ clutter_box_layout_allocate (ClutterLayoutManager   *layout,
 
   /* If there is no visible child, simply return. */
   if (nvis_children <= 0)
-    return;
-
-  sizes = g_newa (RequestedSize, nvis_children);
+    {
+      box_children_release (self, children);
+      return;
+    }
 
   if (priv->orientation == CLUTTER_ORIENTATION_VERTICAL)
     size = box->y2 - box->y1 - (nvis_children - 1) * priv->spacing;
   else
     size = box->x2 - box->x1 - (nvis_children - 1) * priv->spacing;
 
-  actor = CLUTTER_ACTOR (container);
-
   /* Retrieve desired size for visible children. */
-  i = 0;
-  clutter_actor_iter_init (&iter, actor);
-  while (clutter_actor_iter_next (&iter, &child))
-    {
-      if (!clutter_actor_is_visible (child))
-        continue;
-
-      if (priv->orientation == CLUTTER_ORIENTATION_VERTICAL)
-        clutter_actor_get_preferred_height (child,
-                                            box->x2 - box->x1,
-                                            &sizes[i].minimum_size,
-                                            &sizes[i].natural_size);
-      else
-        clutter_actor_get_preferred_width (child,
-                                           box->y2 - box->y1,
-                                           &sizes[i].minimum_size,
-                                           &sizes[i].natural_size);
-
+  box_children_measure (children, priv->orientation,
+                        priv->orientation == CLUTTER_ORIENTATION_VERTICAL
+                          ? box->x2 - box->x1
+                          : box->y2 - box->y1);
 
+  for (i = 0; i < nvis_children; i++)
+    {
       /* Assert the api is working properly */
-      if (sizes[i].minimum_size < 0)
+      if (children->minimum[i] < 0)
         g_error ("ClutterBoxLayout child %s minimum %s: %f < 0 for %s %f",
-                 _clutter_actor_get_debug_name (child),
+                 _clutter_actor_get_debug_name (children->actors[i]),
                  priv->orientation == CLUTTER_ORIENTATION_VERTICAL
                    ? "height"
                    : "width",
-                 sizes[i].minimum_size,
+                 children->minimum[i],
                  priv->orientation == CLUTTER_ORIENTATION_VERTICAL
                    ? "width"
                    : "height",
@@ -1020,14 +1091,14 @@ clutter_box_layout_allocate (ClutterLayoutManager   *layout,
                    ? box->x2 - box->x1
                    : box->y2 - box->y1);
 
-      if (sizes[i].natural_size < sizes[i].minimum_size)
+      if (children->natural[i] < children->minimum[i])
         g_error ("ClutterBoxLayout child %s natural %s: %f < minimum %f for %s %f",
-                 _clutter_actor_get_debug_name (child),
+                 _clutter_actor_get_debug_name (children->actors[i]),
                  priv->orientation == CLUTTER_ORIENTATION_VERTICAL
                    ? "height"
                    : "width",
-                 sizes[i].natural_size,
-                 sizes[i].minimum_size,
+                 children->natural[i],
+                 children->minimum[i],
                  priv->orientation == CLUTTER_ORIENTATION_VERTICAL
                    ? "width"
                    : "height",
@@ -1035,11 +1106,9 @@ clutter_box_layout_allocate (ClutterLayoutManager   *layout,
                    ? box->x2 - box->x1
                    : box->y2 - box->y1);
 
-      size -= sizes[i].minimum_size;
-
-      sizes[i].actor = child;
+      size -= children->minimum[i];
 
-      i += 1;
+      children->sizes[i] = children->minimum[i];
     }
 
   if (priv->is_homogeneous)
@@ -1058,7 +1127,7 @@ clutter_box_layout_allocate (ClutterLayoutManager   *layout,
   else
     {
       /* Bring children up to size first */
-      size = distribute_natural_allocation (MAX (0, size), nvis_children, sizes);
+      size = distribute_natural_allocation (MAX (0, size), children);
 
       /* Calculate space which hasn't distributed yet,
        * and is available for expanding children.
@@ -1102,21 +1171,9 @@ clutter_box_layout_allocate (ClutterLayoutManager   *layout,
         x = box->x1;
     }
 
-  i = 0;
-  clutter_actor_iter_init (&iter, actor);
-  while (clutter_actor_iter_next (&iter, &child))
+  for (i = 0; i < nvis_children; i++)
     {
-      ClutterLayoutMeta *meta;
-      ClutterBoxChild *box_child;
-
-      /* If widget is not visible, skip it. */
-      if (!clutter_actor_is_visible (child))
-        continue;
-
-      meta = clutter_layout_manager_get_child_meta (layout,
-                                                    container,
-                                                    child);
-      box_child = CLUTTER_BOX_CHILD (meta);
+      ClutterActor *child = children->actors[i];
 
       /* Assign the child's size. */
       if (priv->is_homogeneous)
@@ -1131,10 +1188,9 @@ clutter_box_layout_allocate (ClutterLayoutManager   *layout,
         }
       else
         {
-          child_size = sizes[i].minimum_size;
+          child_size = children->sizes[i];
 
-          if (clutter_actor_needs_expand (child, priv->orientation) ||
-              box_child->expand)
+          if (children->expand[i])
             {
               child_size += extra;
 
@@ -1149,16 +1205,15 @@ clutter_box_layout_allocate (ClutterLayoutManager   *layout,
       /* Assign the child's position. */
       if (priv->orientation == CLUTTER_ORIENTATION_VERTICAL)
         {
-          if (clutter_actor_needs_expand (child, priv->orientation) ||
-              box_child->expand)
+          if (children->expand[i])
             {
               child_allocation.y1 = y;
               child_allocation.y2 = child_allocation.y1 + MAX (1.0, child_size);
             }
           else
             {
-              child_allocation.y1 = y + (child_size - sizes[i].minimum_size) / 2;
-              child_allocation.y2 = child_allocation.y1 + sizes[i].minimum_size;
+              child_allocation.y1 = y + (child_size - children->sizes[i]) / 2;
+              child_allocation.y2 = child_allocation.y1 + children->sizes[i];
             }
 
           if (priv->is_pack_start)
@@ -1175,16 +1230,15 @@ clutter_box_layout_allocate (ClutterLayoutManager   *layout,
         }
       else /* CLUTTER_ORIENTATION_HORIZONTAL */
         {
-          if (clutter_actor_needs_expand (child, priv->orientation) ||
-              box_child->expand)
+          if (children->expand[i])
             {
               child_allocation.x1 = x;
               child_allocation.x2 = child_allocation.x1 + MAX (1.0, child_size);
             }
           else
             {
-              child_allocation.x1 = x + (child_size - sizes[i].minimum_size) / 2;
-              child_allocation.x2 = child_allocation.x1 + sizes[i].minimum_size;
+              child_allocation.x1 = x + (child_size - children->sizes[i]) / 2;
+              child_allocation.x2 = child_allocation.x1 + children->sizes[i];
             }
 
           if (priv->is_pack_start)
@@ -1209,14 +1263,14 @@ clutter_box_layout_allocate (ClutterLayoutManager   *layout,
 
         }
 
-        allocate_box_child (CLUTTER_BOX_LAYOUT (layout),
-                            container,
+        allocate_box_child (self,
                             child,
+                            children->metas[i],
                             &child_allocation,
                             flags);
-
-        i += 1;
     }
+
+  box_children_release (self, children);
 }
 
 static void
@@ -1316,6 +1370,16 @@ clutter_box_layout_get_property (GObject    *gobject,
     }
 }
 
+static void
+clutter_box_layout_finalize (GObject *gobject)
+{
+  ClutterBoxLayoutPrivate *priv = CLUTTER_BOX_LAYOUT (gobject)->priv;
+
+  box_children_clear (&priv->children);
+
+  G_OBJECT_CLASS (clutter_box_layout_parent_class)->finalize (gobject);
+}
+
 static void
 clutter_box_layout_class_init (ClutterBoxLayoutClass *klass)
 {
@@ -1479,6 +1543,7 @@ clutter_box_layout_class_init (ClutterBoxLayoutClass *klass)
 
   gobject_class->set_property = clutter_box_layout_set_property;
   gobject_class->get_property = clutter_box_layout_get_property;
+  gobject_class->finalize = clutter_box_layout_finalize;
   g_object_class_install_properties (gobject_class, PROP_LAST, obj_props);
 }
 
@@ -102,6 +102,7 @@
 #include "clutter-enum-types.h"
 #include "clutter-marshal.h"
 #include "clutter-private.h"
+#include "clutter-stage-private.h"
 
 struct _ClutterClickActionPrivate
 {
@@ -153,9 +154,9 @@ static guint click_signals[LAST_SIGNAL] = { 0, };
 G_DEFINE_TYPE_WITH_PRIVATE (ClutterClickAction, clutter_click_action, CLUTTER_TYPE_ACTION)
 
 /* forward declaration */
-static gboolean on_captured_event (ClutterActor       *stage,
-                                   ClutterEvent       *event,
-                                   ClutterClickAction *action);
+static gboolean on_captured_event (ClutterStage       *stage,
+                                   const ClutterEvent *event,
+                                   gpointer            user_data);
 
 static inline void
 click_action_set_pressed (ClutterClickAction *action,
@@ -206,7 +207,8 @@ click_action_emit_long_press (gpointer data)
 
   if (priv->capture_id != 0)
     {
-      g_signal_handler_disconnect (priv->stage, priv->capture_id);
+      _clutter_stage_remove_event_handler (CLUTTER_STAGE (priv->stage),
+                                           priv->capture_id);
       priv->capture_id = 0;
     }
 
@@ -318,9 +320,12 @@ on_event (ClutterActor       *actor,
       if (priv->stage == NULL)
         priv->stage = clutter_actor_get_stage (actor);
 
-      priv->capture_id = g_signal_connect_after (priv->stage, "captured-event",
-                                                 G_CALLBACK (on_captured_event),
-                                                 action);
+      /* all the events are stopped until the button is released */
+      priv->capture_id =
+        _clutter_stage_add_event_handler (CLUTTER_STAGE (priv->stage),
+                                          CLUTTER_STAGE_EVENT_MASK_ALL,
+                                          on_captured_event,
+                                          action);
 
       click_action_set_pressed (action, TRUE);
       click_action_set_held (action, TRUE);
@@ -344,10 +349,11 @@ on_event (ClutterActor       *actor,
 }
 
 static gboolean
-on_captured_event (ClutterActor       *stage,
-                   ClutterEvent       *event,
-                   ClutterClickAction *action)
+on_captured_event (ClutterStage       *stage,
+                   const ClutterEvent *event,
+                   gpointer            user_data)
 {
+  ClutterClickAction *action = user_data;
   ClutterClickActionPrivate *priv = action->priv;
   ClutterActor *actor;
   ClutterModifierType modifier_state;
@@ -375,7 +381,8 @@ on_captured_event (ClutterActor       *stage,
       /* disconnect the capture */
       if (priv->capture_id != 0)
         {
-          g_signal_handler_disconnect (priv->stage, priv->capture_id);
+          _clutter_stage_remove_event_handler (CLUTTER_STAGE (priv->stage),
+                                               priv->capture_id);
           priv->capture_id = 0;
         }
 
@@ -459,7 +466,8 @@ clutter_click_action_set_actor (ClutterActorMeta *meta,
   if (priv->capture_id != 0)
     {
       if (priv->stage != NULL)
-        g_signal_handler_disconnect (priv->stage, priv->capture_id);
+        _clutter_stage_remove_event_handler (CLUTTER_STAGE (priv->stage),
+                                             priv->capture_id);
 
       priv->capture_id = 0;
       priv->stage = NULL;
@@ -552,7 +560,8 @@ clutter_click_action_dispose (GObject *gobject)
 
   if (priv->capture_id)
     {
-      g_signal_handler_disconnect (priv->stage, priv->capture_id);
+      _clutter_stage_remove_event_handler (CLUTTER_STAGE (priv->stage),
+                                           priv->capture_id);
       priv->capture_id = 0;
     }
 
@@ -761,7 +770,8 @@ clutter_click_action_release (ClutterClickAction *action)
   /* disconnect the capture */
   if (priv->capture_id != 0)
     {
-      g_signal_handler_disconnect (priv->stage, priv->capture_id);
+      _clutter_stage_remove_event_handler (CLUTTER_STAGE (priv->stage),
+                                           priv->capture_id);
       priv->capture_id = 0;
     }
 
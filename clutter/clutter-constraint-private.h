@@ -26,6 +26,8 @@
 
 G_BEGIN_DECLS
 
+typedef ClutterActor * (* ClutterConstraintSourceFunc) (ClutterConstraint *constraint);
+
 gboolean clutter_constraint_update_allocation (ClutterConstraint *constraint,
                                                ClutterActor      *actor,
                                                ClutterActorBox   *allocation);
@@ -37,6 +39,10 @@ void clutter_constraint_update_preferred_size (ClutterConstraint  *constraint,
                                                float              *minimum_size,
                                                float              *natural_size);
 
+ClutterActor *clutter_constraint_get_source (ClutterConstraint *constraint);
+void clutter_constraint_class_set_source_func (ClutterConstraintClass      *klass,
+                                               ClutterConstraintSourceFunc  func);
+
 G_END_DECLS
 
 #endif /* __CLUTTER_CONSTRAINT_PRIVATE_H__ */
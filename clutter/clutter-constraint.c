@@ -136,14 +136,17 @@
 
 #include "clutter-constraint-private.h"
 
-#include "clutter-actor.h"
 #include "clutter-actor-meta-private.h"
+#include "clutter-actor-private.h"
 #include "clutter-private.h"
+#include "clutter-stage-private.h"
 
 G_DEFINE_ABSTRACT_TYPE (ClutterConstraint,
                         clutter_constraint,
                         CLUTTER_TYPE_ACTOR_META);
 
+static GQuark quark_constraint_source_func = 0;
+
 static void
 constraint_update_allocation (ClutterConstraint *constraint,
                               ClutterActor      *actor,
@@ -161,19 +164,52 @@ constraint_update_preferred_size (ClutterConstraint  *constraint,
 {
 }
 
+/* the dependencies between the constraints of the actors of the stage
+ * changed, so a cycle between them is reported again
+ */
+static void
+constraint_dependencies_changed (ClutterActor *actor)
+{
+  ClutterActor *stage;
+
+  if (actor == NULL)
+    return;
+
+  stage = _clutter_actor_get_stage_internal (actor);
+  if (stage != NULL)
+    _clutter_stage_constraints_changed (CLUTTER_STAGE (stage));
+}
+
+static void
+clutter_constraint_set_actor (ClutterActorMeta *meta,
+                              ClutterActor     *new_actor)
+{
+  constraint_dependencies_changed (clutter_actor_meta_get_actor (meta));
+  constraint_dependencies_changed (new_actor);
+
+  CLUTTER_ACTOR_META_CLASS (clutter_constraint_parent_class)->set_actor (meta, new_actor);
+}
+
 static void
 clutter_constraint_notify (GObject    *gobject,
                            GParamSpec *pspec)
 {
+  ClutterActorMeta *meta = CLUTTER_ACTOR_META (gobject);
+  ClutterActor *actor = clutter_actor_meta_get_actor (meta);
+
   if (strcmp (pspec->name, "enabled") == 0)
     {
-      ClutterActorMeta *meta = CLUTTER_ACTOR_META (gobject);
-      ClutterActor *actor = clutter_actor_meta_get_actor (meta);
-
       if (actor != NULL)
         clutter_actor_queue_relayout (actor);
     }
 
+  /* the constraints provided by Clutter notify the change of their
+   * source through their :source property
+   */
+  if (strcmp (pspec->name, "enabled") == 0 ||
+      strcmp (pspec->name, "source") == 0)
+    constraint_dependencies_changed (actor);
+
   if (G_OBJECT_CLASS (clutter_constraint_parent_class)->notify != NULL)
     G_OBJECT_CLASS (clutter_constraint_parent_class)->notify (gobject, pspec);
 }
@@ -182,11 +218,17 @@ static void
 clutter_constraint_class_init (ClutterConstraintClass *klass)
 {
   GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  ClutterActorMetaClass *meta_class = CLUTTER_ACTOR_META_CLASS (klass);
 
   gobject_class->notify = clutter_constraint_notify;
 
+  meta_class->set_actor = clutter_constraint_set_actor;
+
   klass->update_allocation = constraint_update_allocation;
   klass->update_preferred_size = constraint_update_preferred_size;
+
+  quark_constraint_source_func =
+    g_quark_from_static_string ("-clutter-constraint-source-func");
 }
 
 static void
@@ -241,3 +283,59 @@ clutter_constraint_update_preferred_size (ClutterConstraint  *constraint,
                                                                     minimum_size,
                                                                     natural_size);
 }
+
+/*< private >
+ * clutter_constraint_get_source:
+ * @constraint: a #ClutterConstraint
+ *
+ * Retrieves the actor that the allocation computed by @constraint
+ * depends on.
+ *
+ * Return value: (transfer none): the source of @constraint, or %NULL
+ */
+ClutterActor *
+clutter_constraint_get_source (ClutterConstraint *constraint)
+{
+  GType gtype;
+
+  g_return_val_if_fail (CLUTTER_IS_CONSTRAINT (constraint), NULL);
+
+  /* the function is looked up on the type of @constraint, then on its
+   * ancestors, so sub-classes of the constraints provided by Clutter
+   * inherit it
+   */
+  for (gtype = G_OBJECT_TYPE (constraint);
+       gtype != CLUTTER_TYPE_CONSTRAINT;
+       gtype = g_type_parent (gtype))
+    {
+      ClutterConstraintSourceFunc func;
+
+      func = g_type_get_qdata (gtype, quark_constraint_source_func);
+      if (func != NULL)
+        return func (constraint);
+    }
+
+  return NULL;
+}
+
+/*< private >
+ * clutter_constraint_class_set_source_func:
+ * @klass: a #ClutterConstraintClass
+ * @func: the function returning the source of a constraint
+ *
+ * Sets the function used by clutter_constraint_get_source() for the
+ * instances of the class of @klass and of its sub-classes.
+ *
+ * The function is stored on the type instead of the class structure,
+ * so that the padding of #ClutterConstraintClass is left untouched.
+ */
+void
+clutter_constraint_class_set_source_func (ClutterConstraintClass      *klass,
+                                          ClutterConstraintSourceFunc  func)
+{
+  g_return_if_fail (CLUTTER_IS_CONSTRAINT_CLASS (klass));
+
+  g_type_set_qdata (G_TYPE_FROM_CLASS (klass),
+                    quark_constraint_source_func,
+                    func);
+}
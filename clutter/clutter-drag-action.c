@@ -89,7 +89,7 @@ struct _ClutterDragActionPrivate
   ClutterEventSequence *sequence;
   gulong button_press_id;
   gulong touch_begin_id;
-  gulong capture_id;
+  guint capture_id;
 
   gfloat press_x;
   gfloat press_y;
@@ -173,9 +173,9 @@ get_drag_threshold (ClutterDragAction *action,
 }
 
 static void
-emit_drag_begin (ClutterDragAction *action,
-                 ClutterActor      *actor,
-                 ClutterEvent      *event)
+emit_drag_begin (ClutterDragAction  *action,
+                 ClutterActor       *actor,
+                 const ClutterEvent *event)
 {
   ClutterDragActionPrivate *priv = action->priv;
 
@@ -203,9 +203,9 @@ emit_drag_begin (ClutterDragAction *action,
 }
 
 static void
-emit_drag_motion (ClutterDragAction *action,
-                  ClutterActor      *actor,
-                  ClutterEvent      *event)
+emit_drag_motion (ClutterDragAction  *action,
+                  ClutterActor       *actor,
+                  const ClutterEvent *event)
 {
   ClutterDragActionPrivate *priv = action->priv;
   ClutterActor *drag_handle = NULL;
@@ -281,9 +281,9 @@ emit_drag_motion (ClutterDragAction *action,
 }
 
 static void
-emit_drag_end (ClutterDragAction *action,
-               ClutterActor      *actor,
-               ClutterEvent      *event)
+emit_drag_end (ClutterDragAction  *action,
+               ClutterActor       *actor,
+               const ClutterEvent *event)
 {
   ClutterDragActionPrivate *priv = action->priv;
 
@@ -319,7 +319,7 @@ emit_drag_end (ClutterDragAction *action,
   /* disconnect the capture */
   if (priv->capture_id != 0)
     {
-      g_signal_handler_disconnect (priv->stage, priv->capture_id);
+      _clutter_stage_remove_event_handler (priv->stage, priv->capture_id);
       priv->capture_id = 0;
     }
 
@@ -343,11 +343,21 @@ out:
   g_object_unref (action);
 }
 
+/* the events tracked on the stage during a drag */
+#define DRAG_EVENT_MASK         (CLUTTER_STAGE_EVENT_MASK (CLUTTER_MOTION) | \
+                                 CLUTTER_STAGE_EVENT_MASK (CLUTTER_BUTTON_RELEASE) | \
+                                 CLUTTER_STAGE_EVENT_MASK (CLUTTER_ENTER) | \
+                                 CLUTTER_STAGE_EVENT_MASK (CLUTTER_LEAVE) | \
+                                 CLUTTER_STAGE_EVENT_MASK (CLUTTER_TOUCH_UPDATE) | \
+                                 CLUTTER_STAGE_EVENT_MASK (CLUTTER_TOUCH_END) | \
+                                 CLUTTER_STAGE_EVENT_MASK (CLUTTER_TOUCH_CANCEL))
+
 static gboolean
-on_captured_event (ClutterActor      *stage,
-                   ClutterEvent      *event,
-                   ClutterDragAction *action)
+on_captured_event (ClutterStage       *stage,
+                   const ClutterEvent *event,
+                   gpointer            user_data)
 {
+  ClutterDragAction *action = user_data;
   ClutterDragActionPrivate *priv = action->priv;
   ClutterActor *actor;
 
@@ -460,9 +470,10 @@ on_drag_begin (ClutterActor      *actor,
     priv->emit_delayed_press = TRUE;
 
   priv->in_drag = TRUE;
-  priv->capture_id = g_signal_connect_after (priv->stage, "captured-event",
-                                             G_CALLBACK (on_captured_event),
-                                             action);
+  priv->capture_id = _clutter_stage_add_event_handler (priv->stage,
+                                                       DRAG_EVENT_MASK,
+                                                       on_captured_event,
+                                                       action);
 
   return CLUTTER_EVENT_PROPAGATE;
 }
@@ -491,7 +502,7 @@ clutter_drag_action_set_actor (ClutterActorMeta *meta,
   if (priv->capture_id != 0)
     {
       if (priv->stage != NULL)
-        g_signal_handler_disconnect (priv->stage, priv->capture_id);
+        _clutter_stage_remove_event_handler (priv->stage, priv->capture_id);
 
       priv->capture_id = 0;
       priv->stage = NULL;
@@ -670,7 +681,7 @@ clutter_drag_action_dispose (GObject *gobject)
                                                priv->motion_events_enabled);
 
       if (priv->stage != NULL)
-        g_signal_handler_disconnect (priv->stage, priv->capture_id);
+        _clutter_stage_remove_event_handler (priv->stage, priv->capture_id);
 
       priv->capture_id = 0;
       priv->stage = NULL;
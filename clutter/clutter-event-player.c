@@ -0,0 +1,604 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:clutter-event-player
+ * @Title: ClutterEventPlayer
+ * @Short_Description: Replays recorded input events
+ * @See_Also: #ClutterEventRecorder
+ *
+ * #ClutterEventPlayer loads a file written by #ClutterEventRecorder
+ * and injects its events on a #ClutterStage through clutter_event_put(),
+ * either with the timing of the recording, scaled by a speed factor, or
+ * one event per frame as soon as the previous one was processed.
+ *
+ * While replaying, the player measures for each event:
+ *
+ *  - the processing time, that is the time spent by the stage
+ *    delivering the event to the scene graph;
+ *  - the latency, that is the time elapsed between the injection
+ *    of the event and the end of the first paint of the stage
+ *    following its processing.
+ *
+ * Events merged into a later one by the motion event compression of
+ * the stage have no processing time, but their latency is measured
+ * against the paint that follows the event they were merged into.
+ *
+ * Since the devices of the recording are resolved by id, falling back
+ * to the core devices, a recording can be replayed on any backend,
+ * including the headless one.
+ *
+ * #ClutterEventPlayer is available since Clutter 1.28
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "clutter-event-player.h"
+#include "clutter-event-recorder-private.h"
+
+#include "clutter-debug.h"
+#include "clutter-event-private.h"
+#include "clutter-main.h"
+#include "clutter-marshal.h"
+#include "clutter-private.h"
+#include "clutter-stage.h"
+
+typedef struct _ClutterEventTiming
+{
+  gint64 inject_time;
+  gint64 processing_time;
+  gint64 latency;
+} ClutterEventTiming;
+
+struct _ClutterEventPlayerPrivate
+{
+  /* the loaded ClutterEventRecord */
+  GArray *records;
+
+  /* a ClutterEventTiming for each record */
+  GArray *timings;
+
+  ClutterStage *stage;
+  gdouble speed;
+  gint64 start_time;
+
+  GSource *source;
+  gulong after_paint_id;
+  guint repaint_id;
+
+  /* the index of the next event to inject */
+  guint next_event;
+
+  /* the index of the first event without a latency */
+  guint first_pending;
+
+  /* the serial of the last processed event; the serial of an
+   * event is its index plus one
+   */
+  guint last_processed;
+};
+
+enum
+{
+  FINISHED,
+
+  LAST_SIGNAL
+};
+
+static guint player_signals[LAST_SIGNAL] = { 0, };
+
+G_DEFINE_TYPE_WITH_PRIVATE (ClutterEventPlayer,
+                            clutter_event_player,
+                            G_TYPE_OBJECT)
+
+static gboolean
+player_source_dispatch (GSource     *source,
+                        GSourceFunc  callback,
+                        gpointer     user_data)
+{
+  return callback (user_data);
+}
+
+static GSourceFuncs player_source_funcs = {
+  NULL,
+  NULL,
+  player_source_dispatch,
+  NULL
+};
+
+static gboolean
+clutter_event_player_inject (gpointer data)
+{
+  ClutterEventPlayer *player = data;
+  ClutterEventPlayerPrivate *priv = player->priv;
+  gint64 now, ready_time = -1;
+
+  _clutter_threads_acquire_lock ();
+
+  now = g_get_monotonic_time ();
+
+  while (priv->next_event < priv->records->len)
+    {
+      const ClutterEventRecord *record;
+      ClutterEventTiming *timing;
+      ClutterEvent *event;
+
+      record = &g_array_index (priv->records, ClutterEventRecord, priv->next_event);
+
+      if (priv->speed > 0)
+        {
+          gint64 due_time = priv->start_time + record->queue_time / priv->speed;
+
+          if (due_time > now)
+            {
+              ready_time = due_time;
+              break;
+            }
+        }
+
+      event = _clutter_event_record_to_event (record, priv->stage);
+      _clutter_event_set_replay_serial (event, priv->next_event + 1);
+
+      timing = &g_array_index (priv->timings, ClutterEventTiming, priv->next_event);
+      timing->inject_time = now;
+
+      clutter_event_put (event);
+      clutter_event_free (event);
+
+      priv->next_event += 1;
+
+      /* without timing, wait for the event to be processed before
+       * injecting the next one
+       */
+      if (priv->speed <= 0)
+        break;
+    }
+
+  g_source_set_ready_time (priv->source, ready_time);
+
+  _clutter_threads_release_lock ();
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+clutter_event_player_after_paint (ClutterStage       *stage,
+                                  ClutterEventPlayer *player)
+{
+  ClutterEventPlayerPrivate *priv = player->priv;
+  gint64 now = g_get_monotonic_time ();
+
+  /* every event up to the last processed one has been presented,
+   * including the ones compressed into a later event
+   */
+  while (priv->first_pending < priv->last_processed)
+    {
+      ClutterEventTiming *timing;
+
+      timing = &g_array_index (priv->timings, ClutterEventTiming, priv->first_pending);
+      if (timing->latency < 0)
+        timing->latency = now - timing->inject_time;
+
+      priv->first_pending += 1;
+    }
+}
+
+static gboolean
+clutter_event_player_check_finished (gpointer data)
+{
+  ClutterEventPlayer *player = data;
+  ClutterEventPlayerPrivate *priv = player->priv;
+
+  if (priv->last_processed < priv->records->len)
+    return TRUE;
+
+  CLUTTER_NOTE (EVENT, "Replayed %u events", priv->records->len);
+
+  /* the repaint function is removed by returning FALSE */
+  priv->repaint_id = 0;
+
+  g_object_ref (player);
+  clutter_event_player_stop (player);
+  g_signal_emit (player, player_signals[FINISHED], 0);
+  g_object_unref (player);
+
+  return FALSE;
+}
+
+void
+_clutter_event_player_event_processed (const ClutterEvent *event,
+                                       gint64              processing_time)
+{
+  ClutterMainContext *context = _clutter_context_get_default ();
+  ClutterEventPlayerPrivate *priv;
+  ClutterEventTiming *timing;
+  guint serial;
+
+  if (context->event_player == NULL)
+    return;
+
+  priv = context->event_player->priv;
+
+  serial = _clutter_event_get_replay_serial (event);
+  if (serial == 0 || serial > priv->next_event)
+    return;
+
+  timing = &g_array_index (priv->timings, ClutterEventTiming, serial - 1);
+  timing->processing_time = processing_time;
+
+  priv->last_processed = MAX (priv->last_processed, serial);
+
+  if (priv->speed <= 0 && serial == priv->next_event)
+    g_source_set_ready_time (priv->source, 0);
+}
+
+static void
+clutter_event_player_finalize (GObject *gobject)
+{
+  ClutterEventPlayer *player = CLUTTER_EVENT_PLAYER (gobject);
+  ClutterEventPlayerPrivate *priv = player->priv;
+
+  clutter_event_player_stop (player);
+
+  g_array_unref (priv->records);
+  g_array_unref (priv->timings);
+
+  G_OBJECT_CLASS (clutter_event_player_parent_class)->finalize (gobject);
+}
+
+static void
+clutter_event_player_class_init (ClutterEventPlayerClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->finalize = clutter_event_player_finalize;
+
+  /**
+   * ClutterEventPlayer::finished:
+   * @player: the #ClutterEventPlayer that emitted the signal
+   *
+   * The ::finished signal is emitted once every event of the
+   * recording has been injected and processed, at the end of
+   * the frame that processed the last one.
+   *
+   * The timings of the events are available when the signal
+   * is emitted.
+   *
+   * Since: 1.28
+   */
+  player_signals[FINISHED] =
+    g_signal_new (I_("finished"),
+                  G_TYPE_FROM_CLASS (klass),
+                  G_SIGNAL_RUN_LAST,
+                  G_STRUCT_OFFSET (ClutterEventPlayerClass, finished),
+                  NULL, NULL,
+                  _clutter_marshal_VOID__VOID,
+                  G_TYPE_NONE, 0);
+}
+
+static void
+clutter_event_player_init (ClutterEventPlayer *self)
+{
+  self->priv = clutter_event_player_get_instance_private (self);
+
+  self->priv->records = g_array_new (FALSE, FALSE, sizeof (ClutterEventRecord));
+  self->priv->timings = g_array_new (FALSE, FALSE, sizeof (ClutterEventTiming));
+}
+
+/**
+ * clutter_event_player_new:
+ *
+ * Creates a new #ClutterEventPlayer.
+ *
+ * Return value: (transfer full): the newly created #ClutterEventPlayer;
+ *   use g_object_unref() when done
+ *
+ * Since: 1.28
+ */
+ClutterEventPlayer *
+clutter_event_player_new (void)
+{
+  return g_object_new (CLUTTER_TYPE_EVENT_PLAYER, NULL);
+}
+
+/**
+ * clutter_event_player_load:
+ * @player: a #ClutterEventPlayer
+ * @filename: (type filename): the path of a file written by
+ *   a #ClutterEventRecorder
+ * @error: return location for a #GError, or %NULL
+ *
+ * Loads the events recorded in @filename, replacing the events
+ * previously loaded and their timings.
+ *
+ * Return value: %TRUE if the recording was loaded, and %FALSE
+ *   otherwise, in which case @error is set
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_event_player_load (ClutterEventPlayer  *player,
+                           const gchar         *filename,
+                           GError             **error)
+{
+  ClutterEventPlayerPrivate *priv;
+  GFileInputStream *file_stream;
+  GDataInputStream *stream;
+  ClutterEventRecord record;
+  GError *internal_error = NULL;
+  GFile *file;
+
+  g_return_val_if_fail (CLUTTER_IS_EVENT_PLAYER (player), FALSE);
+  g_return_val_if_fail (filename != NULL, FALSE);
+
+  priv = player->priv;
+
+  g_return_val_if_fail (priv->stage == NULL, FALSE);
+
+  file = g_file_new_for_path (filename);
+  file_stream = g_file_read (file, NULL, error);
+  g_object_unref (file);
+
+  if (file_stream == NULL)
+    return FALSE;
+
+  stream = g_data_input_stream_new (G_INPUT_STREAM (file_stream));
+  g_object_unref (file_stream);
+
+  g_array_set_size (priv->records, 0);
+  g_array_set_size (priv->timings, 0);
+
+  if (!_clutter_event_record_read_header (stream, error))
+    {
+      g_object_unref (stream);
+      return FALSE;
+    }
+
+  while (_clutter_event_record_read (stream, &record, &internal_error))
+    g_array_append_val (priv->records, record);
+
+  g_object_unref (stream);
+
+  if (internal_error != NULL)
+    {
+      g_propagate_error (error, internal_error);
+      g_array_set_size (priv->records, 0);
+      return FALSE;
+    }
+
+  CLUTTER_NOTE (EVENT, "Loaded %u events from '%s'",
+                priv->records->len,
+                filename);
+
+  return TRUE;
+}
+
+/**
+ * clutter_event_player_get_n_events:
+ * @player: a #ClutterEventPlayer
+ *
+ * Retrieves the number of events loaded by clutter_event_player_load().
+ *
+ * Return value: the number of events
+ *
+ * Since: 1.28
+ */
+guint
+clutter_event_player_get_n_events (ClutterEventPlayer *player)
+{
+  g_return_val_if_fail (CLUTTER_IS_EVENT_PLAYER (player), 0);
+
+  return player->priv->records->len;
+}
+
+/**
+ * clutter_event_player_play:
+ * @player: a #ClutterEventPlayer
+ * @stage: the #ClutterStage receiving the events
+ * @speed: the speed factor applied to the timing of the recording,
+ *   or 0 to inject each event as soon as the previous one was processed
+ *
+ * Starts replaying the loaded events on @stage, discarding the
+ * timings of any previous replay.
+ *
+ * With a @speed of 1.0 the events are injected with the timing of
+ * the recording; larger values accelerate the replay. With a @speed
+ * of 0 a single event is in flight at any given time, which makes the
+ * processing time and latency of each event independent of the motion
+ * event compression of the stage.
+ *
+ * The #ClutterEventPlayer::finished signal is emitted at the end of
+ * the replay.
+ *
+ * Only a single #ClutterEventPlayer can replay events at any given time.
+ *
+ * Since: 1.28
+ */
+void
+clutter_event_player_play (ClutterEventPlayer *player,
+                           ClutterStage       *stage,
+                           gdouble             speed)
+{
+  ClutterMainContext *context = _clutter_context_get_default ();
+  ClutterEventPlayerPrivate *priv;
+  guint i;
+
+  g_return_if_fail (CLUTTER_IS_EVENT_PLAYER (player));
+  g_return_if_fail (CLUTTER_IS_STAGE (stage));
+  g_return_if_fail (speed >= 0);
+
+  priv = player->priv;
+
+  if (context->event_player != NULL && context->event_player != player)
+    {
+      g_warning ("Another ClutterEventPlayer is already replaying events");
+      return;
+    }
+
+  clutter_event_player_stop (player);
+
+  g_array_set_size (priv->timings, priv->records->len);
+  for (i = 0; i < priv->timings->len; i++)
+    {
+      ClutterEventTiming *timing;
+
+      timing = &g_array_index (priv->timings, ClutterEventTiming, i);
+      timing->inject_time = -1;
+      timing->processing_time = -1;
+      timing->latency = -1;
+    }
+
+  priv->stage = g_object_ref (stage);
+  priv->speed = speed;
+  priv->next_event = 0;
+  priv->first_pending = 0;
+  priv->last_processed = 0;
+  priv->start_time = g_get_monotonic_time ();
+
+  context->event_player = player;
+
+  priv->after_paint_id =
+    g_signal_connect (stage, "after-paint",
+                      G_CALLBACK (clutter_event_player_after_paint),
+                      player);
+
+  priv->repaint_id =
+    clutter_threads_add_repaint_func_full (CLUTTER_REPAINT_FLAGS_POST_PAINT,
+                                           clutter_event_player_check_finished,
+                                           player,
+                                           NULL);
+
+  priv->source = g_source_new (&player_source_funcs, sizeof (GSource));
+  g_source_set_name (priv->source, "Clutter event player");
+  g_source_set_priority (priv->source, CLUTTER_PRIORITY_EVENTS);
+  g_source_set_callback (priv->source,
+                         clutter_event_player_inject,
+                         player,
+                         NULL);
+  g_source_set_ready_time (priv->source, 0);
+  g_source_attach (priv->source, NULL);
+
+  /* an empty recording still needs a frame to finish */
+  clutter_stage_ensure_redraw (stage);
+}
+
+/**
+ * clutter_event_player_stop:
+ * @player: a #ClutterEventPlayer
+ *
+ * Stops replaying events. The events already injected are still
+ * delivered, but their timings are not updated any more.
+ *
+ * Since: 1.28
+ */
+void
+clutter_event_player_stop (ClutterEventPlayer *player)
+{
+  ClutterMainContext *context = _clutter_context_get_default ();
+  ClutterEventPlayerPrivate *priv;
+
+  g_return_if_fail (CLUTTER_IS_EVENT_PLAYER (player));
+
+  priv = player->priv;
+
+  if (priv->stage == NULL)
+    return;
+
+  if (context->event_player == player)
+    context->event_player = NULL;
+
+  if (priv->source != NULL)
+    {
+      g_source_destroy (priv->source);
+      g_source_unref (priv->source);
+      priv->source = NULL;
+    }
+
+  if (priv->repaint_id != 0)
+    {
+      clutter_threads_remove_repaint_func (priv->repaint_id);
+      priv->repaint_id = 0;
+    }
+
+  g_signal_handler_disconnect (priv->stage, priv->after_paint_id);
+  priv->after_paint_id = 0;
+
+  g_clear_object (&priv->stage);
+}
+
+/**
+ * clutter_event_player_is_playing:
+ * @player: a #ClutterEventPlayer
+ *
+ * Checks whether @player is replaying events.
+ *
+ * Return value: %TRUE if the replay is in progress
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_event_player_is_playing (ClutterEventPlayer *player)
+{
+  g_return_val_if_fail (CLUTTER_IS_EVENT_PLAYER (player), FALSE);
+
+  return player->priv->stage != NULL;
+}
+
+/**
+ * clutter_event_player_get_timings:
+ * @player: a #ClutterEventPlayer
+ * @index_: the index of an event of the recording
+ * @processing_time: (out) (optional): return location for the time
+ *   spent processing the event, in microseconds, or -1 if the event
+ *   was not processed
+ * @latency: (out) (optional): return location for the time elapsed
+ *   between the injection of the event and the end of the following
+ *   paint, in microseconds, or -1 if the event was not presented
+ *
+ * Retrieves the timings of an event measured by the last replay.
+ *
+ * Return value: %TRUE if @index_ is a valid event index
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_event_player_get_timings (ClutterEventPlayer *player,
+                                  guint               index_,
+                                  gint64             *processing_time,
+                                  gint64             *latency)
+{
+  const ClutterEventTiming *timing;
+
+  g_return_val_if_fail (CLUTTER_IS_EVENT_PLAYER (player), FALSE);
+
+  if (index_ >= player->priv->timings->len)
+    return FALSE;
+
+  timing = &g_array_index (player->priv->timings, ClutterEventTiming, index_);
+
+  if (processing_time != NULL)
+    *processing_time = timing->processing_time;
+
+  if (latency != NULL)
+    *latency = timing->latency;
+
+  return TRUE;
+}
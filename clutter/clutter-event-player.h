@@ -0,0 +1,110 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CLUTTER_EVENT_PLAYER_H__
+#define __CLUTTER_EVENT_PLAYER_H__
+
+#if !defined(__CLUTTER_H_INSIDE__) && !defined(CLUTTER_COMPILATION)
+#error "Only <clutter/clutter.h> can be included directly."
+#endif
+
+#include <clutter/clutter-types.h>
+
+G_BEGIN_DECLS
+
+#define CLUTTER_TYPE_EVENT_PLAYER             (clutter_event_player_get_type ())
+#define CLUTTER_EVENT_PLAYER(obj)             (G_TYPE_CHECK_INSTANCE_CAST ((obj), CLUTTER_TYPE_EVENT_PLAYER, ClutterEventPlayer))
+#define CLUTTER_IS_EVENT_PLAYER(obj)          (G_TYPE_CHECK_INSTANCE_TYPE ((obj), CLUTTER_TYPE_EVENT_PLAYER))
+#define CLUTTER_EVENT_PLAYER_CLASS(klass)     (G_TYPE_CHECK_CLASS_CAST ((klass), CLUTTER_TYPE_EVENT_PLAYER, ClutterEventPlayerClass))
+#define CLUTTER_IS_EVENT_PLAYER_CLASS(klass)  (G_TYPE_CHECK_CLASS_TYPE ((klass), CLUTTER_TYPE_EVENT_PLAYER))
+#define CLUTTER_EVENT_PLAYER_GET_CLASS(obj)   (G_TYPE_INSTANCE_GET_CLASS ((obj), CLUTTER_TYPE_EVENT_PLAYER, ClutterEventPlayerClass))
+
+typedef struct _ClutterEventPlayer            ClutterEventPlayer;
+typedef struct _ClutterEventPlayerPrivate     ClutterEventPlayerPrivate;
+typedef struct _ClutterEventPlayerClass       ClutterEventPlayerClass;
+
+/**
+ * ClutterEventPlayer:
+ *
+ * The #ClutterEventPlayer structure contains only private
+ * data and should be accessed using the provided API.
+ *
+ * Since: 1.28
+ */
+struct _ClutterEventPlayer
+{
+  /*< private >*/
+  GObject parent_instance;
+
+  ClutterEventPlayerPrivate *priv;
+};
+
+/**
+ * ClutterEventPlayerClass:
+ * @finished: class handler for the #ClutterEventPlayer::finished signal
+ *
+ * The #ClutterEventPlayerClass structure contains only
+ * private data.
+ *
+ * Since: 1.28
+ */
+struct _ClutterEventPlayerClass
+{
+  /*< private >*/
+  GObjectClass parent_class;
+
+  /*< public >*/
+  void (* finished) (ClutterEventPlayer *player);
+
+  /*< private >*/
+  /* padding for future expansion */
+  gpointer _padding[4];
+};
+
+CLUTTER_AVAILABLE_IN_1_28
+GType clutter_event_player_get_type (void) G_GNUC_CONST;
+
+CLUTTER_AVAILABLE_IN_1_28
+ClutterEventPlayer *    clutter_event_player_new                (void);
+
+CLUTTER_AVAILABLE_IN_1_28
+gboolean                clutter_event_player_load               (ClutterEventPlayer  *player,
+                                                                 const gchar         *filename,
+                                                                 GError             **error);
+CLUTTER_AVAILABLE_IN_1_28
+guint                   clutter_event_player_get_n_events       (ClutterEventPlayer  *player);
+
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_event_player_play               (ClutterEventPlayer  *player,
+                                                                 ClutterStage        *stage,
+                                                                 gdouble              speed);
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_event_player_stop               (ClutterEventPlayer  *player);
+CLUTTER_AVAILABLE_IN_1_28
+gboolean                clutter_event_player_is_playing         (ClutterEventPlayer  *player);
+
+CLUTTER_AVAILABLE_IN_1_28
+gboolean                clutter_event_player_get_timings        (ClutterEventPlayer  *player,
+                                                                 guint                index_,
+                                                                 gint64              *processing_time,
+                                                                 gint64              *latency);
+
+G_END_DECLS
+
+#endif /* __CLUTTER_EVENT_PLAYER_H__ */
@@ -21,6 +21,10 @@ void            _clutter_event_set_platform_data        (ClutterEvent       *eve
                                                          gpointer            data);
 gpointer        _clutter_event_get_platform_data        (const ClutterEvent *event);
 
+void            _clutter_event_set_replay_serial        (ClutterEvent       *event,
+                                                         guint               serial);
+guint           _clutter_event_get_replay_serial        (const ClutterEvent *event);
+
 void            _clutter_event_set_state_full           (ClutterEvent        *event,
 							 ClutterModifierType  button_state,
 							 ClutterModifierType  base_state,
@@ -31,6 +35,9 @@ void            _clutter_event_set_state_full           (ClutterEvent        *ev
 void            _clutter_event_push                     (const ClutterEvent *event,
                                                          gboolean            do_copy);
 
+void            _clutter_event_coalesce                 (ClutterEvent       *event,
+                                                         ClutterEvent       *previous);
+
 G_END_DECLS
 
 #endif /* __CLUTTER_EVENT_PRIVATE_H__ */
@@ -0,0 +1,93 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CLUTTER_EVENT_RECORDER_PRIVATE_H__
+#define __CLUTTER_EVENT_RECORDER_PRIVATE_H__
+
+#include <gio/gio.h>
+#include <clutter/clutter-event.h>
+
+G_BEGIN_DECLS
+
+/* "CLER", followed by the version of the format */
+#define CLUTTER_EVENT_RECORD_MAGIC      0x434c4552
+#define CLUTTER_EVENT_RECORD_VERSION    1
+
+/*
+ * ClutterEventRecord:
+ * @queue_time: the time at which the event was queued on the stage,
+ *   in microseconds since the beginning of the recording
+ * @details: the integer fields specific to the event type: the button
+ *   and click count; the key symbol, hardware keycode and Unicode
+ *   value; the scroll direction; the phase and number of fingers of
+ *   touchpad gestures
+ * @values: the floating point fields specific to the event type: the
+ *   scroll deltas; the deltas, angle delta and scale of touchpad
+ *   gestures
+ *
+ * The serialised form of a #ClutterEvent. Devices and touch sequences
+ * are stored by id, and resolved again when the record is replayed.
+ */
+typedef struct _ClutterEventRecord
+{
+  gint64 queue_time;
+
+  guint32 type;
+  guint32 time;
+  guint32 flags;
+  guint32 state;
+
+  gint32 device_id;
+  gint32 source_device_id;
+  guint32 sequence;
+
+  gfloat x;
+  gfloat y;
+
+  guint32 details[3];
+  gdouble values[4];
+} ClutterEventRecord;
+
+gboolean        _clutter_event_record_write_header      (GDataOutputStream        *stream,
+                                                         GError                  **error);
+gboolean        _clutter_event_record_read_header       (GDataInputStream         *stream,
+                                                         GError                  **error);
+gboolean        _clutter_event_record_write             (GDataOutputStream        *stream,
+                                                         const ClutterEventRecord *record,
+                                                         GError                  **error);
+gboolean        _clutter_event_record_read              (GDataInputStream         *stream,
+                                                         ClutterEventRecord       *record,
+                                                         GError                  **error);
+
+gboolean        _clutter_event_record_from_event        (ClutterEventRecord       *record,
+                                                         const ClutterEvent       *event);
+ClutterEvent *  _clutter_event_record_to_event          (const ClutterEventRecord *record,
+                                                         ClutterStage             *stage);
+
+/* called by the stage for every event queued, while recording */
+void            _clutter_event_recorders_queue_event    (ClutterStage             *stage,
+                                                         const ClutterEvent       *event);
+
+/* called by the stage for every replayed event, once processed */
+void            _clutter_event_player_event_processed   (const ClutterEvent       *event,
+                                                         gint64                    processing_time);
+
+G_END_DECLS
+
+#endif /* __CLUTTER_EVENT_RECORDER_PRIVATE_H__ */
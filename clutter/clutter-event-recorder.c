@@ -0,0 +1,683 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:clutter-event-recorder
+ * @Title: ClutterEventRecorder
+ * @Short_Description: Records input events to a file
+ * @See_Also: #ClutterEventPlayer
+ *
+ * #ClutterEventRecorder serialises every input event queued on a
+ * #ClutterStage, for instance by a backend or by clutter_event_put(),
+ * into a compact binary file. Each record contains the type, time,
+ * flags and modifiers of the event, the ids of its devices, its touch
+ * sequence and coordinates, the fields specific to its type, and the
+ * time at which it was queued.
+ *
+ * The resulting file can be replayed using #ClutterEventPlayer, to
+ * measure the processing time and the input-to-paint latency of a
+ * real input session in a reproducible way.
+ *
+ * |[<!-- language="C" -->
+ *   ClutterEventRecorder *recorder = clutter_event_recorder_new ();
+ *
+ *   if (!clutter_event_recorder_start (recorder, "session.events", &error))
+ *     g_error ("Unable to record: %s", error->message);
+ *
+ *   clutter_main ();
+ *
+ *   clutter_event_recorder_stop (recorder, NULL);
+ * ]|
+ *
+ * #ClutterEventRecorder is available since Clutter 1.28
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+
+#include "clutter-event-recorder.h"
+#include "clutter-event-recorder-private.h"
+
+#include "clutter-debug.h"
+#include "clutter-device-manager.h"
+#include "clutter-event-private.h"
+#include "clutter-input-device.h"
+#include "clutter-private.h"
+#include "clutter-stage.h"
+
+struct _ClutterEventRecorderPrivate
+{
+  GDataOutputStream *stream;
+
+  /* the first write error, reported by stop() */
+  GError *error;
+
+  gint64 start_time;
+  guint n_events;
+};
+
+G_DEFINE_TYPE_WITH_PRIVATE (ClutterEventRecorder,
+                            clutter_event_recorder,
+                            G_TYPE_OBJECT)
+
+static inline guint32
+float_to_bits (gfloat value)
+{
+  union { gfloat f; guint32 u; } v;
+
+  v.f = value;
+
+  return v.u;
+}
+
+static inline gfloat
+bits_to_float (guint32 value)
+{
+  union { gfloat f; guint32 u; } v;
+
+  v.u = value;
+
+  return v.f;
+}
+
+static inline guint64
+double_to_bits (gdouble value)
+{
+  union { gdouble d; guint64 u; } v;
+
+  v.d = value;
+
+  return v.u;
+}
+
+static inline gdouble
+bits_to_double (guint64 value)
+{
+  union { gdouble d; guint64 u; } v;
+
+  v.u = value;
+
+  return v.d;
+}
+
+gboolean
+_clutter_event_record_write_header (GDataOutputStream  *stream,
+                                    GError            **error)
+{
+  return g_data_output_stream_put_uint32 (stream, CLUTTER_EVENT_RECORD_MAGIC, NULL, error) &&
+         g_data_output_stream_put_uint32 (stream, CLUTTER_EVENT_RECORD_VERSION, NULL, error);
+}
+
+gboolean
+_clutter_event_record_read_header (GDataInputStream  *stream,
+                                   GError           **error)
+{
+  GError *internal_error = NULL;
+  guint32 magic, version;
+
+  magic = g_data_input_stream_read_uint32 (stream, NULL, &internal_error);
+  if (internal_error == NULL)
+    version = g_data_input_stream_read_uint32 (stream, NULL, &internal_error);
+
+  if (internal_error != NULL)
+    {
+      g_propagate_error (error, internal_error);
+      return FALSE;
+    }
+
+  if (magic != CLUTTER_EVENT_RECORD_MAGIC)
+    {
+      g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                           "Not an event recording");
+      return FALSE;
+    }
+
+  if (version != CLUTTER_EVENT_RECORD_VERSION)
+    {
+      g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                   "Unsupported event recording version %u",
+                   version);
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
+gboolean
+_clutter_event_record_write (GDataOutputStream         *stream,
+                             const ClutterEventRecord  *record,
+                             GError                   **error)
+{
+  guint i;
+
+  if (!g_data_output_stream_put_int64 (stream, record->queue_time, NULL, error) ||
+      !g_data_output_stream_put_uint32 (stream, record->type, NULL, error) ||
+      !g_data_output_stream_put_uint32 (stream, record->time, NULL, error) ||
+      !g_data_output_stream_put_uint32 (stream, record->flags, NULL, error) ||
+      !g_data_output_stream_put_uint32 (stream, record->state, NULL, error) ||
+      !g_data_output_stream_put_int32 (stream, record->device_id, NULL, error) ||
+      !g_data_output_stream_put_int32 (stream, record->source_device_id, NULL, error) ||
+      !g_data_output_stream_put_uint32 (stream, record->sequence, NULL, error) ||
+      !g_data_output_stream_put_uint32 (stream, float_to_bits (record->x), NULL, error) ||
+      !g_data_output_stream_put_uint32 (stream, float_to_bits (record->y), NULL, error))
+    return FALSE;
+
+  for (i = 0; i < G_N_ELEMENTS (record->details); i++)
+    {
+      if (!g_data_output_stream_put_uint32 (stream, record->details[i], NULL, error))
+        return FALSE;
+    }
+
+  for (i = 0; i < G_N_ELEMENTS (record->values); i++)
+    {
+      if (!g_data_output_stream_put_uint64 (stream, double_to_bits (record->values[i]), NULL, error))
+        return FALSE;
+    }
+
+  return TRUE;
+}
+
+/* returns FALSE without setting @error at the end of the stream */
+gboolean
+_clutter_event_record_read (GDataInputStream    *stream,
+                            ClutterEventRecord  *record,
+                            GError             **error)
+{
+  GBufferedInputStream *buffered = G_BUFFERED_INPUT_STREAM (stream);
+  GError *internal_error = NULL;
+  guint i;
+
+  /* a clean end of the stream falls on a record boundary */
+  if (g_buffered_input_stream_get_available (buffered) == 0 &&
+      g_buffered_input_stream_fill (buffered, -1, NULL, error) <= 0)
+    return FALSE;
+
+#define READ_FIELD(func,lvalue) \
+  G_STMT_START { \
+    if (internal_error == NULL) \
+      lvalue = func (stream, NULL, &internal_error); \
+  } G_STMT_END
+
+  READ_FIELD (g_data_input_stream_read_int64, record->queue_time);
+  READ_FIELD (g_data_input_stream_read_uint32, record->type);
+  READ_FIELD (g_data_input_stream_read_uint32, record->time);
+  READ_FIELD (g_data_input_stream_read_uint32, record->flags);
+  READ_FIELD (g_data_input_stream_read_uint32, record->state);
+  READ_FIELD (g_data_input_stream_read_int32, record->device_id);
+  READ_FIELD (g_data_input_stream_read_int32, record->source_device_id);
+  READ_FIELD (g_data_input_stream_read_uint32, record->sequence);
+
+  if (internal_error == NULL)
+    record->x = bits_to_float (g_data_input_stream_read_uint32 (stream, NULL, &internal_error));
+  if (internal_error == NULL)
+    record->y = bits_to_float (g_data_input_stream_read_uint32 (stream, NULL, &internal_error));
+
+  for (i = 0; i < G_N_ELEMENTS (record->details); i++)
+    READ_FIELD (g_data_input_stream_read_uint32, record->details[i]);
+
+  for (i = 0; i < G_N_ELEMENTS (record->values) && internal_error == NULL; i++)
+    record->values[i] = bits_to_double (g_data_input_stream_read_uint64 (stream, NULL, &internal_error));
+
+#undef READ_FIELD
+
+  if (internal_error != NULL)
+    {
+      g_propagate_error (error, internal_error);
+      return FALSE;
+    }
+
+  if (record->type == CLUTTER_NOTHING || record->type >= CLUTTER_EVENT_LAST)
+    {
+      g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                   "Invalid event type %u",
+                   record->type);
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
+/* only input events are recorded: the other types describe the
+ * state of the stage, which is not replayed
+ */
+gboolean
+_clutter_event_record_from_event (ClutterEventRecord *record,
+                                  const ClutterEvent *event)
+{
+  ClutterInputDevice *device;
+  gdouble dx, dy;
+
+  switch (event->type)
+    {
+    case CLUTTER_NOTHING:
+    case CLUTTER_STAGE_STATE:
+    case CLUTTER_DESTROY_NOTIFY:
+    case CLUTTER_CLIENT_MESSAGE:
+    case CLUTTER_DELETE:
+    case CLUTTER_EVENT_LAST:
+      return FALSE;
+
+    default:
+      break;
+    }
+
+  memset (record, 0, sizeof (ClutterEventRecord));
+
+  record->type = event->type;
+  record->time = clutter_event_get_time (event);
+  record->flags = clutter_event_get_flags (event);
+  record->state = clutter_event_get_state (event);
+
+  device = clutter_event_get_device (event);
+  record->device_id = device != NULL
+                    ? clutter_input_device_get_device_id (device)
+                    : -1;
+
+  device = clutter_event_get_source_device (event);
+  record->source_device_id = device != NULL
+                           ? clutter_input_device_get_device_id (device)
+                           : -1;
+
+  record->sequence = GPOINTER_TO_UINT (clutter_event_get_event_sequence (event));
+
+  clutter_event_get_coords (event, &record->x, &record->y);
+
+  switch (event->type)
+    {
+    case CLUTTER_BUTTON_PRESS:
+    case CLUTTER_BUTTON_RELEASE:
+      record->details[0] = event->button.button;
+      record->details[1] = event->button.click_count;
+      break;
+
+    case CLUTTER_KEY_PRESS:
+    case CLUTTER_KEY_RELEASE:
+      record->details[0] = event->key.keyval;
+      record->details[1] = event->key.hardware_keycode;
+      record->details[2] = event->key.unicode_value;
+      break;
+
+    case CLUTTER_SCROLL:
+      record->details[0] = event->scroll.direction;
+      record->details[1] = event->scroll.scroll_source;
+      record->details[2] = event->scroll.finish_flags;
+      if (event->scroll.direction == CLUTTER_SCROLL_SMOOTH)
+        {
+          clutter_event_get_scroll_delta (event, &dx, &dy);
+          record->values[0] = dx;
+          record->values[1] = dy;
+        }
+      break;
+
+    case CLUTTER_TOUCHPAD_PINCH:
+      record->details[0] = event->touchpad_pinch.phase;
+      record->values[0] = event->touchpad_pinch.dx;
+      record->values[1] = event->touchpad_pinch.dy;
+      record->values[2] = event->touchpad_pinch.angle_delta;
+      record->values[3] = event->touchpad_pinch.scale;
+      break;
+
+    case CLUTTER_TOUCHPAD_SWIPE:
+      record->details[0] = event->touchpad_swipe.phase;
+      record->details[1] = event->touchpad_swipe.n_fingers;
+      record->values[0] = event->touchpad_swipe.dx;
+      record->values[1] = event->touchpad_swipe.dy;
+      break;
+
+    default:
+      break;
+    }
+
+  return TRUE;
+}
+
+static ClutterInputDevice *
+resolve_device (ClutterDeviceManager *manager,
+                gint                  device_id,
+                ClutterEventType      event_type)
+{
+  ClutterInputDevice *device = NULL;
+
+  if (device_id >= 0)
+    device = clutter_device_manager_get_device (manager, device_id);
+
+  /* the devices of the recording might not exist when replaying,
+   * for instance with the headless backend; the core devices are
+   * the closest match
+   */
+  if (device == NULL)
+    {
+      if (event_type == CLUTTER_KEY_PRESS || event_type == CLUTTER_KEY_RELEASE)
+        device = clutter_device_manager_get_core_device (manager, CLUTTER_KEYBOARD_DEVICE);
+      else
+        device = clutter_device_manager_get_core_device (manager, CLUTTER_POINTER_DEVICE);
+    }
+
+  return device;
+}
+
+ClutterEvent *
+_clutter_event_record_to_event (const ClutterEventRecord *record,
+                                ClutterStage             *stage)
+{
+  ClutterDeviceManager *manager = clutter_device_manager_get_default ();
+  ClutterInputDevice *device;
+  ClutterEvent *event;
+
+  event = clutter_event_new (record->type);
+
+  clutter_event_set_stage (event, stage);
+  clutter_event_set_time (event, record->time);
+  clutter_event_set_flags (event, record->flags | CLUTTER_EVENT_FLAG_SYNTHETIC);
+  clutter_event_set_state (event, record->state);
+
+  device = resolve_device (manager, record->device_id, record->type);
+  clutter_event_set_device (event, device);
+
+  if (record->source_device_id >= 0)
+    device = resolve_device (manager, record->source_device_id, record->type);
+  clutter_event_set_source_device (event, device);
+
+  clutter_event_set_coords (event, record->x, record->y);
+
+  switch (record->type)
+    {
+    case CLUTTER_BUTTON_PRESS:
+    case CLUTTER_BUTTON_RELEASE:
+      event->button.button = record->details[0];
+      event->button.click_count = record->details[1];
+      break;
+
+    case CLUTTER_KEY_PRESS:
+    case CLUTTER_KEY_RELEASE:
+      event->key.keyval = record->details[0];
+      event->key.hardware_keycode = record->details[1];
+      event->key.unicode_value = record->details[2];
+      break;
+
+    case CLUTTER_SCROLL:
+      event->scroll.direction = record->details[0];
+      event->scroll.scroll_source = record->details[1];
+      event->scroll.finish_flags = record->details[2];
+      if (event->scroll.direction == CLUTTER_SCROLL_SMOOTH)
+        clutter_event_set_scroll_delta (event, record->values[0], record->values[1]);
+      break;
+
+    case CLUTTER_ENTER:
+    case CLUTTER_LEAVE:
+      /* crossing events are only queued for the stage itself */
+      event->crossing.source = CLUTTER_ACTOR (stage);
+      event->crossing.related = NULL;
+      break;
+
+    case CLUTTER_TOUCH_BEGIN:
+    case CLUTTER_TOUCH_UPDATE:
+    case CLUTTER_TOUCH_END:
+    case CLUTTER_TOUCH_CANCEL:
+      event->touch.sequence = GUINT_TO_POINTER (record->sequence);
+      break;
+
+    case CLUTTER_TOUCHPAD_PINCH:
+      event->touchpad_pinch.phase = record->details[0];
+      event->touchpad_pinch.dx = record->values[0];
+      event->touchpad_pinch.dy = record->values[1];
+      event->touchpad_pinch.angle_delta = record->values[2];
+      event->touchpad_pinch.scale = record->values[3];
+      break;
+
+    case CLUTTER_TOUCHPAD_SWIPE:
+      event->touchpad_swipe.phase = record->details[0];
+      event->touchpad_swipe.n_fingers = record->details[1];
+      event->touchpad_swipe.dx = record->values[0];
+      event->touchpad_swipe.dy = record->values[1];
+      break;
+
+    default:
+      break;
+    }
+
+  return event;
+}
+
+void
+_clutter_event_recorders_queue_event (ClutterStage       *stage,
+                                      const ClutterEvent *event)
+{
+  ClutterMainContext *context = _clutter_context_get_default ();
+  ClutterEventRecord record;
+  gint64 now;
+  GSList *l;
+
+  if (!_clutter_event_record_from_event (&record, event))
+    return;
+
+  now = g_get_monotonic_time ();
+
+  for (l = context->event_recorders; l != NULL; l = l->next)
+    {
+      ClutterEventRecorderPrivate *priv = CLUTTER_EVENT_RECORDER (l->data)->priv;
+
+      /* stop writing after the first error */
+      if (priv->error != NULL)
+        continue;
+
+      record.queue_time = now - priv->start_time;
+
+      if (!_clutter_event_record_write (priv->stream, &record, &priv->error))
+        {
+          g_warning ("Unable to record event: %s", priv->error->message);
+          continue;
+        }
+
+      priv->n_events += 1;
+    }
+}
+
+static void
+clutter_event_recorder_finalize (GObject *gobject)
+{
+  ClutterEventRecorder *recorder = CLUTTER_EVENT_RECORDER (gobject);
+
+  if (recorder->priv->stream != NULL)
+    clutter_event_recorder_stop (recorder, NULL);
+
+  G_OBJECT_CLASS (clutter_event_recorder_parent_class)->finalize (gobject);
+}
+
+static void
+clutter_event_recorder_class_init (ClutterEventRecorderClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->finalize = clutter_event_recorder_finalize;
+}
+
+static void
+clutter_event_recorder_init (ClutterEventRecorder *self)
+{
+  self->priv = clutter_event_recorder_get_instance_private (self);
+}
+
+/**
+ * clutter_event_recorder_new:
+ *
+ * Creates a new #ClutterEventRecorder.
+ *
+ * Return value: (transfer full): the newly created #ClutterEventRecorder;
+ *   use g_object_unref() when done
+ *
+ * Since: 1.28
+ */
+ClutterEventRecorder *
+clutter_event_recorder_new (void)
+{
+  return g_object_new (CLUTTER_TYPE_EVENT_RECORDER, NULL);
+}
+
+/**
+ * clutter_event_recorder_start:
+ * @recorder: a #ClutterEventRecorder
+ * @filename: (type filename): the path of the file to record into
+ * @error: return location for a #GError, or %NULL
+ *
+ * Starts recording the input events queued on every stage into
+ * @filename, replacing its contents.
+ *
+ * Return value: %TRUE if the recording started, and %FALSE
+ *   otherwise, in which case @error is set
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_event_recorder_start (ClutterEventRecorder  *recorder,
+                              const gchar           *filename,
+                              GError               **error)
+{
+  ClutterMainContext *context = _clutter_context_get_default ();
+  ClutterEventRecorderPrivate *priv;
+  GFileOutputStream *file_stream;
+  GFile *file;
+
+  g_return_val_if_fail (CLUTTER_IS_EVENT_RECORDER (recorder), FALSE);
+  g_return_val_if_fail (filename != NULL, FALSE);
+
+  priv = recorder->priv;
+
+  g_return_val_if_fail (priv->stream == NULL, FALSE);
+
+  file = g_file_new_for_path (filename);
+  file_stream = g_file_replace (file, NULL, FALSE,
+                                G_FILE_CREATE_REPLACE_DESTINATION,
+                                NULL,
+                                error);
+  g_object_unref (file);
+
+  if (file_stream == NULL)
+    return FALSE;
+
+  priv->stream = g_data_output_stream_new (G_OUTPUT_STREAM (file_stream));
+  g_object_unref (file_stream);
+
+  if (!_clutter_event_record_write_header (priv->stream, error))
+    {
+      g_clear_object (&priv->stream);
+      return FALSE;
+    }
+
+  priv->n_events = 0;
+  priv->start_time = g_get_monotonic_time ();
+  g_clear_error (&priv->error);
+
+  context->event_recorders = g_slist_prepend (context->event_recorders,
+                                              recorder);
+
+  CLUTTER_NOTE (EVENT, "Recording events into '%s'", filename);
+
+  return TRUE;
+}
+
+/**
+ * clutter_event_recorder_stop:
+ * @recorder: a #ClutterEventRecorder
+ * @error: return location for a #GError, or %NULL
+ *
+ * Stops the recording started by clutter_event_recorder_start(),
+ * and closes the file.
+ *
+ * Return value: %TRUE if every event was recorded and the file
+ *   was closed successfully, and %FALSE otherwise, in which case
+ *   @error is set
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_event_recorder_stop (ClutterEventRecorder  *recorder,
+                             GError               **error)
+{
+  ClutterMainContext *context = _clutter_context_get_default ();
+  ClutterEventRecorderPrivate *priv;
+  gboolean res;
+
+  g_return_val_if_fail (CLUTTER_IS_EVENT_RECORDER (recorder), FALSE);
+
+  priv = recorder->priv;
+
+  if (priv->stream == NULL)
+    return TRUE;
+
+  context->event_recorders = g_slist_remove (context->event_recorders,
+                                             recorder);
+
+  if (priv->error != NULL)
+    {
+      g_propagate_error (error, priv->error);
+      priv->error = NULL;
+
+      g_output_stream_close (G_OUTPUT_STREAM (priv->stream), NULL, NULL);
+      res = FALSE;
+    }
+  else
+    res = g_output_stream_close (G_OUTPUT_STREAM (priv->stream), NULL, error);
+
+  g_clear_object (&priv->stream);
+
+  CLUTTER_NOTE (EVENT, "Recorded %u events", priv->n_events);
+
+  return res;
+}
+
+/**
+ * clutter_event_recorder_is_recording:
+ * @recorder: a #ClutterEventRecorder
+ *
+ * Checks whether @recorder is recording events.
+ *
+ * Return value: %TRUE if the recording is in progress
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_event_recorder_is_recording (ClutterEventRecorder *recorder)
+{
+  g_return_val_if_fail (CLUTTER_IS_EVENT_RECORDER (recorder), FALSE);
+
+  return recorder->priv->stream != NULL;
+}
+
+/**
+ * clutter_event_recorder_get_n_events:
+ * @recorder: a #ClutterEventRecorder
+ *
+ * Retrieves the number of events recorded since the last call
+ * to clutter_event_recorder_start().
+ *
+ * Return value: the number of recorded events
+ *
+ * Since: 1.28
+ */
+guint
+clutter_event_recorder_get_n_events (ClutterEventRecorder *recorder)
+{
+  g_return_val_if_fail (CLUTTER_IS_EVENT_RECORDER (recorder), 0);
+
+  return recorder->priv->n_events;
+}
@@ -0,0 +1,95 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CLUTTER_EVENT_RECORDER_H__
+#define __CLUTTER_EVENT_RECORDER_H__
+
+#if !defined(__CLUTTER_H_INSIDE__) && !defined(CLUTTER_COMPILATION)
+#error "Only <clutter/clutter.h> can be included directly."
+#endif
+
+#include <clutter/clutter-types.h>
+
+G_BEGIN_DECLS
+
+#define CLUTTER_TYPE_EVENT_RECORDER             (clutter_event_recorder_get_type ())
+#define CLUTTER_EVENT_RECORDER(obj)             (G_TYPE_CHECK_INSTANCE_CAST ((obj), CLUTTER_TYPE_EVENT_RECORDER, ClutterEventRecorder))
+#define CLUTTER_IS_EVENT_RECORDER(obj)          (G_TYPE_CHECK_INSTANCE_TYPE ((obj), CLUTTER_TYPE_EVENT_RECORDER))
+#define CLUTTER_EVENT_RECORDER_CLASS(klass)     (G_TYPE_CHECK_CLASS_CAST ((klass), CLUTTER_TYPE_EVENT_RECORDER, ClutterEventRecorderClass))
+#define CLUTTER_IS_EVENT_RECORDER_CLASS(klass)  (G_TYPE_CHECK_CLASS_TYPE ((klass), CLUTTER_TYPE_EVENT_RECORDER))
+#define CLUTTER_EVENT_RECORDER_GET_CLASS(obj)   (G_TYPE_INSTANCE_GET_CLASS ((obj), CLUTTER_TYPE_EVENT_RECORDER, ClutterEventRecorderClass))
+
+typedef struct _ClutterEventRecorder            ClutterEventRecorder;
+typedef struct _ClutterEventRecorderPrivate     ClutterEventRecorderPrivate;
+typedef struct _ClutterEventRecorderClass       ClutterEventRecorderClass;
+
+/**
+ * ClutterEventRecorder:
+ *
+ * The #ClutterEventRecorder structure contains only private
+ * data and should be accessed using the provided API.
+ *
+ * Since: 1.28
+ */
+struct _ClutterEventRecorder
+{
+  /*< private >*/
+  GObject parent_instance;
+
+  ClutterEventRecorderPrivate *priv;
+};
+
+/**
+ * ClutterEventRecorderClass:
+ *
+ * The #ClutterEventRecorderClass structure contains only
+ * private data.
+ *
+ * Since: 1.28
+ */
+struct _ClutterEventRecorderClass
+{
+  /*< private >*/
+  GObjectClass parent_class;
+
+  /* padding for future expansion */
+  gpointer _padding[4];
+};
+
+CLUTTER_AVAILABLE_IN_1_28
+GType clutter_event_recorder_get_type (void) G_GNUC_CONST;
+
+CLUTTER_AVAILABLE_IN_1_28
+ClutterEventRecorder *  clutter_event_recorder_new              (void);
+
+CLUTTER_AVAILABLE_IN_1_28
+gboolean                clutter_event_recorder_start            (ClutterEventRecorder  *recorder,
+                                                                 const gchar           *filename,
+                                                                 GError               **error);
+CLUTTER_AVAILABLE_IN_1_28
+gboolean                clutter_event_recorder_stop             (ClutterEventRecorder  *recorder,
+                                                                 GError               **error);
+CLUTTER_AVAILABLE_IN_1_28
+gboolean                clutter_event_recorder_is_recording     (ClutterEventRecorder  *recorder);
+CLUTTER_AVAILABLE_IN_1_28
+guint                   clutter_event_recorder_get_n_events     (ClutterEventRecorder  *recorder);
+
+G_END_DECLS
+
+#endif /* __CLUTTER_EVENT_RECORDER_H__ */
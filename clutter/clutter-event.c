@@ -34,6 +34,7 @@
 #include "clutter-private.h"
 
 #include <math.h>
+#include <string.h>
 
 /**
  * SECTION:clutter-event
@@ -45,6 +46,18 @@
  * be synthesized by Clutter itself or by the application code.
  */
 
+typedef struct _ClutterEventHistorySample {
+  guint32 time;
+  gfloat x;
+  gfloat y;
+} ClutterEventHistorySample;
+
+/* the number of samples kept in the history of a coalesced event; this
+ * covers a frame at 30Hz for a device reporting at 1kHz, and only the
+ * most recent samples are kept past that
+ */
+#define EVENT_HISTORY_SIZE      32
+
 typedef struct _ClutterEventPrivate {
   ClutterEvent base;
 
@@ -61,7 +74,26 @@ typedef struct _ClutterEventPrivate {
   ClutterModifierType latched_state;
   ClutterModifierType locked_state;
 
+  /* set while the event is in use, see is_event_allocated() */
+  guint32 magic;
+
+  /* ring of the samples of the events coalesced into this one, from
+   * the oldest to the most recent, starting at history_start
+   */
+  ClutterEventHistorySample history[EVENT_HISTORY_SIZE];
+  guint8 history_start;
+  guint8 n_history;
+
+  /* index of the event in a replayed recording, plus one */
+  guint replay_serial;
+
   guint is_pointer_emulated : 1;
+
+  /* index of the next free event in the pool; this must be the last
+   * field, as it is accessed atomically and is not cleared when the
+   * event is allocated, see event_pool_alloc()
+   */
+  gsize next_free;
 } ClutterEventPrivate;
 
 typedef struct _ClutterEventFilter {
@@ -73,8 +105,6 @@ typedef struct _ClutterEventFilter {
   gpointer user_data;
 } ClutterEventFilter;
 
-static GHashTable *all_events = NULL;
-
 G_DEFINE_BOXED_TYPE (ClutterEvent, clutter_event,
                      clutter_event_copy,
                      clutter_event_free);
@@ -96,13 +126,248 @@ G_DEFINE_BOXED_TYPE (ClutterEventSequence, clutter_event_sequence,
                      clutter_event_sequence_copy,
                      clutter_event_sequence_free);
 
+/* Events are allocated from a pool of blocks, each twice as big as the
+ * previous one; this allows us to check whether an event was allocated
+ * by Clutter by looking at the address range of each block, and at the
+ * marker stored inside the event itself, instead of keeping a global
+ * hash table of every allocated event.
+ *
+ * The unused events are kept in a free list which is accessed without
+ * taking a lock, so that events can be allocated and freed by the
+ * input threads as well as by the main thread; the head of the list
+ * contains the index of the first free event in its lower bits, and a
+ * counter in its upper bits to avoid the ABA problem. Only growing the
+ * pool requires taking a lock.
+ *
+ * On 32 bit platforms the counter would only have a few bits, and it
+ * would wrap around quickly enough for the ABA problem to happen, so
+ * the free list is protected by a lock instead.
+ */
+#define EVENT_POOL_BLOCK_SIZE   128
+#define EVENT_POOL_MAX_BLOCKS   17
+
+#if GLIB_SIZEOF_VOID_P == 8
+#define EVENT_POOL_LOCK_FREE    1
+#define EVENT_POOL_INDEX_BITS   32
+#define EVENT_POOL_INDEX_MASK   ((((gsize) 1) << EVENT_POOL_INDEX_BITS) - 1)
+#define EVENT_POOL_TAG_STEP     (((gsize) 1) << EVENT_POOL_INDEX_BITS)
+#else
+#define EVENT_POOL_INDEX_MASK   (~((gsize) 0))
+#endif
+
+#define EVENT_ALLOCATED_MAGIC   0x45564e54      /* 'EVNT' */
+
+typedef struct _ClutterEventPool {
+  ClutterEventPrivate *blocks[EVENT_POOL_MAX_BLOCKS];
+  gint n_blocks;
+
+  /* tag | (index + 1) of the first free event, 0 if the list is empty */
+  gsize free_head;
+} ClutterEventPool;
+
+static ClutterEventPool event_pool = { { NULL, }, 0, 0 };
+G_LOCK_DEFINE_STATIC (event_pool);
+
+#ifndef EVENT_POOL_LOCK_FREE
+G_LOCK_DEFINE_STATIC (event_pool_free_list);
+#endif
+
+static inline ClutterEventPrivate *
+event_pool_get_slot (gsize index_)
+{
+  guint block = g_bit_storage (index_ / EVENT_POOL_BLOCK_SIZE + 1) - 1;
+  gsize block_start = EVENT_POOL_BLOCK_SIZE * ((((gsize) 1) << block) - 1);
+
+  return &event_pool.blocks[block][index_ - block_start];
+}
+
+#ifdef EVENT_POOL_LOCK_FREE
+static void
+event_pool_push_chain (gsize first_index,
+                       ClutterEventPrivate *last)
+{
+  gsize old_head, new_head;
+
+  do
+    {
+      old_head = (gsize) g_atomic_pointer_get (&event_pool.free_head);
+
+      g_atomic_pointer_set (&last->next_free, old_head & EVENT_POOL_INDEX_MASK);
+      new_head = ((old_head & ~EVENT_POOL_INDEX_MASK) + EVENT_POOL_TAG_STEP)
+               | (first_index + 1);
+    }
+  while (!g_atomic_pointer_compare_and_exchange (&event_pool.free_head,
+                                                 old_head,
+                                                 new_head));
+}
+
+static ClutterEventPrivate *
+event_pool_pop (void)
+{
+  ClutterEventPrivate *slot;
+  gsize old_head, new_head;
+
+  do
+    {
+      old_head = (gsize) g_atomic_pointer_get (&event_pool.free_head);
+      if ((old_head & EVENT_POOL_INDEX_MASK) == 0)
+        return NULL;
+
+      /* the blocks are never released, and the next index is only
+       * accessed atomically, so it is safe to read it even if another
+       * thread popped the slot in the meantime; the tag will make the
+       * exchange fail
+       */
+      slot = event_pool_get_slot ((old_head & EVENT_POOL_INDEX_MASK) - 1);
+      new_head = ((old_head & ~EVENT_POOL_INDEX_MASK) + EVENT_POOL_TAG_STEP)
+               | (gsize) g_atomic_pointer_get (&slot->next_free);
+    }
+  while (!g_atomic_pointer_compare_and_exchange (&event_pool.free_head,
+                                                 old_head,
+                                                 new_head));
+
+  return slot;
+}
+#else /* !EVENT_POOL_LOCK_FREE */
+static void
+event_pool_push_chain (gsize first_index,
+                       ClutterEventPrivate *last)
+{
+  G_LOCK (event_pool_free_list);
+
+  last->next_free = event_pool.free_head;
+  g_atomic_pointer_set (&event_pool.free_head, first_index + 1);
+
+  G_UNLOCK (event_pool_free_list);
+}
+
+static ClutterEventPrivate *
+event_pool_pop (void)
+{
+  ClutterEventPrivate *slot = NULL;
+
+  G_LOCK (event_pool_free_list);
+
+  if (event_pool.free_head != 0)
+    {
+      slot = event_pool_get_slot (event_pool.free_head - 1);
+      g_atomic_pointer_set (&event_pool.free_head, slot->next_free);
+    }
+
+  G_UNLOCK (event_pool_free_list);
+
+  return slot;
+}
+#endif /* EVENT_POOL_LOCK_FREE */
+
+static void
+event_pool_grow (void)
+{
+  ClutterEventPrivate *block;
+  gsize block_start, block_size, i;
+  gint n_blocks;
+
+  G_LOCK (event_pool);
+
+  /* another thread may have grown the pool while we were waiting */
+  if (((gsize) g_atomic_pointer_get (&event_pool.free_head) & EVENT_POOL_INDEX_MASK) != 0)
+    {
+      G_UNLOCK (event_pool);
+      return;
+    }
+
+  n_blocks = g_atomic_int_get (&event_pool.n_blocks);
+  if (G_UNLIKELY (n_blocks == EVENT_POOL_MAX_BLOCKS))
+    g_error ("Unable to allocate more than %" G_GSIZE_FORMAT " events",
+             (gsize) EVENT_POOL_BLOCK_SIZE * ((((gsize) 1) << EVENT_POOL_MAX_BLOCKS) - 1));
+
+  block_size = ((gsize) EVENT_POOL_BLOCK_SIZE) << n_blocks;
+  block_start = EVENT_POOL_BLOCK_SIZE * ((((gsize) 1) << n_blocks) - 1);
+  block = g_new0 (ClutterEventPrivate, block_size);
+
+  for (i = 0; i < block_size - 1; i++)
+    block[i].next_free = block_start + i + 2;
+
+  CLUTTER_NOTE (EVENT, "Growing the event pool to %" G_GSIZE_FORMAT " events",
+                block_start + block_size);
+
+  /* publish the block before making its events reachable */
+  event_pool.blocks[n_blocks] = block;
+  g_atomic_int_inc (&event_pool.n_blocks);
+
+  event_pool_push_chain (block_start, &block[block_size - 1]);
+
+  G_UNLOCK (event_pool);
+}
+
+static ClutterEventPrivate *
+event_pool_alloc (void)
+{
+  ClutterEventPrivate *priv;
+
+  while ((priv = event_pool_pop ()) == NULL)
+    event_pool_grow ();
+
+  /* the next index may still be read by a thread racing to pop the
+   * same event, so leave it alone
+   */
+  memset (priv, 0, G_STRUCT_OFFSET (ClutterEventPrivate, next_free));
+  priv->magic = EVENT_ALLOCATED_MAGIC;
+
+  return priv;
+}
+
+static void
+event_pool_free (ClutterEventPrivate *priv)
+{
+  gsize index_;
+  gint block;
+
+  priv->magic = 0;
+
+  for (block = 0; block < g_atomic_int_get (&event_pool.n_blocks); block++)
+    {
+      ClutterEventPrivate *start = event_pool.blocks[block];
+
+      if (priv >= start && priv < start + (EVENT_POOL_BLOCK_SIZE << block))
+        {
+          index_ = EVENT_POOL_BLOCK_SIZE * ((((gsize) 1) << block) - 1)
+                 + (priv - start);
+          event_pool_push_chain (index_, priv);
+          return;
+        }
+    }
+
+  g_assert_not_reached ();
+}
+
 static gboolean
 is_event_allocated (const ClutterEvent *event)
 {
-  if (all_events == NULL)
-    return FALSE;
+  const gchar *ptr = (const gchar *) event;
+  gint block, n_blocks;
+
+  n_blocks = g_atomic_int_get (&event_pool.n_blocks);
+
+  /* the events not allocated by Clutter, like the ones on the stack,
+   * are outside of all the pool blocks, so we can safely look at the
+   * marker only after checking the address range
+   */
+  for (block = 0; block < n_blocks; block++)
+    {
+      const gchar *start = (const gchar *) event_pool.blocks[block];
+      gsize size = sizeof (ClutterEventPrivate) * (EVENT_POOL_BLOCK_SIZE << block);
+
+      if (ptr >= start && ptr < start + size)
+        {
+          if ((ptr - start) % sizeof (ClutterEventPrivate) != 0)
+            return FALSE;
+
+          return ((const ClutterEventPrivate *) event)->magic == EVENT_ALLOCATED_MAGIC;
+        }
+    }
 
-  return g_hash_table_lookup (all_events, event) != NULL;
+  return FALSE;
 }
 
 /*
@@ -143,6 +408,25 @@ _clutter_event_set_platform_data (ClutterEvent *event,
   ((ClutterEventPrivate *) event)->platform_data = data;
 }
 
+void
+_clutter_event_set_replay_serial (ClutterEvent *event,
+                                  guint         serial)
+{
+  if (!is_event_allocated (event))
+    return;
+
+  ((ClutterEventPrivate *) event)->replay_serial = serial;
+}
+
+guint
+_clutter_event_get_replay_serial (const ClutterEvent *event)
+{
+  if (!is_event_allocated (event))
+    return 0;
+
+  return ((ClutterEventPrivate *) event)->replay_serial;
+}
+
 void
 _clutter_event_set_pointer_emulated (ClutterEvent *event,
                                      gboolean      is_emulated)
@@ -1220,16 +1504,11 @@ clutter_event_new (ClutterEventType type)
   ClutterEvent *new_event;
   ClutterEventPrivate *priv;
 
-  priv = g_slice_new0 (ClutterEventPrivate);
+  priv = event_pool_alloc ();
 
   new_event = (ClutterEvent *) priv;
   new_event->type = new_event->any.type = type;
 
-  if (G_UNLIKELY (all_events == NULL))
-    all_events = g_hash_table_new (NULL, NULL);
-
-  g_hash_table_replace (all_events, priv, GUINT_TO_POINTER (1));
-
   return new_event;
 }
 
@@ -1269,6 +1548,15 @@ clutter_event_copy (const ClutterEvent *event)
       new_real_event->button_state = real_event->button_state;
       new_real_event->latched_state = real_event->latched_state;
       new_real_event->locked_state = real_event->locked_state;
+      new_real_event->replay_serial = real_event->replay_serial;
+
+      if (real_event->n_history > 0)
+        {
+          memcpy (new_real_event->history, real_event->history,
+                  sizeof (real_event->history));
+          new_real_event->history_start = real_event->history_start;
+          new_real_event->n_history = real_event->n_history;
+        }
     }
 
   device = clutter_event_get_device (event);
@@ -1356,8 +1644,7 @@ clutter_event_free (ClutterEvent *event)
           break;
         }
 
-      g_hash_table_remove (all_events, event);
-      g_slice_free (ClutterEventPrivate, (ClutterEventPrivate *) event);
+      event_pool_free ((ClutterEventPrivate *) event);
     }
 }
 
@@ -2041,3 +2328,176 @@ clutter_event_get_scroll_finish_flags (const ClutterEvent *event)
 
   return event->scroll.finish_flags;
 }
+
+static inline const ClutterEventHistorySample *
+event_history_get (const ClutterEventPrivate *real_event,
+                   guint                      index_)
+{
+  return &real_event->history[(real_event->history_start + index_) % EVENT_HISTORY_SIZE];
+}
+
+static void
+event_history_push (ClutterEventPrivate             *real_event,
+                    const ClutterEventHistorySample *sample)
+{
+  guint index_;
+
+  /* drop the oldest sample when the ring is full */
+  if (real_event->n_history == EVENT_HISTORY_SIZE)
+    {
+      real_event->history_start = (real_event->history_start + 1) % EVENT_HISTORY_SIZE;
+      real_event->n_history -= 1;
+    }
+
+  index_ = (real_event->history_start + real_event->n_history) % EVENT_HISTORY_SIZE;
+  real_event->history[index_] = *sample;
+  real_event->n_history += 1;
+}
+
+/*< private >
+ * _clutter_event_coalesce:
+ * @event: a #ClutterEvent
+ * @previous: the event superseded by @event
+ *
+ * Moves the coordinates and timestamp of @previous, along with its
+ * own history, at the beginning of the history of @event.
+ *
+ * The history is stored inside the events, so this does not allocate
+ * any memory; only the most recent %EVENT_HISTORY_SIZE samples are
+ * kept.
+ */
+void
+_clutter_event_coalesce (ClutterEvent       *event,
+                         ClutterEvent       *previous)
+{
+  ClutterEventPrivate *real_event, *real_previous;
+  ClutterEventHistorySample own[EVENT_HISTORY_SIZE];
+  ClutterEventHistorySample sample;
+  guint i, n_own;
+
+  if (!is_event_allocated (event))
+    return;
+
+  real_event = (ClutterEventPrivate *) event;
+  real_previous = (ClutterEventPrivate *) previous;
+
+  /* the samples of @event, if any, come after the ones of @previous */
+  n_own = real_event->n_history;
+  for (i = 0; i < n_own; i++)
+    own[i] = *event_history_get (real_event, i);
+
+  real_event->history_start = 0;
+  real_event->n_history = 0;
+
+  if (is_event_allocated (previous))
+    {
+      for (i = 0; i < real_previous->n_history; i++)
+        event_history_push (real_event, event_history_get (real_previous, i));
+
+      real_previous->n_history = 0;
+    }
+
+  sample.time = clutter_event_get_time (previous);
+  clutter_event_get_coords (previous, &sample.x, &sample.y);
+  event_history_push (real_event, &sample);
+
+  for (i = 0; i < n_own; i++)
+    event_history_push (real_event, &own[i]);
+}
+
+/**
+ * clutter_event_get_history_size:
+ * @event: a #ClutterEvent of type %CLUTTER_MOTION or %CLUTTER_TOUCH_UPDATE
+ *
+ * Retrieves the number of samples coalesced into @event.
+ *
+ * When a #ClutterStage throttles the motion events, only the last
+ * motion event or touch update coming from the same device and
+ * sequence during a frame is delivered; the coordinates and
+ * timestamps of the events that were dropped are stored inside the
+ * delivered event, and can be retrieved using
+ * clutter_event_get_history_coords() and clutter_event_get_history_time(),
+ * for instance to estimate the velocity of a gesture at the full rate
+ * of the input device.
+ *
+ * Only the 32 most recent samples are kept, which covers a frame at
+ * 30Hz for a device reporting at 1kHz.
+ *
+ * Return value: the number of samples, or 0
+ *
+ * Since: 1.28
+ */
+guint
+clutter_event_get_history_size (const ClutterEvent *event)
+{
+  const ClutterEventPrivate *real_event;
+
+  g_return_val_if_fail (event != NULL, 0);
+
+  if (!is_event_allocated (event))
+    return 0;
+
+  real_event = (const ClutterEventPrivate *) event;
+
+  return real_event->n_history;
+}
+
+/**
+ * clutter_event_get_history_coords:
+ * @event: a #ClutterEvent of type %CLUTTER_MOTION or %CLUTTER_TOUCH_UPDATE
+ * @index_: the index of the sample, between 0 and the value returned
+ *   by clutter_event_get_history_size(), exclusive
+ * @x: (out) (allow-none): return location for the X coordinate
+ * @y: (out) (allow-none): return location for the Y coordinate
+ *
+ * Retrieves the coordinates of a sample coalesced into @event.
+ *
+ * The samples are sorted from the oldest to the most recent one, and
+ * they do not include the coordinates of @event itself.
+ *
+ * Since: 1.28
+ */
+void
+clutter_event_get_history_coords (const ClutterEvent *event,
+                                  guint               index_,
+                                  gfloat             *x,
+                                  gfloat             *y)
+{
+  const ClutterEventHistorySample *sample;
+
+  g_return_if_fail (event != NULL);
+  g_return_if_fail (index_ < clutter_event_get_history_size (event));
+
+  sample = event_history_get ((const ClutterEventPrivate *) event, index_);
+
+  if (x != NULL)
+    *x = sample->x;
+
+  if (y != NULL)
+    *y = sample->y;
+}
+
+/**
+ * clutter_event_get_history_time:
+ * @event: a #ClutterEvent of type %CLUTTER_MOTION or %CLUTTER_TOUCH_UPDATE
+ * @index_: the index of the sample, between 0 and the value returned
+ *   by clutter_event_get_history_size(), exclusive
+ *
+ * Retrieves the timestamp of a sample coalesced into @event.
+ *
+ * See also clutter_event_get_history_coords().
+ *
+ * Return value: the timestamp of the sample, in milliseconds
+ *
+ * Since: 1.28
+ */
+guint32
+clutter_event_get_history_time (const ClutterEvent *event,
+                                guint               index_)
+{
+  g_return_val_if_fail (event != NULL, CLUTTER_CURRENT_TIME);
+  g_return_val_if_fail (index_ < clutter_event_get_history_size (event),
+                        CLUTTER_CURRENT_TIME);
+
+  return event_history_get ((const ClutterEventPrivate *) event, index_)->time;
+}
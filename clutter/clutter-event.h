@@ -689,6 +689,17 @@ void                    clutter_event_get_gesture_motion_delta       (const Clut
 ClutterScrollSource      clutter_event_get_scroll_source             (const ClutterEvent     *event);
 ClutterScrollFinishFlags clutter_event_get_scroll_finish_flags       (const ClutterEvent     *event);
 
+CLUTTER_AVAILABLE_IN_1_28
+guint                   clutter_event_get_history_size          (const ClutterEvent     *event);
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_event_get_history_coords        (const ClutterEvent     *event,
+                                                                 guint                   index_,
+                                                                 gfloat                 *x,
+                                                                 gfloat                 *y);
+CLUTTER_AVAILABLE_IN_1_28
+guint32                 clutter_event_get_history_time          (const ClutterEvent     *event,
+                                                                 guint                   index_);
+
 G_END_DECLS
 
 #endif /* __CLUTTER_EVENT_H__ */
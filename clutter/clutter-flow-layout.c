@@ -61,7 +61,7 @@
 #define CLUTTER_DISABLE_DEPRECATION_WARNINGS
 #include "deprecated/clutter-container.h"
 
-#include "clutter-actor.h"
+#include "clutter-actor-private.h"
 #include "clutter-animatable.h"
 #include "clutter-child-meta.h"
 #include "clutter-debug.h"
@@ -70,6 +70,34 @@
 #include "clutter-layout-meta.h"
 #include "clutter-private.h"
 
+#define N_CACHED_LINE_REQUESTS  3
+
+/* the lines computed by a size request; the requests are cached for
+ * the available size they were computed for, and for the column width
+ * or row height computed by the last request on the other axis, which
+ * they depend upon when snapping to the grid
+ */
+typedef struct _FlowLineRequest
+{
+  gfloat for_size;
+  gfloat cell_size;
+
+  gfloat min_size;
+  gfloat natural_size;
+
+  /* the column width or row height computed by the request */
+  gfloat line_cell_size;
+
+  guint line_count;
+
+  /* per-line size */
+  GArray *line_min;
+  GArray *line_natural;
+
+  /* an age of 0 means the request is not valid */
+  guint age;
+} FlowLineRequest;
+
 struct _ClutterFlowLayoutPrivate
 {
   ClutterContainer *container;
@@ -87,13 +115,14 @@ struct _ClutterFlowLayoutPrivate
   gfloat max_row_height;
   gfloat row_height;
 
-  /* per-line size */
-  GArray *line_min;
-  GArray *line_natural;
-  gfloat req_width;
-  gfloat req_height;
+  FlowLineRequest width_requests[N_CACHED_LINE_REQUESTS];
+  FlowLineRequest height_requests[N_CACHED_LINE_REQUESTS];
+  guint request_age;
 
-  guint line_count;
+  /* the age of the layout of the children when the requests were
+   * computed; see _clutter_actor_get_children_layout_age()
+   */
+  guint children_layout_age;
 
   guint is_homogeneous : 1;
   guint snap_to_grid : 1;
@@ -184,13 +213,83 @@ compute_lines (ClutterFlowLayout *self,
 }
 
 static void
-clutter_flow_layout_get_preferred_width (ClutterLayoutManager *manager,
-                                         ClutterContainer     *container,
-                                         gfloat                for_height,
-                                         gfloat               *min_width_p,
-                                         gfloat               *nat_width_p)
+invalidate_line_requests (ClutterFlowLayout *self)
 {
-  ClutterFlowLayoutPrivate *priv = CLUTTER_FLOW_LAYOUT (manager)->priv;
+  ClutterFlowLayoutPrivate *priv = self->priv;
+  gint i;
+
+  for (i = 0; i < N_CACHED_LINE_REQUESTS; i++)
+    {
+      priv->width_requests[i].age = 0;
+      priv->height_requests[i].age = 0;
+    }
+}
+
+/* returns the cached request matching the given sizes, or the entry
+ * to be filled with a new request, in which case @found is set to
+ * %FALSE
+ */
+static FlowLineRequest *
+lookup_line_request (ClutterFlowLayout *self,
+                     ClutterContainer  *container,
+                     FlowLineRequest   *requests,
+                     gfloat             for_size,
+                     gfloat             cell_size,
+                     gboolean          *found)
+{
+  ClutterFlowLayoutPrivate *priv = self->priv;
+  FlowLineRequest *request = &requests[0];
+  guint layout_age;
+  gint i;
+
+  /* the requests are only valid as long as the children do not
+   * change; changes to the layout properties are caught by the
+   * ::layout-changed class handler
+   */
+  layout_age = _clutter_actor_get_children_layout_age (CLUTTER_ACTOR (container));
+  if (layout_age != priv->children_layout_age)
+    {
+      invalidate_line_requests (self);
+      priv->children_layout_age = layout_age;
+    }
+
+  for (i = 0; i < N_CACHED_LINE_REQUESTS; i++)
+    {
+      if (requests[i].age > 0 &&
+          requests[i].for_size == for_size &&
+          requests[i].cell_size == cell_size)
+        {
+          *found = TRUE;
+          return &requests[i];
+        }
+
+      /* reuse the oldest entry */
+      if (requests[i].age < request->age)
+        request = &requests[i];
+    }
+
+  priv->request_age += 1;
+
+  request->age = priv->request_age;
+  request->for_size = for_size;
+  request->cell_size = cell_size;
+
+  /* the arrays are kept around, to avoid reallocating them */
+  g_array_set_size (request->line_min, 0);
+  g_array_set_size (request->line_natural, 0);
+
+  *found = FALSE;
+
+  return request;
+}
+
+static void
+compute_preferred_width (ClutterFlowLayout *self,
+                         ClutterContainer  *container,
+                         gfloat             for_height,
+                         FlowLineRequest   *request)
+{
+  ClutterFlowLayoutPrivate *priv = self->priv;
   gint n_rows, line_item_count, line_count;
   gfloat total_min_width, total_natural_width;
   gfloat line_min_width, line_natural_width;
@@ -199,7 +298,7 @@ clutter_flow_layout_get_preferred_width (ClutterLayoutManager *manager,
   ClutterActorIter iter;
   gfloat item_y;
 
-  n_rows = get_rows (CLUTTER_FLOW_LAYOUT (manager), for_height);
+  n_rows = get_rows (self, for_height);
 
   total_min_width = 0;
   total_natural_width = 0;
@@ -214,20 +313,6 @@ clutter_flow_layout_get_preferred_width (ClutterLayoutManager *manager,
 
   actor = CLUTTER_ACTOR (container);
 
-  /* clear the line width arrays */
-  if (priv->line_min != NULL)
-    g_array_free (priv->line_min, TRUE);
-
-  if (priv->line_natural != NULL)
-    g_array_free (priv->line_natural, TRUE);
-
-  priv->line_min = g_array_sized_new (FALSE, FALSE,
-                                      sizeof (gfloat),
-                                      16);
-  priv->line_natural = g_array_sized_new (FALSE, FALSE,
-                                          sizeof (gfloat),
-                                          16);
-
   if (clutter_actor_get_n_children (actor) != 0)
     line_count = 1;
 
@@ -254,9 +339,9 @@ clutter_flow_layout_get_preferred_width (ClutterLayoutManager *manager,
               total_min_width += line_min_width;
               total_natural_width += line_natural_width;
 
-              g_array_append_val (priv->line_min,
+              g_array_append_val (request->line_min,
                                   line_min_width);
-              g_array_append_val (priv->line_natural,
+              g_array_append_val (request->line_natural,
                                   line_natural_width);
 
               line_min_width = line_natural_width = 0;
@@ -322,19 +407,17 @@ clutter_flow_layout_get_preferred_width (ClutterLayoutManager *manager,
           total_min_width += line_min_width;
           total_natural_width += line_natural_width;
 
-          g_array_append_val (priv->line_min,
+          g_array_append_val (request->line_min,
                               line_min_width);
-          g_array_append_val (priv->line_natural,
+          g_array_append_val (request->line_natural,
                               line_natural_width);
         }
 
-      priv->line_count = line_count;
-
-      if (priv->line_count > 0)
+      if (line_count > 0)
         {
           gfloat total_spacing;
 
-          total_spacing = priv->col_spacing * (priv->line_count - 1);
+          total_spacing = priv->col_spacing * (line_count - 1);
 
           total_min_width += total_spacing;
           total_natural_width += total_spacing;
@@ -342,16 +425,14 @@ clutter_flow_layout_get_preferred_width (ClutterLayoutManager *manager,
     }
   else
     {
-      g_array_append_val (priv->line_min, line_min_width);
-      g_array_append_val (priv->line_natural, line_natural_width);
+      g_array_append_val (request->line_min, line_min_width);
+      g_array_append_val (request->line_natural, line_natural_width);
 
-      priv->line_count = line_count;
-
-      if (priv->line_count > 0)
+      if (line_count > 0)
         {
           gfloat total_spacing;
 
-          total_spacing = priv->col_spacing * (priv->line_count - 1);
+          total_spacing = priv->col_spacing * (line_count - 1);
 
           total_min_width += total_spacing;
           total_natural_width += total_spacing;
@@ -360,28 +441,66 @@ clutter_flow_layout_get_preferred_width (ClutterLayoutManager *manager,
 
   CLUTTER_NOTE (LAYOUT,
                 "Flow[w]: %d lines (%d per line): w [ %.2f, %.2f ] for h %.2f",
-                n_rows, priv->line_count,
+                n_rows, line_count,
                 total_min_width,
                 total_natural_width,
                 for_height);
 
-  priv->req_height = for_height;
+  request->min_size = max_min_width;
+  request->natural_size = total_natural_width;
+  request->line_cell_size = priv->col_width;
+  request->line_count = line_count;
+}
+
+static FlowLineRequest *
+get_width_request (ClutterFlowLayout *self,
+                   ClutterContainer  *container,
+                   gfloat             for_height)
+{
+  ClutterFlowLayoutPrivate *priv = self->priv;
+  FlowLineRequest *request;
+  gboolean found;
+
+  request = lookup_line_request (self, container,
+                                 priv->width_requests,
+                                 for_height,
+                                 priv->row_height,
+                                 &found);
+  if (found)
+    priv->col_width = request->line_cell_size;
+  else
+    compute_preferred_width (self, container, for_height, request);
+
+  return request;
+}
+
+static void
+clutter_flow_layout_get_preferred_width (ClutterLayoutManager *manager,
+                                         ClutterContainer     *container,
+                                         gfloat                for_height,
+                                         gfloat               *min_width_p,
+                                         gfloat               *nat_width_p)
+{
+  FlowLineRequest *request;
+
+  request = get_width_request (CLUTTER_FLOW_LAYOUT (manager),
+                               container,
+                               for_height);
 
   if (min_width_p)
-    *min_width_p = max_min_width;
+    *min_width_p = request->min_size;
 
   if (nat_width_p)
-    *nat_width_p = total_natural_width;
+    *nat_width_p = request->natural_size;
 }
 
 static void
-clutter_flow_layout_get_preferred_height (ClutterLayoutManager *manager,
-                                          ClutterContainer     *container,
-                                          gfloat                for_width,
-                                          gfloat               *min_height_p,
-                                          gfloat               *nat_height_p)
+compute_preferred_height (ClutterFlowLayout *self,
+                          ClutterContainer  *container,
+                          gfloat             for_width,
+                          FlowLineRequest   *request)
 {
-  ClutterFlowLayoutPrivate *priv = CLUTTER_FLOW_LAYOUT (manager)->priv;
+  ClutterFlowLayoutPrivate *priv = self->priv;
   gint n_columns, line_item_count, line_count;
   gfloat total_min_height, total_natural_height;
   gfloat line_min_height, line_natural_height;
@@ -390,7 +509,7 @@ clutter_flow_layout_get_preferred_height (ClutterLayoutManager *manager,
   ClutterActorIter iter;
   gfloat item_x;
 
-  n_columns = get_columns (CLUTTER_FLOW_LAYOUT (manager), for_width);
+  n_columns = get_columns (self, for_width);
 
   total_min_height = 0;
   total_natural_height = 0;
@@ -405,20 +524,6 @@ clutter_flow_layout_get_preferred_height (ClutterLayoutManager *manager,
 
   actor = CLUTTER_ACTOR (container);
 
-  /* clear the line height arrays */
-  if (priv->line_min != NULL)
-    g_array_free (priv->line_min, TRUE);
-
-  if (priv->line_natural != NULL)
-    g_array_free (priv->line_natural, TRUE);
-
-  priv->line_min = g_array_sized_new (FALSE, FALSE,
-                                      sizeof (gfloat),
-                                      16);
-  priv->line_natural = g_array_sized_new (FALSE, FALSE,
-                                          sizeof (gfloat),
-                                          16);
-
   if (clutter_actor_get_n_children (actor) != 0)
     line_count = 1;
 
@@ -445,9 +550,9 @@ clutter_flow_layout_get_preferred_height (ClutterLayoutManager *manager,
               total_min_height += line_min_height;
               total_natural_height += line_natural_height;
 
-              g_array_append_val (priv->line_min,
+              g_array_append_val (request->line_min,
                                   line_min_height);
-              g_array_append_val (priv->line_natural,
+              g_array_append_val (request->line_natural,
                                   line_natural_height);
 
               line_min_height = line_natural_height = 0;
@@ -514,18 +619,17 @@ clutter_flow_layout_get_preferred_height (ClutterLayoutManager *manager,
           total_min_height += line_min_height;
           total_natural_height += line_natural_height;
 
-          g_array_append_val (priv->line_min,
+          g_array_append_val (request->line_min,
                               line_min_height);
-          g_array_append_val (priv->line_natural,
+          g_array_append_val (request->line_natural,
                               line_natural_height);
         }
 
-      priv->line_count = line_count;
-      if (priv->line_count > 0)
+      if (line_count > 0)
         {
           gfloat total_spacing;
 
-          total_spacing = priv->row_spacing * (priv->line_count - 1);
+          total_spacing = priv->row_spacing * (line_count - 1);
 
           total_min_height += total_spacing;
           total_natural_height += total_spacing;
@@ -533,16 +637,14 @@ clutter_flow_layout_get_preferred_height (ClutterLayoutManager *manager,
     }
   else
     {
-      g_array_append_val (priv->line_min, line_min_height);
-      g_array_append_val (priv->line_natural, line_natural_height);
-
-      priv->line_count = line_count;
+      g_array_append_val (request->line_min, line_min_height);
+      g_array_append_val (request->line_natural, line_natural_height);
 
-      if (priv->line_count > 0)
+      if (line_count > 0)
         {
           gfloat total_spacing;
 
-          total_spacing = priv->col_spacing * priv->line_count;
+          total_spacing = priv->col_spacing * line_count;
 
           total_min_height += total_spacing;
           total_natural_height += total_spacing;
@@ -551,18 +653,57 @@ clutter_flow_layout_get_preferred_height (ClutterLayoutManager *manager,
 
   CLUTTER_NOTE (LAYOUT,
                 "Flow[h]: %d lines (%d per line): w [ %.2f, %.2f ] for h %.2f",
-                n_columns, priv->line_count,
+                n_columns, line_count,
                 total_min_height,
                 total_natural_height,
                 for_width);
 
-  priv->req_width = for_width;
+  request->min_size = max_min_height;
+  request->natural_size = total_natural_height;
+  request->line_cell_size = priv->row_height;
+  request->line_count = line_count;
+}
+
+static FlowLineRequest *
+get_height_request (ClutterFlowLayout *self,
+                    ClutterContainer  *container,
+                    gfloat             for_width)
+{
+  ClutterFlowLayoutPrivate *priv = self->priv;
+  FlowLineRequest *request;
+  gboolean found;
+
+  request = lookup_line_request (self, container,
+                                 priv->height_requests,
+                                 for_width,
+                                 priv->col_width,
+                                 &found);
+  if (found)
+    priv->row_height = request->line_cell_size;
+  else
+    compute_preferred_height (self, container, for_width, request);
+
+  return request;
+}
+
+static void
+clutter_flow_layout_get_preferred_height (ClutterLayoutManager *manager,
+                                          ClutterContainer     *container,
+                                          gfloat                for_width,
+                                          gfloat               *min_height_p,
+                                          gfloat               *nat_height_p)
+{
+  FlowLineRequest *request;
+
+  request = get_height_request (CLUTTER_FLOW_LAYOUT (manager),
+                                container,
+                                for_width);
 
   if (min_height_p)
-    *min_height_p = max_min_height;
+    *min_height_p = request->min_size;
 
   if (nat_height_p)
-    *nat_height_p = total_natural_height;
+    *nat_height_p = request->natural_size;
 }
 
 static void
@@ -571,7 +712,9 @@ clutter_flow_layout_allocate (ClutterLayoutManager   *manager,
                               const ClutterActorBox  *allocation,
                               ClutterAllocationFlags  flags)
 {
-  ClutterFlowLayoutPrivate *priv = CLUTTER_FLOW_LAYOUT (manager)->priv;
+  ClutterFlowLayout *self = CLUTTER_FLOW_LAYOUT (manager);
+  ClutterFlowLayoutPrivate *priv = self->priv;
+  FlowLineRequest *width_request, *height_request, *lines;
   ClutterActor *actor, *child;
   ClutterActorIter iter;
   gfloat x_off, y_off;
@@ -588,23 +731,18 @@ clutter_flow_layout_allocate (ClutterLayoutManager   *manager,
   clutter_actor_box_get_origin (allocation, &x_off, &y_off);
   clutter_actor_box_get_size (allocation, &avail_width, &avail_height);
 
-  /* blow the cached preferred size and re-compute with the given
-   * available size in case the FlowLayout wasn't given the exact
-   * size it requested
+  /* the lines for the available size; these are usually the ones
+   * computed when the container was asked for its preferred size
    */
-  if ((priv->req_width >= 0 && avail_width != priv->req_width) ||
-      (priv->req_height >= 0 && avail_height != priv->req_height))
-    {
-      clutter_flow_layout_get_preferred_width (manager, container,
-                                               avail_height,
-                                               NULL, NULL);
-      clutter_flow_layout_get_preferred_height (manager, container,
-                                                avail_width,
-                                                NULL, NULL);
-    }
+  width_request = get_width_request (self, container, avail_height);
+  height_request = get_height_request (self, container, avail_width);
 
-  items_per_line = compute_lines (CLUTTER_FLOW_LAYOUT (manager),
-                                  avail_width, avail_height);
+  if (priv->orientation == CLUTTER_FLOW_HORIZONTAL)
+    lines = height_request;
+  else
+    lines = width_request;
+
+  items_per_line = compute_lines (self, avail_width, avail_height);
 
   item_x = x_off;
   item_y = y_off;
@@ -637,7 +775,7 @@ clutter_flow_layout_allocate (ClutterLayoutManager   *manager,
                line_item_count == items_per_line && line_item_count > 0) ||
               (!priv->snap_to_grid && item_x + item_width > avail_width))
             {
-              item_y += g_array_index (priv->line_natural,
+              item_y += g_array_index (lines->line_natural,
                                        gfloat,
                                        line_index);
 
@@ -661,7 +799,7 @@ clutter_flow_layout_allocate (ClutterLayoutManager   *manager,
               new_x = item_x + item_width + priv->col_spacing;
             }
 
-          item_height = g_array_index (priv->line_natural,
+          item_height = g_array_index (lines->line_natural,
                                        gfloat,
                                        line_index);
 
@@ -672,7 +810,7 @@ clutter_flow_layout_allocate (ClutterLayoutManager   *manager,
                line_item_count == items_per_line && line_item_count > 0) ||
               (!priv->snap_to_grid && item_y + item_height > avail_height))
             {
-              item_x += g_array_index (priv->line_natural,
+              item_x += g_array_index (lines->line_natural,
                                        gfloat,
                                        line_index);
 
@@ -696,7 +834,7 @@ clutter_flow_layout_allocate (ClutterLayoutManager   *manager,
               new_y = item_y + item_height + priv->row_spacing;
             }
 
-          item_width = g_array_index (priv->line_natural,
+          item_width = g_array_index (lines->line_natural,
                                       gfloat,
                                       line_index);
         }
@@ -751,6 +889,8 @@ clutter_flow_layout_set_container (ClutterLayoutManager *manager,
 
   priv->container = container;
 
+  invalidate_line_requests (CLUTTER_FLOW_LAYOUT (manager));
+
   if (priv->container != NULL)
     {
       ClutterRequestMode request_mode;
@@ -886,16 +1026,25 @@ static void
 clutter_flow_layout_finalize (GObject *gobject)
 {
   ClutterFlowLayoutPrivate *priv = CLUTTER_FLOW_LAYOUT (gobject)->priv;
+  gint i;
 
-  if (priv->line_min != NULL)
-    g_array_free (priv->line_min, TRUE);
-
-  if (priv->line_natural != NULL)
-    g_array_free (priv->line_natural, TRUE);
+  for (i = 0; i < N_CACHED_LINE_REQUESTS; i++)
+    {
+      g_array_unref (priv->width_requests[i].line_min);
+      g_array_unref (priv->width_requests[i].line_natural);
+      g_array_unref (priv->height_requests[i].line_min);
+      g_array_unref (priv->height_requests[i].line_natural);
+    }
 
   G_OBJECT_CLASS (clutter_flow_layout_parent_class)->finalize (gobject);
 }
 
+static void
+clutter_flow_layout_layout_changed (ClutterLayoutManager *manager)
+{
+  invalidate_line_requests (CLUTTER_FLOW_LAYOUT (manager));
+}
+
 static void
 clutter_flow_layout_class_init (ClutterFlowLayoutClass *klass)
 {
@@ -911,6 +1060,7 @@ clutter_flow_layout_class_init (ClutterFlowLayoutClass *klass)
     clutter_flow_layout_get_preferred_height;
   layout_class->allocate = clutter_flow_layout_allocate;
   layout_class->set_container = clutter_flow_layout_set_container;
+  layout_class->layout_changed = clutter_flow_layout_layout_changed;
 
   /**
    * ClutterFlowLayout:orientation:
@@ -1068,6 +1218,7 @@ static void
 clutter_flow_layout_init (ClutterFlowLayout *self)
 {
   ClutterFlowLayoutPrivate *priv;
+  gint i;
 
   self->priv = priv = clutter_flow_layout_get_instance_private (self);
 
@@ -1079,9 +1230,19 @@ clutter_flow_layout_init (ClutterFlowLayout *self)
   priv->min_col_width = priv->min_row_height = 0;
   priv->max_col_width = priv->max_row_height = -1;
 
-  priv->line_min = NULL;
-  priv->line_natural = NULL;
   priv->snap_to_grid = TRUE;
+
+  for (i = 0; i < N_CACHED_LINE_REQUESTS; i++)
+    {
+      priv->width_requests[i].line_min =
+        g_array_sized_new (FALSE, FALSE, sizeof (gfloat), 16);
+      priv->width_requests[i].line_natural =
+        g_array_sized_new (FALSE, FALSE, sizeof (gfloat), 16);
+      priv->height_requests[i].line_min =
+        g_array_sized_new (FALSE, FALSE, sizeof (gfloat), 16);
+      priv->height_requests[i].line_natural =
+        g_array_sized_new (FALSE, FALSE, sizeof (gfloat), 16);
+    }
 }
 
 /**
@@ -93,6 +93,7 @@
 #include "clutter-enum-types.h"
 #include "clutter-marshal.h"
 #include "clutter-private.h"
+#include "clutter-stage-private.h"
 
 #include <math.h>
 
@@ -121,7 +122,7 @@ struct _ClutterGestureActionPrivate
   GArray *points;
 
   guint actor_capture_id;
-  gulong stage_capture_id;
+  guint stage_capture_id;
 
   ClutterGestureTriggerEdge edge;
   float distance_x, distance_y;
@@ -157,7 +158,7 @@ static guint gesture_signals[LAST_SIGNAL] = { 0, };
 G_DEFINE_TYPE_WITH_PRIVATE (ClutterGestureAction, clutter_gesture_action, CLUTTER_TYPE_ACTION)
 
 static GesturePoint *
-gesture_register_point (ClutterGestureAction *action, ClutterEvent *event)
+gesture_register_point (ClutterGestureAction *action, const ClutterEvent *event)
 {
   ClutterGestureActionPrivate *priv = action->priv;
   GesturePoint *point = NULL;
@@ -189,7 +190,7 @@ gesture_register_point (ClutterGestureAction *action, ClutterEvent *event)
 
 static GesturePoint *
 gesture_find_point (ClutterGestureAction *action,
-                    ClutterEvent *event,
+                    const ClutterEvent *event,
                     gint *position)
 {
   ClutterGestureActionPrivate *priv = action->priv;
@@ -231,8 +232,8 @@ gesture_unregister_point (ClutterGestureAction *action, gint position)
 }
 
 static void
-gesture_update_motion_point (GesturePoint *point,
-                             ClutterEvent *event)
+gesture_update_motion_point (GesturePoint       *point,
+                             const ClutterEvent *event)
 {
   gfloat motion_x, motion_y;
   gint64 _time;
@@ -253,8 +254,8 @@ gesture_update_motion_point (GesturePoint *point,
 }
 
 static void
-gesture_update_release_point (GesturePoint *point,
-                              ClutterEvent *event)
+gesture_update_release_point (GesturePoint       *point,
+                              const ClutterEvent *event)
 {
   gint64 _time;
 
@@ -282,7 +283,7 @@ gesture_get_default_threshold (void)
 static gboolean
 gesture_point_pass_threshold (ClutterGestureAction *action,
                               GesturePoint         *point,
-                              ClutterEvent         *event)
+                              const ClutterEvent   *event)
 {
   float threshold_x, threshold_y;
   gfloat motion_x, motion_y;
@@ -312,7 +313,8 @@ cancel_gesture (ClutterGestureAction *action)
 
   if (priv->stage_capture_id != 0)
     {
-      g_signal_handler_disconnect (priv->stage, priv->stage_capture_id);
+      _clutter_stage_remove_event_handler (CLUTTER_STAGE (priv->stage),
+                                           priv->stage_capture_id);
       priv->stage_capture_id = 0;
     }
 
@@ -354,11 +356,19 @@ begin_gesture (ClutterGestureAction *action,
   return TRUE;
 }
 
+/* the events tracked on the stage during a gesture */
+#define GESTURE_EVENT_MASK      (CLUTTER_STAGE_EVENT_MASK (CLUTTER_MOTION) | \
+                                 CLUTTER_STAGE_EVENT_MASK (CLUTTER_BUTTON_RELEASE) | \
+                                 CLUTTER_STAGE_EVENT_MASK (CLUTTER_TOUCH_UPDATE) | \
+                                 CLUTTER_STAGE_EVENT_MASK (CLUTTER_TOUCH_END) | \
+                                 CLUTTER_STAGE_EVENT_MASK (CLUTTER_TOUCH_CANCEL))
+
 static gboolean
-stage_captured_event_cb (ClutterActor         *stage,
-                         ClutterEvent         *event,
-                         ClutterGestureAction *action)
+stage_captured_event_cb (ClutterStage       *stage,
+                         const ClutterEvent *event,
+                         gpointer            user_data)
 {
+  ClutterGestureAction *action = user_data;
   ClutterGestureActionPrivate *priv = action->priv;
   ClutterActor *actor;
   gint position;
@@ -485,7 +495,8 @@ stage_captured_event_cb (ClutterActor         *stage,
 
   if (priv->points->len == 0 && priv->stage_capture_id)
     {
-      g_signal_handler_disconnect (priv->stage, priv->stage_capture_id);
+      _clutter_stage_remove_event_handler (CLUTTER_STAGE (priv->stage),
+                                           priv->stage_capture_id);
       priv->stage_capture_id = 0;
     }
 
@@ -514,9 +525,10 @@ actor_captured_event_cb (ClutterActor *actor,
 
   if (priv->stage_capture_id == 0)
     priv->stage_capture_id =
-      g_signal_connect_after (priv->stage, "captured-event",
-                              G_CALLBACK (stage_captured_event_cb),
-                              action);
+      _clutter_stage_add_event_handler (CLUTTER_STAGE (priv->stage),
+                                        GESTURE_EVENT_MASK,
+                                        stage_captured_event_cb,
+                                        action);
 
   /* Start the gesture immediately if the gesture has no
    * _TRIGGER_EDGE_AFTER drag threshold. */
@@ -548,7 +560,8 @@ clutter_gesture_action_set_actor (ClutterActorMeta *meta,
   if (priv->stage_capture_id != 0)
     {
       if (priv->stage != NULL)
-        g_signal_handler_disconnect (priv->stage, priv->stage_capture_id);
+        _clutter_stage_remove_event_handler (CLUTTER_STAGE (priv->stage),
+                                             priv->stage_capture_id);
 
       priv->stage_capture_id = 0;
       priv->stage = NULL;
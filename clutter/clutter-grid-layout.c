@@ -75,6 +75,7 @@ typedef struct _ClutterGridLine         ClutterGridLine;
 typedef struct _ClutterGridLines        ClutterGridLines;
 typedef struct _ClutterGridLineData     ClutterGridLineData;
 typedef struct _ClutterGridRequest      ClutterGridRequest;
+typedef struct _ClutterGridItem         ClutterGridItem;
 
 
 struct _ClutterGridAttach
@@ -104,17 +105,6 @@ struct _ClutterGridLineData
   guint homogeneous : 1;
 };
 
-struct _ClutterGridLayoutPrivate
-{
-  ClutterContainer *container;
-  ClutterOrientation orientation;
-
-  ClutterGridLineData linedata[2];
-};
-
-#define ROWS(priv)    (&(priv)->linedata[CLUTTER_ORIENTATION_HORIZONTAL])
-#define COLUMNS(priv) (&(priv)->linedata[CLUTTER_ORIENTATION_VERTICAL])
-
 /* A ClutterGridLine struct represents a single row or column
  * during size requests
  */
@@ -136,12 +126,55 @@ struct _ClutterGridLines
   gint min, max;
 };
 
+/* A ClutterGridItem struct represents a child of the grid
+ * and its attachment during size requests
+ */
+struct _ClutterGridItem
+{
+  ClutterActor *actor;
+  ClutterGridChild *grid_child;
+};
+
 struct _ClutterGridRequest
 {
   ClutterGridLayout *grid;
   ClutterGridLines lines[2];
+
+  ClutterGridItem *items;
+  gint n_items;
 };
 
+struct _ClutterGridLayoutPrivate
+{
+  ClutterContainer *container;
+  ClutterOrientation orientation;
+
+  ClutterGridLineData linedata[2];
+
+  /* the children of the container and the lines they span are
+   * kept between size requests, until the children layout age of
+   * the container changes or the layout manager is changed
+   */
+  GArray *items;
+  guint children_layout_age;
+
+  /* the requests of the lines that do not depend on the size of
+   * the lines in the other orientation
+   */
+  ClutterGridLines base_lines[2];
+
+  guint items_valid : 1;
+  guint base_valid[2];
+
+  /* whether all the children have a fixed size, in which case
+   * the requests of the lines never depend on the other orientation
+   */
+  guint fixed_size[2];
+};
+
+#define ROWS(priv)    (&(priv)->linedata[CLUTTER_ORIENTATION_HORIZONTAL])
+#define COLUMNS(priv) (&(priv)->linedata[CLUTTER_ORIENTATION_VERTICAL])
+
 enum
 {
   PROP_0,
@@ -200,6 +233,8 @@ grid_attach (ClutterGridLayout *self,
   CHILD_TOP (grid_child) = top;
   CHILD_WIDTH (grid_child) = width;
   CHILD_HEIGHT (grid_child) = height;
+
+  self->priv->items_valid = FALSE;
 }
 
 /* Find the position 'touching' existing
@@ -340,13 +375,13 @@ grid_attach_next_to (ClutterGridLayout   *layout,
 }
 
 static void
-clutter_grid_request_update_child_attach (ClutterGridRequest *request,
-                                          ClutterActor       *actor)
+clutter_grid_layout_update_child_attach (ClutterGridLayout *self,
+                                         ClutterActor      *actor)
 {
-  ClutterGridLayoutPrivate *priv = request->grid->priv;
+  ClutterGridLayoutPrivate *priv = self->priv;
   ClutterGridChild *grid_child;
 
-  grid_child = GET_GRID_CHILD (request->grid, actor);
+  grid_child = GET_GRID_CHILD (self, actor);
 
   if (CHILD_LEFT (grid_child) == -1 || CHILD_TOP (grid_child) == -1)
     {
@@ -372,57 +407,118 @@ clutter_grid_request_update_child_attach (ClutterGridRequest *request,
 
       sibling = clutter_actor_get_previous_sibling (actor);
       if (sibling)
-        clutter_grid_layout_insert_next_to (request->grid, sibling, side);
-      grid_attach_next_to (request->grid, actor, sibling, side,
+        clutter_grid_layout_insert_next_to (self, sibling, side);
+      grid_attach_next_to (self, actor, sibling, side,
                            CHILD_WIDTH (grid_child),
                            CHILD_HEIGHT (grid_child));
     }
 }
 
 static void
-clutter_grid_request_update_attach (ClutterGridRequest *request)
+clutter_grid_layout_update_attach (ClutterGridLayout *self)
 {
-  ClutterGridLayoutPrivate *priv = request->grid->priv;
+  ClutterGridLayoutPrivate *priv = self->priv;
   ClutterActorIter iter;
   ClutterActor *child;
 
   clutter_actor_iter_init (&iter, CLUTTER_ACTOR (priv->container));
   while (clutter_actor_iter_next (&iter, &child))
-    clutter_grid_request_update_child_attach (request, child);
+    clutter_grid_layout_update_child_attach (self, child);
 }
 
-/* Calculates the min and max numbers for both orientations.
+/* Collects the children of the grid and calculates the min
+ * and max numbers for both orientations, unless the children
+ * did not change since the last time.
  */
 static void
-clutter_grid_request_count_lines (ClutterGridRequest *request)
+clutter_grid_layout_ensure_items (ClutterGridLayout *self)
 {
-  ClutterGridLayoutPrivate *priv = request->grid->priv;
-  ClutterGridChild *grid_child;
+  ClutterGridLayoutPrivate *priv = self->priv;
+  ClutterActor *container = CLUTTER_ACTOR (priv->container);
   ClutterGridAttach *attach;
   ClutterActorIter iter;
   ClutterActor *child;
   gint min[2];
   gint max[2];
+  gint i;
+
+  if (priv->items_valid &&
+      priv->children_layout_age == _clutter_actor_get_children_layout_age (container))
+    return;
+
+  /* placing the children without an attachment may insert rows
+   * or columns, so it has to happen before collecting them
+   */
+  clutter_grid_layout_update_attach (self);
+
+  g_array_set_size (priv->items, 0);
 
   min[0] = min[1] = G_MAXINT;
   max[0] = max[1] = G_MININT;
 
-  clutter_actor_iter_init (&iter, CLUTTER_ACTOR (priv->container));
+  priv->fixed_size[0] = priv->fixed_size[1] = TRUE;
+
+  clutter_actor_iter_init (&iter, container);
   while (clutter_actor_iter_next (&iter, &child))
     {
-      grid_child = GET_GRID_CHILD (request->grid, child);
-      attach = grid_child->attach;
+      ClutterGridItem item;
+
+      item.actor = child;
+      item.grid_child = GET_GRID_CHILD (self, child);
+      g_array_append_val (priv->items, item);
+
+      attach = item.grid_child->attach;
 
       min[0] = MIN (min[0], attach[0].pos);
       max[0] = MAX (max[0], attach[0].pos + attach[0].span);
       min[1] = MIN (min[1], attach[1].pos);
       max[1] = MAX (max[1], attach[1].pos + attach[1].span);
+
+      for (i = 0; i < 2; i++)
+        {
+          if (!_clutter_actor_has_fixed_size (child, i))
+            priv->fixed_size[i] = FALSE;
+        }
+    }
+
+  if (priv->items->len == 0)
+    min[0] = min[1] = max[0] = max[1] = 0;
+
+  for (i = 0; i < 2; i++)
+    {
+      ClutterGridLines *lines = &priv->base_lines[i];
+
+      lines->min = min[i];
+      lines->max = max[i];
+      lines->lines = g_renew (ClutterGridLine, lines->lines, max[i] - min[i]);
+
+      priv->base_valid[i] = FALSE;
     }
 
-  request->lines[0].min = min[0];
-  request->lines[0].max = max[0];
-  request->lines[1].min = min[1];
-  request->lines[1].max = max[1];
+  priv->children_layout_age = _clutter_actor_get_children_layout_age (container);
+  priv->items_valid = TRUE;
+}
+
+/* Sets up the children and the min and max numbers of @request
+ * from the state kept by the grid; the lines have to be allocated
+ * by the caller.
+ */
+static void
+clutter_grid_request_setup (ClutterGridRequest *request,
+                            ClutterGridLayout  *self)
+{
+  ClutterGridLayoutPrivate *priv = self->priv;
+
+  clutter_grid_layout_ensure_items (self);
+
+  request->grid = self;
+  request->items = (ClutterGridItem *) priv->items->data;
+  request->n_items = priv->items->len;
+
+  request->lines[0].min = priv->base_lines[0].min;
+  request->lines[0].max = priv->base_lines[0].max;
+  request->lines[1].min = priv->base_lines[1].min;
+  request->lines[1].max = priv->base_lines[1].max;
 }
 
 /* Sets line sizes to 0 and marks lines as expand
@@ -432,12 +528,9 @@ static void
 clutter_grid_request_init (ClutterGridRequest *request,
                            ClutterOrientation  orientation)
 {
-  ClutterGridLayoutPrivate *priv = request->grid->priv;
-  ClutterGridChild *grid_child;
+  ClutterGridItem *item;
   ClutterGridAttach *attach;
   ClutterGridLines *lines;
-  ClutterActorIter iter;
-  ClutterActor *child;
   gint i;
 
   lines = &request->lines[orientation];
@@ -449,12 +542,11 @@ clutter_grid_request_init (ClutterGridRequest *request,
       lines->lines[i].expand = FALSE;
     }
 
-  clutter_actor_iter_init (&iter, CLUTTER_ACTOR (priv->container));
-  while (clutter_actor_iter_next (&iter, &child))
+  for (i = 0; i < request->n_items; i++)
     {
-      grid_child = GET_GRID_CHILD (request->grid, child);
-      attach = &grid_child->attach[orientation];
-      if (attach->span == 1 && clutter_actor_needs_expand (child, orientation))
+      item = &request->items[i];
+      attach = &item->grid_child->attach[orientation];
+      if (attach->span == 1 && clutter_actor_needs_expand (item->actor, orientation))
         lines->lines[attach->pos - lines->min].expand = TRUE;
     }
 }
@@ -463,11 +555,10 @@ clutter_grid_request_init (ClutterGridRequest *request,
  */
 static gfloat
 compute_allocation_for_child (ClutterGridRequest *request,
-                              ClutterActor       *child,
+                              ClutterGridItem    *item,
                               ClutterOrientation  orientation)
 {
   ClutterGridLayoutPrivate *priv = request->grid->priv;
-  ClutterGridChild *grid_child;
   ClutterGridLineData *linedata;
   ClutterGridLines *lines;
   ClutterGridLine *line;
@@ -475,10 +566,9 @@ compute_allocation_for_child (ClutterGridRequest *request,
   gfloat size;
   gint i;
 
-  grid_child = GET_GRID_CHILD (request->grid, child);
   linedata = &priv->linedata[orientation];
   lines = &request->lines[orientation];
-  attach = &grid_child->attach[orientation];
+  attach = &item->grid_child->attach[orientation];
 
   size = (attach->span - 1) * linedata->spacing;
   for (i = 0; i < attach->span; i++)
@@ -492,17 +582,19 @@ compute_allocation_for_child (ClutterGridRequest *request,
 
 static void
 compute_request_for_child (ClutterGridRequest *request,
-                           ClutterActor       *child,
+                           ClutterGridItem    *item,
                            ClutterOrientation  orientation,
                            gboolean            contextual,
                            gfloat             *minimum,
                            gfloat             *natural)
 {
+  ClutterActor *child = item->actor;
+
   if (contextual)
     {
       gfloat size;
 
-      size = compute_allocation_for_child (request, child, 1 - orientation);
+      size = compute_allocation_for_child (request, item, 1 - orientation);
       if (orientation == CLUTTER_ORIENTATION_HORIZONTAL)
         clutter_actor_get_preferred_width (child, size, minimum, natural);
       else
@@ -526,31 +618,27 @@ clutter_grid_request_non_spanning (ClutterGridRequest *request,
                                    ClutterOrientation  orientation,
                                    gboolean            contextual)
 {
-  ClutterGridLayoutPrivate *priv = request->grid->priv;
-  ClutterGridChild *grid_child;
+  ClutterGridItem *item;
   ClutterGridAttach *attach;
   ClutterGridLines *lines;
   ClutterGridLine *line;
-  ClutterActorIter iter;
-  ClutterActor *child;
   gfloat minimum;
   gfloat natural;
+  gint i;
 
   lines = &request->lines[orientation];
 
-  clutter_actor_iter_init (&iter, CLUTTER_ACTOR (priv->container));
-  while (clutter_actor_iter_next (&iter, &child))
+  for (i = 0; i < request->n_items; i++)
     {
-      if (!clutter_actor_is_visible (child))
+      item = &request->items[i];
+      if (!clutter_actor_is_visible (item->actor))
         continue;
 
-      grid_child = GET_GRID_CHILD (request->grid, child);
-
-      attach = &grid_child->attach[orientation];
+      attach = &item->grid_child->attach[orientation];
       if (attach->span != 1)
         continue;
 
-      compute_request_for_child (request, child, orientation, contextual, &minimum, &natural);
+      compute_request_for_child (request, item, orientation, contextual, &minimum, &natural);
 
       line = &lines->lines[attach->pos - lines->min];
       line->minimum = MAX (line->minimum, minimum);
@@ -602,9 +690,7 @@ clutter_grid_request_spanning (ClutterGridRequest *request,
                                gboolean            contextual)
 {
   ClutterGridLayoutPrivate *priv = request->grid->priv;
-  ClutterGridChild *grid_child;
-  ClutterActor *child;
-  ClutterActorIter iter;
+  ClutterGridItem *item;
   ClutterGridAttach *attach;
   ClutterGridLineData *linedata;
   ClutterGridLines *lines;
@@ -618,24 +704,22 @@ clutter_grid_request_spanning (ClutterGridRequest *request,
   gint extra;
   gint expand;
   gint line_extra;
-  gint i;
+  gint i, n;
 
   linedata = &priv->linedata[orientation];
   lines = &request->lines[orientation];
 
-  clutter_actor_iter_init (&iter, CLUTTER_ACTOR (priv->container));
-  while (clutter_actor_iter_next (&iter, &child))
+  for (n = 0; n < request->n_items; n++)
     {
-      if (!clutter_actor_is_visible (child))
+      item = &request->items[n];
+      if (!clutter_actor_is_visible (item->actor))
         continue;
 
-      grid_child = GET_GRID_CHILD (request->grid, child);
-
-      attach = &grid_child->attach[orientation];
+      attach = &item->grid_child->attach[orientation];
       if (attach->span == 1)
         continue;
 
-      compute_request_for_child (request, child, orientation, contextual,
+      compute_request_for_child (request, item, orientation, contextual,
                                  &minimum, &natural);
 
       span_minimum = (attach->span - 1) * linedata->spacing;
@@ -739,12 +823,9 @@ clutter_grid_request_compute_expand (ClutterGridRequest *request,
                                      gint               *nonempty_lines,
                                      gint               *expand_lines)
 {
-  ClutterGridLayoutPrivate *priv = request->grid->priv;
-  ClutterGridChild *grid_child;
+  ClutterGridItem *item;
   ClutterGridAttach *attach;
-  ClutterActorIter iter;
-  ClutterActor *child;
-  gint i;
+  gint i, n;
   ClutterGridLines *lines;
   ClutterGridLine *line;
   gboolean has_expand;
@@ -760,34 +841,30 @@ clutter_grid_request_compute_expand (ClutterGridRequest *request,
       lines->lines[i].empty = TRUE;
     }
 
-  clutter_actor_iter_init (&iter, CLUTTER_ACTOR (priv->container));
-  while (clutter_actor_iter_next (&iter, &child))
+  for (n = 0; n < request->n_items; n++)
     {
-      if (!clutter_actor_is_visible (child))
+      item = &request->items[n];
+      if (!clutter_actor_is_visible (item->actor))
         continue;
 
-      grid_child = GET_GRID_CHILD (request->grid, child);
-
-      attach = &grid_child->attach[orientation];
+      attach = &item->grid_child->attach[orientation];
       if (attach->span != 1)
         continue;
 
       line = &lines->lines[attach->pos - lines->min];
       line->empty = FALSE;
-      if (clutter_actor_needs_expand (child, orientation))
+      if (clutter_actor_needs_expand (item->actor, orientation))
         line->expand = TRUE;
     }
 
 
-  clutter_actor_iter_init (&iter, CLUTTER_ACTOR (priv->container));
-  while (clutter_actor_iter_next (&iter, &child))
+  for (n = 0; n < request->n_items; n++)
     {
-      if (!clutter_actor_is_visible (child))
+      item = &request->items[n];
+      if (!clutter_actor_is_visible (item->actor))
         continue;
 
-      grid_child = GET_GRID_CHILD (request->grid, child);
-
-      attach = &grid_child->attach[orientation];
+      attach = &item->grid_child->attach[orientation];
       if (attach->span == 1)
         continue;
 
@@ -800,7 +877,7 @@ clutter_grid_request_compute_expand (ClutterGridRequest *request,
             has_expand = TRUE;
         }
 
-      if (!has_expand && clutter_actor_needs_expand (child, orientation))
+      if (!has_expand && clutter_actor_needs_expand (item->actor, orientation))
         {
           for (i = 0; i < attach->span; i++)
             {
@@ -890,6 +967,48 @@ clutter_grid_request_run (ClutterGridRequest *request,
   clutter_grid_request_homogeneous (request, orientation);
 }
 
+/* Computes minimum and natural fields of lines without
+ * requiring the allocation of the lines in the opposite
+ * orientation, reusing the results of the previous run
+ * if the children did not change since.
+ */
+static void
+clutter_grid_request_run_base (ClutterGridRequest *request,
+                               ClutterOrientation  orientation)
+{
+  ClutterGridLayoutPrivate *priv = request->grid->priv;
+  ClutterGridLines *lines = &request->lines[orientation];
+  ClutterGridLines *base = &priv->base_lines[orientation];
+  gsize size = (lines->max - lines->min) * sizeof (ClutterGridLine);
+
+  if (!priv->base_valid[orientation])
+    {
+      clutter_grid_request_run (request, orientation, FALSE);
+
+      memcpy (base->lines, lines->lines, size);
+      priv->base_valid[orientation] = TRUE;
+    }
+  else
+    memcpy (lines->lines, base->lines, size);
+}
+
+/* Computes minimum and natural fields of lines for the
+ * allocation of the lines in the opposite orientation;
+ * if all the children have a fixed size, the allocation
+ * does not matter and the children are not measured again.
+ */
+static void
+clutter_grid_request_run_contextual (ClutterGridRequest *request,
+                                     ClutterOrientation  orientation)
+{
+  ClutterGridLayoutPrivate *priv = request->grid->priv;
+
+  if (priv->fixed_size[orientation])
+    clutter_grid_request_run_base (request, orientation);
+  else
+    clutter_grid_request_run (request, orientation, TRUE);
+}
+
 typedef struct _RequestedSize
 {
   gpointer data;
@@ -1269,6 +1388,7 @@ clutter_grid_layout_set_container (ClutterLayoutManager *self,
   ClutterLayoutManagerClass *parent_class;
 
   priv->container = container;
+  priv->items_valid = FALSE;
 
   if (priv->container != NULL)
     {
@@ -1299,9 +1419,7 @@ clutter_grid_layout_get_size_for_size (ClutterGridLayout  *self,
   ClutterGridLines *lines;
   float min_size, nat_size;
 
-  request.grid = self;
-  clutter_grid_request_update_attach (&request);
-  clutter_grid_request_count_lines (&request);
+  clutter_grid_request_setup (&request, self);
 
   lines = &request.lines[0];
   lines->lines = g_newa (ClutterGridLine, lines->max - lines->min);
@@ -1311,11 +1429,11 @@ clutter_grid_layout_get_size_for_size (ClutterGridLayout  *self,
   lines->lines = g_newa (ClutterGridLine, lines->max - lines->min);
   memset (lines->lines, 0, (lines->max - lines->min) * sizeof (ClutterGridLine));
 
-  clutter_grid_request_run (&request, 1 - orientation, FALSE);
+  clutter_grid_request_run_base (&request, 1 - orientation);
   clutter_grid_request_sum (&request, 1 - orientation, &min_size, &nat_size);
   clutter_grid_request_allocate (&request, 1 - orientation, MAX (size, nat_size));
 
-  clutter_grid_request_run (&request, orientation, TRUE);
+  clutter_grid_request_run_contextual (&request, orientation);
   clutter_grid_request_sum (&request, orientation, minimum, natural);
 }
 
@@ -1400,13 +1518,10 @@ clutter_grid_layout_allocate (ClutterLayoutManager   *layout,
   ClutterOrientation orientation;
   ClutterGridRequest request;
   ClutterGridLines *lines;
-  ClutterActorIter iter;
-  ClutterActor *child;
+  gint i;
 
-  request.grid = self;
+  clutter_grid_request_setup (&request, self);
 
-  clutter_grid_request_update_attach (&request);
-  clutter_grid_request_count_lines (&request);
   lines = &request.lines[0];
   lines->lines = g_newa (ClutterGridLine, lines->max - lines->min);
   memset (lines->lines, 0, (lines->max - lines->min) * sizeof (ClutterGridLine));
@@ -1419,26 +1534,25 @@ clutter_grid_layout_allocate (ClutterLayoutManager   *layout,
   else
     orientation = CLUTTER_ORIENTATION_VERTICAL;
 
-  clutter_grid_request_run (&request, 1 - orientation, FALSE);
+  clutter_grid_request_run_base (&request, 1 - orientation);
   clutter_grid_request_allocate (&request, 1 - orientation, GET_SIZE (allocation, 1 - orientation));
-  clutter_grid_request_run (&request, orientation, TRUE);
+  clutter_grid_request_run_contextual (&request, orientation);
 
   clutter_grid_request_allocate (&request, orientation, GET_SIZE (allocation, orientation));
 
   clutter_grid_request_position (&request, 0);
   clutter_grid_request_position (&request, 1);
 
-  clutter_actor_iter_init (&iter, CLUTTER_ACTOR (container));
-  while (clutter_actor_iter_next (&iter, &child))
+  for (i = 0; i < request.n_items; i++)
     {
+      ClutterActor *child = request.items[i].actor;
+      ClutterGridChild *grid_child = request.items[i].grid_child;
       ClutterActorBox child_allocation;
       gfloat x, y, width, height;
-      ClutterGridChild *grid_child;
 
       if (!clutter_actor_is_visible (child))
         continue;
 
-      grid_child = GET_GRID_CHILD (self, child);
       allocate_child (&request, CLUTTER_ORIENTATION_HORIZONTAL, grid_child,
                       &x, &width);
       allocate_child (&request, CLUTTER_ORIENTATION_VERTICAL, grid_child,
@@ -1465,6 +1579,27 @@ clutter_grid_layout_get_child_meta_type (ClutterLayoutManager *self)
   return CLUTTER_TYPE_GRID_CHILD;
 }
 
+static void
+clutter_grid_layout_layout_changed (ClutterLayoutManager *manager)
+{
+  ClutterGridLayoutPrivate *priv = CLUTTER_GRID_LAYOUT (manager)->priv;
+
+  /* the attachments, spacing or homogeneity changed */
+  priv->items_valid = FALSE;
+}
+
+static void
+clutter_grid_layout_finalize (GObject *gobject)
+{
+  ClutterGridLayoutPrivate *priv = CLUTTER_GRID_LAYOUT (gobject)->priv;
+
+  g_array_unref (priv->items);
+  g_free (priv->base_lines[0].lines);
+  g_free (priv->base_lines[1].lines);
+
+  G_OBJECT_CLASS (clutter_grid_layout_parent_class)->finalize (gobject);
+}
+
 static void
 clutter_grid_layout_set_property (GObject      *gobject,
                                   guint         prop_id,
@@ -1549,12 +1684,14 @@ clutter_grid_layout_class_init (ClutterGridLayoutClass *klass)
 
   object_class->set_property = clutter_grid_layout_set_property;
   object_class->get_property = clutter_grid_layout_get_property;
+  object_class->finalize = clutter_grid_layout_finalize;
 
   layout_class->set_container = clutter_grid_layout_set_container;
   layout_class->get_preferred_width = clutter_grid_layout_get_preferred_width;
   layout_class->get_preferred_height = clutter_grid_layout_get_preferred_height;
   layout_class->allocate = clutter_grid_layout_allocate;
   layout_class->get_child_meta_type = clutter_grid_layout_get_child_meta_type;
+  layout_class->layout_changed = clutter_grid_layout_layout_changed;
 
   /**
    * ClutterGridLayout:orientation:
@@ -1643,6 +1780,8 @@ clutter_grid_layout_init (ClutterGridLayout *self)
 
   self->priv->linedata[0].homogeneous = FALSE;
   self->priv->linedata[1].homogeneous = FALSE;
+
+  self->priv->items = g_array_new (FALSE, FALSE, sizeof (ClutterGridItem));
 }
 
 /**
@@ -0,0 +1,649 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* ClutterKineticScroller computes the motion of a scrolled area after
+ * a fling, independently on each axis.
+ *
+ * The motion is a closed-form function of the time elapsed since the
+ * fling, so the position on each frame only depends on the time of the
+ * frame, and not on the number or the rate of the previous frames:
+ *
+ *  - the velocity decays exponentially, v(t) = v0 * exp (-t / tau), so
+ *    the position is x(t) = x0 + v0 * tau * (1 - exp (-t / tau)); the
+ *    motion ends when the velocity drops below a minimum;
+ *  - when the motion crosses one of the bounds, it continues with a
+ *    critically damped spring anchored at the bound, with the velocity
+ *    the motion had when crossing it; the displacement from the bound
+ *    is d(t) = (a + b * t) * exp (-omega * t), which overshoots once
+ *    and settles without oscillating;
+ *  - with a snap interval, the initial velocity is adjusted so that the
+ *    motion ends on the multiple of the interval closest to where it
+ *    would have ended.
+ *
+ * The initial velocity is estimated from the samples of the drag with
+ * a least squares fit over a short window, which is less sensitive to
+ * the noise of the last motion event than the delta of the last two.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <math.h>
+
+#include "clutter-kinetic-scroller.h"
+
+#include "clutter-debug.h"
+#include "clutter-private.h"
+
+/* the velocity under which the motion stops, in px/ms */
+#define MIN_VELOCITY            0.1
+
+/* the stiffness of the spring at the bounds, in 1/ms */
+#define SPRING_OMEGA            0.012
+
+/* the maximum distance the motion overshoots a bound */
+#define MAX_OVERSHOOT           120.0
+
+/* the resistance applied when dragging past a bound */
+#define RUBBER_BAND_COEFF       0.55
+
+/* the distance from its rest position under which a spring stops */
+#define REST_DISTANCE           0.5
+
+/* the samples used to estimate the velocity; times are in ms */
+#define N_SAMPLES               20
+#define VELOCITY_WINDOW         100
+#define VELOCITY_MAX_IDLE       50
+
+typedef enum
+{
+  AXIS_IDLE,
+  AXIS_DECAY,
+  AXIS_SPRING
+} AxisPhase;
+
+typedef struct _Axis
+{
+  AxisPhase phase;
+
+  /* the time the current phase started, in ms since the fling */
+  gdouble start;
+
+  /* decay: the position and the velocity at the start of the phase;
+   * spring: the rest position; idle: the final position
+   */
+  gdouble origin;
+  gdouble velocity;
+
+  /* decay: the duration of the phase, and the position at its end */
+  gdouble duration;
+  gdouble target;
+  gboolean bounce;
+
+  /* spring: d(t) = (a + b * t) * exp (-omega * t) */
+  gdouble omega;
+  gdouble a, b;
+
+  gfloat min, max;
+  gfloat snap;
+} Axis;
+
+typedef struct _Sample
+{
+  guint32 time;
+  gfloat x;
+  gfloat y;
+} Sample;
+
+struct _ClutterKineticScroller
+{
+  Axis axes[2];
+
+  /* the time constant of the decay, in ms */
+  gdouble tau;
+
+  gint64 start_time;
+
+  Sample samples[N_SAMPLES];
+  guint first_sample;
+  guint n_samples;
+};
+
+ClutterKineticScroller *
+_clutter_kinetic_scroller_new (void)
+{
+  ClutterKineticScroller *scroller;
+  guint i;
+
+  scroller = g_slice_new0 (ClutterKineticScroller);
+
+  for (i = 0; i < G_N_ELEMENTS (scroller->axes); i++)
+    {
+      scroller->axes[i].phase = AXIS_IDLE;
+      scroller->axes[i].min = -G_MAXFLOAT;
+      scroller->axes[i].max = G_MAXFLOAT;
+    }
+
+  _clutter_kinetic_scroller_set_deceleration (scroller, 0.95);
+
+  return scroller;
+}
+
+void
+_clutter_kinetic_scroller_free (ClutterKineticScroller *scroller)
+{
+  if (scroller == NULL)
+    return;
+
+  g_slice_free (ClutterKineticScroller, scroller);
+}
+
+/*< private >
+ * _clutter_kinetic_scroller_set_deceleration:
+ * @scroller: a #ClutterKineticScroller
+ * @rate: the factor the velocity is multiplied by every 60th of a
+ *   second, between 0 and 1
+ *
+ * Sets the rate of the deceleration after a fling.
+ */
+void
+_clutter_kinetic_scroller_set_deceleration (ClutterKineticScroller *scroller,
+                                            gdouble                 rate)
+{
+  /* tau = 1000ms / (frame_per_second * - ln (decay_per_frame)); with
+   * frame_per_second = 60 and decay_per_frame = 0.95, tau ~= 325ms
+   */
+  if (rate >= 1.0)
+    scroller->tau = G_MAXDOUBLE;
+  else
+    scroller->tau = 1000.0 / (60.0 * -log (MAX (rate, 1e-6)));
+}
+
+/*< private >
+ * _clutter_kinetic_scroller_set_bounds:
+ * @scroller: a #ClutterKineticScroller
+ * @min_x: the minimum position on the X axis
+ * @min_y: the minimum position on the Y axis
+ * @max_x: the maximum position on the X axis
+ * @max_y: the maximum position on the Y axis
+ *
+ * Sets the range of the positions the motion can rest at.
+ */
+void
+_clutter_kinetic_scroller_set_bounds (ClutterKineticScroller *scroller,
+                                      gfloat                  min_x,
+                                      gfloat                  min_y,
+                                      gfloat                  max_x,
+                                      gfloat                  max_y)
+{
+  scroller->axes[0].min = min_x;
+  scroller->axes[0].max = MAX (min_x, max_x);
+  scroller->axes[1].min = min_y;
+  scroller->axes[1].max = MAX (min_y, max_y);
+}
+
+/*< private >
+ * _clutter_kinetic_scroller_set_snap_interval:
+ * @scroller: a #ClutterKineticScroller
+ * @interval_x: the interval between the snap points on the X axis,
+ *   or 0 to disable snapping
+ * @interval_y: the interval between the snap points on the Y axis,
+ *   or 0 to disable snapping
+ *
+ * Sets the interval between the positions a fling ends at.
+ */
+void
+_clutter_kinetic_scroller_set_snap_interval (ClutterKineticScroller *scroller,
+                                             gfloat                  interval_x,
+                                             gfloat                  interval_y)
+{
+  scroller->axes[0].snap = MAX (interval_x, 0.f);
+  scroller->axes[1].snap = MAX (interval_y, 0.f);
+}
+
+void
+_clutter_kinetic_scroller_reset_samples (ClutterKineticScroller *scroller)
+{
+  scroller->first_sample = 0;
+  scroller->n_samples = 0;
+}
+
+/*< private >
+ * _clutter_kinetic_scroller_add_sample:
+ * @scroller: a #ClutterKineticScroller
+ * @time_: the time of the sample, in milliseconds
+ * @x: the X coordinate of the pointer
+ * @y: the Y coordinate of the pointer
+ *
+ * Records a position of the pointer during a drag, to estimate its
+ * velocity at the time of the release.
+ */
+void
+_clutter_kinetic_scroller_add_sample (ClutterKineticScroller *scroller,
+                                      guint32                 time_,
+                                      gfloat                  x,
+                                      gfloat                  y)
+{
+  Sample *sample;
+
+  if (scroller->n_samples > 0)
+    {
+      sample = &scroller->samples[(scroller->first_sample + scroller->n_samples - 1) % N_SAMPLES];
+
+      /* out of order */
+      if ((gint32) (time_ - sample->time) < 0)
+        return;
+
+      if (time_ == sample->time)
+        {
+          sample->x = x;
+          sample->y = y;
+          return;
+        }
+    }
+
+  if (scroller->n_samples == N_SAMPLES)
+    {
+      scroller->first_sample = (scroller->first_sample + 1) % N_SAMPLES;
+      scroller->n_samples -= 1;
+    }
+
+  sample = &scroller->samples[(scroller->first_sample + scroller->n_samples) % N_SAMPLES];
+  sample->time = time_;
+  sample->x = x;
+  sample->y = y;
+
+  scroller->n_samples += 1;
+}
+
+/*< private >
+ * _clutter_kinetic_scroller_get_velocity:
+ * @scroller: a #ClutterKineticScroller
+ * @time_: the time of the release, in milliseconds
+ * @velocity_x: (out): return location for the velocity on the X axis
+ * @velocity_y: (out): return location for the velocity on the Y axis
+ *
+ * Estimates the velocity of the pointer at @time_, in pixels per
+ * millisecond, from the samples recorded in the preceding window. The
+ * velocity is zero if the pointer was held still before the release.
+ *
+ * Return value: %TRUE if there were enough samples for an estimate
+ */
+gboolean
+_clutter_kinetic_scroller_get_velocity (ClutterKineticScroller *scroller,
+                                        guint32                 time_,
+                                        gfloat                 *velocity_x,
+                                        gfloat                 *velocity_y)
+{
+  const Sample *last;
+  gdouble mean_t, mean_x, mean_y;
+  gdouble var_t, cov_x, cov_y;
+  guint i, n;
+
+  if (scroller->n_samples < 2)
+    return FALSE;
+
+  last = &scroller->samples[(scroller->first_sample + scroller->n_samples - 1) % N_SAMPLES];
+
+  if ((gint32) (time_ - last->time) > VELOCITY_MAX_IDLE)
+    {
+      *velocity_x = *velocity_y = 0.f;
+      return TRUE;
+    }
+
+  /* least squares fit of the samples in the window, with the times
+   * relative to the last sample
+   */
+  mean_t = mean_x = mean_y = 0.0;
+  for (i = 0, n = 0; i < scroller->n_samples; i++)
+    {
+      const Sample *sample = &scroller->samples[(scroller->first_sample + i) % N_SAMPLES];
+      gint32 age = (gint32) (last->time - sample->time);
+
+      if (age > VELOCITY_WINDOW)
+        continue;
+
+      mean_t -= age;
+      mean_x += sample->x;
+      mean_y += sample->y;
+      n += 1;
+    }
+
+  if (n < 2)
+    return FALSE;
+
+  mean_t /= n;
+  mean_x /= n;
+  mean_y /= n;
+
+  var_t = cov_x = cov_y = 0.0;
+  for (i = 0; i < scroller->n_samples; i++)
+    {
+      const Sample *sample = &scroller->samples[(scroller->first_sample + i) % N_SAMPLES];
+      gint32 age = (gint32) (last->time - sample->time);
+      gdouble dt;
+
+      if (age > VELOCITY_WINDOW)
+        continue;
+
+      dt = -age - mean_t;
+      var_t += dt * dt;
+      cov_x += dt * (sample->x - mean_x);
+      cov_y += dt * (sample->y - mean_y);
+    }
+
+  if (var_t < 1.0)
+    return FALSE;
+
+  *velocity_x = cov_x / var_t;
+  *velocity_y = cov_y / var_t;
+
+  return TRUE;
+}
+
+static gdouble
+axis_rubber_band (const Axis *axis,
+                  gdouble     position)
+{
+  gdouble excess, bound;
+
+  if (position < axis->min)
+    {
+      bound = axis->min;
+      excess = axis->min - position;
+    }
+  else if (position > axis->max)
+    {
+      bound = axis->max;
+      excess = position - axis->max;
+    }
+  else
+    return position;
+
+  /* the resisted excess tends towards MAX_OVERSHOOT */
+  excess = MAX_OVERSHOOT * (1.0 - 1.0 / (excess * RUBBER_BAND_COEFF / MAX_OVERSHOOT + 1.0));
+
+  return position < axis->min ? bound - excess : bound + excess;
+}
+
+/*< private >
+ * _clutter_kinetic_scroller_constrain:
+ * @scroller: a #ClutterKineticScroller
+ * @x: (inout): the X coordinate of a position
+ * @y: (inout): the Y coordinate of a position
+ *
+ * Applies the resistance to the drag past the bounds to a position.
+ */
+void
+_clutter_kinetic_scroller_constrain (ClutterKineticScroller *scroller,
+                                     gfloat                 *x,
+                                     gfloat                 *y)
+{
+  *x = axis_rubber_band (&scroller->axes[0], *x);
+  *y = axis_rubber_band (&scroller->axes[1], *y);
+}
+
+static void
+axis_start_spring (Axis    *axis,
+                   gdouble  start,
+                   gdouble  rest,
+                   gdouble  displacement,
+                   gdouble  velocity)
+{
+  axis->phase = AXIS_SPRING;
+  axis->start = start;
+  axis->origin = rest;
+
+  /* a critically damped spring launched from its rest position with
+   * the velocity v peaks at v / (omega * e); stiffen the spring for
+   * the fast flings, so that they do not overshoot too far
+   */
+  axis->omega = SPRING_OMEGA;
+  if (displacement == 0.0)
+    axis->omega = MAX (axis->omega, fabs (velocity) / (G_E * MAX_OVERSHOOT));
+
+  axis->a = displacement;
+  axis->b = velocity + axis->omega * displacement;
+}
+
+static gdouble
+axis_snap_point (const Axis *axis,
+                 gdouble     position)
+{
+  gdouble snapped;
+
+  snapped = floor (position / axis->snap + 0.5) * axis->snap;
+
+  return CLAMP (snapped, axis->min, axis->max);
+}
+
+static void
+axis_fling (Axis    *axis,
+            gdouble  tau,
+            gdouble  position,
+            gdouble  velocity)
+{
+  gdouble distance;
+
+  axis->start = 0.0;
+  axis->bounce = FALSE;
+
+  /* released past a bound: spring back */
+  if (position < axis->min || position > axis->max)
+    {
+      gdouble bound = position < axis->min ? axis->min : axis->max;
+
+      axis_start_spring (axis, 0.0, bound, position - bound, velocity);
+      return;
+    }
+
+  if (fabs (velocity) < MIN_VELOCITY || tau == G_MAXDOUBLE)
+    {
+      gdouble snapped = position;
+
+      if (axis->snap > 0.f)
+        snapped = axis_snap_point (axis, position);
+
+      if (fabs (snapped - position) > REST_DISTANCE)
+        axis_start_spring (axis, 0.0, snapped, position - snapped, velocity);
+      else
+        {
+          axis->phase = AXIS_IDLE;
+          axis->origin = snapped;
+        }
+
+      return;
+    }
+
+  /* the velocity reaches MIN_VELOCITY after tau * ln (|v0| / MIN_VELOCITY) */
+  axis->duration = tau * log (fabs (velocity) / MIN_VELOCITY);
+  distance = velocity * tau * (1.0 - MIN_VELOCITY / fabs (velocity));
+
+  axis->phase = AXIS_DECAY;
+  axis->origin = position;
+  axis->velocity = velocity;
+  axis->target = position + distance;
+
+  if (axis->snap > 0.f)
+    {
+      /* land on the snap point closest to the natural end of the
+       * motion, in the same amount of time
+       */
+      axis->target = axis_snap_point (axis, axis->target);
+      axis->velocity = (axis->target - position)
+                     / (tau * (1.0 - exp (-axis->duration / tau)));
+    }
+  else if (axis->target > axis->max || axis->target < axis->min)
+    {
+      gdouble bound = axis->target > axis->max ? axis->max : axis->min;
+
+      /* solve x(t) = bound for the time the motion crosses the bound */
+      axis->duration = -tau * log (1.0 - (bound - position) / (velocity * tau));
+      axis->target = bound;
+      axis->bounce = TRUE;
+    }
+}
+
+static gboolean
+axis_evaluate (Axis    *axis,
+               gdouble  tau,
+               gdouble  t,
+               gdouble *position)
+{
+  gdouble elapsed;
+
+  while (TRUE)
+    {
+      elapsed = MAX (t - axis->start, 0.0);
+
+      switch (axis->phase)
+        {
+        case AXIS_IDLE:
+          *position = axis->origin;
+          return FALSE;
+
+        case AXIS_DECAY:
+          if (elapsed < axis->duration)
+            {
+              *position = axis->origin
+                        + axis->velocity * tau * (1.0 - exp (-elapsed / tau));
+              return TRUE;
+            }
+
+          if (axis->bounce)
+            {
+              gdouble velocity;
+
+              velocity = axis->velocity * exp (-axis->duration / tau);
+              axis_start_spring (axis,
+                                 axis->start + axis->duration,
+                                 axis->target,
+                                 0.0,
+                                 velocity);
+              continue;
+            }
+
+          axis->phase = AXIS_IDLE;
+          axis->origin = axis->target;
+          break;
+
+        case AXIS_SPRING:
+          {
+            gdouble decay = exp (-axis->omega * elapsed);
+            gdouble displacement, velocity;
+
+            displacement = (axis->a + axis->b * elapsed) * decay;
+            velocity = (axis->b - axis->omega * (axis->a + axis->b * elapsed)) * decay;
+
+            if (elapsed > 0.0 &&
+                fabs (displacement) < REST_DISTANCE &&
+                fabs (velocity) < MIN_VELOCITY)
+              {
+                axis->phase = AXIS_IDLE;
+                break;
+              }
+
+            *position = axis->origin + displacement;
+            return TRUE;
+          }
+        }
+    }
+}
+
+/*< private >
+ * _clutter_kinetic_scroller_fling:
+ * @scroller: a #ClutterKineticScroller
+ * @start_time: the time of the fling, in microseconds
+ * @x: the X coordinate of the position at @start_time
+ * @y: the Y coordinate of the position at @start_time
+ * @velocity_x: the velocity on the X axis, in pixels per millisecond
+ * @velocity_y: the velocity on the Y axis, in pixels per millisecond
+ *
+ * Starts the motion after a fling. The position is then retrieved for
+ * each frame with _clutter_kinetic_scroller_evaluate().
+ *
+ * Return value: %TRUE if there is a motion, and %FALSE if the position
+ *   is already at rest
+ */
+gboolean
+_clutter_kinetic_scroller_fling (ClutterKineticScroller *scroller,
+                                 gint64                  start_time,
+                                 gfloat                  x,
+                                 gfloat                  y,
+                                 gfloat                  velocity_x,
+                                 gfloat                  velocity_y)
+{
+  scroller->start_time = start_time;
+
+  axis_fling (&scroller->axes[0], scroller->tau, x, velocity_x);
+  axis_fling (&scroller->axes[1], scroller->tau, y, velocity_y);
+
+  CLUTTER_NOTE (EVENT, "Kinetic fling from %.2f, %.2f at %.3f, %.3f px/ms",
+                x, y,
+                velocity_x, velocity_y);
+
+  return _clutter_kinetic_scroller_is_running (scroller);
+}
+
+/*< private >
+ * _clutter_kinetic_scroller_evaluate:
+ * @scroller: a #ClutterKineticScroller
+ * @time_: the time of the frame, in microseconds
+ * @x: (out): return location for the X coordinate of the position
+ * @y: (out): return location for the Y coordinate of the position
+ *
+ * Computes the position of the motion at @time_.
+ *
+ * Return value: %TRUE if the motion continues after @time_, and %FALSE
+ *   if the position is the final one
+ */
+gboolean
+_clutter_kinetic_scroller_evaluate (ClutterKineticScroller *scroller,
+                                    gint64                  time_,
+                                    gfloat                 *x,
+                                    gfloat                 *y)
+{
+  gdouble t, position_x, position_y;
+  gboolean running;
+
+  t = (time_ - scroller->start_time) / 1000.0;
+
+  running = axis_evaluate (&scroller->axes[0], scroller->tau, t, &position_x);
+  running |= axis_evaluate (&scroller->axes[1], scroller->tau, t, &position_y);
+
+  *x = position_x;
+  *y = position_y;
+
+  return running;
+}
+
+void
+_clutter_kinetic_scroller_stop (ClutterKineticScroller *scroller)
+{
+  scroller->axes[0].phase = AXIS_IDLE;
+  scroller->axes[1].phase = AXIS_IDLE;
+}
+
+gboolean
+_clutter_kinetic_scroller_is_running (ClutterKineticScroller *scroller)
+{
+  return scroller->axes[0].phase != AXIS_IDLE ||
+         scroller->axes[1].phase != AXIS_IDLE;
+}
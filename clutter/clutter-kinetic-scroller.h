@@ -0,0 +1,74 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ClutterKineticScroller: the physics of kinetic scrolling.
+ */
+
+#ifndef __CLUTTER_KINETIC_SCROLLER_H__
+#define __CLUTTER_KINETIC_SCROLLER_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef struct _ClutterKineticScroller  ClutterKineticScroller;
+
+ClutterKineticScroller *        _clutter_kinetic_scroller_new                   (void);
+void                            _clutter_kinetic_scroller_free                  (ClutterKineticScroller *scroller);
+
+void                            _clutter_kinetic_scroller_set_deceleration      (ClutterKineticScroller *scroller,
+                                                                                 gdouble                 rate);
+void                            _clutter_kinetic_scroller_set_bounds            (ClutterKineticScroller *scroller,
+                                                                                 gfloat                  min_x,
+                                                                                 gfloat                  min_y,
+                                                                                 gfloat                  max_x,
+                                                                                 gfloat                  max_y);
+void                            _clutter_kinetic_scroller_set_snap_interval     (ClutterKineticScroller *scroller,
+                                                                                 gfloat                  interval_x,
+                                                                                 gfloat                  interval_y);
+
+void                            _clutter_kinetic_scroller_reset_samples         (ClutterKineticScroller *scroller);
+void                            _clutter_kinetic_scroller_add_sample            (ClutterKineticScroller *scroller,
+                                                                                 guint32                 time_,
+                                                                                 gfloat                  x,
+                                                                                 gfloat                  y);
+gboolean                        _clutter_kinetic_scroller_get_velocity          (ClutterKineticScroller *scroller,
+                                                                                 guint32                 time_,
+                                                                                 gfloat                 *velocity_x,
+                                                                                 gfloat                 *velocity_y);
+
+void                            _clutter_kinetic_scroller_constrain             (ClutterKineticScroller *scroller,
+                                                                                 gfloat                 *x,
+                                                                                 gfloat                 *y);
+
+gboolean                        _clutter_kinetic_scroller_fling                 (ClutterKineticScroller *scroller,
+                                                                                 gint64                  start_time,
+                                                                                 gfloat                  x,
+                                                                                 gfloat                  y,
+                                                                                 gfloat                  velocity_x,
+                                                                                 gfloat                  velocity_y);
+gboolean                        _clutter_kinetic_scroller_evaluate              (ClutterKineticScroller *scroller,
+                                                                                 gint64                  time_,
+                                                                                 gfloat                 *x,
+                                                                                 gfloat                 *y);
+void                            _clutter_kinetic_scroller_stop                  (ClutterKineticScroller *scroller);
+gboolean                        _clutter_kinetic_scroller_is_running            (ClutterKineticScroller *scroller);
+
+G_END_DECLS
+
+#endif /* __CLUTTER_KINETIC_SCROLLER_H__ */
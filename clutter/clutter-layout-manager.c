@@ -85,6 +85,21 @@
  * #ClutterContainer using the #ClutterLayoutManager, and `actor` is
  * the #ClutterActor child of the #ClutterContainer.
  *
+ * ## Animating the layout
+ *
+ * The allocation of the children of a container is animated if the
+ * children have an easing state with a non-zero duration when the
+ * layout manager allocates them, for instance by using
+ * clutter_actor_save_easing_state() and clutter_actor_set_easing_duration()
+ * inside the #ClutterLayoutManagerClass.allocate() virtual function.
+ *
+ * By default, each frame of the animation lays out the children of
+ * the animated actors again, at their intermediate size. Layout managers
+ * with clutter_layout_manager_set_layout_only_animations() enabled only
+ * interpolate the allocation of their children between the start and
+ * the end of the animation, and lay out the children of the animated
+ * actors once, at the end.
+ *
  * ## Using ClutterLayoutManager with ClutterScript
  *
  * #ClutterLayoutManager instances can be created in the same way
@@ -167,6 +182,17 @@ G_DEFINE_ABSTRACT_TYPE (ClutterLayoutManager,
 
 static GQuark quark_layout_meta  = 0;
 static GQuark quark_layout_alpha = 0;
+static GQuark quark_layout_changed_freeze = 0;
+static GQuark quark_layout_only_animations = 0;
+
+/* the state of clutter_layout_manager_freeze_layout_changed() */
+typedef struct _LayoutChangedFreeze
+{
+  guint level;
+
+  /* whether the layout changed while frozen */
+  guint pending : 1;
+} LayoutChangedFreeze;
 
 static guint manager_signals[LAST_SIGNAL] = { 0, };
 
@@ -399,6 +425,12 @@ clutter_layout_manager_class_init (ClutterLayoutManagerClass *klass)
   quark_layout_alpha =
     g_quark_from_static_string ("clutter-layout-manager-alpha");
 
+  quark_layout_changed_freeze =
+    g_quark_from_static_string ("clutter-layout-manager-changed-freeze");
+
+  quark_layout_only_animations =
+    g_quark_from_static_string ("clutter-layout-manager-layout-only-animations");
+
   klass->get_preferred_width = layout_manager_real_get_preferred_width;
   klass->get_preferred_height = layout_manager_real_get_preferred_height;
   klass->allocate = layout_manager_real_allocate;
@@ -570,17 +602,155 @@ clutter_layout_manager_allocate (ClutterLayoutManager   *manager,
 void
 clutter_layout_manager_layout_changed (ClutterLayoutManager *manager)
 {
+  LayoutChangedFreeze *freeze;
   gpointer is_frozen;
 
   g_return_if_fail (CLUTTER_IS_LAYOUT_MANAGER (manager));
 
   is_frozen = g_object_get_data (G_OBJECT (manager), "freeze-change");
-  if (is_frozen == NULL)
-    g_signal_emit (manager, manager_signals[LAYOUT_CHANGED], 0);
-  else
-    CLUTTER_NOTE (LAYOUT, "Layout manager '%s'[%p] has been frozen",
-                  G_OBJECT_TYPE_NAME (manager),
-                  manager);
+  if (is_frozen != NULL)
+    {
+      CLUTTER_NOTE (LAYOUT, "Layout manager '%s'[%p] has been frozen",
+                    G_OBJECT_TYPE_NAME (manager),
+                    manager);
+      return;
+    }
+
+  freeze = g_object_get_qdata (G_OBJECT (manager), quark_layout_changed_freeze);
+  if (freeze != NULL)
+    {
+      freeze->pending = TRUE;
+      return;
+    }
+
+  g_signal_emit (manager, manager_signals[LAYOUT_CHANGED], 0);
+}
+
+/**
+ * clutter_layout_manager_freeze_layout_changed:
+ * @manager: a #ClutterLayoutManager
+ *
+ * Delays the emission of the #ClutterLayoutManager::layout-changed
+ * signal until clutter_layout_manager_thaw_layout_changed() is called,
+ * so that changing the layout properties of many children of a
+ * container queues a single relayout.
+ *
+ * Calls to this function can be nested; the signal is emitted by the
+ * last call to clutter_layout_manager_thaw_layout_changed(), only if
+ * the layout changed in the meantime.
+ *
+ * Since: 1.28
+ */
+void
+clutter_layout_manager_freeze_layout_changed (ClutterLayoutManager *manager)
+{
+  LayoutChangedFreeze *freeze;
+
+  g_return_if_fail (CLUTTER_IS_LAYOUT_MANAGER (manager));
+
+  freeze = g_object_get_qdata (G_OBJECT (manager), quark_layout_changed_freeze);
+  if (freeze == NULL)
+    {
+      freeze = g_slice_new0 (LayoutChangedFreeze);
+      g_object_set_qdata (G_OBJECT (manager), quark_layout_changed_freeze, freeze);
+    }
+
+  freeze->level += 1;
+}
+
+/**
+ * clutter_layout_manager_thaw_layout_changed:
+ * @manager: a #ClutterLayoutManager
+ *
+ * Reverts the effect of a previous call to
+ * clutter_layout_manager_freeze_layout_changed(), emitting the
+ * #ClutterLayoutManager::layout-changed signal if the layout of
+ * @manager changed while it was frozen.
+ *
+ * Since: 1.28
+ */
+void
+clutter_layout_manager_thaw_layout_changed (ClutterLayoutManager *manager)
+{
+  LayoutChangedFreeze *freeze;
+  gboolean pending;
+
+  g_return_if_fail (CLUTTER_IS_LAYOUT_MANAGER (manager));
+
+  freeze = g_object_get_qdata (G_OBJECT (manager), quark_layout_changed_freeze);
+  if (freeze == NULL)
+    {
+      g_critical (G_STRLOC ": Mismatched thaw; you have to call "
+                  "clutter_layout_manager_freeze_layout_changed() prior to "
+                  "calling clutter_layout_manager_thaw_layout_changed()");
+      return;
+    }
+
+  freeze->level -= 1;
+  if (freeze->level > 0)
+    return;
+
+  pending = freeze->pending;
+
+  g_object_set_qdata (G_OBJECT (manager), quark_layout_changed_freeze, NULL);
+  g_slice_free (LayoutChangedFreeze, freeze);
+
+  if (pending)
+    clutter_layout_manager_layout_changed (manager);
+}
+
+/**
+ * clutter_layout_manager_set_layout_only_animations:
+ * @manager: a #ClutterLayoutManager
+ * @layout_only: whether the animations of the allocations of the
+ *   children only interpolate their allocation
+ *
+ * Sets whether the animations of the allocation of the children of
+ * the container using @manager only interpolate their allocation.
+ *
+ * The start and end allocations of the children are computed once
+ * by @manager, and each frame of the animation sets the interpolated
+ * allocation of the children without requesting their size or laying
+ * out their own children; the children are laid out at the end of the
+ * animation. The duration, mode and delay of the animations are
+ * controlled by the easing state of the children.
+ *
+ * This is useful for animating a container with many children, or
+ * with children that are expensive to lay out, at the cost of not
+ * updating the layout of the children while they are animated.
+ *
+ * Since: 1.28
+ */
+void
+clutter_layout_manager_set_layout_only_animations (ClutterLayoutManager *manager,
+                                                   gboolean              layout_only)
+{
+  g_return_if_fail (CLUTTER_IS_LAYOUT_MANAGER (manager));
+
+  g_object_set_qdata (G_OBJECT (manager), quark_layout_only_animations,
+                      GINT_TO_POINTER (!!layout_only));
+}
+
+/**
+ * clutter_layout_manager_get_layout_only_animations:
+ * @manager: a #ClutterLayoutManager
+ *
+ * Retrieves whether the animations of the allocations of the children
+ * only interpolate their allocation.
+ *
+ * See clutter_layout_manager_set_layout_only_animations().
+ *
+ * Return value: %TRUE if the animations are layout-only
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_layout_manager_get_layout_only_animations (ClutterLayoutManager *manager)
+{
+  g_return_val_if_fail (CLUTTER_IS_LAYOUT_MANAGER (manager), FALSE);
+
+  return GPOINTER_TO_INT (g_object_get_qdata (G_OBJECT (manager),
+                                              quark_layout_only_animations));
 }
 
 /**
@@ -702,10 +872,8 @@ clutter_layout_manager_get_child_meta (ClutterLayoutManager *manager,
 }
 
 static inline gboolean
-layout_set_property_internal (ClutterLayoutManager *manager,
-                              GObject              *gobject,
-                              GParamSpec           *pspec,
-                              const GValue         *value)
+layout_property_is_writable (ClutterLayoutManager *manager,
+                             GParamSpec           *pspec)
 {
   if (pspec->flags & G_PARAM_CONSTRUCT_ONLY)
     {
@@ -723,6 +891,18 @@ layout_set_property_internal (ClutterLayoutManager *manager,
       return FALSE;
     }
 
+  return TRUE;
+}
+
+static inline gboolean
+layout_set_property_internal (ClutterLayoutManager *manager,
+                              GObject              *gobject,
+                              GParamSpec           *pspec,
+                              const GValue         *value)
+{
+  if (!layout_property_is_writable (manager, pspec))
+    return FALSE;
+
   g_object_set_property (gobject, pspec->name, value);
 
   return TRUE;
@@ -791,6 +971,9 @@ clutter_layout_manager_child_set (ClutterLayoutManager *manager,
 
   klass = G_OBJECT_GET_CLASS (meta);
 
+  /* setting many properties only changes the layout once */
+  clutter_layout_manager_freeze_layout_changed (manager);
+
   va_start (var_args, first_property);
 
   pname = first_property;
@@ -834,6 +1017,8 @@ clutter_layout_manager_child_set (ClutterLayoutManager *manager,
     }
 
   va_end (var_args);
+
+  clutter_layout_manager_thaw_layout_changed (manager);
 }
 
 /**
@@ -889,6 +1074,105 @@ clutter_layout_manager_child_set_property (ClutterLayoutManager *manager,
   layout_set_property_internal (manager, G_OBJECT (meta), pspec, value);
 }
 
+/**
+ * clutter_layout_manager_children_set_property:
+ * @manager: a #ClutterLayoutManager
+ * @container: a #ClutterContainer using @manager
+ * @actors: (array length=n_actors): children of @container
+ * @n_actors: the number of children in @actors
+ * @pspec: the #GParamSpec of the layout property to set, as returned
+ *   by clutter_layout_manager_find_child_property()
+ * @value: a #GValue with the value of the property to set
+ *
+ * Sets a property on the #ClutterLayoutMeta created by @manager for
+ * each of the @actors.
+ *
+ * Unlike clutter_layout_manager_child_set_property(), the property is
+ * looked up once by the caller and can be reused for any number of
+ * calls; @value is converted once for all the children, and the
+ * #ClutterLayoutManager::layout-changed signal is emitted at most once.
+ *
+ * Since: 1.28
+ */
+void
+clutter_layout_manager_children_set_property (ClutterLayoutManager *manager,
+                                              ClutterContainer     *container,
+                                              ClutterActor * const *actors,
+                                              guint                 n_actors,
+                                              GParamSpec           *pspec,
+                                              const GValue         *value)
+{
+  GValue real_value = G_VALUE_INIT;
+  GType meta_type;
+  guint i;
+
+  g_return_if_fail (CLUTTER_IS_LAYOUT_MANAGER (manager));
+  g_return_if_fail (CLUTTER_IS_CONTAINER (container));
+  g_return_if_fail (actors != NULL || n_actors == 0);
+  g_return_if_fail (G_IS_PARAM_SPEC (pspec));
+  g_return_if_fail (G_IS_VALUE (value));
+
+  meta_type = _clutter_layout_manager_get_child_meta_type (manager);
+  if (meta_type == G_TYPE_INVALID ||
+      !g_type_is_a (meta_type, pspec->owner_type))
+    {
+      g_warning ("%s: Layout managers of type '%s' have no layout "
+                 "property named '%s'",
+                 G_STRLOC, G_OBJECT_TYPE_NAME (manager), pspec->name);
+      return;
+    }
+
+  if (!layout_property_is_writable (manager, pspec))
+    return;
+
+  g_value_init (&real_value, G_PARAM_SPEC_VALUE_TYPE (pspec));
+  if (!g_value_transform (value, &real_value))
+    {
+      g_warning ("%s: Unable to convert a value of type '%s' into the "
+                 "type '%s' of the layout property '%s'",
+                 G_STRLOC,
+                 G_VALUE_TYPE_NAME (value),
+                 g_type_name (G_PARAM_SPEC_VALUE_TYPE (pspec)),
+                 pspec->name);
+      g_value_unset (&real_value);
+      return;
+    }
+
+  if (g_param_value_validate (pspec, &real_value) &&
+      !(pspec->flags & G_PARAM_LAX_VALIDATION))
+    {
+      g_warning ("%s: The value is out of range for the layout "
+                 "property '%s' of type '%s'",
+                 G_STRLOC,
+                 pspec->name,
+                 g_type_name (G_PARAM_SPEC_VALUE_TYPE (pspec)));
+      g_value_unset (&real_value);
+      return;
+    }
+
+  clutter_layout_manager_freeze_layout_changed (manager);
+
+  /* the value has already been converted into the type of the property,
+   * so setting it on each child does not need to transform it again
+   */
+  for (i = 0; i < n_actors; i++)
+    {
+      ClutterLayoutMeta *meta;
+
+      meta = get_child_meta (manager, container, actors[i]);
+      if (meta == NULL)
+        continue;
+
+      g_object_freeze_notify (G_OBJECT (meta));
+      g_object_set_property (G_OBJECT (meta), pspec->name, &real_value);
+      g_object_thaw_notify (G_OBJECT (meta));
+    }
+
+  clutter_layout_manager_thaw_layout_changed (manager);
+
+  g_value_unset (&real_value);
+}
+
 /**
  * clutter_layout_manager_child_get:
  * @manager: a #ClutterLayoutManager
@@ -175,6 +175,16 @@ void               clutter_layout_manager_set_container         (ClutterLayoutMa
                                                                  ClutterContainer       *container);
 CLUTTER_AVAILABLE_IN_1_2
 void               clutter_layout_manager_layout_changed        (ClutterLayoutManager   *manager);
+CLUTTER_AVAILABLE_IN_1_28
+void               clutter_layout_manager_freeze_layout_changed (ClutterLayoutManager   *manager);
+CLUTTER_AVAILABLE_IN_1_28
+void               clutter_layout_manager_thaw_layout_changed   (ClutterLayoutManager   *manager);
+
+CLUTTER_AVAILABLE_IN_1_28
+void               clutter_layout_manager_set_layout_only_animations (ClutterLayoutManager *manager,
+                                                                      gboolean              layout_only);
+CLUTTER_AVAILABLE_IN_1_28
+gboolean           clutter_layout_manager_get_layout_only_animations (ClutterLayoutManager *manager);
 
 CLUTTER_AVAILABLE_IN_1_2
 GParamSpec *       clutter_layout_manager_find_child_property   (ClutterLayoutManager   *manager,
@@ -212,6 +222,13 @@ void               clutter_layout_manager_child_get_property    (ClutterLayoutMa
                                                                  ClutterActor           *actor,
                                                                  const gchar            *property_name,
                                                                  GValue                 *value);
+CLUTTER_AVAILABLE_IN_1_28
+void               clutter_layout_manager_children_set_property (ClutterLayoutManager   *manager,
+                                                                 ClutterContainer       *container,
+                                                                 ClutterActor * const   *actors,
+                                                                 guint                   n_actors,
+                                                                 GParamSpec             *pspec,
+                                                                 const GValue           *value);
 
 CLUTTER_DEPRECATED_IN_1_12
 ClutterAlpha *     clutter_layout_manager_begin_animation       (ClutterLayoutManager   *manager,
@@ -0,0 +1,961 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:clutter-list-layout
+ * @Title: ClutterListLayout
+ * @Short_Description: A layout manager for long lists of rows
+ *
+ * #ClutterListLayout is a layout manager that stacks the children of
+ * a container vertically, as rows as wide as the container, out of a
+ * list of rows that can be much longer than the list of children.
+ *
+ * The visible children are allocated, in order, at the position of the
+ * rows from the #ClutterListLayout:first-row onwards; the other rows
+ * take space, but have no actor. The preferred height of the container
+ * is the height of all the #ClutterListLayout:n-rows rows.
+ *
+ * The rows can have different heights. Until a row has been allocated
+ * its height is assumed to be the #ClutterListLayout:estimated-row-height;
+ * once allocated, its natural height is kept, until the row is
+ * invalidated with clutter_list_layout_invalidate_rows(). The cost of
+ * finding the position of a row, or the row at a position, grows with
+ * the logarithm of the number of rows.
+ *
+ * #ClutterListLayout is used by #ClutterListView, which creates and
+ * recycles the children for the visible rows.
+ *
+ * #ClutterListLayout is available since Clutter 1.28.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "clutter-list-layout.h"
+
+#include "clutter-actor.h"
+#include "clutter-debug.h"
+#include "clutter-main.h"
+#include "clutter-private.h"
+
+/* the heights of the rows are kept in blocks, which are only created
+ * once a row within them has been measured
+ */
+#define BLOCK_SHIFT             8
+#define BLOCK_SIZE              (1 << BLOCK_SHIFT)
+#define BLOCK_MASK              (BLOCK_SIZE - 1)
+
+#define UNMEASURED              (-1.f)
+
+typedef struct _RowBlock
+{
+  /* the sum of the differences between the measured heights and the
+   * estimated height of the rows in the block
+   */
+  gdouble delta;
+
+  gfloat heights[BLOCK_SIZE];
+} RowBlock;
+
+struct _ClutterListLayoutPrivate
+{
+  guint n_rows;
+  guint first_row;
+
+  gfloat estimated_row_height;
+
+  /* RowBlock, or NULL if no row in the block has been measured */
+  GPtrArray *blocks;
+
+  /* a binary indexed tree of the deltas of the blocks, from index 1,
+   * for summing the deltas of the blocks before a row
+   */
+  GArray *delta_tree;
+  gdouble total_delta;
+
+  guint changed_id;
+};
+
+enum
+{
+  PROP_0,
+
+  PROP_N_ROWS,
+  PROP_FIRST_ROW,
+  PROP_ESTIMATED_ROW_HEIGHT,
+
+  PROP_LAST
+};
+
+static GParamSpec *obj_props[PROP_LAST] = { NULL, };
+
+G_DEFINE_TYPE_WITH_PRIVATE (ClutterListLayout,
+                            clutter_list_layout,
+                            CLUTTER_TYPE_LAYOUT_MANAGER)
+
+static void
+delta_tree_add (ClutterListLayoutPrivate *priv,
+                guint                     block,
+                gdouble                   delta)
+{
+  guint i;
+
+  for (i = block + 1; i < priv->delta_tree->len; i += i & -i)
+    g_array_index (priv->delta_tree, gdouble, i) += delta;
+
+  priv->total_delta += delta;
+}
+
+/* the sum of the deltas of the first n_blocks blocks */
+static gdouble
+delta_tree_sum (ClutterListLayoutPrivate *priv,
+                guint                     n_blocks)
+{
+  gdouble sum = 0.0;
+  guint i;
+
+  for (i = n_blocks; i > 0; i -= i & -i)
+    sum += g_array_index (priv->delta_tree, gdouble, i);
+
+  return sum;
+}
+
+static void
+delta_tree_rebuild (ClutterListLayoutPrivate *priv)
+{
+  guint n_blocks = priv->blocks->len;
+  guint i, parent;
+
+  g_array_set_size (priv->delta_tree, 0);
+  g_array_set_size (priv->delta_tree, n_blocks + 1);
+
+  priv->total_delta = 0.0;
+
+  for (i = 1; i <= n_blocks; i++)
+    {
+      RowBlock *block = g_ptr_array_index (priv->blocks, i - 1);
+
+      if (block != NULL)
+        {
+          g_array_index (priv->delta_tree, gdouble, i) += block->delta;
+          priv->total_delta += block->delta;
+        }
+
+      parent = i + (i & -i);
+      if (parent <= n_blocks)
+        g_array_index (priv->delta_tree, gdouble, parent) +=
+          g_array_index (priv->delta_tree, gdouble, i);
+    }
+}
+
+static gfloat
+get_row_height (ClutterListLayoutPrivate *priv,
+                guint                     row)
+{
+  RowBlock *block;
+
+  if (row >= priv->n_rows)
+    return priv->estimated_row_height;
+
+  block = g_ptr_array_index (priv->blocks, row >> BLOCK_SHIFT);
+
+  if (block != NULL && block->heights[row & BLOCK_MASK] >= 0.f)
+    return block->heights[row & BLOCK_MASK];
+
+  return priv->estimated_row_height;
+}
+
+/* returns TRUE if the height of the row changed */
+static gboolean
+set_row_height (ClutterListLayoutPrivate *priv,
+                guint                     row,
+                gfloat                    height)
+{
+  RowBlock *block;
+  gfloat old_height;
+  guint i;
+
+  if (row >= priv->n_rows)
+    return FALSE;
+
+  block = g_ptr_array_index (priv->blocks, row >> BLOCK_SHIFT);
+
+  if (block == NULL)
+    {
+      block = g_slice_new (RowBlock);
+      block->delta = 0.0;
+
+      for (i = 0; i < BLOCK_SIZE; i++)
+        block->heights[i] = UNMEASURED;
+
+      g_ptr_array_index (priv->blocks, row >> BLOCK_SHIFT) = block;
+    }
+
+  old_height = block->heights[row & BLOCK_MASK];
+  if (old_height < 0.f)
+    old_height = priv->estimated_row_height;
+  else if (old_height == height)
+    return FALSE;
+
+  block->heights[row & BLOCK_MASK] = height;
+  block->delta += height - old_height;
+  delta_tree_add (priv, row >> BLOCK_SHIFT, height - old_height);
+
+  return old_height != height;
+}
+
+static void
+clear_row_height (ClutterListLayoutPrivate *priv,
+                  guint                     row)
+{
+  RowBlock *block;
+  gfloat height;
+
+  if (row >= priv->n_rows)
+    return;
+
+  block = g_ptr_array_index (priv->blocks, row >> BLOCK_SHIFT);
+
+  if (block == NULL)
+    return;
+
+  height = block->heights[row & BLOCK_MASK];
+  if (height < 0.f)
+    return;
+
+  block->heights[row & BLOCK_MASK] = UNMEASURED;
+  block->delta -= height - priv->estimated_row_height;
+  delta_tree_add (priv, row >> BLOCK_SHIFT, priv->estimated_row_height - height);
+}
+
+static void
+row_block_free (gpointer data)
+{
+  if (data != NULL)
+    g_slice_free (RowBlock, data);
+}
+
+/* the deltas of the blocks before the row come from the tree, and only
+ * the rows before it within its own block are walked
+ */
+static gdouble
+get_row_offset (ClutterListLayoutPrivate *priv,
+                guint                     row)
+{
+  guint i, n_blocks = row >> BLOCK_SHIFT;
+  gdouble offset;
+  RowBlock *block;
+
+  offset = (gdouble) row * priv->estimated_row_height
+         + delta_tree_sum (priv, MIN (n_blocks, priv->blocks->len));
+
+  if (n_blocks < priv->blocks->len &&
+      (block = g_ptr_array_index (priv->blocks, n_blocks)) != NULL)
+    {
+      for (i = 0; i < (row & BLOCK_MASK); i++)
+        {
+          if (block->heights[i] >= 0.f)
+            offset += block->heights[i] - priv->estimated_row_height;
+        }
+    }
+
+  return offset;
+}
+
+static gdouble
+get_total_height (ClutterListLayoutPrivate *priv)
+{
+  return priv->n_rows * priv->estimated_row_height + priv->total_delta;
+}
+
+static guint
+get_row_at_offset (ClutterListLayoutPrivate *priv,
+                   gdouble                   offset)
+{
+  gdouble block_offset = 0.0, full_height;
+  guint n_blocks = priv->blocks->len;
+  guint block_index = 0, step, first, n_rows, j;
+  RowBlock *block;
+
+  if (priv->n_rows == 0 || offset <= 0.0)
+    return 0;
+
+  if (offset >= get_total_height (priv))
+    return priv->n_rows - 1;
+
+  /* descend the tree for the last block starting at or before the
+   * offset; only the last block can be shorter than a full block, and
+   * the offset is within the total height, so assuming it is full
+   * never skips past it
+   */
+  full_height = BLOCK_SIZE * priv->estimated_row_height;
+
+  for (step = 1; step * 2 <= n_blocks; step *= 2)
+    ;
+
+  for (; step > 0; step /= 2)
+    {
+      gdouble next_offset;
+
+      if (block_index + step > n_blocks)
+        continue;
+
+      next_offset = block_offset
+                  + step * full_height
+                  + g_array_index (priv->delta_tree, gdouble, block_index + step);
+
+      if (next_offset <= offset)
+        {
+          block_index += step;
+          block_offset = next_offset;
+        }
+    }
+
+  block_index = MIN (block_index, n_blocks - 1);
+  first = block_index << BLOCK_SHIFT;
+  n_rows = MIN (BLOCK_SIZE, priv->n_rows - first);
+  block = g_ptr_array_index (priv->blocks, block_index);
+
+  if (block == NULL)
+    {
+      j = (guint) ((offset - block_offset) / priv->estimated_row_height);
+
+      return first + MIN (j, n_rows - 1);
+    }
+
+  for (j = 0; j < n_rows - 1; j++)
+    {
+      block_offset += block->heights[j] >= 0.f
+                    ? block->heights[j]
+                    : priv->estimated_row_height;
+
+      if (offset < block_offset)
+        break;
+    }
+
+  return first + j;
+}
+
+static gboolean
+clutter_list_layout_changed_func (gpointer data)
+{
+  ClutterListLayout *self = data;
+
+  self->priv->changed_id = 0;
+
+  clutter_layout_manager_layout_changed (CLUTTER_LAYOUT_MANAGER (self));
+
+  return G_SOURCE_REMOVE;
+}
+
+/* the heights measured during an allocation change the preferred
+ * height of the container, which can only be queued once the
+ * allocation is done
+ */
+static void
+clutter_list_layout_queue_changed (ClutterListLayout *self)
+{
+  ClutterListLayoutPrivate *priv = self->priv;
+
+  if (priv->changed_id != 0)
+    return;
+
+  priv->changed_id =
+    clutter_threads_add_repaint_func_full (CLUTTER_REPAINT_FLAGS_PRE_PAINT,
+                                           clutter_list_layout_changed_func,
+                                           self,
+                                           NULL);
+}
+
+static void
+clutter_list_layout_get_preferred_width (ClutterLayoutManager *manager,
+                                         ClutterContainer     *container,
+                                         gfloat                for_height,
+                                         gfloat               *min_width_p,
+                                         gfloat               *natural_width_p)
+{
+  ClutterActor *child;
+  ClutterActorIter iter;
+  gfloat min_width = 0.f, natural_width = 0.f;
+
+  /* only the rows with an actor can be measured */
+  clutter_actor_iter_init (&iter, CLUTTER_ACTOR (container));
+  while (clutter_actor_iter_next (&iter, &child))
+    {
+      gfloat child_min, child_natural;
+
+      if (!clutter_actor_is_visible (child))
+        continue;
+
+      clutter_actor_get_preferred_width (child, -1,
+                                         &child_min,
+                                         &child_natural);
+
+      min_width = MAX (min_width, child_min);
+      natural_width = MAX (natural_width, child_natural);
+    }
+
+  if (min_width_p != NULL)
+    *min_width_p = min_width;
+
+  if (natural_width_p != NULL)
+    *natural_width_p = natural_width;
+}
+
+static void
+clutter_list_layout_get_preferred_height (ClutterLayoutManager *manager,
+                                          ClutterContainer     *container,
+                                          gfloat                for_width,
+                                          gfloat               *min_height_p,
+                                          gfloat               *natural_height_p)
+{
+  ClutterListLayoutPrivate *priv = CLUTTER_LIST_LAYOUT (manager)->priv;
+  gfloat height = MAX (get_total_height (priv), 0.0);
+
+  if (min_height_p != NULL)
+    *min_height_p = height;
+
+  if (natural_height_p != NULL)
+    *natural_height_p = height;
+}
+
+static void
+clutter_list_layout_allocate (ClutterLayoutManager   *manager,
+                              ClutterContainer       *container,
+                              const ClutterActorBox  *box,
+                              ClutterAllocationFlags  flags)
+{
+  ClutterListLayout *self = CLUTTER_LIST_LAYOUT (manager);
+  ClutterListLayoutPrivate *priv = self->priv;
+  ClutterActor *actor = CLUTTER_ACTOR (container);
+  gfloat width = clutter_actor_box_get_width (box);
+  gboolean heights_changed = FALSE;
+  ClutterActor *child;
+  ClutterActorIter iter;
+  guint row;
+  gdouble y;
+
+  /* measure the rows first, as the new heights move the rows below */
+  row = priv->first_row;
+  clutter_actor_iter_init (&iter, actor);
+  while (row < priv->n_rows && clutter_actor_iter_next (&iter, &child))
+    {
+      gfloat height;
+
+      if (!clutter_actor_is_visible (child))
+        continue;
+
+      clutter_actor_get_preferred_height (child, width, NULL, &height);
+
+      if (set_row_height (priv, row, height))
+        heights_changed = TRUE;
+
+      row += 1;
+    }
+
+  y = box->y1 + get_row_offset (priv, priv->first_row);
+
+  row = priv->first_row;
+  clutter_actor_iter_init (&iter, actor);
+  while (row < priv->n_rows && clutter_actor_iter_next (&iter, &child))
+    {
+      ClutterActorBox child_box;
+
+      if (!clutter_actor_is_visible (child))
+        continue;
+
+      child_box.x1 = box->x1;
+      child_box.y1 = y;
+      child_box.x2 = box->x2;
+      child_box.y2 = y + get_row_height (priv, row);
+
+      clutter_actor_allocate (child, &child_box, flags);
+
+      y = child_box.y2;
+      row += 1;
+    }
+
+  if (heights_changed)
+    clutter_list_layout_queue_changed (self);
+}
+
+static void
+clutter_list_layout_set_property (GObject      *gobject,
+                                  guint         prop_id,
+                                  const GValue *value,
+                                  GParamSpec   *pspec)
+{
+  ClutterListLayout *self = CLUTTER_LIST_LAYOUT (gobject);
+
+  switch (prop_id)
+    {
+    case PROP_N_ROWS:
+      clutter_list_layout_set_n_rows (self, g_value_get_uint (value));
+      break;
+
+    case PROP_FIRST_ROW:
+      clutter_list_layout_set_first_row (self, g_value_get_uint (value));
+      break;
+
+    case PROP_ESTIMATED_ROW_HEIGHT:
+      clutter_list_layout_set_estimated_row_height (self, g_value_get_float (value));
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
+    }
+}
+
+static void
+clutter_list_layout_get_property (GObject    *gobject,
+                                  guint       prop_id,
+                                  GValue     *value,
+                                  GParamSpec *pspec)
+{
+  ClutterListLayoutPrivate *priv = CLUTTER_LIST_LAYOUT (gobject)->priv;
+
+  switch (prop_id)
+    {
+    case PROP_N_ROWS:
+      g_value_set_uint (value, priv->n_rows);
+      break;
+
+    case PROP_FIRST_ROW:
+      g_value_set_uint (value, priv->first_row);
+      break;
+
+    case PROP_ESTIMATED_ROW_HEIGHT:
+      g_value_set_float (value, priv->estimated_row_height);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
+    }
+}
+
+static void
+clutter_list_layout_dispose (GObject *gobject)
+{
+  ClutterListLayoutPrivate *priv = CLUTTER_LIST_LAYOUT (gobject)->priv;
+
+  if (priv->changed_id != 0)
+    {
+      clutter_threads_remove_repaint_func (priv->changed_id);
+      priv->changed_id = 0;
+    }
+
+  G_OBJECT_CLASS (clutter_list_layout_parent_class)->dispose (gobject);
+}
+
+static void
+clutter_list_layout_finalize (GObject *gobject)
+{
+  ClutterListLayoutPrivate *priv = CLUTTER_LIST_LAYOUT (gobject)->priv;
+
+  g_ptr_array_unref (priv->blocks);
+  g_array_unref (priv->delta_tree);
+
+  G_OBJECT_CLASS (clutter_list_layout_parent_class)->finalize (gobject);
+}
+
+static void
+clutter_list_layout_class_init (ClutterListLayoutClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  ClutterLayoutManagerClass *layout_class = CLUTTER_LAYOUT_MANAGER_CLASS (klass);
+
+  gobject_class->set_property = clutter_list_layout_set_property;
+  gobject_class->get_property = clutter_list_layout_get_property;
+  gobject_class->dispose = clutter_list_layout_dispose;
+  gobject_class->finalize = clutter_list_layout_finalize;
+
+  layout_class->get_preferred_width = clutter_list_layout_get_preferred_width;
+  layout_class->get_preferred_height = clutter_list_layout_get_preferred_height;
+  layout_class->allocate = clutter_list_layout_allocate;
+
+  /**
+   * ClutterListLayout:n-rows:
+   *
+   * The number of rows of the list.
+   *
+   * Since: 1.28
+   */
+  obj_props[PROP_N_ROWS] =
+    g_param_spec_uint ("n-rows",
+                       P_("Number of rows"),
+                       P_("The number of rows of the list"),
+                       0, G_MAXUINT,
+                       0,
+                       G_PARAM_READWRITE |
+                       G_PARAM_STATIC_STRINGS);
+
+  /**
+   * ClutterListLayout:first-row:
+   *
+   * The row displayed by the first visible child of the container.
+   *
+   * Since: 1.28
+   */
+  obj_props[PROP_FIRST_ROW] =
+    g_param_spec_uint ("first-row",
+                       P_("First row"),
+                       P_("The row displayed by the first visible child"),
+                       0, G_MAXUINT,
+                       0,
+                       G_PARAM_READWRITE |
+                       G_PARAM_STATIC_STRINGS);
+
+  /**
+   * ClutterListLayout:estimated-row-height:
+   *
+   * The height assumed for the rows that have not been allocated yet.
+   *
+   * Since: 1.28
+   */
+  obj_props[PROP_ESTIMATED_ROW_HEIGHT] =
+    g_param_spec_float ("estimated-row-height",
+                        P_("Estimated row height"),
+                        P_("The height assumed for the rows that have not been allocated"),
+                        1.f, G_MAXFLOAT,
+                        32.f,
+                        G_PARAM_READWRITE |
+                        G_PARAM_STATIC_STRINGS);
+
+  g_object_class_install_properties (gobject_class, PROP_LAST, obj_props);
+}
+
+static void
+clutter_list_layout_init (ClutterListLayout *self)
+{
+  ClutterListLayoutPrivate *priv;
+
+  self->priv = priv = clutter_list_layout_get_instance_private (self);
+
+  priv->estimated_row_height = 32.f;
+
+  priv->blocks = g_ptr_array_new_with_free_func (row_block_free);
+  priv->delta_tree = g_array_new (FALSE, TRUE, sizeof (gdouble));
+  g_array_set_size (priv->delta_tree, 1);
+}
+
+/**
+ * clutter_list_layout_new:
+ *
+ * Creates a new #ClutterListLayout layout manager.
+ *
+ * Return value: the newly created #ClutterListLayout
+ *
+ * Since: 1.28
+ */
+ClutterLayoutManager *
+clutter_list_layout_new (void)
+{
+  return g_object_new (CLUTTER_TYPE_LIST_LAYOUT, NULL);
+}
+
+/**
+ * clutter_list_layout_set_n_rows:
+ * @layout: a #ClutterListLayout
+ * @n_rows: the number of rows
+ *
+ * Sets the number of rows of @layout.
+ *
+ * The rows that are kept keep their measured height.
+ *
+ * Since: 1.28
+ */
+void
+clutter_list_layout_set_n_rows (ClutterListLayout *layout,
+                                guint              n_rows)
+{
+  ClutterListLayoutPrivate *priv;
+  guint i;
+
+  g_return_if_fail (CLUTTER_IS_LIST_LAYOUT (layout));
+
+  priv = layout->priv;
+
+  if (priv->n_rows == n_rows)
+    return;
+
+  /* forget the heights of the removed rows within the last block */
+  for (i = n_rows; i < priv->n_rows && (i & BLOCK_MASK) != 0; i++)
+    clear_row_height (priv, i);
+
+  g_ptr_array_set_size (priv->blocks, (n_rows + BLOCK_MASK) >> BLOCK_SHIFT);
+  delta_tree_rebuild (priv);
+
+  priv->n_rows = n_rows;
+
+  clutter_layout_manager_layout_changed (CLUTTER_LAYOUT_MANAGER (layout));
+
+  g_object_notify_by_pspec (G_OBJECT (layout), obj_props[PROP_N_ROWS]);
+}
+
+/**
+ * clutter_list_layout_get_n_rows:
+ * @layout: a #ClutterListLayout
+ *
+ * Retrieves the number of rows set using clutter_list_layout_set_n_rows().
+ *
+ * Return value: the number of rows
+ *
+ * Since: 1.28
+ */
+guint
+clutter_list_layout_get_n_rows (ClutterListLayout *layout)
+{
+  g_return_val_if_fail (CLUTTER_IS_LIST_LAYOUT (layout), 0);
+
+  return layout->priv->n_rows;
+}
+
+/**
+ * clutter_list_layout_set_first_row:
+ * @layout: a #ClutterListLayout
+ * @row: the index of a row
+ *
+ * Sets the row displayed by the first visible child of the container
+ * using @layout; the following visible children display the following
+ * rows.
+ *
+ * Since: 1.28
+ */
+void
+clutter_list_layout_set_first_row (ClutterListLayout *layout,
+                                   guint              row)
+{
+  ClutterListLayoutPrivate *priv;
+
+  g_return_if_fail (CLUTTER_IS_LIST_LAYOUT (layout));
+
+  priv = layout->priv;
+
+  if (priv->first_row == row)
+    return;
+
+  priv->first_row = row;
+
+  clutter_layout_manager_layout_changed (CLUTTER_LAYOUT_MANAGER (layout));
+
+  g_object_notify_by_pspec (G_OBJECT (layout), obj_props[PROP_FIRST_ROW]);
+}
+
+/**
+ * clutter_list_layout_get_first_row:
+ * @layout: a #ClutterListLayout
+ *
+ * Retrieves the row set using clutter_list_layout_set_first_row().
+ *
+ * Return value: the index of the first row displayed
+ *
+ * Since: 1.28
+ */
+guint
+clutter_list_layout_get_first_row (ClutterListLayout *layout)
+{
+  g_return_val_if_fail (CLUTTER_IS_LIST_LAYOUT (layout), 0);
+
+  return layout->priv->first_row;
+}
+
+/**
+ * clutter_list_layout_set_estimated_row_height:
+ * @layout: a #ClutterListLayout
+ * @height: the estimated height of the rows, in pixels
+ *
+ * Sets the height assumed for the rows of @layout that have not been
+ * allocated yet.
+ *
+ * Since: 1.28
+ */
+void
+clutter_list_layout_set_estimated_row_height (ClutterListLayout *layout,
+                                              gfloat             height)
+{
+  ClutterListLayoutPrivate *priv;
+  guint i, j;
+
+  g_return_if_fail (CLUTTER_IS_LIST_LAYOUT (layout));
+  g_return_if_fail (height >= 1.f);
+
+  priv = layout->priv;
+
+  if (priv->estimated_row_height == height)
+    return;
+
+  priv->estimated_row_height = height;
+
+  /* the differences are relative to the estimate */
+  for (i = 0; i < priv->blocks->len; i++)
+    {
+      RowBlock *block = g_ptr_array_index (priv->blocks, i);
+
+      if (block == NULL)
+        continue;
+
+      block->delta = 0.0;
+
+      for (j = 0; j < BLOCK_SIZE; j++)
+        {
+          if (block->heights[j] >= 0.f)
+            block->delta += block->heights[j] - height;
+        }
+    }
+
+  delta_tree_rebuild (priv);
+
+  clutter_layout_manager_layout_changed (CLUTTER_LAYOUT_MANAGER (layout));
+
+  g_object_notify_by_pspec (G_OBJECT (layout), obj_props[PROP_ESTIMATED_ROW_HEIGHT]);
+}
+
+/**
+ * clutter_list_layout_get_estimated_row_height:
+ * @layout: a #ClutterListLayout
+ *
+ * Retrieves the height set using clutter_list_layout_set_estimated_row_height().
+ *
+ * Return value: the estimated height of the rows
+ *
+ * Since: 1.28
+ */
+gfloat
+clutter_list_layout_get_estimated_row_height (ClutterListLayout *layout)
+{
+  g_return_val_if_fail (CLUTTER_IS_LIST_LAYOUT (layout), 0.f);
+
+  return layout->priv->estimated_row_height;
+}
+
+/**
+ * clutter_list_layout_invalidate_rows:
+ * @layout: a #ClutterListLayout
+ * @first_row: the index of the first row to invalidate
+ * @n_rows: the number of rows to invalidate
+ *
+ * Forgets the measured heights of the given rows, which are measured
+ * again the next time they are allocated.
+ *
+ * Since: 1.28
+ */
+void
+clutter_list_layout_invalidate_rows (ClutterListLayout *layout,
+                                     guint              first_row,
+                                     guint              n_rows)
+{
+  ClutterListLayoutPrivate *priv;
+  guint i, last_row;
+
+  g_return_if_fail (CLUTTER_IS_LIST_LAYOUT (layout));
+
+  priv = layout->priv;
+
+  if (first_row >= priv->n_rows)
+    return;
+
+  last_row = first_row + MIN (n_rows, priv->n_rows - first_row);
+
+  for (i = first_row; i < last_row; i++)
+    clear_row_height (priv, i);
+
+  clutter_layout_manager_layout_changed (CLUTTER_LAYOUT_MANAGER (layout));
+}
+
+/**
+ * clutter_list_layout_get_row_area:
+ * @layout: a #ClutterListLayout
+ * @row: the index of a row
+ * @y: (out) (allow-none): return location for the offset of the row
+ * @height: (out) (allow-none): return location for the height of the row
+ *
+ * Retrieves the area of @row, relative to the container using @layout.
+ * The area of the rows that have not been allocated yet is based on
+ * the estimated height of the rows.
+ *
+ * Return value: %TRUE if @row is a row of @layout
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_list_layout_get_row_area (ClutterListLayout *layout,
+                                  guint              row,
+                                  gfloat            *y,
+                                  gfloat            *height)
+{
+  ClutterListLayoutPrivate *priv;
+
+  g_return_val_if_fail (CLUTTER_IS_LIST_LAYOUT (layout), FALSE);
+
+  priv = layout->priv;
+
+  if (row >= priv->n_rows)
+    return FALSE;
+
+  if (y != NULL)
+    *y = get_row_offset (priv, row);
+
+  if (height != NULL)
+    *height = get_row_height (priv, row);
+
+  return TRUE;
+}
+
+/**
+ * clutter_list_layout_get_row_at_offset:
+ * @layout: a #ClutterListLayout
+ * @offset: a vertical offset, relative to the container using @layout
+ *
+ * Retrieves the row at @offset. The offsets before the first row are
+ * within the first row, and the ones after the last row within the
+ * last row.
+ *
+ * Return value: the index of the row at @offset, or 0 if @layout
+ *   has no rows
+ *
+ * Since: 1.28
+ */
+guint
+clutter_list_layout_get_row_at_offset (ClutterListLayout *layout,
+                                       gfloat             offset)
+{
+  g_return_val_if_fail (CLUTTER_IS_LIST_LAYOUT (layout), 0);
+
+  return get_row_at_offset (layout->priv, offset);
+}
+
+/**
+ * clutter_list_layout_get_total_height:
+ * @layout: a #ClutterListLayout
+ *
+ * Retrieves the height of all the rows of @layout, which is the
+ * preferred height of the container using it.
+ *
+ * Return value: the height of the rows, in pixels
+ *
+ * Since: 1.28
+ */
+gfloat
+clutter_list_layout_get_total_height (ClutterListLayout *layout)
+{
+  g_return_val_if_fail (CLUTTER_IS_LIST_LAYOUT (layout), 0.f);
+
+  return MAX (get_total_height (layout->priv), 0.0);
+}
@@ -0,0 +1,111 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CLUTTER_LIST_LAYOUT_H__
+#define __CLUTTER_LIST_LAYOUT_H__
+
+#if !defined(__CLUTTER_H_INSIDE__) && !defined(CLUTTER_COMPILATION)
+#error "Only <clutter/clutter.h> can be included directly."
+#endif
+
+#include <clutter/clutter-layout-manager.h>
+
+G_BEGIN_DECLS
+
+#define CLUTTER_TYPE_LIST_LAYOUT                (clutter_list_layout_get_type ())
+#define CLUTTER_LIST_LAYOUT(obj)                (G_TYPE_CHECK_INSTANCE_CAST ((obj), CLUTTER_TYPE_LIST_LAYOUT, ClutterListLayout))
+#define CLUTTER_IS_LIST_LAYOUT(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), CLUTTER_TYPE_LIST_LAYOUT))
+#define CLUTTER_LIST_LAYOUT_CLASS(klass)        (G_TYPE_CHECK_CLASS_CAST ((klass), CLUTTER_TYPE_LIST_LAYOUT, ClutterListLayoutClass))
+#define CLUTTER_IS_LIST_LAYOUT_CLASS(klass)     (G_TYPE_CHECK_CLASS_TYPE ((klass), CLUTTER_TYPE_LIST_LAYOUT))
+#define CLUTTER_LIST_LAYOUT_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj), CLUTTER_TYPE_LIST_LAYOUT, ClutterListLayoutClass))
+
+typedef struct _ClutterListLayout               ClutterListLayout;
+typedef struct _ClutterListLayoutPrivate        ClutterListLayoutPrivate;
+typedef struct _ClutterListLayoutClass          ClutterListLayoutClass;
+
+/**
+ * ClutterListLayout:
+ *
+ * The #ClutterListLayout structure contains only private data
+ * and should be accessed using the provided API
+ *
+ * Since: 1.28
+ */
+struct _ClutterListLayout
+{
+  /*< private >*/
+  ClutterLayoutManager parent_instance;
+
+  ClutterListLayoutPrivate *priv;
+};
+
+/**
+ * ClutterListLayoutClass:
+ *
+ * The #ClutterListLayoutClass structure contains only private
+ * data and should be accessed using the provided API
+ *
+ * Since: 1.28
+ */
+struct _ClutterListLayoutClass
+{
+  /*< private >*/
+  ClutterLayoutManagerClass parent_class;
+};
+
+CLUTTER_AVAILABLE_IN_1_28
+GType clutter_list_layout_get_type (void) G_GNUC_CONST;
+
+CLUTTER_AVAILABLE_IN_1_28
+ClutterLayoutManager *  clutter_list_layout_new                         (void);
+
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_list_layout_set_n_rows                  (ClutterListLayout *layout,
+                                                                         guint              n_rows);
+CLUTTER_AVAILABLE_IN_1_28
+guint                   clutter_list_layout_get_n_rows                  (ClutterListLayout *layout);
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_list_layout_set_first_row               (ClutterListLayout *layout,
+                                                                         guint              row);
+CLUTTER_AVAILABLE_IN_1_28
+guint                   clutter_list_layout_get_first_row               (ClutterListLayout *layout);
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_list_layout_set_estimated_row_height    (ClutterListLayout *layout,
+                                                                         gfloat             height);
+CLUTTER_AVAILABLE_IN_1_28
+gfloat                  clutter_list_layout_get_estimated_row_height    (ClutterListLayout *layout);
+
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_list_layout_invalidate_rows             (ClutterListLayout *layout,
+                                                                         guint              first_row,
+                                                                         guint              n_rows);
+CLUTTER_AVAILABLE_IN_1_28
+gboolean                clutter_list_layout_get_row_area                (ClutterListLayout *layout,
+                                                                         guint              row,
+                                                                         gfloat            *y,
+                                                                         gfloat            *height);
+CLUTTER_AVAILABLE_IN_1_28
+guint                   clutter_list_layout_get_row_at_offset           (ClutterListLayout *layout,
+                                                                         gfloat             offset);
+CLUTTER_AVAILABLE_IN_1_28
+gfloat                  clutter_list_layout_get_total_height            (ClutterListLayout *layout);
+
+G_END_DECLS
+
+#endif /* __CLUTTER_LIST_LAYOUT_H__ */
@@ -0,0 +1,1017 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * SECTION:clutter-list-view
+ * @Title: ClutterListView
+ * @Short_Description: An actor displaying a long list of rows
+ *
+ * #ClutterListView is an actor that displays a list of rows, stacked
+ * vertically and as wide as the list view, while creating actors only
+ * for the rows that are visible.
+ *
+ * The rows are not children added by the application: the list view
+ * asks for an actor using the #ClutterListViewCreateFunc, and sets it
+ * up for a given row using the #ClutterListViewBindFunc, both passed to
+ * clutter_list_view_set_row_factory(). When a row is scrolled out of
+ * the visible area its actor is kept aside, and used again for the
+ * next row that becomes visible; the number of actors, and the cost of
+ * allocating them, depend on the size of the visible area and not on
+ * the number of rows.
+ *
+ * The visible area is the area of the first #ClutterScrollActor found
+ * among the ancestors of the list view, or the area of the parent of
+ * the list view if there is none; the rows within the distance set by
+ * the #ClutterListView:overscan property from the visible area are
+ * created as well, so that they are ready when scrolled into view.
+ *
+ * The rows can have different heights. Until a row has been displayed
+ * its height is assumed to be the #ClutterListView:estimated-row-height;
+ * once displayed, its natural height is kept, until the row is
+ * invalidated with clutter_list_view_invalidate_rows().
+ *
+ * A grid can be displayed by having each row display more than one
+ * item.
+ *
+ * The heights of the rows are kept, and the realized rows allocated,
+ * by a #ClutterListLayout, which is the layout manager of the list
+ * view and should not be replaced.
+ *
+ * #ClutterListView is available since Clutter 1.28.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "clutter-list-view.h"
+
+#include "clutter-actor-private.h"
+#include "clutter-debug.h"
+#include "clutter-list-layout.h"
+#include "clutter-main.h"
+#include "clutter-master-clock.h"
+#include "clutter-private.h"
+#include "clutter-scroll-actor-private.h"
+
+struct _ClutterListViewPrivate
+{
+  ClutterListViewCreateFunc create_func;
+  ClutterListViewBindFunc bind_func;
+  gpointer factory_data;
+  GDestroyNotify factory_notify;
+
+  guint n_rows;
+
+  gfloat overscan;
+
+  /* the layout manager of the list view, keeping the heights of the
+   * rows and allocating the realized ones
+   */
+  ClutterListLayout *layout;
+
+  /* the actors of the rows from first_row onwards, in the same order
+   * as the visible children of the list view
+   */
+  guint first_row;
+  GPtrArray *rows;
+
+  /* hidden actors, ready to be bound to a row */
+  GPtrArray *pool;
+
+  ClutterScrollActor *scroll_actor;
+  gulong scroll_transform_id;
+  gulong scroll_allocation_id;
+
+  guint update_id;
+
+  guint rows_dirty : 1;
+};
+
+enum
+{
+  PROP_0,
+
+  PROP_N_ROWS,
+  PROP_ESTIMATED_ROW_HEIGHT,
+  PROP_OVERSCAN,
+
+  PROP_LAST
+};
+
+static GParamSpec *obj_props[PROP_LAST] = { NULL, };
+
+G_DEFINE_TYPE_WITH_PRIVATE (ClutterListView, clutter_list_view, CLUTTER_TYPE_ACTOR)
+
+/* retrieves the visible area, in the coordinates of the list view */
+static void
+clutter_list_view_get_visible_area (ClutterListView *self,
+                                    gfloat          *y1,
+                                    gfloat          *y2)
+{
+  ClutterListViewPrivate *priv = self->priv;
+  ClutterActor *actor, *parent;
+  ClutterActorBox box;
+  gfloat offset = 0.f;
+
+  if (priv->scroll_actor != NULL)
+    {
+      ClutterPoint point;
+
+      for (actor = CLUTTER_ACTOR (self);
+           actor != CLUTTER_ACTOR (priv->scroll_actor);
+           actor = clutter_actor_get_parent (actor))
+        {
+          clutter_actor_get_allocation_box (actor, &box);
+          offset += box.y1;
+        }
+
+      _clutter_scroll_actor_get_scroll_point (priv->scroll_actor, &point);
+      if (!(clutter_scroll_actor_get_scroll_mode (priv->scroll_actor) & CLUTTER_SCROLL_VERTICALLY))
+        point.y = 0.f;
+
+      clutter_actor_get_allocation_box (CLUTTER_ACTOR (priv->scroll_actor), &box);
+
+      *y1 = point.y - offset;
+      *y2 = *y1 + clutter_actor_box_get_height (&box);
+      return;
+    }
+
+  clutter_actor_get_allocation_box (CLUTTER_ACTOR (self), &box);
+
+  parent = clutter_actor_get_parent (CLUTTER_ACTOR (self));
+  if (parent != NULL)
+    {
+      ClutterActorBox parent_box;
+
+      clutter_actor_get_allocation_box (parent, &parent_box);
+
+      *y1 = -box.y1;
+      *y2 = *y1 + clutter_actor_box_get_height (&parent_box);
+    }
+  else
+    {
+      *y1 = 0.f;
+      *y2 = clutter_actor_box_get_height (&box);
+    }
+}
+
+static gboolean
+clutter_list_view_get_visible_rows (ClutterListView *self,
+                                    guint           *first_row,
+                                    guint           *last_row)
+{
+  ClutterListViewPrivate *priv = self->priv;
+  gfloat y1, y2;
+
+  if (priv->n_rows == 0 || priv->create_func == NULL)
+    return FALSE;
+
+  clutter_list_view_get_visible_area (self, &y1, &y2);
+
+  y1 -= priv->overscan;
+  y2 += priv->overscan;
+
+  if (y2 <= 0.f || y1 >= clutter_list_layout_get_total_height (priv->layout))
+    return FALSE;
+
+  *first_row = clutter_list_layout_get_row_at_offset (priv->layout, y1);
+  *last_row = clutter_list_layout_get_row_at_offset (priv->layout, y2);
+
+  return TRUE;
+}
+
+static void
+clutter_list_view_recycle_row (ClutterListView *self,
+                               ClutterActor    *row_actor,
+                               guint            max_pool_size)
+{
+  ClutterListViewPrivate *priv = self->priv;
+
+  if (priv->pool->len >= max_pool_size)
+    {
+      clutter_actor_destroy (row_actor);
+      return;
+    }
+
+  clutter_actor_hide (row_actor);
+  g_ptr_array_add (priv->pool, row_actor);
+}
+
+static ClutterActor *
+clutter_list_view_obtain_row (ClutterListView *self)
+{
+  ClutterListViewPrivate *priv = self->priv;
+  ClutterActor *row_actor;
+
+  if (priv->pool->len > 0)
+    return g_ptr_array_remove_index_fast (priv->pool, priv->pool->len - 1);
+
+  row_actor = priv->create_func (self, priv->factory_data);
+  if (row_actor == NULL)
+    {
+      g_critical ("The row factory of the ClutterListView %p did not "
+                  "return an actor",
+                  self);
+      return NULL;
+    }
+
+  clutter_actor_add_child (CLUTTER_ACTOR (self), row_actor);
+
+  return row_actor;
+}
+
+/* creates, binds and recycles the actors so that the realized rows
+ * match the visible ones; this must not be called while allocating
+ */
+static void
+clutter_list_view_update_rows (ClutterListView *self)
+{
+  ClutterListViewPrivate *priv = self->priv;
+  GPtrArray *old_rows = priv->rows;
+  guint old_first = priv->first_row;
+  guint first_row = 0, last_row = 0;
+  guint kept_start = 0, kept_end = 0;
+  gboolean has_rows;
+  guint i;
+
+  priv->rows_dirty = FALSE;
+
+  has_rows = clutter_list_view_get_visible_rows (self, &first_row, &last_row);
+
+  if (has_rows &&
+      first_row == old_first &&
+      last_row + 1 == old_first + old_rows->len)
+    return;
+
+  if (!has_rows && old_rows->len == 0)
+    return;
+
+  priv->rows = g_ptr_array_sized_new (has_rows ? last_row - first_row + 1 : 0);
+  priv->first_row = first_row;
+
+  if (has_rows)
+    {
+      g_ptr_array_set_size (priv->rows, last_row - first_row + 1);
+
+      /* keep the actors of the rows that are still visible */
+      for (i = first_row; i <= last_row; i++)
+        {
+          if (i >= old_first && i < old_first + old_rows->len)
+            {
+              if (kept_start == kept_end)
+                kept_start = i - first_row;
+
+              g_ptr_array_index (priv->rows, i - first_row) =
+                g_ptr_array_index (old_rows, i - old_first);
+              g_ptr_array_index (old_rows, i - old_first) = NULL;
+
+              kept_end = i - first_row + 1;
+            }
+        }
+    }
+
+  for (i = 0; i < old_rows->len; i++)
+    {
+      ClutterActor *row_actor = g_ptr_array_index (old_rows, i);
+
+      if (row_actor != NULL)
+        clutter_list_view_recycle_row (self, row_actor, priv->rows->len);
+    }
+
+  g_ptr_array_unref (old_rows);
+
+  for (i = 0; i < priv->rows->len; i++)
+    {
+      ClutterActor *row_actor = g_ptr_array_index (priv->rows, i);
+
+      if (row_actor != NULL)
+        continue;
+
+      row_actor = clutter_list_view_obtain_row (self);
+      if (row_actor == NULL)
+        {
+          g_ptr_array_set_size (priv->rows, i);
+          break;
+        }
+
+      if (priv->bind_func != NULL)
+        priv->bind_func (self, row_actor, first_row + i, priv->factory_data);
+
+      clutter_actor_show (row_actor);
+
+      g_ptr_array_index (priv->rows, i) = row_actor;
+    }
+
+  /* the layout manager allocates the visible children in order, so the
+   * new rows go below the kept ones if they come before them, and above
+   * them otherwise
+   */
+  for (i = MIN (kept_start, priv->rows->len); i > 0; i--)
+    clutter_actor_set_child_below_sibling (CLUTTER_ACTOR (self),
+                                           g_ptr_array_index (priv->rows, i - 1),
+                                           NULL);
+
+  for (i = kept_end; i < priv->rows->len; i++)
+    clutter_actor_set_child_above_sibling (CLUTTER_ACTOR (self),
+                                           g_ptr_array_index (priv->rows, i),
+                                           NULL);
+
+  clutter_list_layout_set_first_row (priv->layout, priv->first_row);
+
+  CLUTTER_NOTE (LAYOUT, "List view %p: rows %u to %u realized, %u pooled",
+                self,
+                priv->first_row,
+                priv->first_row + priv->rows->len,
+                priv->pool->len);
+
+  clutter_actor_queue_relayout (CLUTTER_ACTOR (self));
+}
+
+static void
+clutter_list_view_clear_rows (ClutterListView *self)
+{
+  ClutterListViewPrivate *priv = self->priv;
+
+  g_ptr_array_set_size (priv->rows, 0);
+  g_ptr_array_set_size (priv->pool, 0);
+  priv->first_row = 0;
+
+  clutter_list_layout_set_first_row (priv->layout, 0);
+  clutter_actor_destroy_all_children (CLUTTER_ACTOR (self));
+}
+
+static gboolean
+clutter_list_view_update_func (gpointer data)
+{
+  ClutterListView *self = data;
+  ClutterListViewPrivate *priv = self->priv;
+
+  priv->update_id = 0;
+
+  if (priv->rows_dirty)
+    clutter_list_view_update_rows (self);
+
+  return G_SOURCE_REMOVE;
+}
+
+/* updates the rows before the next frame is painted; this is safe to
+ * call while allocating, though a frame will be painted first
+ */
+static void
+clutter_list_view_queue_update (ClutterListView *self)
+{
+  ClutterListViewPrivate *priv = self->priv;
+
+  priv->rows_dirty = TRUE;
+
+  if (priv->update_id != 0)
+    return;
+
+  priv->update_id =
+    clutter_threads_add_repaint_func_full (CLUTTER_REPAINT_FLAGS_PRE_PAINT,
+                                           clutter_list_view_update_func,
+                                           self,
+                                           NULL);
+
+  _clutter_master_clock_ensure_next_iteration (_clutter_master_clock_get_default ());
+}
+
+static void
+on_scroll_transform_changed (GObject         *gobject,
+                             GParamSpec      *pspec,
+                             ClutterListView *self)
+{
+  ClutterActor *stage = clutter_actor_get_stage (CLUTTER_ACTOR (self));
+
+  /* scrolling happens while handling the events or before painting,
+   * so the new rows can be realized in time for the current frame
+   */
+  if (stage != NULL && !CLUTTER_ACTOR_IN_RELAYOUT (stage))
+    clutter_list_view_update_rows (self);
+  else
+    clutter_list_view_queue_update (self);
+}
+
+static void
+on_scroll_allocation_changed (GObject         *gobject,
+                              GParamSpec      *pspec,
+                              ClutterListView *self)
+{
+  clutter_list_view_queue_update (self);
+}
+
+static void
+clutter_list_view_set_scroll_actor (ClutterListView    *self,
+                                    ClutterScrollActor *scroll_actor)
+{
+  ClutterListViewPrivate *priv = self->priv;
+
+  if (priv->scroll_actor == scroll_actor)
+    return;
+
+  if (priv->scroll_actor != NULL)
+    {
+      g_signal_handler_disconnect (priv->scroll_actor, priv->scroll_transform_id);
+      g_signal_handler_disconnect (priv->scroll_actor, priv->scroll_allocation_id);
+      priv->scroll_transform_id = 0;
+      priv->scroll_allocation_id = 0;
+    }
+
+  priv->scroll_actor = scroll_actor;
+
+  if (priv->scroll_actor != NULL)
+    {
+      priv->scroll_transform_id =
+        g_signal_connect (priv->scroll_actor, "notify::child-transform",
+                          G_CALLBACK (on_scroll_transform_changed),
+                          self);
+      priv->scroll_allocation_id =
+        g_signal_connect (priv->scroll_actor, "notify::allocation",
+                          G_CALLBACK (on_scroll_allocation_changed),
+                          self);
+    }
+}
+
+static void
+clutter_list_view_map (ClutterActor *actor)
+{
+  ClutterListView *self = CLUTTER_LIST_VIEW (actor);
+  ClutterActor *ancestor;
+
+  CLUTTER_ACTOR_CLASS (clutter_list_view_parent_class)->map (actor);
+
+  for (ancestor = clutter_actor_get_parent (actor);
+       ancestor != NULL;
+       ancestor = clutter_actor_get_parent (ancestor))
+    {
+      if (CLUTTER_IS_SCROLL_ACTOR (ancestor))
+        break;
+    }
+
+  clutter_list_view_set_scroll_actor (self, (ClutterScrollActor *) ancestor);
+  clutter_list_view_queue_update (self);
+}
+
+static void
+clutter_list_view_unmap (ClutterActor *actor)
+{
+  ClutterListView *self = CLUTTER_LIST_VIEW (actor);
+
+  CLUTTER_ACTOR_CLASS (clutter_list_view_parent_class)->unmap (actor);
+
+  clutter_list_view_set_scroll_actor (self, NULL);
+}
+
+static void
+clutter_list_view_allocate (ClutterActor           *actor,
+                            const ClutterActorBox  *box,
+                            ClutterAllocationFlags  flags)
+{
+  ClutterListView *self = CLUTTER_LIST_VIEW (actor);
+  ClutterListViewPrivate *priv = self->priv;
+  guint first_row, last_row;
+
+  /* the layout manager allocates the realized rows */
+  CLUTTER_ACTOR_CLASS (clutter_list_view_parent_class)->allocate (actor, box,
+                                                                  flags | CLUTTER_DELEGATE_LAYOUT);
+
+  /* the visible rows can only be updated once the allocation is done */
+  if (!clutter_list_view_get_visible_rows (self, &first_row, &last_row))
+    {
+      if (priv->rows->len != 0)
+        clutter_list_view_queue_update (self);
+    }
+  else if (first_row != priv->first_row ||
+           last_row + 1 != priv->first_row + priv->rows->len)
+    {
+      clutter_list_view_queue_update (self);
+    }
+}
+
+static void
+clutter_list_view_set_property (GObject      *gobject,
+                                guint         prop_id,
+                                const GValue *value,
+                                GParamSpec   *pspec)
+{
+  ClutterListView *self = CLUTTER_LIST_VIEW (gobject);
+
+  switch (prop_id)
+    {
+    case PROP_N_ROWS:
+      clutter_list_view_set_n_rows (self, g_value_get_uint (value));
+      break;
+
+    case PROP_ESTIMATED_ROW_HEIGHT:
+      clutter_list_view_set_estimated_row_height (self, g_value_get_float (value));
+      break;
+
+    case PROP_OVERSCAN:
+      clutter_list_view_set_overscan (self, g_value_get_float (value));
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
+    }
+}
+
+static void
+clutter_list_view_get_property (GObject    *gobject,
+                                guint       prop_id,
+                                GValue     *value,
+                                GParamSpec *pspec)
+{
+  ClutterListViewPrivate *priv = CLUTTER_LIST_VIEW (gobject)->priv;
+
+  switch (prop_id)
+    {
+    case PROP_N_ROWS:
+      g_value_set_uint (value, priv->n_rows);
+      break;
+
+    case PROP_ESTIMATED_ROW_HEIGHT:
+      g_value_set_float (value, clutter_list_layout_get_estimated_row_height (priv->layout));
+      break;
+
+    case PROP_OVERSCAN:
+      g_value_set_float (value, priv->overscan);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
+    }
+}
+
+static void
+clutter_list_view_dispose (GObject *gobject)
+{
+  ClutterListView *self = CLUTTER_LIST_VIEW (gobject);
+  ClutterListViewPrivate *priv = self->priv;
+
+  if (priv->update_id != 0)
+    {
+      clutter_threads_remove_repaint_func (priv->update_id);
+      priv->update_id = 0;
+    }
+
+  clutter_list_view_set_scroll_actor (self, NULL);
+
+  /* the row actors are destroyed with the other children */
+  g_ptr_array_set_size (priv->rows, 0);
+  g_ptr_array_set_size (priv->pool, 0);
+
+  if (priv->factory_notify != NULL)
+    priv->factory_notify (priv->factory_data);
+
+  priv->create_func = NULL;
+  priv->bind_func = NULL;
+  priv->factory_data = NULL;
+  priv->factory_notify = NULL;
+
+  G_OBJECT_CLASS (clutter_list_view_parent_class)->dispose (gobject);
+}
+
+static void
+clutter_list_view_finalize (GObject *gobject)
+{
+  ClutterListViewPrivate *priv = CLUTTER_LIST_VIEW (gobject)->priv;
+
+  g_ptr_array_unref (priv->rows);
+  g_ptr_array_unref (priv->pool);
+
+  G_OBJECT_CLASS (clutter_list_view_parent_class)->finalize (gobject);
+}
+
+static void
+clutter_list_view_class_init (ClutterListViewClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  ClutterActorClass *actor_class = CLUTTER_ACTOR_CLASS (klass);
+
+  gobject_class->set_property = clutter_list_view_set_property;
+  gobject_class->get_property = clutter_list_view_get_property;
+  gobject_class->dispose = clutter_list_view_dispose;
+  gobject_class->finalize = clutter_list_view_finalize;
+
+  actor_class->map = clutter_list_view_map;
+  actor_class->unmap = clutter_list_view_unmap;
+  actor_class->allocate = clutter_list_view_allocate;
+
+  /**
+   * ClutterListView:n-rows:
+   *
+   * The number of rows of the list view.
+   *
+   * Since: 1.28
+   */
+  obj_props[PROP_N_ROWS] =
+    g_param_spec_uint ("n-rows",
+                       P_("Number of rows"),
+                       P_("The number of rows of the list view"),
+                       0, G_MAXUINT,
+                       0,
+                       G_PARAM_READWRITE |
+                       G_PARAM_STATIC_STRINGS);
+
+  /**
+   * ClutterListView:estimated-row-height:
+   *
+   * The height assumed for the rows that have not been displayed yet.
+   *
+   * Since: 1.28
+   */
+  obj_props[PROP_ESTIMATED_ROW_HEIGHT] =
+    g_param_spec_float ("estimated-row-height",
+                        P_("Estimated row height"),
+                        P_("The height assumed for the rows that have not been displayed"),
+                        1.f, G_MAXFLOAT,
+                        32.f,
+                        G_PARAM_READWRITE |
+                        G_PARAM_STATIC_STRINGS);
+
+  /**
+   * ClutterListView:overscan:
+   *
+   * The distance from the visible area, in pixels, within which the
+   * rows are created even if they are not visible.
+   *
+   * Since: 1.28
+   */
+  obj_props[PROP_OVERSCAN] =
+    g_param_spec_float ("overscan",
+                        P_("Overscan"),
+                        P_("The distance from the visible area within which the rows are created"),
+                        0.f, G_MAXFLOAT,
+                        200.f,
+                        G_PARAM_READWRITE |
+                        G_PARAM_STATIC_STRINGS);
+
+  g_object_class_install_properties (gobject_class, PROP_LAST, obj_props);
+}
+
+static void
+clutter_list_view_init (ClutterListView *self)
+{
+  ClutterListViewPrivate *priv;
+
+  self->priv = priv = clutter_list_view_get_instance_private (self);
+
+  priv->overscan = 200.f;
+
+  priv->layout = CLUTTER_LIST_LAYOUT (clutter_list_layout_new ());
+  clutter_actor_set_layout_manager (CLUTTER_ACTOR (self),
+                                    CLUTTER_LAYOUT_MANAGER (priv->layout));
+
+  priv->rows = g_ptr_array_new ();
+  priv->pool = g_ptr_array_new ();
+}
+
+/**
+ * clutter_list_view_new:
+ *
+ * Creates a new #ClutterListView actor.
+ *
+ * Return value: The newly created #ClutterListView actor.
+ *
+ * Since: 1.28
+ */
+ClutterActor *
+clutter_list_view_new (void)
+{
+  return g_object_new (CLUTTER_TYPE_LIST_VIEW, NULL);
+}
+
+/**
+ * clutter_list_view_set_row_factory:
+ * @view: a #ClutterListView
+ * @create_func: (allow-none): the function creating the actors of the rows
+ * @bind_func: (allow-none): the function setting up an actor for a row
+ * @user_data: (closure): data passed to @create_func and @bind_func
+ * @notify: function called when @user_data is not needed any more
+ *
+ * Sets the functions used by @view to create the actors for its rows,
+ * and to set them up for a given row.
+ *
+ * The actors created by @view for the previous factory are destroyed.
+ *
+ * Since: 1.28
+ */
+void
+clutter_list_view_set_row_factory (ClutterListView           *view,
+                                   ClutterListViewCreateFunc  create_func,
+                                   ClutterListViewBindFunc    bind_func,
+                                   gpointer                   user_data,
+                                   GDestroyNotify             notify)
+{
+  ClutterListViewPrivate *priv;
+
+  g_return_if_fail (CLUTTER_IS_LIST_VIEW (view));
+
+  priv = view->priv;
+
+  clutter_list_view_clear_rows (view);
+
+  if (priv->factory_notify != NULL)
+    priv->factory_notify (priv->factory_data);
+
+  priv->create_func = create_func;
+  priv->bind_func = bind_func;
+  priv->factory_data = user_data;
+  priv->factory_notify = notify;
+
+  clutter_list_view_queue_update (view);
+}
+
+/**
+ * clutter_list_view_set_n_rows:
+ * @view: a #ClutterListView
+ * @n_rows: the number of rows
+ *
+ * Sets the number of rows displayed by @view.
+ *
+ * The rows that are kept keep their measured height, and their actors
+ * are not set up again; use clutter_list_view_invalidate_rows() if
+ * their contents changed.
+ *
+ * Since: 1.28
+ */
+void
+clutter_list_view_set_n_rows (ClutterListView *view,
+                              guint            n_rows)
+{
+  ClutterListViewPrivate *priv;
+  guint i;
+
+  g_return_if_fail (CLUTTER_IS_LIST_VIEW (view));
+
+  priv = view->priv;
+
+  if (priv->n_rows == n_rows)
+    return;
+
+  /* the actors of the removed rows are recycled right away, as a
+   * relayout can happen before the rows are updated
+   */
+  if (priv->first_row + priv->rows->len > n_rows)
+    {
+      guint n_kept = priv->first_row < n_rows ? n_rows - priv->first_row : 0;
+      guint max_pool_size = priv->rows->len;
+
+      for (i = n_kept; i < priv->rows->len; i++)
+        {
+          ClutterActor *row_actor = g_ptr_array_index (priv->rows, i);
+
+          clutter_list_view_recycle_row (view, row_actor, max_pool_size);
+        }
+
+      g_ptr_array_set_size (priv->rows, n_kept);
+      priv->first_row = MIN (priv->first_row, n_rows);
+    }
+
+  priv->n_rows = n_rows;
+
+  /* the layout manager forgets the heights of the removed rows */
+  clutter_list_layout_set_first_row (priv->layout, priv->first_row);
+  clutter_list_layout_set_n_rows (priv->layout, n_rows);
+
+  clutter_list_view_queue_update (view);
+
+  g_object_notify_by_pspec (G_OBJECT (view), obj_props[PROP_N_ROWS]);
+}
+
+/**
+ * clutter_list_view_get_n_rows:
+ * @view: a #ClutterListView
+ *
+ * Retrieves the number of rows set using clutter_list_view_set_n_rows().
+ *
+ * Return value: the number of rows
+ *
+ * Since: 1.28
+ */
+guint
+clutter_list_view_get_n_rows (ClutterListView *view)
+{
+  g_return_val_if_fail (CLUTTER_IS_LIST_VIEW (view), 0);
+
+  return view->priv->n_rows;
+}
+
+/**
+ * clutter_list_view_set_estimated_row_height:
+ * @view: a #ClutterListView
+ * @height: the estimated height of the rows, in pixels
+ *
+ * Sets the height assumed for the rows of @view that have not been
+ * displayed yet. An estimate close to the average height of the rows
+ * keeps the size of @view, and the position of the scroll bars, from
+ * changing as the rows are displayed.
+ *
+ * Since: 1.28
+ */
+void
+clutter_list_view_set_estimated_row_height (ClutterListView *view,
+                                            gfloat           height)
+{
+  ClutterListViewPrivate *priv;
+
+  g_return_if_fail (CLUTTER_IS_LIST_VIEW (view));
+  g_return_if_fail (height >= 1.f);
+
+  priv = view->priv;
+
+  if (clutter_list_layout_get_estimated_row_height (priv->layout) == height)
+    return;
+
+  clutter_list_layout_set_estimated_row_height (priv->layout, height);
+
+  clutter_list_view_queue_update (view);
+
+  g_object_notify_by_pspec (G_OBJECT (view), obj_props[PROP_ESTIMATED_ROW_HEIGHT]);
+}
+
+/**
+ * clutter_list_view_get_estimated_row_height:
+ * @view: a #ClutterListView
+ *
+ * Retrieves the height set using clutter_list_view_set_estimated_row_height().
+ *
+ * Return value: the estimated height of the rows
+ *
+ * Since: 1.28
+ */
+gfloat
+clutter_list_view_get_estimated_row_height (ClutterListView *view)
+{
+  g_return_val_if_fail (CLUTTER_IS_LIST_VIEW (view), 0.f);
+
+  return clutter_list_layout_get_estimated_row_height (view->priv->layout);
+}
+
+/**
+ * clutter_list_view_set_overscan:
+ * @view: a #ClutterListView
+ * @overscan: a distance, in pixels
+ *
+ * Sets the distance from the visible area within which @view creates
+ * the actors of its rows, so that they are ready before being scrolled
+ * into view.
+ *
+ * Since: 1.28
+ */
+void
+clutter_list_view_set_overscan (ClutterListView *view,
+                                gfloat           overscan)
+{
+  ClutterListViewPrivate *priv;
+
+  g_return_if_fail (CLUTTER_IS_LIST_VIEW (view));
+  g_return_if_fail (overscan >= 0.f);
+
+  priv = view->priv;
+
+  if (priv->overscan == overscan)
+    return;
+
+  priv->overscan = overscan;
+
+  clutter_list_view_queue_update (view);
+
+  g_object_notify_by_pspec (G_OBJECT (view), obj_props[PROP_OVERSCAN]);
+}
+
+/**
+ * clutter_list_view_get_overscan:
+ * @view: a #ClutterListView
+ *
+ * Retrieves the distance set using clutter_list_view_set_overscan().
+ *
+ * Return value: the overscan, in pixels
+ *
+ * Since: 1.28
+ */
+gfloat
+clutter_list_view_get_overscan (ClutterListView *view)
+{
+  g_return_val_if_fail (CLUTTER_IS_LIST_VIEW (view), 0.f);
+
+  return view->priv->overscan;
+}
+
+/**
+ * clutter_list_view_invalidate_rows:
+ * @view: a #ClutterListView
+ * @first_row: the index of the first row to invalidate
+ * @n_rows: the number of rows to invalidate
+ *
+ * Notifies @view that the contents of the given rows changed: the
+ * actors displaying them are set up again, and their heights are
+ * measured again.
+ *
+ * Since: 1.28
+ */
+void
+clutter_list_view_invalidate_rows (ClutterListView *view,
+                                   guint            first_row,
+                                   guint            n_rows)
+{
+  ClutterListViewPrivate *priv;
+  guint i, last_row;
+
+  g_return_if_fail (CLUTTER_IS_LIST_VIEW (view));
+
+  priv = view->priv;
+
+  if (first_row >= priv->n_rows)
+    return;
+
+  last_row = first_row + MIN (n_rows, priv->n_rows - first_row);
+
+  clutter_list_layout_invalidate_rows (priv->layout, first_row, n_rows);
+
+  for (i = MAX (first_row, priv->first_row);
+       i < MIN (last_row, priv->first_row + priv->rows->len);
+       i++)
+    {
+      ClutterActor *row_actor = g_ptr_array_index (priv->rows, i - priv->first_row);
+
+      if (priv->bind_func != NULL)
+        priv->bind_func (view, row_actor, i, priv->factory_data);
+    }
+}
+
+/**
+ * clutter_list_view_get_row_actor:
+ * @view: a #ClutterListView
+ * @row: the index of a row
+ *
+ * Retrieves the actor displaying @row, if @row is within the visible
+ * area of @view, or within the overscan.
+ *
+ * The actor is only valid until the next time @view is scrolled, or
+ * the next frame is painted.
+ *
+ * Return value: (transfer none): the actor displaying @row, or %NULL
+ *
+ * Since: 1.28
+ */
+ClutterActor *
+clutter_list_view_get_row_actor (ClutterListView *view,
+                                 guint            row)
+{
+  ClutterListViewPrivate *priv;
+
+  g_return_val_if_fail (CLUTTER_IS_LIST_VIEW (view), NULL);
+
+  priv = view->priv;
+
+  if (row < priv->first_row || row >= priv->first_row + priv->rows->len)
+    return NULL;
+
+  return g_ptr_array_index (priv->rows, row - priv->first_row);
+}
+
+/**
+ * clutter_list_view_get_row_area:
+ * @view: a #ClutterListView
+ * @row: the index of a row
+ * @y: (out) (allow-none): return location for the offset of the row
+ * @height: (out) (allow-none): return location for the height of the row
+ *
+ * Retrieves the area of @row, relative to @view. The area of the rows
+ * that have not been displayed yet is based on the estimated height of
+ * the rows.
+ *
+ * This function can be used to scroll a #ClutterScrollActor to a row.
+ *
+ * Return value: %TRUE if @row is a row of @view
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_list_view_get_row_area (ClutterListView *view,
+                                guint            row,
+                                gfloat          *y,
+                                gfloat          *height)
+{
+  g_return_val_if_fail (CLUTTER_IS_LIST_VIEW (view), FALSE);
+
+  return clutter_list_layout_get_row_area (view->priv->layout, row, y, height);
+}
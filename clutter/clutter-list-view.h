@@ -0,0 +1,150 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CLUTTER_LIST_VIEW_H__
+#define __CLUTTER_LIST_VIEW_H__
+
+#if !defined(__CLUTTER_H_INSIDE__) && !defined(CLUTTER_COMPILATION)
+#error "Only <clutter/clutter.h> can be included directly."
+#endif
+
+#include <clutter/clutter-types.h>
+#include <clutter/clutter-actor.h>
+
+G_BEGIN_DECLS
+
+#define CLUTTER_TYPE_LIST_VIEW                  (clutter_list_view_get_type ())
+#define CLUTTER_LIST_VIEW(obj)                  (G_TYPE_CHECK_INSTANCE_CAST ((obj), CLUTTER_TYPE_LIST_VIEW, ClutterListView))
+#define CLUTTER_IS_LIST_VIEW(obj)               (G_TYPE_CHECK_INSTANCE_TYPE ((obj), CLUTTER_TYPE_LIST_VIEW))
+#define CLUTTER_LIST_VIEW_CLASS(klass)          (G_TYPE_CHECK_CLASS_CAST ((klass), CLUTTER_TYPE_LIST_VIEW, ClutterListViewClass))
+#define CLUTTER_IS_LIST_VIEW_CLASS(klass)       (G_TYPE_CHECK_CLASS_TYPE ((klass), CLUTTER_TYPE_LIST_VIEW))
+#define CLUTTER_LIST_VIEW_GET_CLASS(obj)        (G_TYPE_INSTANCE_GET_CLASS ((obj), CLUTTER_TYPE_LIST_VIEW, ClutterListViewClass))
+
+typedef struct _ClutterListViewPrivate          ClutterListViewPrivate;
+typedef struct _ClutterListViewClass            ClutterListViewClass;
+
+/**
+ * ClutterListView:
+ *
+ * The #ClutterListView structure contains only
+ * private data, and should be accessed using the provided API.
+ *
+ * Since: 1.28
+ */
+struct _ClutterListView
+{
+  /*< private >*/
+  ClutterActor parent_instance;
+
+  ClutterListViewPrivate *priv;
+};
+
+/**
+ * ClutterListViewClass:
+ *
+ * The #ClutterListViewClass structure contains only
+ * private data.
+ *
+ * Since: 1.28
+ */
+struct _ClutterListViewClass
+{
+  /*< private >*/
+  ClutterActorClass parent_class;
+
+  gpointer _padding[8];
+};
+
+/**
+ * ClutterListViewCreateFunc:
+ * @view: the #ClutterListView
+ * @user_data: the data passed to clutter_list_view_set_row_factory()
+ *
+ * Creates an actor for displaying the rows of @view. The actor is
+ * reused for different rows, and is set up for each of them by the
+ * #ClutterListViewBindFunc.
+ *
+ * Return value: (transfer full): a new #ClutterActor
+ *
+ * Since: 1.28
+ */
+typedef ClutterActor * (* ClutterListViewCreateFunc) (ClutterListView *view,
+                                                      gpointer         user_data);
+
+/**
+ * ClutterListViewBindFunc:
+ * @view: the #ClutterListView
+ * @row_actor: an actor created by the #ClutterListViewCreateFunc
+ * @row: the index of the row to display
+ * @user_data: the data passed to clutter_list_view_set_row_factory()
+ *
+ * Sets up @row_actor for displaying the row at index @row.
+ *
+ * Since: 1.28
+ */
+typedef void (* ClutterListViewBindFunc) (ClutterListView *view,
+                                          ClutterActor    *row_actor,
+                                          guint            row,
+                                          gpointer         user_data);
+
+CLUTTER_AVAILABLE_IN_1_28
+GType clutter_list_view_get_type (void) G_GNUC_CONST;
+
+CLUTTER_AVAILABLE_IN_1_28
+ClutterActor *  clutter_list_view_new                           (void);
+
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_list_view_set_row_factory               (ClutterListView           *view,
+                                                                 ClutterListViewCreateFunc  create_func,
+                                                                 ClutterListViewBindFunc    bind_func,
+                                                                 gpointer                   user_data,
+                                                                 GDestroyNotify             notify);
+
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_list_view_set_n_rows                    (ClutterListView           *view,
+                                                                 guint                      n_rows);
+CLUTTER_AVAILABLE_IN_1_28
+guint           clutter_list_view_get_n_rows                    (ClutterListView           *view);
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_list_view_set_estimated_row_height      (ClutterListView           *view,
+                                                                 gfloat                     height);
+CLUTTER_AVAILABLE_IN_1_28
+gfloat          clutter_list_view_get_estimated_row_height      (ClutterListView           *view);
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_list_view_set_overscan                  (ClutterListView           *view,
+                                                                 gfloat                     overscan);
+CLUTTER_AVAILABLE_IN_1_28
+gfloat          clutter_list_view_get_overscan                  (ClutterListView           *view);
+
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_list_view_invalidate_rows               (ClutterListView           *view,
+                                                                 guint                      first_row,
+                                                                 guint                      n_rows);
+CLUTTER_AVAILABLE_IN_1_28
+ClutterActor *  clutter_list_view_get_row_actor                 (ClutterListView           *view,
+                                                                 guint                      row);
+CLUTTER_AVAILABLE_IN_1_28
+gboolean        clutter_list_view_get_row_area                  (ClutterListView           *view,
+                                                                 guint                      row,
+                                                                 gfloat                    *y,
+                                                                 gfloat                    *height);
+
+G_END_DECLS
+
+#endif /* __CLUTTER_LIST_VIEW_H__ */
@@ -64,6 +64,7 @@
 #include "clutter-feature.h"
 #include "clutter-main.h"
 #include "clutter-master-clock.h"
+#include "clutter-master-clock-manual.h"
 #include "clutter-private.h"
 #include "clutter-settings-private.h"
 #include "clutter-stage-manager.h"
@@ -91,6 +92,9 @@
 #ifdef CLUTTER_WINDOWING_MIR
 #include "mir/clutter-backend-mir.h"
 #endif
+#ifdef CLUTTER_WINDOWING_HEADLESS
+#include "headless/clutter-backend-headless.h"
+#endif
 
 #include <cogl/cogl.h>
 #include <cogl-pango/cogl-pango.h>
@@ -501,6 +505,101 @@ clutter_disable_accessibility (void)
   clutter_enable_accessibility = FALSE;
 }
 
+/**
+ * clutter_enable_manual_master_clock:
+ *
+ * Replaces the master clock, which runs the frames of every stage at
+ * the pace of the system clock and of the vertical refresh, with one
+ * that only runs frames when clutter_master_clock_step() is called.
+ *
+ * This is meant for benchmarks and tests, which need the same frames
+ * to be run regardless of the load of the system. This function must
+ * be called before clutter_init().
+ *
+ * Since: 1.28
+ */
+void
+clutter_enable_manual_master_clock (void)
+{
+  ClutterMainContext *context;
+
+  if (clutter_is_initialized)
+    {
+      g_warning ("clutter_enable_manual_master_clock() can only be called "
+                 "before initializing Clutter.");
+      return;
+    }
+
+  context = _clutter_context_get_default ();
+  context->use_manual_clock = TRUE;
+}
+
+/**
+ * clutter_master_clock_step:
+ * @n_frames: the number of frames to run
+ * @frame_interval: the interval between two frames, in microseconds
+ *
+ * Runs @n_frames frames, advancing the time of the master clock by
+ * @frame_interval microseconds before each of them.
+ *
+ * Each frame processes the events queued on the stages, advances the
+ * timelines and relayouts and redraws the stages that need it, exactly
+ * like a frame of the default master clock, but it does not depend on
+ * the system time; events coming from the windowing system are only
+ * queued when the main loop runs.
+ *
+ * This function can only be used after calling
+ * clutter_enable_manual_master_clock(), and it cannot be called from
+ * within a frame, for instance from a paint handler.
+ *
+ * Since: 1.28
+ */
+void
+clutter_master_clock_step (guint  n_frames,
+                           gint64 frame_interval)
+{
+  ClutterMasterClock *master_clock;
+
+  g_return_if_fail (frame_interval >= 0);
+
+  master_clock = _clutter_master_clock_get_default ();
+  if (!CLUTTER_IS_MASTER_CLOCK_MANUAL (master_clock))
+    {
+      g_critical ("The master clock can only be stepped after calling "
+                  "clutter_enable_manual_master_clock().");
+      return;
+    }
+
+  _clutter_master_clock_manual_step (CLUTTER_MASTER_CLOCK_MANUAL (master_clock),
+                                     n_frames,
+                                     frame_interval);
+}
+
+/**
+ * clutter_master_clock_get_time:
+ *
+ * Retrieves the time of the last frame run by clutter_master_clock_step().
+ *
+ * The time of the manual master clock starts at zero and is only
+ * advanced by clutter_master_clock_step().
+ *
+ * Return value: the time, in microseconds, or -1 if the manual master
+ *   clock is not enabled
+ *
+ * Since: 1.28
+ */
+gint64
+clutter_master_clock_get_time (void)
+{
+  ClutterMasterClock *master_clock;
+
+  master_clock = _clutter_master_clock_get_default ();
+  if (!CLUTTER_IS_MASTER_CLOCK_MANUAL (master_clock))
+    return -1;
+
+  return _clutter_master_clock_manual_get_time (CLUTTER_MASTER_CLOCK_MANUAL (master_clock));
+}
+
 /**
  * clutter_redraw:
  *
@@ -3066,6 +3165,360 @@ clutter_clear_glyph_cache (void)
   cogl_pango_font_map_clear_glyph_cache (font_map);
 }
 
+/* number of characters rasterised for each iteration of the
+ * glyph cache warm-up idle source
+ */
+#define GLYPH_WARM_UP_CHUNK     64
+
+#define GLYPH_MANIFEST_KEY      "characters"
+
+typedef struct _GlyphWarmUpJob
+{
+  PangoFontDescription *font_desc;
+  PangoLayout *layout;
+
+  gchar *characters;
+  const gchar *cursor;
+} GlyphWarmUpJob;
+
+static void
+glyph_warm_up_job_free (gpointer data)
+{
+  GlyphWarmUpJob *job = data;
+
+  if (job == NULL)
+    return;
+
+  pango_font_description_free (job->font_desc);
+  g_clear_object (&job->layout);
+  g_free (job->characters);
+
+  g_slice_free (GlyphWarmUpJob, job);
+}
+
+static PangoContext *
+clutter_glyph_cache_create_pango_context (void)
+{
+  ClutterBackend *backend = clutter_get_default_backend ();
+  PangoContext *context;
+  gdouble resolution;
+
+  context =
+    cogl_pango_font_map_create_context (clutter_context_get_pango_fontmap ());
+
+  /* we need the same configuration used by the actors, otherwise the
+   * glyphs we rasterise will not match the ones looked up at paint time
+   */
+  resolution = clutter_backend_get_resolution (backend);
+  if (resolution < 0)
+    resolution = 96.0; /* fall back */
+
+  pango_cairo_context_set_font_options (context,
+                                        clutter_backend_get_font_options (backend));
+  pango_cairo_context_set_resolution (context, resolution);
+  pango_context_set_language (context, pango_language_get_default ());
+
+  return context;
+}
+
+static void
+clutter_glyph_cache_record (ClutterMainContext         *context,
+                            const PangoFontDescription *font_desc,
+                            const gchar                *text,
+                            const gchar                *text_end)
+{
+  GHashTable *glyph_set;
+  const gchar *p;
+  gchar *key;
+
+  if (context->glyph_warm_up_manifest == NULL)
+    context->glyph_warm_up_manifest =
+      g_hash_table_new_full (g_str_hash, g_str_equal,
+                             g_free,
+                             (GDestroyNotify) g_hash_table_unref);
+
+  key = pango_font_description_to_string (font_desc);
+
+  glyph_set = g_hash_table_lookup (context->glyph_warm_up_manifest, key);
+  if (glyph_set == NULL)
+    {
+      glyph_set = g_hash_table_new (NULL, NULL);
+      g_hash_table_insert (context->glyph_warm_up_manifest, key, glyph_set);
+    }
+  else
+    g_free (key);
+
+  for (p = text; p < text_end; p = g_utf8_next_char (p))
+    g_hash_table_add (glyph_set, GUINT_TO_POINTER (g_utf8_get_char (p)));
+}
+
+static gboolean
+clutter_glyph_cache_warm_up_idle (gpointer data G_GNUC_UNUSED)
+{
+  ClutterMainContext *context = _clutter_context_get_default ();
+  GlyphWarmUpJob *job;
+  const gchar *end;
+  guint n_chars;
+
+  job = context->glyph_warm_up_jobs != NULL
+      ? g_queue_peek_head (context->glyph_warm_up_jobs)
+      : NULL;
+  if (job == NULL)
+    {
+      context->glyph_warm_up_id = 0;
+      return G_SOURCE_REMOVE;
+    }
+
+  if (job->layout == NULL)
+    {
+      PangoContext *pango_context;
+
+      pango_context = clutter_glyph_cache_create_pango_context ();
+      job->layout = pango_layout_new (pango_context);
+      pango_layout_set_font_description (job->layout, job->font_desc);
+      g_object_unref (pango_context);
+    }
+
+  /* rasterise the glyphs in small chunks, so that we don't block
+   * the frame processing for too long
+   */
+  end = job->cursor;
+  for (n_chars = 0; *end != '\0' && n_chars < GLYPH_WARM_UP_CHUNK; n_chars++)
+    end = g_utf8_next_char (end);
+
+  pango_layout_set_text (job->layout, job->cursor, end - job->cursor);
+  cogl_pango_ensure_glyph_cache_for_layout (job->layout);
+
+  CLUTTER_NOTE (PANGO, "Warmed up %u glyphs", n_chars);
+
+  clutter_glyph_cache_record (context, job->font_desc, job->cursor, end);
+
+  job->cursor = end;
+  if (*job->cursor == '\0')
+    glyph_warm_up_job_free (g_queue_pop_head (context->glyph_warm_up_jobs));
+
+  if (g_queue_is_empty (context->glyph_warm_up_jobs))
+    {
+      g_clear_pointer (&context->glyph_warm_up_jobs, g_queue_free);
+      context->glyph_warm_up_id = 0;
+      return G_SOURCE_REMOVE;
+    }
+
+  return G_SOURCE_CONTINUE;
+}
+
+/*< private >
+ * _clutter_clear_glyph_cache_warm_up:
+ *
+ * Cancels the pending glyph cache warm-up jobs and forgets the
+ * characters recorded for the manifest.
+ */
+void
+_clutter_clear_glyph_cache_warm_up (void)
+{
+  ClutterMainContext *context = _clutter_context_get_default ();
+
+  if (context->glyph_warm_up_id != 0)
+    {
+      g_source_remove (context->glyph_warm_up_id);
+      context->glyph_warm_up_id = 0;
+    }
+
+  if (context->glyph_warm_up_jobs != NULL)
+    {
+      g_queue_free_full (context->glyph_warm_up_jobs, glyph_warm_up_job_free);
+      context->glyph_warm_up_jobs = NULL;
+    }
+
+  g_clear_pointer (&context->glyph_warm_up_manifest, g_hash_table_unref);
+}
+
+/**
+ * clutter_glyph_cache_warm_up:
+ * @font_desc: a #PangoFontDescription
+ * @characters: a UTF-8 encoded string with the characters to rasterise
+ *
+ * Queues the rasterisation of the glyphs for @characters, using the
+ * font described by @font_desc, into the glyph cache of the font map
+ * returned by clutter_get_font_map().
+ *
+ * The glyphs are rasterised in small batches from an idle handler
+ * with a low priority, so that the warm-up does not delay the frame
+ * processing; the text drawn afterwards using the same font will not
+ * need to rasterise the glyphs the first time it is painted.
+ *
+ * The characters are also recorded, so that they can be saved using
+ * clutter_glyph_cache_save_manifest() and pre-rasterised on the next
+ * run with clutter_glyph_cache_load_manifest().
+ *
+ * This function can only be called after Clutter has been initialized.
+ *
+ * Since: 1.28
+ */
+void
+clutter_glyph_cache_warm_up (const PangoFontDescription *font_desc,
+                             const gchar                *characters)
+{
+  ClutterMainContext *context;
+  GlyphWarmUpJob *job;
+
+  g_return_if_fail (font_desc != NULL);
+  g_return_if_fail (characters != NULL);
+  g_return_if_fail (g_utf8_validate (characters, -1, NULL));
+
+  if (!_clutter_context_is_initialized ())
+    {
+      g_critical ("Clutter has not been initialized; the glyph cache "
+                  "can only be warmed up after calling clutter_init()");
+      return;
+    }
+
+  if (*characters == '\0')
+    return;
+
+  context = _clutter_context_get_default ();
+
+  job = g_slice_new0 (GlyphWarmUpJob);
+  job->font_desc = pango_font_description_copy (font_desc);
+  job->characters = g_strdup (characters);
+  job->cursor = job->characters;
+
+  if (context->glyph_warm_up_jobs == NULL)
+    context->glyph_warm_up_jobs = g_queue_new ();
+
+  g_queue_push_tail (context->glyph_warm_up_jobs, job);
+
+  if (context->glyph_warm_up_id == 0)
+    context->glyph_warm_up_id =
+      clutter_threads_add_idle_full (G_PRIORITY_LOW,
+                                     clutter_glyph_cache_warm_up_idle,
+                                     NULL,
+                                     NULL);
+}
+
+/**
+ * clutter_glyph_cache_save_manifest:
+ * @filename: (type filename): the path of the file to write
+ * @error: return location for a #GError, or %NULL
+ *
+ * Saves the list of glyphs that have been rasterised through
+ * clutter_glyph_cache_warm_up(), grouped by font description and
+ * size, into @filename.
+ *
+ * The rasterised glyphs are owned by the GPU glyph atlas, so only the
+ * characters are stored; the file can be passed to
+ * clutter_glyph_cache_load_manifest() on the next run to pre-rasterise
+ * the same glyphs during idle time.
+ *
+ * Return value: %TRUE if the manifest was saved, and %FALSE otherwise
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_glyph_cache_save_manifest (const gchar  *filename,
+                                   GError      **error)
+{
+  ClutterMainContext *context;
+  GKeyFile *keyfile;
+  GHashTableIter iter;
+  gpointer key, value;
+  gboolean res;
+
+  g_return_val_if_fail (filename != NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  context = _clutter_context_get_default ();
+
+  keyfile = g_key_file_new ();
+
+  if (context->glyph_warm_up_manifest != NULL)
+    {
+      g_hash_table_iter_init (&iter, context->glyph_warm_up_manifest);
+      while (g_hash_table_iter_next (&iter, &key, &value))
+        {
+          GHashTableIter glyph_iter;
+          gpointer glyph;
+          GString *characters;
+
+          characters = g_string_sized_new (g_hash_table_size (value) * 2);
+
+          g_hash_table_iter_init (&glyph_iter, value);
+          while (g_hash_table_iter_next (&glyph_iter, &glyph, NULL))
+            g_string_append_unichar (characters, GPOINTER_TO_UINT (glyph));
+
+          g_key_file_set_string (keyfile, key,
+                                 GLYPH_MANIFEST_KEY,
+                                 characters->str);
+
+          g_string_free (characters, TRUE);
+        }
+    }
+
+  res = g_key_file_save_to_file (keyfile, filename, error);
+
+  g_key_file_free (keyfile);
+
+  return res;
+}
+
+/**
+ * clutter_glyph_cache_load_manifest:
+ * @filename: (type filename): the path of the file to read
+ * @error: return location for a #GError, or %NULL
+ *
+ * Loads a manifest saved by clutter_glyph_cache_save_manifest() and
+ * calls clutter_glyph_cache_warm_up() for each font it contains.
+ *
+ * This function can only be called after Clutter has been initialized.
+ *
+ * Return value: %TRUE if the manifest was loaded, and %FALSE otherwise
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_glyph_cache_load_manifest (const gchar  *filename,
+                                   GError      **error)
+{
+  GKeyFile *keyfile;
+  gchar **fonts;
+  gsize i, n_fonts;
+
+  g_return_val_if_fail (filename != NULL, FALSE);
+  g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+  keyfile = g_key_file_new ();
+
+  if (!g_key_file_load_from_file (keyfile, filename, G_KEY_FILE_NONE, error))
+    {
+      g_key_file_free (keyfile);
+      return FALSE;
+    }
+
+  fonts = g_key_file_get_groups (keyfile, &n_fonts);
+  for (i = 0; i < n_fonts; i++)
+    {
+      PangoFontDescription *font_desc;
+      gchar *characters;
+
+      characters = g_key_file_get_string (keyfile, fonts[i],
+                                          GLYPH_MANIFEST_KEY,
+                                          NULL);
+      if (characters == NULL)
+        continue;
+
+      font_desc = pango_font_description_from_string (fonts[i]);
+      clutter_glyph_cache_warm_up (font_desc, characters);
+
+      pango_font_description_free (font_desc);
+      g_free (characters);
+    }
+
+  g_strfreev (fonts);
+  g_key_file_free (keyfile);
+
+  return TRUE;
+}
+
 /**
  * clutter_set_font_flags:
  * @flags: The new flags
@@ -3684,6 +4137,12 @@ clutter_check_windowing_backend (const char *backend_type)
     return TRUE;
   else
 #endif
+#ifdef CLUTTER_WINDOWING_HEADLESS
+  if (backend_type == I_(CLUTTER_WINDOWING_HEADLESS) &&
+      CLUTTER_IS_BACKEND_HEADLESS (context->backend))
+    return TRUE;
+  else
+#endif
 #ifdef CLUTTER_WINDOWING_GDK
   if (backend_type == I_(CLUTTER_WINDOWING_GDK) &&
       CLUTTER_IS_BACKEND_GDK (context->backend))
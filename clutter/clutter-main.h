@@ -114,6 +114,15 @@ gboolean                clutter_get_accessibility_enabled       (void);
 CLUTTER_AVAILABLE_IN_1_14
 void                    clutter_disable_accessibility           (void);
 
+/* Benchmarking functions */
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_enable_manual_master_clock      (void);
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_master_clock_step               (guint   n_frames,
+                                                                 gint64  frame_interval);
+CLUTTER_AVAILABLE_IN_1_28
+gint64                  clutter_master_clock_get_time           (void);
+
 /* Threading functions */
 CLUTTER_AVAILABLE_IN_ALL
 void                    clutter_threads_set_lock_functions      (GCallback enter_fn,
@@ -164,6 +173,16 @@ ClutterActor *          clutter_get_keyboard_grab               (void);
 CLUTTER_AVAILABLE_IN_ALL
 PangoFontMap *          clutter_get_font_map                    (void);
 
+CLUTTER_AVAILABLE_IN_1_28
+void                    clutter_glyph_cache_warm_up             (const PangoFontDescription *font_desc,
+                                                                 const gchar                *characters);
+CLUTTER_AVAILABLE_IN_1_28
+gboolean                clutter_glyph_cache_save_manifest       (const gchar   *filename,
+                                                                 GError       **error);
+CLUTTER_AVAILABLE_IN_1_28
+gboolean                clutter_glyph_cache_load_manifest       (const gchar   *filename,
+                                                                 GError       **error);
+
 CLUTTER_AVAILABLE_IN_ALL
 ClutterTextDirection    clutter_get_default_text_direction      (void);
 
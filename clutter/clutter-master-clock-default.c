@@ -39,6 +39,7 @@
 #include "clutter-private.h"
 #include "clutter-stage-manager-private.h"
 #include "clutter-stage-private.h"
+#include "clutter-stage-window.h"
 
 #ifdef CLUTTER_ENABLE_DEBUG
 #define clutter_warn_if_over_budget(master_clock,start_time,section)    G_STMT_START  { \
@@ -680,6 +681,22 @@ clutter_master_clock_default_set_paused (ClutterMasterClock *clock,
   master_clock->paused = !!paused;
 }
 
+static void
+clutter_master_clock_default_get_frame_times (ClutterMasterClock *clock,
+                                              ClutterStage       *stage,
+                                              gint64             *frame_time,
+                                              gint64             *presentation_time)
+{
+  ClutterStageWindow *stage_window = _clutter_stage_get_window (stage);
+
+  *frame_time = g_get_monotonic_time ();
+
+  if (stage_window != NULL)
+    *presentation_time = _clutter_stage_window_get_next_presentation_time (stage_window);
+  else
+    *presentation_time = -1;
+}
+
 static void
 clutter_master_clock_iface_init (ClutterMasterClockIface *iface)
 {
@@ -688,4 +705,5 @@ clutter_master_clock_iface_init (ClutterMasterClockIface *iface)
   iface->start_running = clutter_master_clock_default_start_running;
   iface->ensure_next_iteration = clutter_master_clock_default_ensure_next_iteration;
   iface->set_paused = clutter_master_clock_default_set_paused;
+  iface->get_frame_times = clutter_master_clock_default_get_frame_times;
 }
@@ -0,0 +1,293 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SECTION:clutter-master-clock-manual
+ * @short_description: A master clock advanced on demand
+ *
+ * The #ClutterMasterClockManual class is an implementation of
+ * #ClutterMasterClock that does not use the main loop or the system
+ * time: frames are only run when the application calls
+ * clutter_master_clock_step(), and the time of each frame is advanced
+ * by a fixed interval. This makes the animations and the amount of
+ * work done by each frame independent of the load of the system, which
+ * is what benchmarks and tests need.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "clutter-master-clock.h"
+#include "clutter-master-clock-manual.h"
+#include "clutter-debug.h"
+#include "clutter-private.h"
+#include "clutter-stage-manager-private.h"
+#include "clutter-stage-private.h"
+
+struct _ClutterMasterClockManual
+{
+  GObject parent_instance;
+
+  /* the list of timelines handled by the clock */
+  GSList *timelines;
+
+  /* the simulated time of the current frame, in usecs */
+  gint64 cur_tick;
+
+  guint in_step : 1;
+  guint paused : 1;
+};
+
+static void clutter_master_clock_iface_init (ClutterMasterClockIface *iface);
+
+#define clutter_master_clock_manual_get_type    _clutter_master_clock_manual_get_type
+
+G_DEFINE_TYPE_WITH_CODE (ClutterMasterClockManual,
+                         clutter_master_clock_manual,
+                         G_TYPE_OBJECT,
+                         G_IMPLEMENT_INTERFACE (CLUTTER_TYPE_MASTER_CLOCK,
+                                                clutter_master_clock_iface_init));
+
+static GSList *
+master_clock_list_mapped_stages (ClutterMasterClockManual *master_clock)
+{
+  ClutterStageManager *stage_manager = clutter_stage_manager_get_default ();
+  const GSList *stages, *l;
+  GSList *result;
+
+  stages = clutter_stage_manager_peek_stages (stage_manager);
+
+  /* unlike the default clock we do not wait for the update time of
+   * each stage: every frame updates all the mapped stages
+   */
+  result = NULL;
+  for (l = stages; l != NULL; l = l->next)
+    {
+      if (clutter_actor_is_mapped (l->data))
+        result = g_slist_prepend (result, g_object_ref (l->data));
+    }
+
+  return g_slist_reverse (result);
+}
+
+static void
+master_clock_advance_timelines (ClutterMasterClockManual *master_clock)
+{
+  GSList *timelines, *l;
+
+  /* see master_clock_advance_timelines() in the default master clock
+   * for why we iterate over a copy of the list
+   */
+  timelines = g_slist_copy (master_clock->timelines);
+  g_slist_foreach (timelines, (GFunc) g_object_ref, NULL);
+
+  for (l = timelines; l != NULL; l = l->next)
+    _clutter_timeline_do_tick (l->data, master_clock->cur_tick / 1000);
+
+  g_slist_foreach (timelines, (GFunc) g_object_unref, NULL);
+  g_slist_free (timelines);
+}
+
+static void
+master_clock_run_frame (ClutterMasterClockManual *master_clock)
+{
+  GSList *stages, *l;
+
+  CLUTTER_NOTE (SCHEDULER, "Manual master clock [tick: %" G_GINT64_FORMAT "]",
+                master_clock->cur_tick);
+
+  stages = master_clock_list_mapped_stages (master_clock);
+
+  if (G_UNLIKELY (clutter_paint_debug_flags &
+                  CLUTTER_DEBUG_CONTINUOUS_REDRAW))
+    {
+      for (l = stages; l != NULL; l = l->next)
+        clutter_actor_queue_redraw (l->data);
+    }
+
+  /* the same three phases as a frame of the default master clock */
+  for (l = stages; l != NULL; l = l->next)
+    _clutter_stage_process_queued_events (l->data);
+
+  master_clock_advance_timelines (master_clock);
+
+  _clutter_run_repaint_functions (CLUTTER_REPAINT_FLAGS_PRE_PAINT);
+
+  for (l = stages; l != NULL; l = l->next)
+    _clutter_stage_do_update (l->data);
+
+  _clutter_run_repaint_functions (CLUTTER_REPAINT_FLAGS_POST_PAINT);
+
+  /* the stages were updated regardless of their update time, so reset
+   * it for the next frame
+   */
+  for (l = stages; l != NULL; l = l->next)
+    _clutter_stage_clear_update_time (l->data);
+
+  g_slist_foreach (stages, (GFunc) g_object_unref, NULL);
+  g_slist_free (stages);
+}
+
+/*
+ * _clutter_master_clock_manual_step:
+ * @master_clock: a #ClutterMasterClockManual
+ * @n_frames: the number of frames to run
+ * @frame_interval: the interval between two frames, in microseconds
+ *
+ * Runs @n_frames frames, advancing the time of the clock by
+ * @frame_interval before each of them.
+ */
+void
+_clutter_master_clock_manual_step (ClutterMasterClockManual *master_clock,
+                                   guint                     n_frames,
+                                   gint64                    frame_interval)
+{
+  guint i;
+
+  if (master_clock->in_step)
+    {
+      g_critical ("The master clock cannot be advanced from within a frame");
+      return;
+    }
+
+  if (master_clock->paused)
+    return;
+
+  master_clock->in_step = TRUE;
+
+  for (i = 0; i < n_frames; i++)
+    {
+      master_clock->cur_tick += frame_interval;
+
+      master_clock_run_frame (master_clock);
+    }
+
+  master_clock->in_step = FALSE;
+}
+
+/*
+ * _clutter_master_clock_manual_get_time:
+ * @master_clock: a #ClutterMasterClockManual
+ *
+ * Retrieves the simulated time of the last frame.
+ *
+ * Return value: the time, in microseconds
+ */
+gint64
+_clutter_master_clock_manual_get_time (ClutterMasterClockManual *master_clock)
+{
+  return master_clock->cur_tick;
+}
+
+static void
+clutter_master_clock_manual_finalize (GObject *gobject)
+{
+  ClutterMasterClockManual *master_clock = CLUTTER_MASTER_CLOCK_MANUAL (gobject);
+
+  g_slist_free (master_clock->timelines);
+
+  G_OBJECT_CLASS (clutter_master_clock_manual_parent_class)->finalize (gobject);
+}
+
+static void
+clutter_master_clock_manual_class_init (ClutterMasterClockManualClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->finalize = clutter_master_clock_manual_finalize;
+}
+
+static void
+clutter_master_clock_manual_init (ClutterMasterClockManual *self)
+{
+  self->cur_tick = 0;
+  self->in_step = FALSE;
+  self->paused = FALSE;
+}
+
+static void
+clutter_master_clock_manual_add_timeline (ClutterMasterClock *clock,
+                                          ClutterTimeline    *timeline)
+{
+  ClutterMasterClockManual *master_clock = (ClutterMasterClockManual *) clock;
+
+  if (g_slist_find (master_clock->timelines, timeline))
+    return;
+
+  master_clock->timelines = g_slist_prepend (master_clock->timelines,
+                                             timeline);
+}
+
+static void
+clutter_master_clock_manual_remove_timeline (ClutterMasterClock *clock,
+                                             ClutterTimeline    *timeline)
+{
+  ClutterMasterClockManual *master_clock = (ClutterMasterClockManual *) clock;
+
+  master_clock->timelines = g_slist_remove (master_clock->timelines,
+                                            timeline);
+}
+
+static void
+clutter_master_clock_manual_start_running (ClutterMasterClock *clock)
+{
+  /* frames are only run by _clutter_master_clock_manual_step() */
+}
+
+static void
+clutter_master_clock_manual_ensure_next_iteration (ClutterMasterClock *clock)
+{
+  /* every step runs a full frame anyway */
+}
+
+static void
+clutter_master_clock_manual_set_paused (ClutterMasterClock *clock,
+                                        gboolean            paused)
+{
+  ClutterMasterClockManual *master_clock = (ClutterMasterClockManual *) clock;
+
+  master_clock->paused = !!paused;
+}
+
+static void
+clutter_master_clock_manual_get_frame_times (ClutterMasterClock *clock,
+                                             ClutterStage       *stage,
+                                             gint64             *frame_time,
+                                             gint64             *presentation_time)
+{
+  ClutterMasterClockManual *master_clock = (ClutterMasterClockManual *) clock;
+
+  /* the frames are presented at the simulated time, which is also
+   * the time base of the events put by the users of the clock
+   */
+  *frame_time = master_clock->cur_tick;
+  *presentation_time = master_clock->cur_tick;
+}
+
+static void
+clutter_master_clock_iface_init (ClutterMasterClockIface *iface)
+{
+  iface->add_timeline = clutter_master_clock_manual_add_timeline;
+  iface->remove_timeline = clutter_master_clock_manual_remove_timeline;
+  iface->start_running = clutter_master_clock_manual_start_running;
+  iface->ensure_next_iteration = clutter_master_clock_manual_ensure_next_iteration;
+  iface->set_paused = clutter_master_clock_manual_set_paused;
+  iface->get_frame_times = clutter_master_clock_manual_get_frame_times;
+}
@@ -0,0 +1,49 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CLUTTER_MASTER_CLOCK_MANUAL_H__
+#define __CLUTTER_MASTER_CLOCK_MANUAL_H__
+
+#include <clutter/clutter-timeline.h>
+
+G_BEGIN_DECLS
+
+#define CLUTTER_TYPE_MASTER_CLOCK_MANUAL            (_clutter_master_clock_manual_get_type ())
+#define CLUTTER_MASTER_CLOCK_MANUAL(obj)            (G_TYPE_CHECK_INSTANCE_CAST ((obj), CLUTTER_TYPE_MASTER_CLOCK_MANUAL, ClutterMasterClockManual))
+#define CLUTTER_IS_MASTER_CLOCK_MANUAL(obj)         (G_TYPE_CHECK_INSTANCE_TYPE ((obj), CLUTTER_TYPE_MASTER_CLOCK_MANUAL))
+#define CLUTTER_MASTER_CLOCK_MANUAL_GET_CLASS(obj)  (G_TYPE_INSTANCE_GET_CLASS ((obj), CLUTTER_TYPE_MASTER_CLOCK_MANUAL, ClutterMasterClockManualClass))
+
+typedef struct _ClutterMasterClockManual      ClutterMasterClockManual;
+typedef struct _ClutterMasterClockManualClass ClutterMasterClockManualClass;
+
+struct _ClutterMasterClockManualClass
+{
+  GObjectClass parent_class;
+};
+
+GType _clutter_master_clock_manual_get_type (void) G_GNUC_CONST;
+
+void    _clutter_master_clock_manual_step       (ClutterMasterClockManual *master_clock,
+                                                 guint                     n_frames,
+                                                 gint64                    frame_interval);
+gint64  _clutter_master_clock_manual_get_time   (ClutterMasterClockManual *master_clock);
+
+G_END_DECLS
+
+#endif /* __CLUTTER_MASTER_CLOCK_MANUAL_H__ */
@@ -37,6 +37,7 @@
 
 #include "clutter-master-clock.h"
 #include "clutter-master-clock-default.h"
+#include "clutter-master-clock-manual.h"
 #include "clutter-private.h"
 #ifdef CLUTTER_WINDOWING_GDK
 #include "gdk/clutter-backend-gdk.h"
@@ -61,6 +62,9 @@ _clutter_master_clock_get_default (void)
 
   if (G_UNLIKELY (context->master_clock == NULL))
     {
+    if (context->use_manual_clock)
+      context->master_clock = g_object_new (CLUTTER_TYPE_MASTER_CLOCK_MANUAL, NULL);
+    else
 #ifdef CLUTTER_WINDOWING_GDK
     if (CLUTTER_IS_BACKEND_GDK (context->backend))
       context->master_clock = g_object_new (CLUTTER_TYPE_MASTER_CLOCK_GDK, NULL);
@@ -147,3 +151,30 @@ _clutter_master_clock_set_paused (ClutterMasterClock *master_clock,
   CLUTTER_MASTER_CLOCK_GET_IFACE (master_clock)->set_paused (master_clock,
                                                              !!paused);
 }
+
+/*
+ * _clutter_master_clock_get_frame_times:
+ * @master_clock: a #ClutterMasterClock
+ * @stage: the #ClutterStage being updated
+ * @frame_time: (out): return location for the time of the current
+ *   frame, in microseconds, on the time base of the events
+ * @presentation_time: (out): return location for the time at which
+ *   the frame of @stage is expected to be presented, in microseconds,
+ *   or -1 if it cannot be predicted
+ *
+ * Retrieves the timing of the frame being run for @stage, e.g. to
+ * resample the input events at the time the frame is presented.
+ */
+void
+_clutter_master_clock_get_frame_times (ClutterMasterClock *master_clock,
+                                       ClutterStage       *stage,
+                                       gint64             *frame_time,
+                                       gint64             *presentation_time)
+{
+  g_return_if_fail (CLUTTER_IS_MASTER_CLOCK (master_clock));
+
+  CLUTTER_MASTER_CLOCK_GET_IFACE (master_clock)->get_frame_times (master_clock,
+                                                                  stage,
+                                                                  frame_time,
+                                                                  presentation_time);
+}
@@ -0,0 +1,393 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* ClutterMotionResampler keeps the last few samples of each pointer
+ * and touch sequence, and replaces the coordinates of the motion event
+ * delivered on each frame with the position of the device at a fixed
+ * offset before the presentation time of the frame.
+ *
+ * Input devices report at a rate unrelated to the refresh rate of the
+ * display, so the last sample received before a frame can be anywhere
+ * between zero and one input period old; delivering it as-is makes a
+ * steady motion advance by uneven steps between frames. Sampling at
+ * a fixed point in time relative to the presentation removes most of
+ * that jitter, at the cost of a small, constant latency.
+ *
+ * When the resampling time falls after the last sample, the motion is
+ * extrapolated from the last two samples, but only by a fraction of
+ * the input period; this keeps the overshoot small when the device
+ * stops or changes direction.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+
+#include "clutter-motion-resampler.h"
+
+#include "clutter-debug.h"
+#include "clutter-event.h"
+#include "clutter-private.h"
+
+/* the number of samples kept for each device and sequence */
+#define N_SAMPLES                       4
+
+/* the motion is sampled this long before the presentation time, so
+ * that the samples straddling the resampling time have usually been
+ * received already; all times are in microseconds
+ */
+#define RESAMPLE_LATENCY                5000
+
+/* samples closer or farther apart than these intervals are not used
+ * for extrapolating
+ */
+#define RESAMPLE_MIN_DELTA              2000
+#define RESAMPLE_MAX_DELTA              20000
+
+/* the maximum extrapolation past the last sample */
+#define RESAMPLE_MAX_PREDICTION         8000
+
+/* events older than this are not resampled; this also detects the
+ * devices whose timestamps do not use the monotonic clock
+ */
+#define MAX_EVENT_AGE                   1000000
+
+typedef struct _MotionSample
+{
+  gint64 time;
+  gfloat x;
+  gfloat y;
+} MotionSample;
+
+typedef struct _MotionTrack
+{
+  ClutterInputDevice *device;
+  ClutterEventSequence *sequence;
+
+  MotionSample samples[N_SAMPLES];
+  guint n_samples;
+} MotionTrack;
+
+struct _ClutterMotionResampler
+{
+  GArray *tracks;
+};
+
+ClutterMotionResampler *
+_clutter_motion_resampler_new (void)
+{
+  ClutterMotionResampler *resampler;
+
+  resampler = g_slice_new (ClutterMotionResampler);
+  resampler->tracks = g_array_new (FALSE, FALSE, sizeof (MotionTrack));
+
+  return resampler;
+}
+
+void
+_clutter_motion_resampler_free (ClutterMotionResampler *resampler)
+{
+  if (resampler == NULL)
+    return;
+
+  g_array_unref (resampler->tracks);
+  g_slice_free (ClutterMotionResampler, resampler);
+}
+
+void
+_clutter_motion_resampler_reset (ClutterMotionResampler *resampler)
+{
+  g_array_set_size (resampler->tracks, 0);
+}
+
+static MotionTrack *
+find_track (ClutterMotionResampler *resampler,
+            ClutterInputDevice     *device,
+            ClutterEventSequence   *sequence,
+            guint                  *index_)
+{
+  guint i;
+
+  for (i = 0; i < resampler->tracks->len; i++)
+    {
+      MotionTrack *track = &g_array_index (resampler->tracks, MotionTrack, i);
+
+      if (track->device == device && track->sequence == sequence)
+        {
+          if (index_ != NULL)
+            *index_ = i;
+
+          return track;
+        }
+    }
+
+  return NULL;
+}
+
+static void
+remove_track (ClutterMotionResampler *resampler,
+              ClutterInputDevice     *device,
+              ClutterEventSequence   *sequence)
+{
+  guint index_;
+
+  if (find_track (resampler, device, sequence, &index_) != NULL)
+    g_array_remove_index_fast (resampler->tracks, index_);
+}
+
+static MotionTrack *
+ensure_track (ClutterMotionResampler *resampler,
+              ClutterInputDevice     *device,
+              ClutterEventSequence   *sequence)
+{
+  MotionTrack *track;
+
+  track = find_track (resampler, device, sequence, NULL);
+  if (track != NULL)
+    return track;
+
+  g_array_set_size (resampler->tracks, resampler->tracks->len + 1);
+
+  track = &g_array_index (resampler->tracks, MotionTrack,
+                          resampler->tracks->len - 1);
+  track->device = device;
+  track->sequence = sequence;
+  track->n_samples = 0;
+
+  return track;
+}
+
+static void
+track_add_sample (MotionTrack *track,
+                  gint64       time_,
+                  gfloat       x,
+                  gfloat       y)
+{
+  MotionSample *sample;
+
+  if (track->n_samples > 0)
+    {
+      sample = &track->samples[track->n_samples - 1];
+
+      /* out of order */
+      if (time_ < sample->time)
+        return;
+
+      /* the timestamps have a millisecond granularity, so a device
+       * can report more than one sample with the same time
+       */
+      if (time_ == sample->time)
+        {
+          sample->x = x;
+          sample->y = y;
+          return;
+        }
+    }
+
+  if (track->n_samples == N_SAMPLES)
+    {
+      memmove (&track->samples[0], &track->samples[1],
+               sizeof (MotionSample) * (N_SAMPLES - 1));
+      track->n_samples -= 1;
+    }
+
+  sample = &track->samples[track->n_samples++];
+  sample->time = time_;
+  sample->x = x;
+  sample->y = y;
+}
+
+static gboolean
+track_resample (const MotionTrack *track,
+                gint64             sample_time,
+                gfloat            *x,
+                gfloat            *y)
+{
+  const MotionSample *a, *b;
+  gdouble alpha;
+  gint64 delta;
+  guint i;
+
+  if (track->n_samples < 2)
+    return FALSE;
+
+  b = &track->samples[track->n_samples - 1];
+
+  if (sample_time <= b->time)
+    {
+      /* interpolate between the samples around the sampling time */
+      for (i = track->n_samples - 1; i > 0; i--)
+        {
+          if (track->samples[i - 1].time <= sample_time)
+            break;
+        }
+
+      if (i == 0)
+        return FALSE;
+
+      a = &track->samples[i - 1];
+      b = &track->samples[i];
+    }
+  else
+    {
+      /* extrapolate from the last two samples */
+      a = &track->samples[track->n_samples - 2];
+
+      delta = b->time - a->time;
+      if (delta < RESAMPLE_MIN_DELTA || delta > RESAMPLE_MAX_DELTA)
+        return FALSE;
+
+      sample_time = MIN (sample_time,
+                         b->time + MIN (delta / 2, RESAMPLE_MAX_PREDICTION));
+    }
+
+  delta = b->time - a->time;
+  if (delta <= 0)
+    return FALSE;
+
+  alpha = (gdouble) (sample_time - a->time) / delta;
+
+  *x = a->x + (b->x - a->x) * alpha;
+  *y = a->y + (b->y - a->y) * alpha;
+
+  return TRUE;
+}
+
+/* converts a timestamp in milliseconds, as found in the events, to
+ * the time base of @now, in microseconds; the backends use the
+ * monotonic clock for their timestamps, modulo 2^32 milliseconds
+ */
+static gboolean
+event_time_to_monotonic (guint32  event_time,
+                         gint64   now,
+                         gint64  *time_)
+{
+  gint64 now_ms = now / 1000;
+  gint32 age;
+
+  age = (gint32) ((guint32) now_ms - event_time);
+  if (age < 0 || (gint64) age * 1000 > MAX_EVENT_AGE)
+    return FALSE;
+
+  *time_ = (now_ms - age) * 1000;
+
+  return TRUE;
+}
+
+/*< private >
+ * _clutter_motion_resampler_process:
+ * @resampler: a #ClutterMotionResampler
+ * @event: the event about to be processed
+ * @now: the current time, in microseconds, in the time base of the
+ *   event timestamps; usually g_get_monotonic_time()
+ * @presentation_time: the predicted presentation time of the frame,
+ *   in microseconds, or -1 if unknown
+ *
+ * Records the samples carried by @event and, if @event is a motion
+ * event or a touch update, replaces its coordinates with the position
+ * of the device at the resampling time of the frame.
+ *
+ * Return value: %TRUE if the coordinates of @event were changed
+ */
+gboolean
+_clutter_motion_resampler_process (ClutterMotionResampler *resampler,
+                                   ClutterEvent           *event,
+                                   gint64                  now,
+                                   gint64                  presentation_time)
+{
+  ClutterInputDevice *device;
+  ClutterEventSequence *sequence;
+  MotionTrack *track;
+  gint64 event_time;
+  gfloat x, y;
+  guint i, n_history;
+
+  device = clutter_event_get_device (event);
+  if (device == NULL)
+    return FALSE;
+
+  sequence = clutter_event_get_event_sequence (event);
+
+  switch (event->type)
+    {
+    case CLUTTER_TOUCH_END:
+    case CLUTTER_TOUCH_CANCEL:
+    case CLUTTER_LEAVE:
+      remove_track (resampler, device, sequence);
+      return FALSE;
+
+    case CLUTTER_TOUCH_BEGIN:
+      remove_track (resampler, device, sequence);
+      break;
+
+    case CLUTTER_MOTION:
+    case CLUTTER_TOUCH_UPDATE:
+    case CLUTTER_BUTTON_PRESS:
+    case CLUTTER_BUTTON_RELEASE:
+      break;
+
+    default:
+      return FALSE;
+    }
+
+  if (!event_time_to_monotonic (clutter_event_get_time (event), now, &event_time))
+    {
+      remove_track (resampler, device, sequence);
+      return FALSE;
+    }
+
+  track = ensure_track (resampler, device, sequence);
+
+  /* the samples of the events compressed into this one come first */
+  n_history = clutter_event_get_history_size (event);
+  for (i = 0; i < n_history; i++)
+    {
+      gint64 sample_time;
+
+      if (!event_time_to_monotonic (clutter_event_get_history_time (event, i),
+                                    now,
+                                    &sample_time))
+        continue;
+
+      clutter_event_get_history_coords (event, i, &x, &y);
+      track_add_sample (track, sample_time, x, y);
+    }
+
+  clutter_event_get_coords (event, &x, &y);
+  track_add_sample (track, event_time, x, y);
+
+  if (event->type != CLUTTER_MOTION && event->type != CLUTTER_TOUCH_UPDATE)
+    return FALSE;
+
+  if (presentation_time < 0)
+    return FALSE;
+
+  if (!track_resample (track, presentation_time - RESAMPLE_LATENCY, &x, &y))
+    return FALSE;
+
+  CLUTTER_NOTE (EVENT, "Resampled %s event at %.2f, %.2f",
+                event->type == CLUTTER_MOTION ? "motion" : "touch update",
+                x, y);
+
+  clutter_event_set_coords (event, x, y);
+
+  return TRUE;
+}
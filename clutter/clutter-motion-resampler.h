@@ -0,0 +1,44 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ClutterMotionResampler: resamples the motion of the input devices
+ * at the presentation time of the frames.
+ */
+
+#ifndef __CLUTTER_MOTION_RESAMPLER_H__
+#define __CLUTTER_MOTION_RESAMPLER_H__
+
+#include <clutter/clutter-event.h>
+
+G_BEGIN_DECLS
+
+typedef struct _ClutterMotionResampler  ClutterMotionResampler;
+
+ClutterMotionResampler *        _clutter_motion_resampler_new           (void);
+void                            _clutter_motion_resampler_free          (ClutterMotionResampler *resampler);
+
+gboolean                        _clutter_motion_resampler_process       (ClutterMotionResampler *resampler,
+                                                                         ClutterEvent           *event,
+                                                                         gint64                  now,
+                                                                         gint64                  presentation_time);
+
+void                            _clutter_motion_resampler_reset         (ClutterMotionResampler *resampler);
+
+G_END_DECLS
+
+#endif /* __CLUTTER_MOTION_RESAMPLER_H__ */
@@ -62,14 +62,16 @@
 #include "clutter-debug.h"
 #include "clutter-enum-types.h"
 #include "clutter-gesture-action-private.h"
+#include "clutter-kinetic-scroller.h"
+#include "clutter-main.h"
 #include "clutter-marshal.h"
+#include "clutter-master-clock.h"
 #include "clutter-private.h"
+#include "clutter-scroll-actor-private.h"
 #include <math.h>
 
 #define FLOAT_EPSILON   (1e-15)
 
-static const gfloat min_velocity = 0.1f; // measured in px/ms
-static const gfloat reference_fps = 60.0f; // the fps assumed for the deceleration rate
 static const gfloat default_deceleration_rate = 0.95f;
 static const gfloat default_acceleration_factor = 1.0f;
 
@@ -95,14 +97,22 @@ struct _ClutterPanActionPrivate
   PanState state;
 
   /* Variables for storing acceleration information */
-  ClutterTimeline *deceleration_timeline;
-  gfloat target_x;
-  gfloat target_y;
+  ClutterKineticScroller *scroller;
+  guint deceleration_id;
   gfloat dx;
   gfloat dy;
   gdouble deceleration_rate;
   gdouble acceleration_factor;
 
+  /* the actor scrolled directly by the action, and its scroll
+   * position at the beginning of the pan
+   */
+  ClutterScrollActor *scroll_actor;
+  ClutterPoint scroll_origin;
+  ClutterPoint pointer_origin;
+  gfloat snap_interval_x;
+  gfloat snap_interval_y;
+
   /* Inertial motion tracking */
   gfloat interpolated_x;
   gfloat interpolated_y;
@@ -122,6 +132,7 @@ enum
   PROP_INTERPOLATE,
   PROP_DECELERATION,
   PROP_ACCELERATION_FACTOR,
+  PROP_SCROLL_ACTOR,
 
   PROP_LAST
 };
@@ -187,41 +198,167 @@ emit_pan_stopped (ClutterPanAction *self,
 }
 
 static void
-on_deceleration_stopped (ClutterTimeline           *timeline,
-                         gboolean                   is_finished,
-                         ClutterPanAction *self)
+constrain_delta (ClutterPanAction *self,
+                 gfloat           *delta_x,
+                 gfloat           *delta_y)
 {
   ClutterPanActionPrivate *priv = self->priv;
+
+  switch (priv->pan_axis)
+    {
+    case CLUTTER_PAN_AXIS_NONE:
+      break;
+
+    case CLUTTER_PAN_AXIS_AUTO:
+      if (priv->pin_state == SCROLL_PINNED_VERTICAL)
+        *delta_x = 0.0f;
+      else if (priv->pin_state == SCROLL_PINNED_HORIZONTAL)
+        *delta_y = 0.0f;
+      break;
+
+    case CLUTTER_PAN_X_AXIS:
+      *delta_y = 0.0f;
+      break;
+
+    case CLUTTER_PAN_Y_AXIS:
+      *delta_x = 0.0f;
+      break;
+    }
+}
+
+static gint64
+get_frame_time (void)
+{
+  gint64 frame_time;
+
+  /* follow the simulated time when the master clock is stepped */
+  frame_time = clutter_master_clock_get_time ();
+  if (frame_time < 0)
+    frame_time = g_get_monotonic_time ();
+
+  return frame_time;
+}
+
+static void
+stop_deceleration (ClutterPanAction *self)
+{
+  ClutterPanActionPrivate *priv = self->priv;
+
+  if (priv->deceleration_id != 0)
+    {
+      clutter_threads_remove_repaint_func (priv->deceleration_id);
+      priv->deceleration_id = 0;
+    }
+
+  _clutter_kinetic_scroller_stop (priv->scroller);
+}
+
+static gboolean
+on_deceleration_frame (gpointer data)
+{
+  ClutterPanAction *self = data;
+  ClutterPanActionPrivate *priv = self->priv;
   ClutterActor *actor;
+  gfloat x, y;
+  gboolean running;
 
-  g_object_unref (timeline);
-  priv->deceleration_timeline = NULL;
+  if (priv->state != PAN_STATE_INTERPOLATING ||
+      !_clutter_kinetic_scroller_is_running (priv->scroller))
+    {
+      priv->deceleration_id = 0;
+      return G_SOURCE_REMOVE;
+    }
+
+  running = _clutter_kinetic_scroller_evaluate (priv->scroller,
+                                                get_frame_time (),
+                                                &x, &y);
 
   actor = clutter_actor_meta_get_actor (CLUTTER_ACTOR_META (self));
+
+  if (priv->scroll_actor != NULL)
+    {
+      ClutterPoint point;
+
+      /* the scroll position moves against the pointer */
+      priv->dx = priv->scroll_origin.x - x;
+      priv->dy = priv->scroll_origin.y - y;
+      priv->interpolated_x += priv->dx;
+      priv->interpolated_y += priv->dy;
+
+      clutter_point_init (&priv->scroll_origin, x, y);
+      clutter_point_init (&point, x, y);
+      _clutter_scroll_actor_set_scroll_point (priv->scroll_actor, &point);
+    }
+  else
+    {
+      priv->dx = x - priv->interpolated_x;
+      priv->dy = y - priv->interpolated_y;
+      priv->interpolated_x = x;
+      priv->interpolated_y = y;
+
+      emit_pan (self, actor, TRUE);
+    }
+
+  if (running)
+    {
+      _clutter_master_clock_ensure_next_iteration (_clutter_master_clock_get_default ());
+      return G_SOURCE_CONTINUE;
+    }
+
+  priv->deceleration_id = 0;
   emit_pan_stopped (self, actor);
+
+  return G_SOURCE_REMOVE;
 }
 
 static void
-on_deceleration_new_frame (ClutterTimeline     *timeline,
-                           gint                 elapsed_time,
-                           ClutterPanAction    *self)
+update_scroll_position (ClutterPanAction *self)
 {
   ClutterPanActionPrivate *priv = self->priv;
-  ClutterActor *actor;
-  gdouble progress;
-  gfloat interpolated_x, interpolated_y;
+  ClutterGestureAction *gesture = CLUTTER_GESTURE_ACTION (self);
+  gfloat motion_x, motion_y;
+  gfloat delta_x, delta_y;
+  ClutterPoint point;
 
-  progress = clutter_timeline_get_progress (timeline);
+  clutter_gesture_action_get_motion_coords (gesture, 0, &motion_x, &motion_y);
 
-  interpolated_x = priv->target_x * progress;
-  interpolated_y = priv->target_y * progress;
-  priv->dx = interpolated_x - priv->interpolated_x;
-  priv->dy = interpolated_y - priv->interpolated_y;
-  priv->interpolated_x = interpolated_x;
-  priv->interpolated_y = interpolated_y;
+  delta_x = motion_x - priv->pointer_origin.x;
+  delta_y = motion_y - priv->pointer_origin.y;
+  constrain_delta (self, &delta_x, &delta_y);
 
-  actor = clutter_actor_meta_get_actor (CLUTTER_ACTOR_META (self));
-  emit_pan (self, actor, TRUE);
+  point.x = priv->scroll_origin.x - delta_x;
+  point.y = priv->scroll_origin.y - delta_y;
+  _clutter_kinetic_scroller_constrain (priv->scroller, &point.x, &point.y);
+
+  _clutter_scroll_actor_set_scroll_point (priv->scroll_actor, &point);
+}
+
+static void
+add_velocity_samples (ClutterPanAction *self)
+{
+  ClutterPanActionPrivate *priv = self->priv;
+  const ClutterEvent *event;
+  gfloat x, y;
+  guint i, n_history;
+
+  event = clutter_gesture_action_get_last_event (CLUTTER_GESTURE_ACTION (self), 0);
+  if (event == NULL)
+    return;
+
+  /* the samples of the motion events compressed into this one */
+  n_history = clutter_event_get_history_size (event);
+  for (i = 0; i < n_history; i++)
+    {
+      clutter_event_get_history_coords (event, i, &x, &y);
+      _clutter_kinetic_scroller_add_sample (priv->scroller,
+                                            clutter_event_get_history_time (event, i),
+                                            x, y);
+    }
+
+  clutter_event_get_coords (event, &x, &y);
+  _clutter_kinetic_scroller_add_sample (priv->scroller,
+                                        clutter_event_get_time (event),
+                                        x, y);
 }
 
 static gboolean
@@ -231,8 +368,13 @@ gesture_prepare (ClutterGestureAction  *gesture,
   ClutterPanAction *self = CLUTTER_PAN_ACTION (gesture);
   ClutterPanActionPrivate *priv = self->priv;
 
-  if (priv->state == PAN_STATE_INTERPOLATING && priv->deceleration_timeline)
-    clutter_timeline_stop (priv->deceleration_timeline);
+  if (priv->state == PAN_STATE_INTERPOLATING)
+    {
+      stop_deceleration (self);
+
+      /* keep the state consistent for the ::pan-stopped handlers */
+      emit_pan_stopped (self, actor);
+    }
 
   return TRUE;
 }
@@ -249,6 +391,26 @@ gesture_begin (ClutterGestureAction  *gesture,
   priv->interpolated_x = priv->interpolated_y = 0.0f;
   priv->dx = priv->dy = 0.0f;
 
+  _clutter_kinetic_scroller_reset_samples (priv->scroller);
+  add_velocity_samples (self);
+
+  if (priv->scroll_actor != NULL)
+    {
+      ClutterRect bounds;
+
+      _clutter_scroll_actor_get_scroll_point (priv->scroll_actor,
+                                              &priv->scroll_origin);
+      clutter_gesture_action_get_motion_coords (gesture, 0,
+                                                &priv->pointer_origin.x,
+                                                &priv->pointer_origin.y);
+      _clutter_scroll_actor_get_scroll_bounds (priv->scroll_actor, &bounds);
+      _clutter_kinetic_scroller_set_bounds (priv->scroller,
+                                            bounds.origin.x,
+                                            bounds.origin.y,
+                                            bounds.origin.x + bounds.size.width,
+                                            bounds.origin.y + bounds.size.height);
+    }
+
   return TRUE;
 }
 
@@ -258,8 +420,13 @@ gesture_progress (ClutterGestureAction *gesture,
 {
   ClutterPanAction *self = CLUTTER_PAN_ACTION (gesture);
 
+  add_velocity_samples (self);
+
   emit_pan (self, actor, FALSE);
 
+  if (self->priv->scroll_actor != NULL)
+    update_scroll_position (self);
+
   return TRUE;
 }
 
@@ -279,14 +446,15 @@ gesture_end (ClutterGestureAction *gesture,
 {
   ClutterPanAction *self = CLUTTER_PAN_ACTION (gesture);
   ClutterPanActionPrivate *priv = self->priv;
-  gfloat velocity, velocity_x, velocity_y;
-  gfloat delta_x, delta_y;
-  gfloat tau;
-  gint duration;
+  const ClutterEvent *event;
+  gfloat velocity_x, velocity_y;
+  gfloat position_x, position_y;
+  gboolean running;
 
   clutter_gesture_action_get_release_coords (CLUTTER_GESTURE_ACTION (self), 0, &priv->release_x, &priv->release_y);
 
-  if (!priv->should_interpolate)
+  /* a scrolled actor still needs to settle within its bounds */
+  if (!priv->should_interpolate && priv->scroll_actor == NULL)
     {
       priv->state = PAN_STATE_INACTIVE;
       return;
@@ -294,35 +462,69 @@ gesture_end (ClutterGestureAction *gesture,
 
   priv->state = PAN_STATE_INTERPOLATING;
 
-  clutter_gesture_action_get_motion_delta (gesture, 0, &delta_x, &delta_y);
-  velocity = clutter_gesture_action_get_velocity (gesture, 0, &velocity_x, &velocity_y);
+  event = clutter_gesture_action_get_last_event (gesture, 0);
+  if (event == NULL ||
+      !_clutter_kinetic_scroller_get_velocity (priv->scroller,
+                                               clutter_event_get_time (event),
+                                               &velocity_x, &velocity_y))
+    clutter_gesture_action_get_velocity (gesture, 0, &velocity_x, &velocity_y);
 
-  /* Exponential timing constant v(t) = v(0) * exp(-t/tau)
-   * tau = 1000ms / (frame_per_second * - ln(decay_per_frame))
-   * with frame_per_second = 60 and decay_per_frame = 0.95, tau ~= 325ms
-   * see http://ariya.ofilabs.com/2011/10/flick-list-with-its-momentum-scrolling-and-deceleration.html */
-  tau = 1000.0f / (reference_fps * - logf (priv->deceleration_rate));
+  if (priv->should_interpolate)
+    {
+      velocity_x *= priv->acceleration_factor;
+      velocity_y *= priv->acceleration_factor;
+      constrain_delta (self, &velocity_x, &velocity_y);
+    }
+  else
+    velocity_x = velocity_y = 0.f;
 
-  /* See where the decreasing velocity reaches $min_velocity px/ms
-   * v(t) = v(0) * exp(-t/tau) = min_velocity
-   * t = - tau * ln( min_velocity / |v(0)|) */
-  duration = - tau * logf (min_velocity / (ABS (velocity) * priv->acceleration_factor));
+  _clutter_kinetic_scroller_set_deceleration (priv->scroller,
+                                              priv->deceleration_rate);
 
-  /* Target point: x(t) = v(0) * tau * [1 - exp(-t/tau)] */
-  priv->target_x = velocity_x * priv->acceleration_factor * tau * (1 - exp ((float)-duration / tau));
-  priv->target_y = velocity_y * priv->acceleration_factor * tau * (1 - exp ((float)-duration / tau));
+  priv->interpolated_x = priv->interpolated_y = 0.0f;
 
-  if (ABS (velocity) * priv->acceleration_factor > min_velocity && duration > FLOAT_EPSILON)
+  if (priv->scroll_actor != NULL)
     {
-      priv->interpolated_x = priv->interpolated_y = 0.0f;
-      priv->deceleration_timeline = clutter_timeline_new (duration);
-      clutter_timeline_set_progress_mode (priv->deceleration_timeline, CLUTTER_EASE_OUT_EXPO);
-
-      g_signal_connect (priv->deceleration_timeline, "new_frame",
-                        G_CALLBACK (on_deceleration_new_frame), self);
-      g_signal_connect (priv->deceleration_timeline, "stopped",
-                        G_CALLBACK (on_deceleration_stopped), self);
-      clutter_timeline_start (priv->deceleration_timeline);
+      ClutterPoint point;
+
+      _clutter_scroll_actor_get_scroll_point (priv->scroll_actor, &point);
+      priv->scroll_origin = point;
+
+      _clutter_kinetic_scroller_set_snap_interval (priv->scroller,
+                                                   priv->snap_interval_x,
+                                                   priv->snap_interval_y);
+
+      /* the scroll position moves against the pointer */
+      position_x = point.x;
+      position_y = point.y;
+      velocity_x = -velocity_x;
+      velocity_y = -velocity_y;
+    }
+  else
+    {
+      _clutter_kinetic_scroller_set_bounds (priv->scroller,
+                                            -G_MAXFLOAT, -G_MAXFLOAT,
+                                            G_MAXFLOAT, G_MAXFLOAT);
+      _clutter_kinetic_scroller_set_snap_interval (priv->scroller, 0.f, 0.f);
+
+      position_x = position_y = 0.f;
+    }
+
+  running = _clutter_kinetic_scroller_fling (priv->scroller,
+                                             get_frame_time (),
+                                             position_x, position_y,
+                                             velocity_x, velocity_y);
+
+  if (running)
+    {
+      if (priv->deceleration_id == 0)
+        priv->deceleration_id =
+          clutter_threads_add_repaint_func_full (CLUTTER_REPAINT_FLAGS_PRE_PAINT,
+                                                 on_deceleration_frame,
+                                                 self,
+                                                 NULL);
+
+      _clutter_master_clock_ensure_next_iteration (_clutter_master_clock_get_default ());
     }
   else
     {
@@ -338,6 +540,10 @@ clutter_pan_action_real_pan (ClutterPanAction *self,
   gfloat dx, dy;
   ClutterMatrix transform;
 
+  /* the scroll actor is moved by the action itself */
+  if (self->priv->scroll_actor != NULL)
+    return TRUE;
+
   clutter_pan_action_get_constrained_motion_delta (self, 0, &dx, &dy);
 
   clutter_actor_get_child_transform (actor, &transform);
@@ -372,6 +578,10 @@ clutter_pan_action_set_property (GObject      *gobject,
       clutter_pan_action_set_acceleration_factor (self, g_value_get_double (value));
       break;
 
+    case PROP_SCROLL_ACTOR:
+      clutter_pan_action_set_scroll_actor (self, g_value_get_object (value));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
     }
@@ -404,6 +614,10 @@ clutter_pan_action_get_property (GObject    *gobject,
       g_value_set_double (value, priv->acceleration_factor);
       break;
 
+    case PROP_SCROLL_ACTOR:
+      g_value_set_object (value, priv->scroll_actor);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id, pspec);
     }
@@ -421,13 +635,31 @@ clutter_pan_action_constructed (GObject *gobject)
 static void
 clutter_pan_action_dispose (GObject *gobject)
 {
-  ClutterPanActionPrivate *priv = CLUTTER_PAN_ACTION (gobject)->priv;
+  ClutterPanAction *self = CLUTTER_PAN_ACTION (gobject);
+  ClutterPanActionPrivate *priv = self->priv;
 
-  g_clear_object (&priv->deceleration_timeline);
+  stop_deceleration (self);
+
+  if (priv->scroll_actor != NULL)
+    {
+      g_object_remove_weak_pointer (G_OBJECT (priv->scroll_actor),
+                                    (gpointer *) &priv->scroll_actor);
+      priv->scroll_actor = NULL;
+    }
 
   G_OBJECT_CLASS (clutter_pan_action_parent_class)->dispose (gobject);
 }
 
+static void
+clutter_pan_action_finalize (GObject *gobject)
+{
+  ClutterPanActionPrivate *priv = CLUTTER_PAN_ACTION (gobject)->priv;
+
+  _clutter_kinetic_scroller_free (priv->scroller);
+
+  G_OBJECT_CLASS (clutter_pan_action_parent_class)->finalize (gobject);
+}
+
 static void
 clutter_pan_action_set_actor (ClutterActorMeta *meta,
                               ClutterActor     *actor)
@@ -441,7 +673,10 @@ clutter_pan_action_set_actor (ClutterActorMeta *meta,
     {
       /* make sure we reset the state */
       if (priv->state == PAN_STATE_INTERPOLATING)
-        g_clear_object (&priv->deceleration_timeline);
+        {
+          stop_deceleration (self);
+          priv->state = PAN_STATE_INACTIVE;
+        }
     }
 
   CLUTTER_ACTOR_META_CLASS (clutter_pan_action_parent_class)->set_actor (meta, actor);
@@ -530,10 +765,31 @@ clutter_pan_action_class_init (ClutterPanActionClass *klass)
                          1.0, G_MAXDOUBLE, default_acceleration_factor,
                          CLUTTER_PARAM_READWRITE);
 
+  /**
+   * ClutterPanAction:scroll-actor:
+   *
+   * The #ClutterScrollActor scrolled by the action.
+   *
+   * When set, the action moves the visible area of the scroll actor
+   * directly, both while panning and during the interpolation phase,
+   * instead of translating the children of the actor it is attached
+   * to; the interpolated positions are computed on each frame, and
+   * no ::pan signal is emitted for them.
+   *
+   * Since: 1.28
+   */
+  pan_props[PROP_SCROLL_ACTOR] =
+    g_param_spec_object ("scroll-actor",
+                         P_("Scroll Actor"),
+                         P_("The scroll actor moved by the action"),
+                         CLUTTER_TYPE_SCROLL_ACTOR,
+                         CLUTTER_PARAM_READWRITE);
+
   gobject_class->constructed = clutter_pan_action_constructed;
   gobject_class->set_property = clutter_pan_action_set_property;
   gobject_class->get_property = clutter_pan_action_get_property;
   gobject_class->dispose = clutter_pan_action_dispose;
+  gobject_class->finalize = clutter_pan_action_finalize;
   g_object_class_install_properties  (gobject_class,
                                       PROP_LAST,
                                       pan_props);
@@ -594,6 +850,7 @@ clutter_pan_action_init (ClutterPanAction *self)
   self->priv->deceleration_rate = default_deceleration_rate;
   self->priv->acceleration_factor = default_acceleration_factor;
   self->priv->state = PAN_STATE_INACTIVE;
+  self->priv->scroller = _clutter_kinetic_scroller_new ();
 }
 
 /**
@@ -876,35 +1133,13 @@ clutter_pan_action_get_constrained_motion_delta (ClutterPanAction *self,
                                                  gfloat           *out_delta_x,
                                                  gfloat           *out_delta_y)
 {
-  ClutterPanActionPrivate *priv;
   gfloat delta_x = 0.f, delta_y = 0.f, distance;
 
   g_return_val_if_fail (CLUTTER_IS_PAN_ACTION (self), 0.0f);
 
-  priv = self->priv;
-
   distance = clutter_pan_action_get_motion_delta (self, point, &delta_x, &delta_y);
 
-  switch (priv->pan_axis)
-    {
-    case CLUTTER_PAN_AXIS_NONE:
-      break;
-
-    case CLUTTER_PAN_AXIS_AUTO:
-      if (priv->pin_state == SCROLL_PINNED_VERTICAL)
-        delta_x = 0.0f;
-      else if (priv->pin_state == SCROLL_PINNED_HORIZONTAL)
-        delta_y = 0.0f;
-      break;
-
-    case CLUTTER_PAN_X_AXIS:
-      delta_y = 0.0f;
-      break;
-
-    case CLUTTER_PAN_Y_AXIS:
-      delta_x = 0.0f;
-      break;
-    }
+  constrain_delta (self, &delta_x, &delta_y);
 
   if (out_delta_x)
     *out_delta_x = delta_x;
@@ -1017,3 +1252,122 @@ clutter_pan_action_get_motion_coords (ClutterPanAction *self,
       g_assert_not_reached ();
     }
 }
+
+/**
+ * clutter_pan_action_set_scroll_actor:
+ * @self: a #ClutterPanAction
+ * @scroll_actor: (allow-none): a #ClutterScrollActor, or %NULL
+ *
+ * Sets the #ClutterScrollActor moved by the action.
+ *
+ * The visible area of @scroll_actor follows the pointer while panning
+ * and, if #ClutterPanAction:interpolate is set, keeps moving after the
+ * release with a decelerating motion computed on each frame. The motion
+ * bounces back at the edges of the children of @scroll_actor, and ends
+ * on the points set with clutter_pan_action_set_snap_interval().
+ *
+ * The @scroll_actor is usually the actor @self is attached to.
+ *
+ * Since: 1.28
+ */
+void
+clutter_pan_action_set_scroll_actor (ClutterPanAction   *self,
+                                     ClutterScrollActor *scroll_actor)
+{
+  ClutterPanActionPrivate *priv;
+
+  g_return_if_fail (CLUTTER_IS_PAN_ACTION (self));
+  g_return_if_fail (scroll_actor == NULL || CLUTTER_IS_SCROLL_ACTOR (scroll_actor));
+
+  priv = self->priv;
+
+  if (priv->scroll_actor == scroll_actor)
+    return;
+
+  if (priv->state == PAN_STATE_INTERPOLATING)
+    {
+      stop_deceleration (self);
+      priv->state = PAN_STATE_INACTIVE;
+    }
+
+  /* the scroll actor usually owns the action */
+  if (priv->scroll_actor != NULL)
+    g_object_remove_weak_pointer (G_OBJECT (priv->scroll_actor),
+                                  (gpointer *) &priv->scroll_actor);
+
+  priv->scroll_actor = scroll_actor;
+
+  if (priv->scroll_actor != NULL)
+    g_object_add_weak_pointer (G_OBJECT (priv->scroll_actor),
+                               (gpointer *) &priv->scroll_actor);
+
+  g_object_notify_by_pspec (G_OBJECT (self), pan_props[PROP_SCROLL_ACTOR]);
+}
+
+/**
+ * clutter_pan_action_get_scroll_actor:
+ * @self: a #ClutterPanAction
+ *
+ * Retrieves the #ClutterScrollActor set with
+ * clutter_pan_action_set_scroll_actor().
+ *
+ * Return value: (transfer none) (nullable): the scroll actor
+ *
+ * Since: 1.28
+ */
+ClutterScrollActor *
+clutter_pan_action_get_scroll_actor (ClutterPanAction *self)
+{
+  g_return_val_if_fail (CLUTTER_IS_PAN_ACTION (self), NULL);
+
+  return self->priv->scroll_actor;
+}
+
+/**
+ * clutter_pan_action_set_snap_interval:
+ * @self: a #ClutterPanAction
+ * @interval_x: the horizontal interval between the snap points, or 0
+ * @interval_y: the vertical interval between the snap points, or 0
+ *
+ * Sets the interval between the scroll positions the motion of the
+ * #ClutterPanAction:scroll-actor ends at after a pan; for instance,
+ * the size of a page. An interval of 0 disables the snapping on that
+ * direction.
+ *
+ * Since: 1.28
+ */
+void
+clutter_pan_action_set_snap_interval (ClutterPanAction *self,
+                                      gfloat            interval_x,
+                                      gfloat            interval_y)
+{
+  g_return_if_fail (CLUTTER_IS_PAN_ACTION (self));
+  g_return_if_fail (interval_x >= 0.f && interval_y >= 0.f);
+
+  self->priv->snap_interval_x = interval_x;
+  self->priv->snap_interval_y = interval_y;
+}
+
+/**
+ * clutter_pan_action_get_snap_interval:
+ * @self: a #ClutterPanAction
+ * @interval_x: (out) (optional): return location for the horizontal interval
+ * @interval_y: (out) (optional): return location for the vertical interval
+ *
+ * Retrieves the intervals set with clutter_pan_action_set_snap_interval().
+ *
+ * Since: 1.28
+ */
+void
+clutter_pan_action_get_snap_interval (ClutterPanAction *self,
+                                      gfloat           *interval_x,
+                                      gfloat           *interval_y)
+{
+  g_return_if_fail (CLUTTER_IS_PAN_ACTION (self));
+
+  if (interval_x != NULL)
+    *interval_x = self->priv->snap_interval_x;
+
+  if (interval_y != NULL)
+    *interval_y = self->priv->snap_interval_y;
+}
@@ -38,6 +38,7 @@
 #endif
 
 #include <clutter/clutter-gesture-action.h>
+#include <clutter/clutter-scroll-actor.h>
 
 G_BEGIN_DECLS
 
@@ -147,6 +148,20 @@ gfloat          clutter_pan_action_get_constrained_motion_delta (ClutterPanActio
                                                                  guint             point,
                                                                  gfloat           *delta_x,
                                                                  gfloat           *delta_y);
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_pan_action_set_scroll_actor             (ClutterPanAction   *self,
+                                                                 ClutterScrollActor *scroll_actor);
+CLUTTER_AVAILABLE_IN_1_28
+ClutterScrollActor *clutter_pan_action_get_scroll_actor         (ClutterPanAction   *self);
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_pan_action_set_snap_interval            (ClutterPanAction   *self,
+                                                                 gfloat              interval_x,
+                                                                 gfloat              interval_y);
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_pan_action_get_snap_interval            (ClutterPanAction   *self,
+                                                                 gfloat             *interval_x,
+                                                                 gfloat             *interval_y);
+
 G_END_DECLS
 
 #endif /* __CLUTTER_PAN_ACTION_H__ */
@@ -156,6 +156,13 @@ struct _ClutterMainContext
 
   CoglPangoFontMap *font_map;   /* Global font map */
 
+  /* pending glyph cache warm-up jobs, and the set of characters
+   * pre-rasterised for each font description
+   */
+  GQueue *glyph_warm_up_jobs;
+  GHashTable *glyph_warm_up_manifest;
+  guint glyph_warm_up_id;
+
   /* stack of #ClutterEvent */
   GSList *current_event;
 
@@ -168,12 +175,21 @@ struct _ClutterMainContext
   /* main settings singleton */
   ClutterSettings *settings;
 
+  /* the active ClutterEventRecorder instances, and the
+   * ClutterEventPlayer replaying events, if any; the player is
+   * named by its struct tag, as repeating its typedef here is not
+   * valid C99
+   */
+  GSList *event_recorders;
+  struct _ClutterEventPlayer *event_player;
+
   /* boolean flags */
   guint is_initialized          : 1;
   guint motion_events_per_actor : 1;
   guint defer_display_setup     : 1;
   guint options_parsed          : 1;
   guint show_fps                : 1;
+  guint use_manual_clock        : 1;
 };
 
 /* shared between clutter-main.c and clutter-frame-source.c */
@@ -201,6 +217,8 @@ ClutterActor *          _clutter_context_peek_shader_stack              (void);
 gboolean                _clutter_context_get_motion_events_enabled      (void);
 gboolean                _clutter_context_get_show_fps                   (void);
 
+void                    _clutter_clear_glyph_cache_warm_up              (void);
+
 const gchar *_clutter_gettext (const gchar *str);
 
 gboolean      _clutter_feature_init (GError **error);
@@ -281,7 +281,7 @@
 
 #define CLUTTER_DISABLE_DEPRECATION_WARNINGS
 
-#include "clutter-actor.h"
+#include "clutter-actor-private.h"
 #include "clutter-stage.h"
 #include "clutter-texture.h"
 
@@ -1247,6 +1247,10 @@ connect_each_object (gpointer key,
           g_object_weak_ref (hook_data->emitter,
                              clutter_script_remove_state_change_hook,
                              hook_data);
+
+          /* the actors skip the emission of events without handlers */
+          if (CLUTTER_IS_ACTOR (object))
+            _clutter_actor_set_has_event_hooks (CLUTTER_ACTOR (object));
         }
 
       signal_info_free (sinfo);
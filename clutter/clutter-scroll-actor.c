@@ -46,7 +46,7 @@
 #include "config.h"
 #endif
 
-#include "clutter-scroll-actor.h"
+#include "clutter-scroll-actor-private.h"
 
 #include "clutter-actor-private.h"
 #include "clutter-animatable.h"
@@ -434,3 +434,99 @@ clutter_scroll_actor_scroll_to_rect (ClutterScrollActor *actor,
 
   clutter_scroll_actor_scroll_to_point (actor, &n_rect.origin);
 }
+
+/*< private >
+ * _clutter_scroll_actor_get_scroll_point:
+ * @actor: a #ClutterScrollActor
+ * @point: (out): return location for the origin of the visible area
+ *
+ * Retrieves the current origin of the visible area of @actor, which
+ * is the intermediate value if a scroll is being eased.
+ */
+void
+_clutter_scroll_actor_get_scroll_point (ClutterScrollActor *actor,
+                                        ClutterPoint       *point)
+{
+  *point = actor->priv->scroll_to;
+}
+
+/*< private >
+ * _clutter_scroll_actor_set_scroll_point:
+ * @actor: a #ClutterScrollActor
+ * @point: the new origin of the visible area
+ *
+ * Moves the origin of the visible area of @actor to @point, without
+ * easing, and stops any eased scroll. This is used by the actions that
+ * compute the scroll position on each frame.
+ */
+void
+_clutter_scroll_actor_set_scroll_point (ClutterScrollActor *actor,
+                                        const ClutterPoint *point)
+{
+  ClutterScrollActorPrivate *priv = actor->priv;
+
+  if (priv->transition != NULL)
+    {
+      clutter_actor_remove_transition (CLUTTER_ACTOR (actor), "scroll-to");
+      priv->transition = NULL;
+    }
+
+  clutter_scroll_actor_set_scroll_to_internal (actor, point);
+}
+
+/*< private >
+ * _clutter_scroll_actor_get_scroll_bounds:
+ * @actor: a #ClutterScrollActor
+ * @bounds: (out): return location for the range of the origin
+ *
+ * Retrieves the range of the origins of the visible area for which
+ * the visible area is covered by the children of @actor, along the
+ * directions set by the #ClutterScrollActor:scroll-mode property.
+ *
+ * If the children are smaller than @actor on a direction, the range
+ * on that direction is empty.
+ */
+void
+_clutter_scroll_actor_get_scroll_bounds (ClutterScrollActor *actor,
+                                         ClutterRect        *bounds)
+{
+  ClutterScrollActorPrivate *priv = actor->priv;
+  ClutterActorBox extent = { 0.f, 0.f, 0.f, 0.f };
+  ClutterActorIter iter;
+  ClutterActor *child;
+  gboolean first = TRUE;
+  gfloat width, height;
+
+  clutter_actor_iter_init (&iter, CLUTTER_ACTOR (actor));
+  while (clutter_actor_iter_next (&iter, &child))
+    {
+      ClutterActorBox box;
+
+      if (!clutter_actor_is_visible (child))
+        continue;
+
+      clutter_actor_get_allocation_box (child, &box);
+
+      if (first)
+        {
+          extent = box;
+          first = FALSE;
+        }
+      else
+        clutter_actor_box_union (&extent, &box, &extent);
+    }
+
+  clutter_actor_get_size (CLUTTER_ACTOR (actor), &width, &height);
+
+  clutter_rect_init (bounds, extent.x1, extent.y1, 0.f, 0.f);
+
+  if (priv->scroll_mode & CLUTTER_SCROLL_HORIZONTALLY)
+    bounds->size.width = MAX (extent.x2 - extent.x1 - width, 0.f);
+  else
+    bounds->origin.x = priv->scroll_to.x;
+
+  if (priv->scroll_mode & CLUTTER_SCROLL_VERTICALLY)
+    bounds->size.height = MAX (extent.y2 - extent.y1 - height, 0.f);
+  else
+    bounds->origin.y = priv->scroll_to.y;
+}
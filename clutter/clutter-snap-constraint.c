@@ -44,7 +44,7 @@
 #include "clutter-snap-constraint.h"
 
 #include "clutter-actor-private.h"
-#include "clutter-constraint.h"
+#include "clutter-constraint-private.h"
 #include "clutter-debug.h"
 #include "clutter-enum-types.h"
 #include "clutter-private.h"
@@ -299,6 +299,12 @@ clutter_snap_constraint_get_property (GObject    *gobject,
     }
 }
 
+static ClutterActor *
+clutter_snap_constraint_get_constraint_source (ClutterConstraint *constraint)
+{
+  return CLUTTER_SNAP_CONSTRAINT (constraint)->source;
+}
+
 static void
 clutter_snap_constraint_class_init (ClutterSnapConstraintClass *klass)
 {
@@ -309,6 +315,8 @@ clutter_snap_constraint_class_init (ClutterSnapConstraintClass *klass)
   meta_class->set_actor = clutter_snap_constraint_set_actor;
 
   constraint_class->update_allocation = clutter_snap_constraint_update_allocation;
+  clutter_constraint_class_set_source_func (constraint_class,
+                                            clutter_snap_constraint_get_constraint_source);
   /**
    * ClutterSnapConstraint:source:
    *
@@ -33,6 +33,25 @@ G_BEGIN_DECLS
 
 typedef struct _ClutterStageQueueRedrawEntry ClutterStageQueueRedrawEntry;
 
+/*< private >
+ * ClutterStageEventFunc:
+ * @stage: the #ClutterStage receiving the event
+ * @event: the event, in the capture phase
+ * @user_data: data passed to _clutter_stage_add_event_handler()
+ *
+ * A function called by the stage for the events it captures; it has
+ * the same semantics as a handler of #ClutterActor::captured-event
+ * connected with g_signal_connect_after().
+ *
+ * Return value: %CLUTTER_EVENT_STOP to stop the propagation of @event
+ */
+typedef gboolean (* ClutterStageEventFunc) (ClutterStage       *stage,
+                                            const ClutterEvent *event,
+                                            gpointer            user_data);
+
+#define CLUTTER_STAGE_EVENT_MASK(event_type)    (1u << (event_type))
+#define CLUTTER_STAGE_EVENT_MASK_ALL            ((1u << CLUTTER_EVENT_LAST) - 1)
+
 /* stage */
 ClutterStageWindow *_clutter_stage_get_default_window    (void);
 
@@ -58,6 +77,18 @@ void                _clutter_stage_get_viewport          (ClutterStage
 void                _clutter_stage_dirty_viewport        (ClutterStage          *stage);
 void                _clutter_stage_maybe_setup_viewport  (ClutterStage          *stage);
 void                _clutter_stage_maybe_relayout        (ClutterActor          *stage);
+void                _clutter_stage_add_constrained_actor (ClutterStage          *stage,
+                                                          ClutterActor          *actor,
+                                                          const ClutterActorBox *box,
+                                                          ClutterAllocationFlags flags,
+                                                          guint64                serial);
+gboolean            _clutter_stage_has_constrained_actor (ClutterStage          *stage,
+                                                          ClutterActor          *actor);
+void                _clutter_stage_constraints_changed   (ClutterStage          *stage);
+void                _clutter_stage_queue_relayout_boundary (ClutterStage        *stage,
+                                                            ClutterActor        *actor);
+void                _clutter_stage_count_queued_relayout (ClutterStage          *stage,
+                                                          guint64                n_invalidated);
 gboolean            _clutter_stage_needs_update          (ClutterStage          *stage);
 gboolean            _clutter_stage_do_update             (ClutterStage          *stage);
 
@@ -120,6 +151,15 @@ gboolean                _clutter_stage_update_state     (ClutterStage      *stag
                                                          ClutterStageState  unset_state,
                                                          ClutterStageState  set_state);
 
+guint           _clutter_stage_add_event_handler        (ClutterStage          *stage,
+                                                         guint                  event_mask,
+                                                         ClutterStageEventFunc  func,
+                                                         gpointer               user_data);
+void            _clutter_stage_remove_event_handler     (ClutterStage          *stage,
+                                                         guint                  handler_id);
+gboolean        _clutter_stage_dispatch_event_handlers  (ClutterStage          *stage,
+                                                         const ClutterEvent    *event);
+
 void                    _clutter_stage_set_scale_factor (ClutterStage      *stage,
                                                          int                factor);
 
@@ -174,6 +174,30 @@ _clutter_stage_window_clear_update_time (ClutterStageWindow *window)
   iface->clear_update_time (window);
 }
 
+/*< private >
+ * _clutter_stage_window_get_next_presentation_time:
+ * @window: a #ClutterStageWindow
+ *
+ * Predicts the time at which the frame being prepared will be
+ * presented, using the timing of the previous frames.
+ *
+ * Return value: the presentation time, in the time base of
+ *   g_get_monotonic_time(), or -1 if it cannot be predicted
+ */
+gint64
+_clutter_stage_window_get_next_presentation_time (ClutterStageWindow *window)
+{
+  ClutterStageWindowIface *iface;
+
+  g_return_val_if_fail (CLUTTER_IS_STAGE_WINDOW (window), -1);
+
+  iface = CLUTTER_STAGE_WINDOW_GET_IFACE (window);
+  if (iface->get_next_presentation_time == NULL)
+    return -1;
+
+  return iface->get_next_presentation_time (window);
+}
+
 void
 _clutter_stage_window_add_redraw_clip (ClutterStageWindow    *window,
                                        cairo_rectangle_int_t *stage_clip)
@@ -65,10 +65,12 @@
 #include "clutter-device-manager-private.h"
 #include "clutter-enum-types.h"
 #include "clutter-event-private.h"
+#include "clutter-event-recorder-private.h"
 #include "clutter-id-pool.h"
 #include "clutter-main.h"
 #include "clutter-marshal.h"
 #include "clutter-master-clock.h"
+#include "clutter-motion-resampler.h"
 #include "clutter-paint-volume-private.h"
 #include "clutter-private.h"
 #include "clutter-stage-manager-private.h"
@@ -120,7 +122,11 @@ struct _ClutterStagePrivate
   gchar *title;
   ClutterActor *key_focused_actor;
 
-  GQueue *event_queue;
+  /* ring buffer of queued events; compressed events leave a hole */
+  ClutterEvent **event_queue;
+  guint event_queue_size;
+  guint event_queue_head;
+  guint event_queue_length;
 
   ClutterStageHint stage_hints;
 
@@ -141,6 +147,11 @@ struct _ClutterStagePrivate
 
 #ifdef CLUTTER_ENABLE_DEBUG
   gulong redraw_count;
+  gulong relayout_count;
+  gulong constraint_update_count;
+  gulong queued_relayout_count;
+  gulong invalidated_actor_count;
+  gulong boundary_relayout_count;
 #endif /* CLUTTER_ENABLE_DEBUG */
 
   ClutterStageState current_state;
@@ -148,6 +159,42 @@ struct _ClutterStagePrivate
   gpointer paint_data;
   GDestroyNotify paint_notify;
 
+  /* resamples the motion events at the presentation time of the
+   * frames; only set if the resampling is enabled
+   */
+  ClutterMotionResampler *motion_resampler;
+
+  /* the handlers called directly for the captured events; see
+   * _clutter_stage_add_event_handler()
+   */
+  GArray *event_handlers;
+  guint event_handlers_mask;
+  guint last_event_handler_id;
+  guint event_handlers_dispatch_depth;
+
+  /* the actors with constraints allocated during the current
+   * relayout, and their index in the array
+   */
+  GArray *constrained_actors;
+  GHashTable *constrained_actors_index;
+
+  /* the relayout boundaries whose children queued a relayout */
+  GPtrArray *relayout_boundaries;
+
+  /* the statistics of the relayouts since the stage was created;
+   * see clutter_stage_get_relayout_counters()
+   */
+  guint64 n_relayouts;
+  guint64 n_constraint_updates;
+  guint64 n_constraint_cycles;
+
+  /* the statistics of the queued relayouts since the stage was
+   * created; see clutter_stage_get_invalidation_counters()
+   */
+  guint64 n_queued_relayouts;
+  guint64 n_invalidated_actors;
+  guint64 n_boundary_relayouts;
+
   guint relayout_pending       : 1;
   guint redraw_pending         : 1;
   guint is_fullscreen          : 1;
@@ -162,6 +209,9 @@ struct _ClutterStagePrivate
   guint accept_focus           : 1;
   guint motion_events_enabled  : 1;
   guint has_custom_perspective : 1;
+  guint event_handlers_dirty   : 1;
+  guint has_constraint_cycle   : 1;
+  guint in_relayout            : 1;
 };
 
 enum
@@ -898,6 +948,131 @@ clutter_stage_real_fullscreen (ClutterStage *stage)
                           CLUTTER_ALLOCATION_NONE);
 }
 
+/* the initial size of the event queue; it is grown when full, and it
+ * needs to be a power of two
+ */
+#define EVENT_QUEUE_INITIAL_SIZE        64
+
+#define EVENT_QUEUE_SLOT(priv,i)        \
+  ((priv)->event_queue[((priv)->event_queue_head + (i)) & ((priv)->event_queue_size - 1)])
+
+static void
+clutter_stage_grow_event_queue (ClutterStage *stage)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  ClutterEvent **events;
+  guint i, new_size;
+
+  new_size = priv->event_queue_size * 2;
+  events = g_new0 (ClutterEvent *, new_size);
+
+  /* unwrap the ring buffer while copying it */
+  for (i = 0; i < priv->event_queue_length; i++)
+    events[i] = EVENT_QUEUE_SLOT (priv, i);
+
+  g_free (priv->event_queue);
+
+  priv->event_queue = events;
+  priv->event_queue_size = new_size;
+  priv->event_queue_head = 0;
+
+  CLUTTER_NOTE (EVENT, "Stage event queue grown to %u events", new_size);
+}
+
+static inline gboolean
+clutter_stage_events_share_source (const ClutterEvent *event,
+                                   const ClutterEvent *other)
+{
+  ClutterInputDevice *device, *other_device;
+
+  device = clutter_event_get_device (event);
+  other_device = clutter_event_get_device (other);
+
+  /* events without a device are assumed to come from any device */
+  if (device != NULL && other_device != NULL && device != other_device)
+    return FALSE;
+
+  /* touch events are only related to events of the same sequence */
+  if (clutter_event_get_event_sequence (event) !=
+      clutter_event_get_event_sequence (other))
+    return FALSE;
+
+  return TRUE;
+}
+
+/*< private >
+ * clutter_stage_compress_event:
+ * @stage: a #ClutterStage
+ * @event: the event about to be queued
+ *
+ * Drops the last queued event coming from the same device and
+ * sequence of @event if @event supersedes it, that is, if both are
+ * motion events, or touch updates of the same sequence, or if @event
+ * is a leave event following a motion.
+ *
+ * The events of other devices or sequences can be interleaved between
+ * the two, but any other event from the same source stops the search.
+ *
+ * The samples of the dropped motion events and touch updates are kept
+ * in the history of @event.
+ */
+static void
+clutter_stage_compress_event (ClutterStage *stage,
+                              ClutterEvent *event)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  ClutterEventType compressed_type;
+  guint i;
+
+  switch (event->type)
+    {
+    case CLUTTER_MOTION:
+    case CLUTTER_LEAVE:
+      compressed_type = CLUTTER_MOTION;
+      break;
+
+    case CLUTTER_TOUCH_UPDATE:
+      compressed_type = CLUTTER_TOUCH_UPDATE;
+      break;
+
+    default:
+      return;
+    }
+
+  for (i = priv->event_queue_length; i > 0; i--)
+    {
+      ClutterEvent **slot = &EVENT_QUEUE_SLOT (priv, i - 1);
+      ClutterEvent *queued = *slot;
+
+      /* already compressed */
+      if (queued == NULL)
+        continue;
+
+      if (!clutter_stage_events_share_source (queued, event))
+        continue;
+
+      if (queued->type == compressed_type)
+        {
+          CLUTTER_NOTE (EVENT, "Omitting %s event at %d, %d",
+                        compressed_type == CLUTTER_MOTION ? "motion"
+                                                          : "touch update",
+                        (int) queued->motion.x,
+                        (int) queued->motion.y);
+
+          if (event->type == compressed_type)
+            _clutter_event_coalesce (event, queued);
+
+          /* leave a hole in the queue, to preserve the position of
+           * the other events
+           */
+          clutter_event_free (queued);
+          *slot = NULL;
+        }
+
+      break;
+    }
+}
+
 void
 _clutter_stage_queue_event (ClutterStage *stage,
                             ClutterEvent *event,
@@ -911,12 +1086,22 @@ _clutter_stage_queue_event (ClutterStage *stage,
 
   priv = stage->priv;
 
-  first_event = priv->event_queue->length == 0;
+  first_event = priv->event_queue_length == 0;
 
   if (copy_event)
     event = clutter_event_copy (event);
 
-  g_queue_push_tail (priv->event_queue, event);
+  if (G_UNLIKELY (_clutter_context_get_default ()->event_recorders != NULL))
+    _clutter_event_recorders_queue_event (stage, event);
+
+  if (priv->throttle_motion_events)
+    clutter_stage_compress_event (stage, event);
+
+  if (priv->event_queue_length == priv->event_queue_size)
+    clutter_stage_grow_event_queue (stage);
+
+  EVENT_QUEUE_SLOT (priv, priv->event_queue_length) = event;
+  priv->event_queue_length += 1;
 
   if (first_event)
     {
@@ -954,88 +1139,80 @@ _clutter_stage_has_queued_events (ClutterStage *stage)
 
   priv = stage->priv;
 
-  return priv->event_queue->length > 0;
+  return priv->event_queue_length > 0;
 }
 
 void
 _clutter_stage_process_queued_events (ClutterStage *stage)
 {
   ClutterStagePrivate *priv;
-  GList *events, *l;
+  gint64 presentation_time = -1;
+  gint64 frame_time = 0;
+  guint n_events;
 
   g_return_if_fail (CLUTTER_IS_STAGE (stage));
 
   priv = stage->priv;
 
-  if (priv->event_queue->length == 0)
+  if (priv->event_queue_length == 0)
     return;
 
   /* In case the stage gets destroyed during event processing */
   g_object_ref (stage);
 
-  /* Steal events before starting processing to avoid reentrancy
-   * issues */
-  events = priv->event_queue->head;
-  priv->event_queue->head =  NULL;
-  priv->event_queue->tail = NULL;
-  priv->event_queue->length = 0;
+  if (priv->motion_resampler != NULL)
+    _clutter_master_clock_get_frame_times (_clutter_master_clock_get_default (),
+                                           stage,
+                                           &frame_time,
+                                           &presentation_time);
 
-  for (l = events; l != NULL; l = l->next)
+  /* Only process the events queued so far, to avoid reentrancy
+   * issues; the events queued while processing will be handled
+   * on the next frame
+   */
+  n_events = priv->event_queue_length;
+
+  while (n_events > 0 && priv->event_queue_length > 0)
     {
       ClutterEvent *event;
-      ClutterEvent *next_event;
-      ClutterInputDevice *device;
-      ClutterInputDevice *next_device;
-      gboolean check_device = FALSE;
-
-      event = l->data;
-      next_event = l->next ? l->next->data : NULL;
 
-      device = clutter_event_get_device (event);
+      /* pop the event before processing it, so that it cannot be
+       * compressed away while it's being emitted
+       */
+      event = EVENT_QUEUE_SLOT (priv, 0);
+      EVENT_QUEUE_SLOT (priv, 0) = NULL;
+      priv->event_queue_head = (priv->event_queue_head + 1) & (priv->event_queue_size - 1);
+      priv->event_queue_length -= 1;
+      n_events -= 1;
+
+      if (event == NULL)
+        continue;
+
+      /* only the delivered event is resampled; the input device
+       * keeps the coordinates of the last real event, which were set
+       * when it was queued
+       */
+      if (priv->motion_resampler != NULL)
+        _clutter_motion_resampler_process (priv->motion_resampler,
+                                           event,
+                                           frame_time,
+                                           presentation_time);
 
-      if (next_event != NULL)
-        next_device = clutter_event_get_device (next_event);
-      else
-        next_device = NULL;
+      if (G_UNLIKELY (_clutter_event_get_replay_serial (event) != 0))
+        {
+          gint64 start_time = g_get_monotonic_time ();
 
-      if (device != NULL && next_device != NULL)
-        check_device = TRUE;
+          _clutter_process_event (event);
 
-      /* Skip consecutive motion events coming from the same device */
-      if (priv->throttle_motion_events && next_event != NULL)
-        {
-          if (event->type == CLUTTER_MOTION &&
-              (next_event->type == CLUTTER_MOTION ||
-               next_event->type == CLUTTER_LEAVE) &&
-              (!check_device || (device == next_device)))
-            {
-              CLUTTER_NOTE (EVENT,
-                            "Omitting motion event at %d, %d",
-                            (int) event->motion.x,
-                            (int) event->motion.y);
-              goto next_event;
-            }
-          else if (event->type == CLUTTER_TOUCH_UPDATE &&
-                   next_event->type == CLUTTER_TOUCH_UPDATE &&
-                   event->touch.sequence == next_event->touch.sequence &&
-                   (!check_device || (device == next_device)))
-            {
-              CLUTTER_NOTE (EVENT,
-                            "Omitting touch update event at %d, %d",
-                            (int) event->touch.x,
-                            (int) event->touch.y);
-              goto next_event;
-            }
+          _clutter_event_player_event_processed (event,
+                                                 g_get_monotonic_time () - start_time);
         }
+      else
+        _clutter_process_event (event);
 
-      _clutter_process_event (event);
-
-    next_event:
       clutter_event_free (event);
     }
 
-  g_list_free (events);
-
   g_object_unref (stage);
 }
 
@@ -1059,6 +1236,411 @@ _clutter_stage_needs_update (ClutterStage *stage)
   return priv->relayout_pending || priv->redraw_pending;
 }
 
+typedef struct _ConstrainedActor
+{
+  ClutterActor *actor;
+
+  /* the allocation given by the parent, before the constraints */
+  ClutterActorBox box;
+  ClutterAllocationFlags flags;
+
+  /* the allocation serial when the constraints were applied */
+  guint64 serial;
+} ConstrainedActor;
+
+/* the number of times the constraints are applied again in a
+ * relayout, if the dependencies between the actors form a cycle
+ */
+#define MAX_CONSTRAINT_PASSES   4
+
+/*< private >
+ * _clutter_stage_add_constrained_actor:
+ * @stage: a #ClutterStage
+ * @actor: an actor with constraints
+ * @box: the allocation given to @actor by its parent
+ * @flags: the allocation flags
+ * @serial: the allocation serial when the constraints of @actor
+ *   were applied
+ *
+ * Records an actor with constraints allocated during the relayout
+ * of @stage, so that its constraints can be applied again if their
+ * sources are allocated after @actor. Allocations outside of
+ * _clutter_stage_maybe_relayout() are ignored.
+ */
+void
+_clutter_stage_add_constrained_actor (ClutterStage           *stage,
+                                      ClutterActor           *actor,
+                                      const ClutterActorBox  *box,
+                                      ClutterAllocationFlags  flags,
+                                      guint64                 serial)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  ConstrainedActor *entry;
+  gpointer index_p;
+
+  if (!priv->in_relayout)
+    return;
+
+  if (g_hash_table_lookup_extended (priv->constrained_actors_index, actor,
+                                    NULL, &index_p))
+    {
+      entry = &g_array_index (priv->constrained_actors, ConstrainedActor,
+                              GPOINTER_TO_UINT (index_p));
+    }
+  else
+    {
+      guint index_ = priv->constrained_actors->len;
+
+      g_hash_table_insert (priv->constrained_actors_index, actor,
+                           GUINT_TO_POINTER (index_));
+
+      g_array_set_size (priv->constrained_actors, index_ + 1);
+      entry = &g_array_index (priv->constrained_actors, ConstrainedActor, index_);
+      entry->actor = g_object_ref (actor);
+    }
+
+  entry->box = *box;
+  entry->flags = flags;
+  entry->serial = serial;
+}
+
+/*< private >
+ * _clutter_stage_has_constrained_actor:
+ * @stage: a #ClutterStage
+ * @actor: a #ClutterActor
+ *
+ * Checks whether @actor was recorded by
+ * _clutter_stage_add_constrained_actor() during the current relayout,
+ * in which case its constraints are applied again at the end of the
+ * relayout if their sources change, without queueing another one.
+ *
+ * Return value: %TRUE if the constraints of @actor will be updated
+ */
+gboolean
+_clutter_stage_has_constrained_actor (ClutterStage *stage,
+                                      ClutterActor *actor)
+{
+  return g_hash_table_contains (stage->priv->constrained_actors_index, actor);
+}
+
+/*< private >
+ * _clutter_stage_constraints_changed:
+ * @stage: a #ClutterStage
+ *
+ * Notifies @stage that a constraint was added to, or removed from, one
+ * of its actors, or that its source changed, so that a cycle between the
+ * constraints is reported again if the dependencies still form one.
+ */
+void
+_clutter_stage_constraints_changed (ClutterStage *stage)
+{
+  stage->priv->has_constraint_cycle = FALSE;
+}
+
+/* Sorts the constrained actors so that each actor comes after the
+ * constrained actors that are, or contain, the sources of its
+ * constraints; the actors whose dependencies form a cycle are left
+ * at the end, in the order in which they were allocated.
+ *
+ * Returns FALSE if there is a cycle.
+ */
+static gboolean
+clutter_stage_sort_constrained_actors (ClutterStage *stage,
+                                       guint        *order)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  guint n_actors = priv->constrained_actors->len;
+  guint *n_deps, *first_dependent, *next_dependent, *dependents;
+  GPtrArray *sources;
+  GArray *edges;
+  gboolean has_cycle;
+  guint n_sorted, i, j;
+
+  n_deps = g_new0 (guint, n_actors);
+  first_dependent = g_new0 (guint, n_actors + 1);
+
+  /* pairs of indices: an actor, and an actor depending on it */
+  edges = g_array_new (FALSE, FALSE, sizeof (guint));
+  sources = g_ptr_array_new ();
+
+  for (i = 0; i < n_actors; i++)
+    {
+      ConstrainedActor *entry;
+
+      entry = &g_array_index (priv->constrained_actors, ConstrainedActor, i);
+
+      g_ptr_array_set_size (sources, 0);
+      _clutter_actor_get_constraint_sources (entry->actor, sources);
+
+      for (j = 0; j < sources->len; j++)
+        {
+          ClutterActor *source;
+
+          /* moving or resizing an ancestor of the source may
+           * change the allocation of the source as well
+           */
+          for (source = g_ptr_array_index (sources, j);
+               source != NULL;
+               source = clutter_actor_get_parent (source))
+            {
+              gpointer index_p;
+              guint k;
+
+              if (!g_hash_table_lookup_extended (priv->constrained_actors_index,
+                                                 source,
+                                                 NULL, &index_p))
+                continue;
+
+              k = GPOINTER_TO_UINT (index_p);
+              if (k == i)
+                continue;
+
+              g_array_append_val (edges, k);
+              g_array_append_val (edges, i);
+
+              first_dependent[k + 1] += 1;
+              n_deps[i] += 1;
+            }
+        }
+    }
+
+  for (i = 0; i < n_actors; i++)
+    first_dependent[i + 1] += first_dependent[i];
+
+  dependents = g_new (guint, MAX (edges->len / 2, 1));
+  next_dependent = g_memdup (first_dependent, n_actors * sizeof (guint));
+
+  for (i = 0; i < edges->len; i += 2)
+    {
+      guint k = g_array_index (edges, guint, i);
+
+      dependents[next_dependent[k]++] = g_array_index (edges, guint, i + 1);
+    }
+
+  n_sorted = 0;
+  for (i = 0; i < n_actors; i++)
+    {
+      if (n_deps[i] == 0)
+        order[n_sorted++] = i;
+    }
+
+  for (i = 0; i < n_sorted; i++)
+    {
+      guint k = order[i];
+
+      for (j = first_dependent[k]; j < first_dependent[k + 1]; j++)
+        {
+          guint dependent = dependents[j];
+
+          n_deps[dependent] -= 1;
+          if (n_deps[dependent] == 0)
+            order[n_sorted++] = dependent;
+        }
+    }
+
+  has_cycle = n_sorted < n_actors;
+  if (has_cycle)
+    {
+      for (i = 0; i < n_actors; i++)
+        {
+          if (n_deps[i] > 0)
+            order[n_sorted++] = i;
+        }
+
+      g_assert (n_sorted == n_actors);
+    }
+
+  g_free (n_deps);
+  g_free (first_dependent);
+  g_free (next_dependent);
+  g_free (dependents);
+  g_array_unref (edges);
+  g_ptr_array_unref (sources);
+
+  return !has_cycle;
+}
+
+/* Applies the constraints of the actors allocated during the
+ * relayout again, in the order of their dependencies, if one of
+ * their sources was allocated after them; this lets chains of
+ * constraints settle within a single relayout.
+ */
+static void
+clutter_stage_resolve_constraints (ClutterStage *stage)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  GPtrArray *sources;
+  gboolean changed, has_cycle;
+  guint pass, i, j;
+
+  if (priv->constrained_actors->len == 0)
+    return;
+
+  sources = g_ptr_array_new ();
+
+  changed = TRUE;
+  has_cycle = FALSE;
+  for (pass = 0; changed && pass < MAX_CONSTRAINT_PASSES; pass++)
+    {
+      guint n_actors = priv->constrained_actors->len;
+      guint *order = g_new (guint, n_actors);
+
+      if (!clutter_stage_sort_constrained_actors (stage, order))
+        has_cycle = TRUE;
+
+      if (has_cycle && !priv->has_constraint_cycle)
+        {
+          g_warning ("The constraints of the actors of the stage '%s' "
+                     "depend on each other in a cycle; their allocations "
+                     "will not be stable",
+                     _clutter_actor_get_debug_name (CLUTTER_ACTOR (stage)));
+          priv->has_constraint_cycle = TRUE;
+        }
+
+      changed = FALSE;
+
+      for (i = 0; i < n_actors; i++)
+        {
+          ConstrainedActor *entry;
+          ClutterAllocationFlags flags;
+          ClutterActorBox box;
+          ClutterActor *actor;
+          gboolean is_stale;
+
+          entry = &g_array_index (priv->constrained_actors, ConstrainedActor, order[i]);
+          actor = entry->actor;
+
+          if (CLUTTER_ACTOR_IN_DESTRUCTION (actor) ||
+              _clutter_actor_get_stage_internal (actor) != CLUTTER_ACTOR (stage))
+            continue;
+
+          g_ptr_array_set_size (sources, 0);
+          _clutter_actor_get_constraint_sources (actor, sources);
+
+          is_stale = FALSE;
+          for (j = 0; j < sources->len && !is_stale; j++)
+            {
+              ClutterActor *source = g_ptr_array_index (sources, j);
+
+              is_stale = _clutter_actor_get_allocation_serial (source) > entry->serial;
+            }
+
+          if (!is_stale)
+            continue;
+
+          CLUTTER_NOTE (LAYOUT, "Updating the constraints of '%s'",
+                        _clutter_actor_get_debug_name (actor));
+
+          /* the parent already propagated a change of the absolute
+           * origin; allocating updates the entry, and may add new ones
+           */
+          box = entry->box;
+          flags = entry->flags & ~CLUTTER_ABSOLUTE_ORIGIN_CHANGED;
+          clutter_actor_allocate (actor, &box, flags);
+
+#ifdef CLUTTER_ENABLE_DEBUG
+          priv->constraint_update_count += 1;
+#endif
+          priv->n_constraint_updates += 1;
+
+          changed = TRUE;
+        }
+
+      g_free (order);
+    }
+
+  if (has_cycle)
+    priv->n_constraint_cycles += 1;
+
+  for (i = 0; i < priv->constrained_actors->len; i++)
+    g_object_unref (g_array_index (priv->constrained_actors, ConstrainedActor, i).actor);
+
+  g_array_set_size (priv->constrained_actors, 0);
+  g_hash_table_remove_all (priv->constrained_actors_index);
+
+  g_ptr_array_unref (sources);
+}
+
+/*< private >
+ * _clutter_stage_queue_relayout_boundary:
+ * @stage: a #ClutterStage
+ * @actor: a relayout boundary
+ *
+ * Queues a relayout of the children of @actor, whose size does not
+ * depend on them; the children are allocated by the next relayout
+ * of @stage, without allocating the ancestors of @actor.
+ */
+void
+_clutter_stage_queue_relayout_boundary (ClutterStage *stage,
+                                        ClutterActor *actor)
+{
+  ClutterStagePrivate *priv = stage->priv;
+
+  g_ptr_array_add (priv->relayout_boundaries, g_object_ref (actor));
+
+  if (!priv->relayout_pending)
+    {
+      _clutter_stage_schedule_update (stage);
+      priv->relayout_pending = TRUE;
+    }
+}
+
+/*< private >
+ * _clutter_stage_count_queued_relayout:
+ * @stage: a #ClutterStage
+ * @n_invalidated: the number of actors invalidated by the relayout
+ *
+ * Records a relayout queued by an actor of @stage, for the
+ * statistics of the frame and clutter_stage_get_invalidation_counters().
+ */
+void
+_clutter_stage_count_queued_relayout (ClutterStage *stage,
+                                      guint64       n_invalidated)
+{
+  ClutterStagePrivate *priv = stage->priv;
+
+#ifdef CLUTTER_ENABLE_DEBUG
+  priv->queued_relayout_count += 1;
+  priv->invalidated_actor_count += n_invalidated;
+#endif
+
+  priv->n_queued_relayouts += 1;
+  priv->n_invalidated_actors += n_invalidated;
+}
+
+/* allocates the children of the relayout boundaries queued before
+ * the relayout, unless the relayout already allocated them; the
+ * boundaries queued while doing so are left for the next relayout
+ */
+static void
+clutter_stage_relayout_boundaries (ClutterStage *stage)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  guint n_boundaries, i;
+
+  n_boundaries = priv->relayout_boundaries->len;
+  if (n_boundaries == 0)
+    return;
+
+  for (i = 0; i < n_boundaries; i++)
+    {
+      ClutterActor *actor = g_ptr_array_index (priv->relayout_boundaries, i);
+
+      if (_clutter_actor_get_stage_internal (actor) != CLUTTER_ACTOR (stage))
+        continue;
+
+      if (_clutter_actor_relayout_boundary (actor))
+        {
+#ifdef CLUTTER_ENABLE_DEBUG
+          priv->boundary_relayout_count += 1;
+#endif
+          priv->n_boundary_relayouts += 1;
+        }
+    }
+
+  g_ptr_array_remove_range (priv->relayout_boundaries, 0, n_boundaries);
+}
+
 void
 _clutter_stage_maybe_relayout (ClutterActor *actor)
 {
@@ -1078,6 +1660,7 @@ _clutter_stage_maybe_relayout (ClutterActor *actor)
       CLUTTER_NOTE (ACTOR, "Recomputing layout");
 
       CLUTTER_SET_PRIVATE_FLAGS (stage, CLUTTER_IN_RELAYOUT);
+      priv->in_relayout = TRUE;
 
       natural_width = natural_height = 0;
       clutter_actor_get_preferred_size (CLUTTER_ACTOR (stage),
@@ -1096,7 +1679,17 @@ _clutter_stage_maybe_relayout (ClutterActor *actor)
       clutter_actor_allocate (CLUTTER_ACTOR (stage),
                               &box, CLUTTER_ALLOCATION_NONE);
 
+      clutter_stage_relayout_boundaries (stage);
+
+      clutter_stage_resolve_constraints (stage);
+
+      priv->in_relayout = FALSE;
       CLUTTER_UNSET_PRIVATE_FLAGS (stage, CLUTTER_IN_RELAYOUT);
+
+#ifdef CLUTTER_ENABLE_DEBUG
+      priv->relayout_count += 1;
+#endif
+      priv->n_relayouts += 1;
     }
 }
 
@@ -1196,6 +1789,31 @@ _clutter_stage_do_update (ClutterStage *stage)
 
       priv->redraw_count = 0;
     }
+
+  if (priv->relayout_count > 0)
+    {
+      CLUTTER_NOTE (LAYOUT, "Ran %lu relayouts during the last cycle, "
+                    "updating the constraints of %lu actors",
+                    priv->relayout_count,
+                    priv->constraint_update_count);
+
+      priv->relayout_count = 0;
+      priv->constraint_update_count = 0;
+    }
+
+  if (priv->queued_relayout_count > 0)
+    {
+      CLUTTER_NOTE (LAYOUT, "Queued %lu relayouts during the last cycle, "
+                    "invalidating %lu actors; allocated the children "
+                    "of %lu relayout boundaries",
+                    priv->queued_relayout_count,
+                    priv->invalidated_actor_count,
+                    priv->boundary_relayout_count);
+
+      priv->queued_relayout_count = 0;
+      priv->invalidated_actor_count = 0;
+      priv->boundary_relayout_count = 0;
+    }
 #endif /* CLUTTER_ENABLE_DEBUG */
 
   return TRUE;
@@ -1734,13 +2352,27 @@ clutter_stage_finalize (GObject *object)
   ClutterStage *stage = CLUTTER_STAGE (object);
   ClutterStagePrivate *priv = stage->priv;
 
-  g_queue_foreach (priv->event_queue, (GFunc) clutter_event_free, NULL);
-  g_queue_free (priv->event_queue);
+  while (priv->event_queue_length > 0)
+    {
+      priv->event_queue_length -= 1;
+      clutter_event_free (EVENT_QUEUE_SLOT (priv, priv->event_queue_length));
+    }
+
+  g_free (priv->event_queue);
+
+  _clutter_motion_resampler_free (priv->motion_resampler);
+
+  if (priv->event_handlers != NULL)
+    g_array_unref (priv->event_handlers);
 
   g_free (priv->title);
 
   g_array_free (priv->paint_volume_stack, TRUE);
 
+  g_array_unref (priv->constrained_actors);
+  g_hash_table_unref (priv->constrained_actors_index);
+  g_ptr_array_unref (priv->relayout_boundaries);
+
   _clutter_id_pool_free (priv->pick_id_pool);
 
   if (priv->fps_timer != NULL)
@@ -2159,7 +2791,8 @@ clutter_stage_init (ClutterStage *self)
         g_critical ("Unable to create a new stage implementation.");
     }
 
-  priv->event_queue = g_queue_new ();
+  priv->event_queue_size = EVENT_QUEUE_INITIAL_SIZE;
+  priv->event_queue = g_new0 (ClutterEvent *, priv->event_queue_size);
 
   priv->is_fullscreen = FALSE;
   priv->is_user_resizable = FALSE;
@@ -2226,6 +2859,11 @@ clutter_stage_init (ClutterStage *self)
   priv->paint_volume_stack =
     g_array_new (FALSE, FALSE, sizeof (ClutterPaintVolume));
 
+  priv->constrained_actors =
+    g_array_new (FALSE, FALSE, sizeof (ConstrainedActor));
+  priv->constrained_actors_index = g_hash_table_new (NULL, NULL);
+  priv->relayout_boundaries = g_ptr_array_new_with_free_func (g_object_unref);
+
   priv->pick_id_pool = _clutter_id_pool_new (256);
 }
 
@@ -3523,6 +4161,86 @@ clutter_stage_ensure_redraw (ClutterStage *stage)
   _clutter_master_clock_start_running (master_clock);
 }
 
+/**
+ * clutter_stage_get_relayout_counters:
+ * @stage: a #ClutterStage
+ * @n_relayouts: (out) (optional): return location for the number of
+ *   relayouts of @stage
+ * @n_constraint_updates: (out) (optional): return location for the
+ *   number of times the constraints of an actor were applied again
+ *   because their sources were allocated after the actor
+ * @n_constraint_cycles: (out) (optional): return location for the
+ *   number of relayouts in which the constraints of the actors depended
+ *   on each other in a cycle
+ *
+ * Retrieves the counters of the relayouts of @stage since its creation;
+ * this can be used to measure how well the constraints of the actors
+ * settle within a single relayout.
+ *
+ * Since: 1.28
+ */
+void
+clutter_stage_get_relayout_counters (ClutterStage *stage,
+                                     guint64      *n_relayouts,
+                                     guint64      *n_constraint_updates,
+                                     guint64      *n_constraint_cycles)
+{
+  ClutterStagePrivate *priv;
+
+  g_return_if_fail (CLUTTER_IS_STAGE (stage));
+
+  priv = stage->priv;
+
+  if (n_relayouts != NULL)
+    *n_relayouts = priv->n_relayouts;
+
+  if (n_constraint_updates != NULL)
+    *n_constraint_updates = priv->n_constraint_updates;
+
+  if (n_constraint_cycles != NULL)
+    *n_constraint_cycles = priv->n_constraint_cycles;
+}
+
+/**
+ * clutter_stage_get_invalidation_counters:
+ * @stage: a #ClutterStage
+ * @n_queued_relayouts: (out) (optional): return location for the number
+ *   of relayouts queued by the actors of @stage that invalidated at
+ *   least one actor
+ * @n_invalidated_actors: (out) (optional): return location for the
+ *   number of actors whose size was invalidated by those relayouts
+ * @n_boundary_relayouts: (out) (optional): return location for the
+ *   number of times the children of a relayout boundary were allocated
+ *   without allocating its ancestors
+ *
+ * Retrieves the counters of the relayouts queued on the actors of
+ * @stage since its creation; this can be used to measure the effect
+ * of clutter_actor_set_relayout_boundary().
+ *
+ * Since: 1.28
+ */
+void
+clutter_stage_get_invalidation_counters (ClutterStage *stage,
+                                         guint64      *n_queued_relayouts,
+                                         guint64      *n_invalidated_actors,
+                                         guint64      *n_boundary_relayouts)
+{
+  ClutterStagePrivate *priv;
+
+  g_return_if_fail (CLUTTER_IS_STAGE (stage));
+
+  priv = stage->priv;
+
+  if (n_queued_relayouts != NULL)
+    *n_queued_relayouts = priv->n_queued_relayouts;
+
+  if (n_invalidated_actors != NULL)
+    *n_invalidated_actors = priv->n_invalidated_actors;
+
+  if (n_boundary_relayouts != NULL)
+    *n_boundary_relayouts = priv->n_boundary_relayouts;
+}
+
 /**
  * clutter_stage_queue_redraw:
  * @stage: the #ClutterStage
@@ -3650,6 +4368,72 @@ clutter_stage_get_throttle_motion_events (ClutterStage *stage)
   return stage->priv->throttle_motion_events;
 }
 
+/**
+ * clutter_stage_set_motion_resampling:
+ * @stage: a #ClutterStage
+ * @resample: %TRUE to resample the motion events
+ *
+ * Sets whether the coordinates of the motion events and touch updates
+ * delivered on each frame should be resampled at a fixed point in
+ * time relative to the presentation of the frame.
+ *
+ * Input devices report at rates unrelated to the refresh rate of the
+ * display, so the last motion event received before a frame can be
+ * more or less recent, and a steady motion advances by uneven steps
+ * between frames. When resampling, @stage keeps the last few samples
+ * of each device and touch sequence, and delivers their position
+ * shortly before the predicted presentation time of the frame,
+ * interpolating or slightly extrapolating the samples, in exchange
+ * for a few milliseconds of latency.
+ *
+ * Resampling only happens when the presentation time of the frames
+ * is known; when using clutter_enable_manual_master_clock(), each frame
+ * is considered presented at the time of the master clock, and the
+ * events are expected to carry timestamps following the same clock.
+ * Resampling is meant to be used together with the throttling
+ * of motion events; see clutter_stage_set_throttle_motion_events().
+ * The raw samples of the compressed events are still available using
+ * clutter_event_get_history_coords().
+ *
+ * Since: 1.28
+ */
+void
+clutter_stage_set_motion_resampling (ClutterStage *stage,
+                                     gboolean      resample)
+{
+  ClutterStagePrivate *priv;
+
+  g_return_if_fail (CLUTTER_IS_STAGE (stage));
+
+  priv = stage->priv;
+
+  if (resample && priv->motion_resampler == NULL)
+    priv->motion_resampler = _clutter_motion_resampler_new ();
+  else if (!resample && priv->motion_resampler != NULL)
+    {
+      _clutter_motion_resampler_free (priv->motion_resampler);
+      priv->motion_resampler = NULL;
+    }
+}
+
+/**
+ * clutter_stage_get_motion_resampling:
+ * @stage: a #ClutterStage
+ *
+ * Retrieves the value set with clutter_stage_set_motion_resampling().
+ *
+ * Return value: %TRUE if the motion events are resampled
+ *
+ * Since: 1.28
+ */
+gboolean
+clutter_stage_get_motion_resampling (ClutterStage *stage)
+{
+  g_return_val_if_fail (CLUTTER_IS_STAGE (stage), FALSE);
+
+  return stage->priv->motion_resampler != NULL;
+}
+
 /**
  * clutter_stage_set_use_alpha:
  * @stage: a #ClutterStage
@@ -4351,6 +5135,187 @@ _clutter_stage_remove_touch_drag_actor (ClutterStage         *stage,
                        NULL);
 }
 
+typedef struct _StageEventHandler
+{
+  guint id;
+  guint event_mask;
+  ClutterStageEventFunc func;
+  gpointer user_data;
+} StageEventHandler;
+
+static void
+clutter_stage_update_event_handlers (ClutterStage *stage)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  guint i;
+
+  priv->event_handlers_mask = 0;
+
+  i = 0;
+  while (i < priv->event_handlers->len)
+    {
+      StageEventHandler *handler;
+
+      handler = &g_array_index (priv->event_handlers, StageEventHandler, i);
+
+      /* the handlers removed during a dispatch are only unset */
+      if (handler->func == NULL)
+        {
+          g_array_remove_index (priv->event_handlers, i);
+          continue;
+        }
+
+      priv->event_handlers_mask |= handler->event_mask;
+      i += 1;
+    }
+
+  priv->event_handlers_dirty = FALSE;
+}
+
+/*< private >
+ * _clutter_stage_add_event_handler:
+ * @stage: a #ClutterStage
+ * @event_mask: a bitwise OR of CLUTTER_STAGE_EVENT_MASK() for the
+ *   types of the events @func is interested in
+ * @func: the function to call
+ * @user_data: data to pass to @func
+ *
+ * Adds a function to be called for each event of the types in
+ * @event_mask captured by @stage.
+ *
+ * The function is called after the #ClutterActor::captured-event
+ * signal has been emitted on @stage, unless one of its handlers
+ * stopped the event, in the order the functions were added. Unlike
+ * a signal handler, the function is called without marshalling, and
+ * only for the events it is interested in; this is meant for the
+ * actions tracking the input devices during a gesture, which would
+ * otherwise handle every event twice.
+ *
+ * Return value: the identifier of the handler, to be used with
+ *   _clutter_stage_remove_event_handler()
+ */
+guint
+_clutter_stage_add_event_handler (ClutterStage          *stage,
+                                  guint                  event_mask,
+                                  ClutterStageEventFunc  func,
+                                  gpointer               user_data)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  StageEventHandler handler;
+
+  g_return_val_if_fail (func != NULL, 0);
+
+  if (priv->event_handlers == NULL)
+    priv->event_handlers = g_array_new (FALSE, FALSE, sizeof (StageEventHandler));
+
+  handler.id = ++priv->last_event_handler_id;
+  handler.event_mask = event_mask;
+  handler.func = func;
+  handler.user_data = user_data;
+
+  g_array_append_val (priv->event_handlers, handler);
+  priv->event_handlers_mask |= event_mask;
+
+  return handler.id;
+}
+
+/*< private >
+ * _clutter_stage_remove_event_handler:
+ * @stage: a #ClutterStage
+ * @handler_id: the identifier returned by _clutter_stage_add_event_handler()
+ *
+ * Removes an event handler from @stage. It is safe to call this
+ * function from an event handler.
+ */
+void
+_clutter_stage_remove_event_handler (ClutterStage *stage,
+                                     guint         handler_id)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  guint i;
+
+  if (priv->event_handlers == NULL)
+    return;
+
+  for (i = 0; i < priv->event_handlers->len; i++)
+    {
+      StageEventHandler *handler;
+
+      handler = &g_array_index (priv->event_handlers, StageEventHandler, i);
+      if (handler->id != handler_id)
+        continue;
+
+      handler->func = NULL;
+      handler->event_mask = 0;
+
+      if (priv->event_handlers_dispatch_depth > 0)
+        priv->event_handlers_dirty = TRUE;
+      else
+        clutter_stage_update_event_handlers (stage);
+
+      return;
+    }
+
+  g_warning ("%s: no event handler with identifier %u on stage %p",
+             G_STRLOC,
+             handler_id,
+             stage);
+}
+
+/*< private >
+ * _clutter_stage_dispatch_event_handlers:
+ * @stage: a #ClutterStage
+ * @event: a captured event
+ *
+ * Calls the event handlers of @stage interested in @event. The
+ * handlers added during the dispatch are not called for @event.
+ *
+ * Return value: %CLUTTER_EVENT_STOP if a handler stopped the event
+ */
+gboolean
+_clutter_stage_dispatch_event_handlers (ClutterStage       *stage,
+                                        const ClutterEvent *event)
+{
+  ClutterStagePrivate *priv = stage->priv;
+  gboolean retval = CLUTTER_EVENT_PROPAGATE;
+  guint event_mask, i, n_handlers;
+
+  if (event->type >= CLUTTER_EVENT_LAST)
+    return CLUTTER_EVENT_PROPAGATE;
+
+  event_mask = CLUTTER_STAGE_EVENT_MASK (event->type);
+  if ((priv->event_handlers_mask & event_mask) == 0)
+    return CLUTTER_EVENT_PROPAGATE;
+
+  priv->event_handlers_dispatch_depth += 1;
+
+  n_handlers = priv->event_handlers->len;
+  for (i = 0; i < n_handlers; i++)
+    {
+      StageEventHandler *handler;
+
+      /* the array can be reallocated by the handlers, so the
+       * handler has to be looked up again at each iteration
+       */
+      handler = &g_array_index (priv->event_handlers, StageEventHandler, i);
+      if (handler->func == NULL || (handler->event_mask & event_mask) == 0)
+        continue;
+
+      if (handler->func (stage, event, handler->user_data))
+        {
+          retval = CLUTTER_EVENT_STOP;
+          break;
+        }
+    }
+
+  priv->event_handlers_dispatch_depth -= 1;
+
+  if (priv->event_handlers_dispatch_depth == 0 && priv->event_handlers_dirty)
+    clutter_stage_update_event_handlers (stage);
+
+  return retval;
+}
+
 /*< private >
  * _clutter_stage_get_state:
  * @stage: a #ClutterStage
@@ -200,6 +200,11 @@ void            clutter_stage_set_throttle_motion_events        (ClutterStage
                                                                  gboolean               throttle);
 CLUTTER_AVAILABLE_IN_ALL
 gboolean        clutter_stage_get_throttle_motion_events        (ClutterStage          *stage);
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_stage_set_motion_resampling             (ClutterStage          *stage,
+                                                                 gboolean               resample);
+CLUTTER_AVAILABLE_IN_1_28
+gboolean        clutter_stage_get_motion_resampling             (ClutterStage          *stage);
 CLUTTER_AVAILABLE_IN_ALL
 void            clutter_stage_set_motion_events_enabled         (ClutterStage          *stage,
                                                                  gboolean               enabled);
@@ -237,6 +242,17 @@ void            clutter_stage_ensure_viewport                   (ClutterStage
 CLUTTER_AVAILABLE_IN_ALL
 void            clutter_stage_ensure_redraw                     (ClutterStage          *stage);
 
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_stage_get_relayout_counters             (ClutterStage          *stage,
+                                                                 guint64               *n_relayouts,
+                                                                 guint64               *n_constraint_updates,
+                                                                 guint64               *n_constraint_cycles);
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_stage_get_invalidation_counters         (ClutterStage          *stage,
+                                                                 guint64               *n_queued_relayouts,
+                                                                 guint64               *n_invalidated_actors,
+                                                                 guint64               *n_boundary_relayouts);
+
 #ifdef CLUTTER_ENABLE_EXPERIMENTAL_API
 CLUTTER_AVAILABLE_IN_1_14
 void            clutter_stage_set_sync_delay                    (ClutterStage          *stage,
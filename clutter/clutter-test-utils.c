@@ -7,6 +7,7 @@
 
 #include "clutter-actor.h"
 #include "clutter-color.h"
+#include "clutter-device-manager.h"
 #include "clutter-event.h"
 #include "clutter-keysyms.h"
 #include "clutter-main.h"
@@ -17,6 +18,11 @@ typedef struct {
   ClutterActor *stage;
 
   guint no_display : 1;
+
+  /* whether the events put by clutter_test_put_pointer_event() left
+   * the primary button pressed
+   */
+  guint button_pressed : 1;
 } ClutterTestEnvironment;
 
 static ClutterTestEnvironment *test_environ = NULL;
@@ -119,6 +125,8 @@ clutter_test_func_wrapper (gconstpointer data_)
   /* ensure that the previous test state has been cleaned up */
   g_assert_null (test_environ->stage);
 
+  test_environ->button_pressed = FALSE;
+
   if (test_environ->no_display)
     {
       g_test_skip ("No DISPLAY set");
@@ -270,6 +278,143 @@ clutter_test_run (void)
   return res;
 }
 
+/**
+ * clutter_test_run_frames:
+ * @n_frames: the number of frames to run
+ *
+ * Hands the events put in the queue over to their stage, and then
+ * advances the manual master clock by @n_frames frames, each one
+ * %CLUTTER_TEST_FRAME_INTERVAL microseconds long.
+ *
+ * The events are only processed by the stage during a frame, so this
+ * function is typically called after clutter_test_put_pointer_event()
+ * or clutter_test_put_key_event().
+ *
+ * This function can only be used by test suites defined with
+ * %CLUTTER_TEST_SUITE_MANUAL_CLOCK.
+ *
+ * Since: 1.28
+ */
+void
+clutter_test_run_frames (guint n_frames)
+{
+  g_assert (test_environ != NULL);
+
+  while (g_main_context_pending (NULL))
+    g_main_context_iteration (NULL, FALSE);
+
+  clutter_master_clock_step (n_frames, CLUTTER_TEST_FRAME_INTERVAL);
+}
+
+/**
+ * clutter_test_put_pointer_event:
+ * @stage: a #ClutterStage
+ * @source: (nullable): the source of the event, or %NULL to use
+ *   the actor under the pointer
+ * @type: the type of the event: %CLUTTER_MOTION, %CLUTTER_BUTTON_PRESS,
+ *   %CLUTTER_BUTTON_RELEASE or %CLUTTER_SCROLL
+ * @time_: the time of the event, or %CLUTTER_CURRENT_TIME
+ * @x: the X coordinate of the event, relative to @stage
+ * @y: the Y coordinate of the event, relative to @stage
+ *
+ * Puts an event of the core pointer in the event queue of @stage.
+ *
+ * The button events use the primary button, and the motion and
+ * release events following a press carry %CLUTTER_BUTTON1_MASK in
+ * their state; the scroll events go down.
+ *
+ * Since: 1.28
+ */
+void
+clutter_test_put_pointer_event (ClutterActor     *stage,
+                                ClutterActor     *source,
+                                ClutterEventType  type,
+                                guint32           time_,
+                                gfloat            x,
+                                gfloat            y)
+{
+  ClutterDeviceManager *manager;
+  ClutterEvent *event;
+
+  g_return_if_fail (CLUTTER_IS_STAGE (stage));
+  g_return_if_fail (source == NULL || CLUTTER_IS_ACTOR (source));
+  g_return_if_fail (type == CLUTTER_MOTION ||
+                    type == CLUTTER_BUTTON_PRESS ||
+                    type == CLUTTER_BUTTON_RELEASE ||
+                    type == CLUTTER_SCROLL);
+
+  g_assert (test_environ != NULL);
+
+  manager = clutter_device_manager_get_default ();
+
+  event = clutter_event_new (type);
+  clutter_event_set_stage (event, CLUTTER_STAGE (stage));
+  clutter_event_set_source (event, source);
+  clutter_event_set_device (event,
+                            clutter_device_manager_get_core_device (manager,
+                                                                    CLUTTER_POINTER_DEVICE));
+  clutter_event_set_time (event, time_);
+  clutter_event_set_coords (event, x, y);
+
+  if (test_environ->button_pressed)
+    clutter_event_set_state (event, CLUTTER_BUTTON1_MASK);
+
+  switch (type)
+    {
+    case CLUTTER_BUTTON_PRESS:
+      clutter_event_set_button (event, CLUTTER_BUTTON_PRIMARY);
+      test_environ->button_pressed = TRUE;
+      break;
+
+    case CLUTTER_BUTTON_RELEASE:
+      clutter_event_set_button (event, CLUTTER_BUTTON_PRIMARY);
+      test_environ->button_pressed = FALSE;
+      break;
+
+    case CLUTTER_SCROLL:
+      clutter_event_set_scroll_direction (event, CLUTTER_SCROLL_DOWN);
+      break;
+
+    default:
+      break;
+    }
+
+  clutter_event_put (event);
+  clutter_event_free (event);
+}
+
+/**
+ * clutter_test_put_key_event:
+ * @stage: a #ClutterStage
+ * @keyval: the key symbol of the event
+ *
+ * Puts a key press event of the core keyboard in the event queue
+ * of @stage.
+ *
+ * Since: 1.28
+ */
+void
+clutter_test_put_key_event (ClutterActor *stage,
+                            guint         keyval)
+{
+  ClutterDeviceManager *manager;
+  ClutterEvent *event;
+
+  g_return_if_fail (CLUTTER_IS_STAGE (stage));
+
+  manager = clutter_device_manager_get_default ();
+
+  event = clutter_event_new (CLUTTER_KEY_PRESS);
+  clutter_event_set_stage (event, CLUTTER_STAGE (stage));
+  clutter_event_set_device (event,
+                            clutter_device_manager_get_core_device (manager,
+                                                                    CLUTTER_KEYBOARD_DEVICE));
+  clutter_event_set_key_symbol (event, keyval);
+
+  clutter_event_put (event);
+  clutter_event_free (event);
+}
+
 typedef struct {
   ClutterActor *stage;
 
@@ -29,6 +29,7 @@
 #include <clutter/clutter-types.h>
 #include <clutter/clutter-actor.h>
 #include <clutter/clutter-color.h>
+#include <clutter/clutter-event.h>
 
 G_BEGIN_DECLS
 
@@ -88,6 +89,41 @@ main (int argc, char *argv[]) \
   return clutter_test_run (); \
 }
 
+/**
+ * CLUTTER_TEST_SUITE_MANUAL_CLOCK:
+ * @units: a list of %CLUTTER_TEST_UNIT definitions
+ *
+ * Like %CLUTTER_TEST_SUITE, but enables the manual master clock before
+ * initializing the test suite, so that the test units run the frames
+ * themselves, using clutter_test_run_frames() or
+ * clutter_master_clock_step().
+ *
+ * Since: 1.28
+ */
+#define CLUTTER_TEST_SUITE_MANUAL_CLOCK(units) \
+int \
+main (int argc, char *argv[]) \
+{ \
+  clutter_enable_manual_master_clock (); \
+  clutter_test_init (&argc, &argv); \
+\
+  { \
+    units \
+  } \
+\
+  return clutter_test_run (); \
+}
+
+/**
+ * CLUTTER_TEST_FRAME_INTERVAL:
+ *
+ * The length of the frames run by clutter_test_run_frames(),
+ * in microseconds.
+ *
+ * Since: 1.28
+ */
+#define CLUTTER_TEST_FRAME_INTERVAL     (16 * 1000)
+
 CLUTTER_AVAILABLE_IN_1_18
 void            clutter_test_init               (int            *argc,
                                                  char         ***argv);
@@ -110,6 +146,19 @@ void            clutter_test_add_data_full      (const char     *test_path,
 CLUTTER_AVAILABLE_IN_1_18
 ClutterActor *  clutter_test_get_stage          (void);
 
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_test_run_frames         (guint           n_frames);
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_test_put_pointer_event  (ClutterActor     *stage,
+                                                 ClutterActor     *source,
+                                                 ClutterEventType  type,
+                                                 guint32           time_,
+                                                 gfloat            x,
+                                                 gfloat            y);
+CLUTTER_AVAILABLE_IN_1_28
+void            clutter_test_put_key_event      (ClutterActor     *stage,
+                                                 guint             keyval);
+
 #define clutter_test_assert_actor_at_point(stage,point,actor) \
 G_STMT_START { \
   const ClutterPoint *__p = (point); \
@@ -167,6 +167,10 @@ struct _ClutterTextPrivate
 
   gunichar password_char;
 
+  /* the masked text shown in password mode */
+  GString *password_text;
+  guint password_text_n_chars;
+
   guint password_hint_id;
   guint password_hint_timeout;
 
@@ -200,6 +204,8 @@ struct _ClutterTextPrivate
   guint paint_volume_valid      : 1;
   guint show_password_hint      : 1;
   guint password_hint_visible   : 1;
+  guint password_text_valid     : 1;
+  guint password_text_hint      : 1;
   guint resolved_direction      : 4;
 };
 
@@ -367,11 +373,104 @@ clutter_text_is_empty (ClutterText *self)
   return FALSE;
 }
 
-static gchar *
+/*
+ * clutter_text_ensure_password_text:
+ * @self: a #ClutterText
+ *
+ * Updates the cached masked text used in password mode.
+ *
+ * Since every character is replaced by the same invisible character,
+ * the masked text only depends on the number of characters inside the
+ * buffer, and it can be grown or truncated in place whenever text is
+ * inserted or deleted; the only character that needs to be looked up
+ * is the last one, when the password hint is visible.
+ */
+static void
+clutter_text_ensure_password_text (ClutterText *self)
+{
+  ClutterTextPrivate *priv = self->priv;
+  ClutterTextBuffer *buffer = get_buffer (self);
+  gboolean show_hint;
+  guint n_chars;
+  gchar buf[7];
+  gint char_len;
+
+  n_chars = clutter_text_buffer_get_length (buffer);
+  show_hint = priv->show_password_hint && priv->password_hint_visible;
+
+  if (priv->password_text == NULL)
+    priv->password_text = g_string_sized_new (clutter_text_buffer_get_bytes (buffer));
+
+  if (!priv->password_text_valid)
+    {
+      g_string_truncate (priv->password_text, 0);
+      priv->password_text_n_chars = 0;
+      priv->password_text_hint = FALSE;
+      priv->password_text_valid = TRUE;
+    }
+  else if (priv->password_text_n_chars == n_chars &&
+           !priv->password_text_hint &&
+           !show_hint)
+    return;
+
+  /* we need to convert the invisible character into UTF-8 for
+   * it to be fed to the Pango layout
+   */
+  memset (buf, 0, sizeof (buf));
+  char_len = g_unichar_to_utf8 (priv->password_char, buf);
+
+  /* the last character may not be masked if the hint was visible */
+  if (priv->password_text_hint)
+    {
+      g_string_truncate (priv->password_text,
+                         (priv->password_text_n_chars - 1) * char_len);
+      g_string_append_len (priv->password_text, buf, char_len);
+      priv->password_text_hint = FALSE;
+    }
+
+  if (priv->password_text_n_chars > n_chars)
+    g_string_truncate (priv->password_text, n_chars * char_len);
+  else
+    {
+      guint i;
+
+      for (i = priv->password_text_n_chars; i < n_chars; i++)
+        g_string_append_len (priv->password_text, buf, char_len);
+    }
+
+  priv->password_text_n_chars = n_chars;
+
+  if (show_hint && n_chars > 0)
+    {
+      const gchar *text = clutter_text_buffer_get_text (buffer);
+      gsize n_bytes = clutter_text_buffer_get_bytes (buffer);
+      const gchar *last_char;
+
+      last_char = g_utf8_find_prev_char (text, text + n_bytes);
+
+      g_string_truncate (priv->password_text, (n_chars - 1) * char_len);
+      g_string_append_len (priv->password_text,
+                           last_char,
+                           text + n_bytes - last_char);
+      priv->password_text_hint = TRUE;
+    }
+}
+
+/*
+ * clutter_text_get_display_text:
+ * @self: a #ClutterText
+ *
+ * Retrieves the text to be displayed, which is the contents of the
+ * buffer unless a password character is set.
+ *
+ * Return value: the displayed text; the returned string is owned by
+ *   the #ClutterText or by its buffer, and it is valid until the next
+ *   change of the contents
+ */
+static const gchar *
 clutter_text_get_display_text (ClutterText *self)
 {
   ClutterTextPrivate *priv = self->priv;
-  ClutterTextBuffer *buffer;
   const gchar *text;
 
   /* short-circuit the case where the buffer is unset or it's empty,
@@ -379,56 +478,22 @@ clutter_text_get_display_text (ClutterText *self)
    * notifications with it
    */
   if (clutter_text_is_empty (self))
-    return g_strdup ("");
+    return "";
 
-  buffer = get_buffer (self);
-  text = clutter_text_buffer_get_text (buffer);
+  text = clutter_text_buffer_get_text (get_buffer (self));
 
-  /* simple short-circuit to avoid going through GString
-   * with an empty text and a password char set
+  /* simple short-circuit to avoid going through the masked
+   * text with an empty text and a password char set
    */
   if (text[0] == '\0')
-    return g_strdup ("");
+    return "";
 
   if (G_LIKELY (priv->password_char == 0))
-    return g_strdup (text);
-  else
-    {
-      GString *str;
-      gunichar invisible_char;
-      gchar buf[7];
-      gint char_len, i;
-      guint n_chars;
-
-      n_chars = clutter_text_buffer_get_length (buffer);
-      str = g_string_sized_new (clutter_text_buffer_get_bytes (buffer));
-      invisible_char = priv->password_char;
-
-      /* we need to convert the string built of invisible
-       * characters into UTF-8 for it to be fed to the Pango
-       * layout
-       */
-      memset (buf, 0, sizeof (buf));
-      char_len = g_unichar_to_utf8 (invisible_char, buf);
+    return text;
 
-      if (priv->show_password_hint && priv->password_hint_visible)
-        {
-          char *last_char;
+  clutter_text_ensure_password_text (self);
 
-          for (i = 0; i < n_chars - 1; i++)
-            g_string_append_len (str, buf, char_len);
-
-          last_char = g_utf8_offset_to_pointer (text, n_chars - 1);
-          g_string_append (str, last_char);
-        }
-      else
-        {
-          for (i = 0; i < n_chars; i++)
-            g_string_append_len (str, buf, char_len);
-        }
-
-      return g_string_free (str, FALSE);
-    }
+  return priv->password_text->str;
 }
 
 static inline void
@@ -494,7 +559,7 @@ clutter_text_create_layout_no_cache (ClutterText       *text,
 {
   ClutterTextPrivate *priv = text->priv;
   PangoLayout *layout;
-  gchar *contents;
+  const gchar *contents;
   gsize contents_len;
 
   layout = clutter_actor_create_pango_layout (CLUTTER_ACTOR (text), NULL);
@@ -580,8 +645,6 @@ clutter_text_create_layout_no_cache (ClutterText       *text,
   pango_layout_set_width (layout, width);
   pango_layout_set_height (layout, height);
 
-  g_free (contents);
-
   return layout;
 }
 
@@ -967,9 +1030,14 @@ clutter_text_position_to_coords (ClutterText *self,
     {
       index_ = 0;
     }
+  else if (priv->password_char != 0)
+    {
+      /* every character of the masked text has the same length */
+      index_ = position * password_char_bytes;
+    }
   else
     {
-      gchar *text = clutter_text_get_display_text (self);
+      const gchar *text = clutter_text_get_display_text (self);
       GString *tmp = g_string_new (text);
       gint cursor_index;
 
@@ -978,12 +1046,8 @@ clutter_text_position_to_coords (ClutterText *self,
       if (priv->preedit_str != NULL)
         g_string_insert (tmp, cursor_index, priv->preedit_str);
 
-      if (priv->password_char == 0)
-        index_ = offset_to_bytes (tmp->str, position);
-      else
-        index_ = position * password_char_bytes;
+      index_ = offset_to_bytes (tmp->str, position);
 
-      g_free (text);
       g_string_free (tmp, TRUE);
     }
 
@@ -1503,6 +1567,9 @@ clutter_text_finalize (GObject *gobject)
   clutter_text_set_buffer (self, NULL);
   g_free (priv->font_name);
 
+  if (priv->password_text != NULL)
+    g_string_free (priv->password_text, TRUE);
+
   G_OBJECT_CLASS (clutter_text_parent_class)->finalize (gobject);
 }
 
@@ -1517,7 +1584,7 @@ clutter_text_foreach_selection_rectangle (ClutterText              *self,
 {
   ClutterTextPrivate *priv = self->priv;
   PangoLayout *layout = clutter_text_get_layout (self);
-  gchar *utf8 = clutter_text_get_display_text (self);
+  const gchar *utf8 = clutter_text_get_display_text (self);
   gint lines;
   gint start_index;
   gint end_index;
@@ -1593,8 +1660,6 @@ clutter_text_foreach_selection_rectangle (ClutterText              *self,
 
       g_free (ranges);
     }
-
-  g_free (utf8);
 }
 
 static void
@@ -5841,6 +5906,7 @@ clutter_text_set_password_char (ClutterText *self,
   if (priv->password_char != wc)
     {
       priv->password_char = wc;
+      priv->password_text_valid = FALSE;
 
       clutter_text_dirty_cache (self);
       clutter_actor_queue_relayout (CLUTTER_ACTOR (self));
@@ -63,6 +63,8 @@
 #include "clutter-enums.h"
 #include "clutter-enum-types.h"
 #include "clutter-event.h"
+#include "clutter-event-player.h"
+#include "clutter-event-recorder.h"
 #include "clutter-feature.h"
 #include "clutter-fixed-layout.h"
 #include "clutter-flow-layout.h"
@@ -76,6 +78,8 @@
 #include "clutter-keysyms.h"
 #include "clutter-layout-manager.h"
 #include "clutter-layout-meta.h"
+#include "clutter-list-layout.h"
+#include "clutter-list-view.h"
 #include "clutter-macros.h"
 #include "clutter-main.h"
 #include "clutter-offscreen-effect.h"
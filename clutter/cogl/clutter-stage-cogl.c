@@ -174,13 +174,29 @@ clutter_stage_cogl_realize (ClutterStageWindow *stage_window)
   return TRUE;
 }
 
+static gint64
+clutter_stage_cogl_get_refresh_interval (ClutterStageCogl *stage_cogl)
+{
+  float refresh_rate;
+  gint64 refresh_interval;
+
+  refresh_rate = stage_cogl->refresh_rate;
+  if (refresh_rate == 0.0)
+    refresh_rate = 60.0;
+
+  refresh_interval = (gint64) (0.5 + 1000000 / refresh_rate);
+  if (refresh_interval == 0)
+    refresh_interval = 16667; /* 1/60th second */
+
+  return refresh_interval;
+}
+
 static void
 clutter_stage_cogl_schedule_update (ClutterStageWindow *stage_window,
                                     gint                sync_delay)
 {
   ClutterStageCogl *stage_cogl = CLUTTER_STAGE_COGL (stage_window);
   gint64 now;
-  float refresh_rate;
   gint64 refresh_interval;
 
   if (stage_cogl->update_time != -1)
@@ -206,13 +222,7 @@ clutter_stage_cogl_schedule_update (ClutterStageWindow *stage_window,
       return;
     }
 
-  refresh_rate = stage_cogl->refresh_rate;
-  if (refresh_rate == 0.0)
-    refresh_rate = 60.0;
-
-  refresh_interval = (gint64) (0.5 + 1000000 / refresh_rate);
-  if (refresh_interval == 0)
-    refresh_interval = 16667; /* 1/60th second */
+  refresh_interval = clutter_stage_cogl_get_refresh_interval (stage_cogl);
 
   stage_cogl->update_time = stage_cogl->last_presentation_time + 1000 * sync_delay;
 
@@ -231,6 +241,30 @@ clutter_stage_cogl_get_update_time (ClutterStageWindow *stage_window)
   return stage_cogl->update_time;
 }
 
+static gint64
+clutter_stage_cogl_get_next_presentation_time (ClutterStageWindow *stage_window)
+{
+  ClutterStageCogl *stage_cogl = CLUTTER_STAGE_COGL (stage_window);
+  gint64 presentation_time, refresh_interval, now;
+
+  now = g_get_monotonic_time ();
+
+  /* same as clutter_stage_cogl_schedule_update(): the timing of the
+   * last presented frame is only reliable for a short while
+   */
+  if (stage_cogl->last_presentation_time == 0 ||
+      stage_cogl->last_presentation_time < now - 150000)
+    return -1;
+
+  refresh_interval = clutter_stage_cogl_get_refresh_interval (stage_cogl);
+
+  presentation_time = stage_cogl->last_presentation_time + refresh_interval;
+  while (presentation_time < now)
+    presentation_time += refresh_interval;
+
+  return presentation_time;
+}
+
 static void
 clutter_stage_cogl_clear_update_time (ClutterStageWindow *stage_window)
 {
@@ -701,6 +735,7 @@ clutter_stage_window_iface_init (ClutterStageWindowIface *iface)
   iface->schedule_update = clutter_stage_cogl_schedule_update;
   iface->get_update_time = clutter_stage_cogl_get_update_time;
   iface->clear_update_time = clutter_stage_cogl_clear_update_time;
+  iface->get_next_presentation_time = clutter_stage_cogl_get_next_presentation_time;
   iface->add_redraw_clip = clutter_stage_cogl_add_redraw_clip;
   iface->has_redraw_clips = clutter_stage_cogl_has_redraw_clips;
   iface->ignoring_redraw_clips = clutter_stage_cogl_ignoring_redraw_clips;
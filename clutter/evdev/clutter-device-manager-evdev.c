@@ -30,6 +30,7 @@
 #include <math.h>
 #include <float.h>
 #include <linux/input.h>
+#include <sys/eventfd.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <errno.h>
@@ -75,6 +76,25 @@
  */
 #define INITIAL_DEVICE_ID 2
 
+/* The maximum number of events forwarded to the stages for each
+ * dispatch of the event source; the remaining events are forwarded
+ * on the next iteration of the main loop.
+ */
+#define MAX_EVENTS_PER_DISPATCH 256
+
+/*
+ * Size of the ring used to hand the events translated by the input
+ * thread over to the main loop; it must be a power of two.
+ */
+#define EVENT_RING_SIZE 1024
+
+/*
+ * Number of free slots in the ring the input thread requires before
+ * translating the next libinput event, which may generate more than
+ * one ClutterEvent.
+ */
+#define EVENT_RING_HEADROOM 64
+
 typedef struct _ClutterTouchState ClutterTouchState;
 typedef struct _ClutterEventFilter ClutterEventFilter;
 
@@ -108,7 +128,7 @@ struct _ClutterSeatEvdev
   guint32 repeat_interval;
   guint32 repeat_key;
   guint32 repeat_count;
-  guint32 repeat_timer;
+  GSource *repeat_source;
   ClutterInputDevice *repeat_device;
 
   gfloat pointer_x;
@@ -155,6 +175,41 @@ struct _ClutterDeviceManagerEvdevPrivate
 
   gint device_id_next;
   GList *free_device_ids;
+
+  /* input thread; the libinput context, the seats and the event
+   * filters are protected by input_lock while it is running
+   */
+  gboolean use_input_thread;
+  GThread *input_thread;
+  GMainContext *input_context;
+  GSource *input_source;
+  GMutex input_lock;
+  GCond base_event_cond;
+  struct libinput_event *pending_base_event;
+  gint input_thread_stopping;
+
+  /* the main loop waits on sync_cond until the input thread has
+   * processed every libinput event queued before sync_request
+   */
+  GCond sync_cond;
+  guint sync_request;
+  guint sync_ack;
+
+  /* ring of the events translated while the input thread is running;
+   * the producers hold input_lock, see event_ring_push(), and the main
+   * loop is the only consumer; it is woken up through the eventfd
+   */
+  ClutterEvent **event_ring;
+  guint event_ring_head;
+  guint event_ring_tail;
+  gint event_ring_fd;
+
+  /* the size of the stage, which cannot be queried from the
+   * input thread
+   */
+  gfloat stage_width;
+  gfloat stage_height;
+  guint stage_allocation_handler;
 };
 
 static void clutter_device_manager_evdev_event_extender_init (ClutterEventExtenderInterface *iface);
@@ -169,6 +224,7 @@ G_DEFINE_TYPE_WITH_CODE (ClutterDeviceManagerEvdev,
 static ClutterOpenDeviceCallback  device_open_callback;
 static ClutterCloseDeviceCallback device_close_callback;
 static gpointer                   device_callback_data;
+static gboolean                   use_input_thread = FALSE;
 
 #ifdef CLUTTER_ENABLE_DEBUG
 static const char *device_type_str[] = {
@@ -259,16 +315,127 @@ struct _ClutterEventSource
 static void
 process_events (ClutterDeviceManagerEvdev *manager_evdev);
 
+/*
+ * Input thread synchronization
+ *
+ * Without the input thread, everything happens on the main loop and
+ * the locking functions do nothing.
+ */
+
+static inline void
+lock_input (ClutterDeviceManagerEvdevPrivate *priv)
+{
+  if (priv->use_input_thread)
+    g_mutex_lock (&priv->input_lock);
+}
+
+static inline void
+unlock_input (ClutterDeviceManagerEvdevPrivate *priv)
+{
+  if (priv->use_input_thread)
+    g_mutex_unlock (&priv->input_lock);
+}
+
+static inline gboolean
+is_input_thread (ClutterDeviceManagerEvdevPrivate *priv)
+{
+  return priv->use_input_thread &&
+         g_main_context_is_owner (priv->input_context);
+}
+
+/* Called by the producer, with the input lock held */
+static gboolean
+event_ring_has_room (ClutterDeviceManagerEvdevPrivate *priv,
+                     guint                             n_slots)
+{
+  guint tail = g_atomic_int_get (&priv->event_ring_tail);
+
+  return EVENT_RING_SIZE - (priv->event_ring_head - tail) >= n_slots;
+}
+
+static gboolean
+event_ring_is_empty (ClutterDeviceManagerEvdevPrivate *priv)
+{
+  return g_atomic_int_get (&priv->event_ring_head) ==
+         g_atomic_int_get (&priv->event_ring_tail);
+}
+
+/* Called by the producers, with the input lock held
+ *
+ * The input thread is not the only producer: clutter_evdev_warp_pointer()
+ * translates and queues its event on the main loop, so the ring has one
+ * consumer but several producers, and it is the input lock that makes
+ * the producers push one at a time. The consumer does not need the lock,
+ * as it only ever moves the tail.
+ */
+static void
+event_ring_push (ClutterDeviceManagerEvdevPrivate *priv,
+                 ClutterEvent                     *event)
+{
+  guint head = priv->event_ring_head;
+
+  /* the input thread leaves the events in the libinput queue when
+   * the main loop is late, so this only happens on huge bursts of
+   * emulated events
+   */
+  if (!event_ring_has_room (priv, 1))
+    {
+      CLUTTER_NOTE (EVENT, "Dropping event of type %d, the main loop "
+                    "is not keeping up", clutter_event_type (event));
+      clutter_event_free (event);
+      return;
+    }
+
+  priv->event_ring[head & (EVENT_RING_SIZE - 1)] = event;
+  g_atomic_int_set (&priv->event_ring_head, head + 1);
+
+  /* only wake up the main loop if it consumed everything that was
+   * in the ring before this event; the head is published before the
+   * tail is read, so the main loop either sees the new event before
+   * going to sleep or is woken up
+   */
+  if (g_atomic_int_get (&priv->event_ring_tail) == head)
+    eventfd_write (priv->event_ring_fd, 1);
+}
+
+/* Called by the consumer, on the main loop */
+static ClutterEvent *
+event_ring_pop (ClutterDeviceManagerEvdevPrivate *priv)
+{
+  guint tail = priv->event_ring_tail;
+  ClutterEvent *event;
+
+  if (tail == (guint) g_atomic_int_get (&priv->event_ring_head))
+    return NULL;
+
+  event = priv->event_ring[tail & (EVENT_RING_SIZE - 1)];
+  g_atomic_int_set (&priv->event_ring_tail, tail + 1);
+
+  return event;
+}
+
+static gboolean
+has_received_events (ClutterDeviceManagerEvdevPrivate *priv)
+{
+  if (!priv->use_input_thread)
+    return FALSE;
+
+  return !event_ring_is_empty (priv) ||
+         g_atomic_pointer_get (&priv->pending_base_event) != NULL;
+}
+
 static gboolean
 clutter_event_prepare (GSource *source,
                        gint    *timeout)
 {
+  ClutterEventSource *event_source = (ClutterEventSource *) source;
   gboolean retval;
 
   _clutter_threads_acquire_lock ();
 
   *timeout = -1;
-  retval = clutter_events_pending ();
+  retval = (clutter_events_pending () ||
+            has_received_events (event_source->manager_evdev->priv));
 
   _clutter_threads_release_lock ();
 
@@ -284,7 +451,8 @@ clutter_event_check (GSource *source)
   _clutter_threads_acquire_lock ();
 
   retval = ((event_source->event_poll_fd.revents & G_IO_IN) ||
-            clutter_events_pending ());
+            clutter_events_pending () ||
+            has_received_events (event_source->manager_evdev->priv));
 
   _clutter_threads_release_lock ();
 
@@ -294,16 +462,24 @@ clutter_event_check (GSource *source)
 static void
 queue_event (ClutterEvent *event)
 {
-  _clutter_event_push (event, FALSE);
+  ClutterInputDevice *input_device = clutter_event_get_source_device (event);
+  ClutterDeviceManagerEvdev *manager_evdev =
+    CLUTTER_DEVICE_MANAGER_EVDEV (input_device->device_manager);
+
+  if (manager_evdev->priv->use_input_thread)
+    event_ring_push (manager_evdev->priv, event);
+  else
+    _clutter_event_push (event, FALSE);
 }
 
 static void
 clear_repeat_timer (ClutterSeatEvdev *seat)
 {
-  if (seat->repeat_timer)
+  if (seat->repeat_source)
     {
-      g_source_remove (seat->repeat_timer);
-      seat->repeat_timer = 0;
+      g_source_destroy (seat->repeat_source);
+      g_source_unref (seat->repeat_source);
+      seat->repeat_source = NULL;
       g_clear_object (&seat->repeat_device);
     }
 }
@@ -393,12 +569,14 @@ notify_key_device (ClutterInputDevice *input_device,
         else
           interval = seat->repeat_interval;
 
-        seat->repeat_timer =
-          clutter_threads_add_timeout_full (CLUTTER_PRIORITY_EVENTS,
-                                            interval,
-                                            keyboard_repeat,
-                                            seat,
-                                            NULL);
+        /* the repeat timer runs on the input thread, if any, so that
+         * the repeated keys are not delayed by the main loop
+         */
+        seat->repeat_source = g_timeout_source_new (interval);
+        g_source_set_priority (seat->repeat_source, CLUTTER_PRIORITY_EVENTS);
+        g_source_set_callback (seat->repeat_source, keyboard_repeat, seat, NULL);
+        g_source_attach (seat->repeat_source,
+                         seat->manager_evdev->priv->input_context);
         return;
       }
     default:
@@ -410,12 +588,16 @@ static gboolean
 keyboard_repeat (gpointer data)
 {
   ClutterSeatEvdev *seat = data;
-  GSource *source;
+  ClutterDeviceManagerEvdevPrivate *priv = seat->manager_evdev->priv;
   guint32 time_ms;
 
   g_return_val_if_fail (seat->repeat_device != NULL, G_SOURCE_REMOVE);
-  source = g_main_context_find_source_by_id (NULL, seat->repeat_timer);
-  time_ms = g_source_get_time (source) / 1000;
+  time_ms = g_source_get_time (seat->repeat_source) / 1000;
+
+  if (priv->use_input_thread)
+    g_mutex_lock (&priv->input_lock);
+  else
+    _clutter_threads_acquire_lock ();
 
   notify_key_device (seat->repeat_device,
                      ms2us (time_ms),
@@ -423,6 +605,11 @@ keyboard_repeat (gpointer data)
                      AUTOREPEAT_VALUE,
                      FALSE);
 
+  if (priv->use_input_thread)
+    g_mutex_unlock (&priv->input_lock);
+  else
+    _clutter_threads_release_lock ();
+
   return G_SOURCE_CONTINUE;
 }
 
@@ -444,8 +631,16 @@ new_absolute_motion_event (ClutterInputDevice *input_device,
   manager_evdev = CLUTTER_DEVICE_MANAGER_EVDEV (input_device->device_manager);
   seat = _clutter_input_device_evdev_get_seat (device_evdev);
 
-  stage_width = clutter_actor_get_width (CLUTTER_ACTOR (stage));
-  stage_height = clutter_actor_get_height (CLUTTER_ACTOR (stage));
+  if (manager_evdev->priv->use_input_thread)
+    {
+      stage_width = manager_evdev->priv->stage_width;
+      stage_height = manager_evdev->priv->stage_height;
+    }
+  else
+    {
+      stage_width = clutter_actor_get_width (CLUTTER_ACTOR (stage));
+      stage_height = clutter_actor_get_height (CLUTTER_ACTOR (stage));
+    }
 
   event = clutter_event_new (CLUTTER_MOTION);
 
@@ -877,6 +1072,41 @@ dispatch_libinput (ClutterDeviceManagerEvdev *manager_evdev)
   process_events (manager_evdev);
 }
 
+static gboolean
+process_base_event (ClutterDeviceManagerEvdev *manager_evdev,
+                    struct libinput_event *event);
+
+static void
+receive_events (ClutterDeviceManagerEvdev *manager_evdev)
+{
+  ClutterDeviceManagerEvdevPrivate *priv = manager_evdev->priv;
+  struct libinput_event *base_event;
+  ClutterEvent *event;
+
+  /* the input thread pushes the events preceding a device change
+   * before publishing it, so read it before draining the ring
+   */
+  base_event = g_atomic_pointer_get (&priv->pending_base_event);
+
+  while ((event = event_ring_pop (priv)) != NULL)
+    _clutter_event_push (event, FALSE);
+
+  if (base_event == NULL)
+    return;
+
+  /* the input thread is blocked until the device has been added or
+   * removed, so the seats and the libinput context can be used
+   * without the input lock, and the handlers of the device manager
+   * signals are free to call back into the evdev API
+   */
+  process_base_event (manager_evdev, base_event);
+
+  g_mutex_lock (&priv->input_lock);
+  g_atomic_pointer_set (&priv->pending_base_event, NULL);
+  g_cond_signal (&priv->base_event_cond);
+  g_mutex_unlock (&priv->input_lock);
+}
+
 static gboolean
 clutter_event_dispatch (GSource     *g_source,
                         GSourceFunc  callback,
@@ -884,35 +1114,63 @@ clutter_event_dispatch (GSource     *g_source,
 {
   ClutterEventSource *source = (ClutterEventSource *) g_source;
   ClutterDeviceManagerEvdev *manager_evdev;
+  ClutterDeviceManagerEvdevPrivate *priv;
   ClutterEvent *event;
+  guint n_events;
 
   _clutter_threads_acquire_lock ();
 
   manager_evdev = source->manager_evdev;
+  priv = manager_evdev->priv;
 
-  /* Don't queue more events if we haven't finished handling the previous batch
-   */
-  if (clutter_events_pending ())
-    goto queue_event;
+  if (priv->use_input_thread)
+    {
+      eventfd_t value;
 
-  dispatch_libinput (manager_evdev);
+      if (source->event_poll_fd.revents & G_IO_IN)
+        eventfd_read (priv->event_ring_fd, &value);
 
- queue_event:
-  event = clutter_event_get ();
+      if (!clutter_events_pending ())
+        receive_events (manager_evdev);
+    }
+  else
+    {
+      /* Don't queue more events if we haven't finished handling the
+       * previous batch
+       */
+      if (!clutter_events_pending ())
+        dispatch_libinput (manager_evdev);
+    }
 
-  if (event)
+  /* the device states are updated by the input thread */
+  lock_input (priv);
+
+  /* forward the whole batch to the stages in one go, instead of one
+   * event per main loop iteration; the number of events is bounded,
+   * so that a flood of events does not delay the next frame
+   */
+  for (n_events = 0; n_events < MAX_EVENTS_PER_DISPATCH; n_events++)
     {
       ClutterModifierType event_state;
-      ClutterInputDevice *input_device =
-        clutter_event_get_source_device (event);
-      ClutterInputDeviceEvdev *device_evdev =
-        CLUTTER_INPUT_DEVICE_EVDEV (input_device);
-      ClutterSeatEvdev *seat =
-        _clutter_input_device_evdev_get_seat (device_evdev);
+      ClutterInputDevice *input_device;
+      ClutterInputDeviceEvdev *device_evdev;
+      ClutterSeatEvdev *seat;
+
+      event = clutter_event_get ();
+      if (event == NULL)
+        break;
+
+      input_device = clutter_event_get_source_device (event);
 
       /* Drop events if we don't have any stage to forward them to */
       if (!_clutter_input_device_get_stage (input_device))
-        goto out;
+        {
+          clutter_event_free (event);
+          continue;
+        }
+
+      device_evdev = CLUTTER_INPUT_DEVICE_EVDEV (input_device);
+      seat = _clutter_input_device_evdev_get_seat (device_evdev);
 
       /* forward the event into clutter for emission etc. */
       _clutter_stage_queue_event (event->any.stage, event, FALSE);
@@ -924,11 +1182,15 @@ clutter_event_dispatch (GSource     *g_source,
       _clutter_input_device_set_state (seat->core_keyboard, event_state);
     }
 
-out:
+  unlock_input (priv);
+
+  CLUTTER_NOTE (EVENT, "Forwarded %u events to the stages", n_events);
+
   _clutter_threads_release_lock ();
 
   return TRUE;
 }
+
 static GSourceFuncs event_funcs = {
   clutter_event_prepare,
   clutter_event_check,
@@ -950,7 +1212,13 @@ clutter_event_source_new (ClutterDeviceManagerEvdev *manager_evdev)
   /* setup the source */
   event_source->manager_evdev = manager_evdev;
 
-  fd = libinput_get_fd (priv->libinput);
+  /* with the input thread, the main loop only waits for the events
+   * it translated
+   */
+  if (priv->use_input_thread)
+    fd = priv->event_ring_fd;
+  else
+    fd = libinput_get_fd (priv->libinput);
   event_source->event_poll_fd.fd = fd;
   event_source->event_poll_fd.events = G_IO_IN;
 
@@ -978,6 +1246,242 @@ clutter_event_source_free (ClutterEventSource *source)
   g_source_unref (g_source);
 }
 
+/*
+ * Input thread
+ *
+ * The input thread reads the input devices and translates the libinput
+ * events into ClutterEvents, which are handed over to the main loop
+ * through the event ring. Devices are added and removed by the main
+ * loop, as that emits signals on the device manager.
+ */
+
+/* Called with the input lock held */
+static gboolean
+has_pending_input (ClutterDeviceManagerEvdevPrivate *priv,
+                   gint                             *timeout)
+{
+  if (libinput_next_event_type (priv->libinput) == LIBINPUT_EVENT_NONE)
+    return FALSE;
+
+  /* the main loop is late: leave the events in the libinput queue,
+   * and retry shortly
+   */
+  if (!event_ring_has_room (priv, EVENT_RING_HEADROOM))
+    {
+      if (timeout != NULL)
+        *timeout = 1;
+
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
+static gboolean
+clutter_input_thread_prepare (GSource *source,
+                              gint    *timeout)
+{
+  ClutterEventSource *event_source = (ClutterEventSource *) source;
+  ClutterDeviceManagerEvdevPrivate *priv = event_source->manager_evdev->priv;
+  gboolean retval;
+
+  g_mutex_lock (&priv->input_lock);
+
+  *timeout = -1;
+  retval = (has_pending_input (priv, timeout) ||
+            priv->sync_ack != priv->sync_request);
+
+  g_mutex_unlock (&priv->input_lock);
+
+  return retval;
+}
+
+static gboolean
+clutter_input_thread_check (GSource *source)
+{
+  ClutterEventSource *event_source = (ClutterEventSource *) source;
+  ClutterDeviceManagerEvdevPrivate *priv = event_source->manager_evdev->priv;
+  gboolean retval;
+
+  g_mutex_lock (&priv->input_lock);
+
+  retval = ((event_source->event_poll_fd.revents & G_IO_IN) ||
+            has_pending_input (priv, NULL) ||
+            priv->sync_ack != priv->sync_request);
+
+  g_mutex_unlock (&priv->input_lock);
+
+  return retval;
+}
+
+static gboolean
+clutter_input_thread_dispatch (GSource     *g_source,
+                               GSourceFunc  callback,
+                               gpointer     user_data)
+{
+  ClutterEventSource *source = (ClutterEventSource *) g_source;
+  ClutterDeviceManagerEvdevPrivate *priv = source->manager_evdev->priv;
+
+  g_mutex_lock (&priv->input_lock);
+
+  dispatch_libinput (source->manager_evdev);
+
+  /* acknowledge the synchronization once the libinput queue is empty;
+   * otherwise the ring is full, and the waiting main loop has to drain
+   * it before the remaining events can be processed
+   */
+  if (priv->sync_ack != priv->sync_request)
+    {
+      if (libinput_next_event_type (priv->libinput) == LIBINPUT_EVENT_NONE)
+        priv->sync_ack = priv->sync_request;
+
+      g_cond_signal (&priv->sync_cond);
+    }
+
+  g_mutex_unlock (&priv->input_lock);
+
+  return G_SOURCE_CONTINUE;
+}
+
+static GSourceFuncs input_thread_funcs = {
+  clutter_input_thread_prepare,
+  clutter_input_thread_check,
+  clutter_input_thread_dispatch,
+  NULL
+};
+
+/*
+ * clutter_input_thread_sync:
+ *
+ * Blocks until the input thread has processed all the libinput events
+ * queued so far. The device changes are handed over to the main loop,
+ * so they are processed while waiting, as the input thread would wait
+ * for them otherwise.
+ */
+static void
+clutter_input_thread_sync (ClutterDeviceManagerEvdev *manager_evdev)
+{
+  ClutterDeviceManagerEvdevPrivate *priv = manager_evdev->priv;
+  guint request;
+
+  g_mutex_lock (&priv->input_lock);
+
+  request = ++priv->sync_request;
+  g_main_context_wakeup (priv->input_context);
+
+  while ((gint) (priv->sync_ack - request) < 0 &&
+         !g_atomic_int_get (&priv->input_thread_stopping))
+    {
+      if (g_atomic_pointer_get (&priv->pending_base_event) != NULL ||
+          !event_ring_has_room (priv, EVENT_RING_HEADROOM))
+        {
+          g_mutex_unlock (&priv->input_lock);
+          receive_events (manager_evdev);
+          g_mutex_lock (&priv->input_lock);
+
+          g_main_context_wakeup (priv->input_context);
+          continue;
+        }
+
+      g_cond_wait (&priv->sync_cond, &priv->input_lock);
+    }
+
+  g_mutex_unlock (&priv->input_lock);
+
+  CLUTTER_NOTE (EVENT, "Synchronized with the evdev input thread");
+}
+
+static gpointer
+clutter_input_thread_func (gpointer data)
+{
+  ClutterDeviceManagerEvdev *manager_evdev = data;
+  ClutterDeviceManagerEvdevPrivate *priv = manager_evdev->priv;
+
+  g_main_context_push_thread_default (priv->input_context);
+
+  while (!g_atomic_int_get (&priv->input_thread_stopping))
+    g_main_context_iteration (priv->input_context, TRUE);
+
+  g_main_context_pop_thread_default (priv->input_context);
+
+  return NULL;
+}
+
+static gboolean
+clutter_input_thread_init (ClutterDeviceManagerEvdev *manager_evdev)
+{
+  ClutterDeviceManagerEvdevPrivate *priv = manager_evdev->priv;
+
+  priv->event_ring_fd = eventfd (0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (priv->event_ring_fd < 0)
+    {
+      g_warning ("Failed to create the eventfd of the input thread: %s",
+                 strerror (errno));
+      return FALSE;
+    }
+
+  priv->event_ring = g_new0 (ClutterEvent *, EVENT_RING_SIZE);
+  priv->input_context = g_main_context_new ();
+
+  return TRUE;
+}
+
+static void
+clutter_input_thread_start (ClutterDeviceManagerEvdev *manager_evdev)
+{
+  ClutterDeviceManagerEvdevPrivate *priv = manager_evdev->priv;
+  ClutterEventSource *event_source;
+  GSource *source;
+
+  source = g_source_new (&input_thread_funcs, sizeof (ClutterEventSource));
+  event_source = (ClutterEventSource *) source;
+
+  event_source->manager_evdev = manager_evdev;
+  event_source->event_poll_fd.fd = libinput_get_fd (priv->libinput);
+  event_source->event_poll_fd.events = G_IO_IN;
+
+  g_source_set_priority (source, CLUTTER_PRIORITY_EVENTS);
+  g_source_add_poll (source, &event_source->event_poll_fd);
+  g_source_attach (source, priv->input_context);
+  priv->input_source = source;
+
+  priv->input_thread = g_thread_new ("clutter-evdev-input",
+                                     clutter_input_thread_func,
+                                     manager_evdev);
+
+  CLUTTER_NOTE (EVENT, "Started the evdev input thread");
+}
+
+static void
+clutter_input_thread_stop (ClutterDeviceManagerEvdev *manager_evdev)
+{
+  ClutterDeviceManagerEvdevPrivate *priv = manager_evdev->priv;
+  ClutterEvent *event;
+
+  g_atomic_int_set (&priv->input_thread_stopping, TRUE);
+
+  /* unblock the input thread if it is waiting for a device change */
+  g_mutex_lock (&priv->input_lock);
+  g_cond_signal (&priv->base_event_cond);
+  g_mutex_unlock (&priv->input_lock);
+
+  g_main_context_wakeup (priv->input_context);
+  g_thread_join (priv->input_thread);
+  priv->input_thread = NULL;
+
+  /* the input thread destroyed the device change it was waiting for */
+  priv->pending_base_event = NULL;
+
+  g_source_destroy (priv->input_source);
+  g_source_unref (priv->input_source);
+  priv->input_source = NULL;
+
+  while ((event = event_ring_pop (priv)) != NULL)
+    clutter_event_free (event);
+
+  CLUTTER_NOTE (EVENT, "Stopped the evdev input thread");
+}
+
 static void
 clutter_touch_state_free (ClutterTouchState *touch_state)
 {
@@ -1839,6 +2343,37 @@ filter_event (ClutterDeviceManagerEvdev *manager_evdev,
   return retval;
 }
 
+static gboolean
+defer_base_event (ClutterDeviceManagerEvdev *manager_evdev,
+                  struct libinput_event     *event)
+{
+  ClutterDeviceManagerEvdevPrivate *priv = manager_evdev->priv;
+
+  switch (libinput_event_get_type (event))
+    {
+    case LIBINPUT_EVENT_DEVICE_ADDED:
+    case LIBINPUT_EVENT_DEVICE_REMOVED:
+      break;
+
+    default:
+      return FALSE;
+    }
+
+  /* hand the device change over to the main loop, and wait for it to
+   * be processed, as the next events may come from the new device or
+   * refer to the removed one
+   */
+  g_atomic_pointer_set (&priv->pending_base_event, event);
+  eventfd_write (priv->event_ring_fd, 1);
+  g_cond_signal (&priv->sync_cond);
+
+  while (g_atomic_pointer_get (&priv->pending_base_event) != NULL &&
+         !g_atomic_int_get (&priv->input_thread_stopping))
+    g_cond_wait (&priv->base_event_cond, &priv->input_lock);
+
+  return TRUE;
+}
+
 static void
 process_event (ClutterDeviceManagerEvdev *manager_evdev,
                struct libinput_event *event)
@@ -1850,6 +2385,10 @@ process_event (ClutterDeviceManagerEvdev *manager_evdev,
   if (retval != CLUTTER_EVENT_PROPAGATE)
     return;
 
+  if (is_input_thread (manager_evdev->priv) &&
+      defer_base_event (manager_evdev, event))
+    return;
+
   if (process_base_event (manager_evdev, event))
     return;
   if (process_device_event (manager_evdev, event))
@@ -1862,10 +2401,19 @@ process_events (ClutterDeviceManagerEvdev *manager_evdev)
   ClutterDeviceManagerEvdevPrivate *priv = manager_evdev->priv;
   struct libinput_event *event;
 
-  while ((event = libinput_get_event (priv->libinput)))
+  while (TRUE)
     {
-      process_event(manager_evdev, event);
-      libinput_event_destroy(event);
+      if (priv->use_input_thread &&
+          (g_atomic_int_get (&priv->input_thread_stopping) ||
+           !event_ring_has_room (priv, EVENT_RING_HEADROOM)))
+        break;
+
+      event = libinput_get_event (priv->libinput);
+      if (event == NULL)
+        break;
+
+      process_event (manager_evdev, event);
+      libinput_event_destroy (event);
     }
 }
 
@@ -1958,10 +2506,16 @@ clutter_device_manager_evdev_constructed (GObject *gobject)
 
   priv->main_seat = clutter_seat_evdev_new (manager_evdev);
 
+  priv->use_input_thread = use_input_thread &&
+                           clutter_input_thread_init (manager_evdev);
+
   dispatch_libinput (manager_evdev);
 
   source = clutter_event_source_new (manager_evdev);
   priv->event_source = source;
+
+  if (priv->use_input_thread)
+    clutter_input_thread_start (manager_evdev);
 }
 
 static void
@@ -1987,6 +2541,13 @@ clutter_device_manager_evdev_dispose (GObject *object)
       priv->stage_removed_handler = 0;
     }
 
+  if (priv->stage_allocation_handler)
+    {
+      g_signal_handler_disconnect (priv->stage,
+                                   priv->stage_allocation_handler);
+      priv->stage_allocation_handler = 0;
+    }
+
   if (priv->stage_manager)
     {
       g_object_unref (priv->stage_manager);
@@ -2005,6 +2566,9 @@ clutter_device_manager_evdev_finalize (GObject *object)
   manager_evdev = CLUTTER_DEVICE_MANAGER_EVDEV (object);
   priv = manager_evdev->priv;
 
+  if (priv->input_thread != NULL)
+    clutter_input_thread_stop (manager_evdev);
+
   g_slist_free_full (priv->seats, (GDestroyNotify) clutter_seat_evdev_free);
   g_slist_free (priv->devices);
 
@@ -2022,6 +2586,14 @@ clutter_device_manager_evdev_finalize (GObject *object)
 
   g_list_free (priv->free_device_ids);
 
+  if (priv->input_context != NULL)
+    g_main_context_unref (priv->input_context);
+
+  g_free (priv->event_ring);
+  g_mutex_clear (&priv->input_lock);
+  g_cond_clear (&priv->base_event_cond);
+  g_cond_clear (&priv->sync_cond);
+
   G_OBJECT_CLASS (clutter_device_manager_evdev_parent_class)->finalize (object);
 }
 
@@ -2043,14 +2615,54 @@ clutter_device_manager_evdev_class_init (ClutterDeviceManagerEvdevClass *klass)
   manager_class->get_device = clutter_device_manager_evdev_get_device;
 }
 
+static void
+clutter_device_manager_evdev_stage_allocation_changed_cb (ClutterActor              *stage,
+                                                          const ClutterActorBox     *box,
+                                                          ClutterAllocationFlags     flags,
+                                                          ClutterDeviceManagerEvdev *self)
+{
+  ClutterDeviceManagerEvdevPrivate *priv = self->priv;
+
+  g_mutex_lock (&priv->input_lock);
+
+  priv->stage_width = clutter_actor_box_get_width (box);
+  priv->stage_height = clutter_actor_box_get_height (box);
+
+  g_mutex_unlock (&priv->input_lock);
+}
+
 static void
 clutter_device_manager_evdev_stage_added_cb (ClutterStageManager *manager,
                                              ClutterStage *stage,
                                              ClutterDeviceManagerEvdev *self)
 {
   ClutterDeviceManagerEvdevPrivate *priv = self->priv;
+  gfloat stage_width = 0, stage_height = 0;
   GSList *l;
 
+  /* the input thread clamps the pointer to the stage size, but it
+   * cannot query it from the stage
+   */
+  if (priv->use_input_thread)
+    {
+      clutter_actor_get_size (CLUTTER_ACTOR (stage),
+                              &stage_width,
+                              &stage_height);
+
+      priv->stage_allocation_handler =
+        g_signal_connect (stage, "allocation-changed",
+                          G_CALLBACK (clutter_device_manager_evdev_stage_allocation_changed_cb),
+                          self);
+    }
+
+  lock_input (priv);
+
+  if (priv->use_input_thread)
+    {
+      priv->stage_width = stage_width;
+      priv->stage_height = stage_height;
+    }
+
   /* NB: Currently we can only associate a single stage with all evdev
    * devices.
    *
@@ -2068,6 +2680,8 @@ clutter_device_manager_evdev_stage_added_cb (ClutterStageManager *manager,
       clutter_seat_evdev_set_stage (seat, stage);
     }
 
+  unlock_input (priv);
+
   /* We only want to do this once so we can catch the default
      stage. If the application has multiple stages then it will need
      to manage the stage of the input devices itself */
@@ -2084,6 +2698,14 @@ clutter_device_manager_evdev_stage_removed_cb (ClutterStageManager *manager,
   ClutterDeviceManagerEvdevPrivate *priv = self->priv;
   GSList *l;
 
+  if (priv->stage_allocation_handler && stage == priv->stage)
+    {
+      g_signal_handler_disconnect (stage, priv->stage_allocation_handler);
+      priv->stage_allocation_handler = 0;
+    }
+
+  lock_input (priv);
+
   /* Remove the stage of any input devices that were pointing to this
      stage so we don't send events to invalid stages */
   for (l = priv->seats; l; l = l->next)
@@ -2092,6 +2714,8 @@ clutter_device_manager_evdev_stage_removed_cb (ClutterStageManager *manager,
 
       clutter_seat_evdev_set_stage (seat, NULL);
     }
+
+  unlock_input (priv);
 }
 
 static void
@@ -2123,6 +2747,11 @@ clutter_device_manager_evdev_init (ClutterDeviceManagerEvdev *self)
                       self);
 
   priv->device_id_next = INITIAL_DEVICE_ID;
+
+  g_mutex_init (&priv->input_lock);
+  g_cond_init (&priv->base_event_cond);
+  g_cond_init (&priv->sync_cond);
+  priv->event_ring_fd = -1;
 }
 
 void
@@ -2226,8 +2855,21 @@ clutter_evdev_release_devices (void)
       return;
     }
 
+  lock_input (priv);
+
   libinput_suspend (priv->libinput);
-  process_events (manager_evdev);
+
+  if (!priv->use_input_thread)
+    process_events (manager_evdev);
+
+  unlock_input (priv);
+
+  /* the input thread hands the removal of the devices over to the
+   * main loop as usual; wait for it, as the caller is about to give
+   * up the access to the devices
+   */
+  if (priv->use_input_thread)
+    clutter_input_thread_sync (manager_evdev);
 
   priv->released = TRUE;
 }
@@ -2297,9 +2939,21 @@ clutter_evdev_reclaim_devices (void)
       return;
     }
 
+  lock_input (priv);
+
   libinput_resume (priv->libinput);
   clutter_evdev_update_xkb_state (manager_evdev);
-  process_events (manager_evdev);
+
+  if (!priv->use_input_thread)
+    process_events (manager_evdev);
+
+  unlock_input (priv);
+
+  /* the devices are added back by the time this function returns,
+   * like without the input thread
+   */
+  if (priv->use_input_thread)
+    clutter_input_thread_sync (manager_evdev);
 
   priv->released = FALSE;
 }
@@ -2332,6 +2986,31 @@ clutter_evdev_set_device_callbacks (ClutterOpenDeviceCallback  open_callback,
   device_callback_data = user_data;
 }
 
+/**
+ * clutter_evdev_set_input_thread_enabled:
+ * @enabled: whether to read the input devices from a dedicated thread
+ *
+ * Sets whether the evdev backend should read the input devices and
+ * translate their events in a dedicated thread, instead of doing it
+ * in the main loop. This keeps the timestamps and the pointer motion
+ * independent of the time the main loop takes to paint a frame.
+ *
+ * When the input thread is enabled, the functions passed to
+ * clutter_evdev_add_filter() and
+ * clutter_evdev_set_pointer_constrain_callback() are called from the
+ * input thread, and must not call the evdev API.
+ *
+ * For reliable effects, this function must be called before clutter_init().
+ *
+ * Since: 1.28
+ * Stability: unstable
+ */
+void
+clutter_evdev_set_input_thread_enabled (gboolean enabled)
+{
+  use_input_thread = !!enabled;
+}
+
 /**
  * clutter_evdev_set_keyboard_map: (skip)
  * @evdev: the #ClutterDeviceManager created by the evdev backend
@@ -2357,11 +3036,15 @@ clutter_evdev_set_keyboard_map (ClutterDeviceManager *evdev,
   manager_evdev = CLUTTER_DEVICE_MANAGER_EVDEV (evdev);
   priv = manager_evdev->priv;
 
+  lock_input (priv);
+
   if (priv->keymap)
     xkb_keymap_unref (priv->keymap);
 
   priv->keymap = xkb_keymap_ref (keymap);
   clutter_evdev_update_xkb_state (manager_evdev);
+
+  unlock_input (priv);
 }
 
 /**
@@ -2410,6 +3093,9 @@ clutter_evdev_set_keyboard_layout_index (ClutterDeviceManager *evdev,
   g_return_if_fail (CLUTTER_IS_DEVICE_MANAGER_EVDEV (evdev));
 
   manager_evdev = CLUTTER_DEVICE_MANAGER_EVDEV (evdev);
+
+  lock_input (manager_evdev->priv);
+
   state = manager_evdev->priv->main_seat->xkb;
 
   depressed_mods = xkb_state_serialize_mods (state, XKB_STATE_MODS_DEPRESSED);
@@ -2417,6 +3103,8 @@ clutter_evdev_set_keyboard_layout_index (ClutterDeviceManager *evdev,
   locked_mods = xkb_state_serialize_mods (state, XKB_STATE_MODS_LOCKED);
 
   xkb_state_update_mask (state, depressed_mods, latched_mods, locked_mods, 0, 0, idx);
+
+  unlock_input (manager_evdev->priv);
 }
 
 /**
@@ -2441,18 +3129,27 @@ clutter_evdev_set_pointer_constrain_callback (ClutterDeviceManager            *e
 {
   ClutterDeviceManagerEvdev *manager_evdev;
   ClutterDeviceManagerEvdevPrivate *priv;
+  GDestroyNotify old_data_notify;
+  gpointer old_data;
 
   g_return_if_fail (CLUTTER_IS_DEVICE_MANAGER_EVDEV (evdev));
 
   manager_evdev = CLUTTER_DEVICE_MANAGER_EVDEV (evdev);
   priv = manager_evdev->priv;
 
-  if (priv->constrain_data_notify)
-    priv->constrain_data_notify (priv->constrain_data);
+  lock_input (priv);
+
+  old_data_notify = priv->constrain_data_notify;
+  old_data = priv->constrain_data;
 
   priv->constrain_callback = callback;
   priv->constrain_data = user_data;
   priv->constrain_data_notify = user_data_notify;
+
+  unlock_input (priv);
+
+  if (old_data_notify)
+    old_data_notify (old_data);
 }
 
 /**
@@ -2484,9 +3181,13 @@ clutter_evdev_set_keyboard_repeat (ClutterDeviceManager *evdev,
   manager_evdev = CLUTTER_DEVICE_MANAGER_EVDEV (evdev);
   seat = manager_evdev->priv->main_seat;
 
+  lock_input (manager_evdev->priv);
+
   seat->repeat = repeat;
   seat->repeat_delay = delay;
   seat->repeat_interval = interval;
+
+  unlock_input (manager_evdev->priv);
 }
 
 /**
@@ -2526,8 +3227,12 @@ clutter_evdev_add_filter (ClutterEvdevFilterFunc func,
   filter->data = data;
   filter->destroy_notify = destroy_notify;
 
+  lock_input (manager_evdev->priv);
+
   manager_evdev->priv->event_filters =
     g_slist_append (manager_evdev->priv->event_filters, filter);
+
+  unlock_input (manager_evdev->priv);
 }
 
 /**
@@ -2560,6 +3265,9 @@ clutter_evdev_remove_filter (ClutterEvdevFilterFunc func,
     }
 
   manager_evdev = CLUTTER_DEVICE_MANAGER_EVDEV (manager);
+
+  lock_input (manager_evdev->priv);
+
   tmp_list = manager_evdev->priv->event_filters;
 
   while (tmp_list)
@@ -2568,16 +3276,22 @@ clutter_evdev_remove_filter (ClutterEvdevFilterFunc func,
 
       if (filter->func == func && filter->data == data)
         {
-          if (filter->destroy_notify)
-            filter->destroy_notify (filter->data);
-          g_free (filter);
           manager_evdev->priv->event_filters =
             g_slist_delete_link (manager_evdev->priv->event_filters, tmp_list);
-          return;
+          break;
         }
 
       tmp_list = tmp_list->next;
     }
+
+  unlock_input (manager_evdev->priv);
+
+  if (tmp_list == NULL)
+    return;
+
+  if (filter->destroy_notify)
+    filter->destroy_notify (filter->data);
+  g_free (filter);
 }
 
 /**
@@ -2604,5 +3318,12 @@ clutter_evdev_warp_pointer (ClutterInputDevice   *pointer_device,
                             int                   x,
                             int                   y)
 {
+  ClutterDeviceManagerEvdev *manager_evdev =
+    CLUTTER_DEVICE_MANAGER_EVDEV (pointer_device->device_manager);
+
+  lock_input (manager_evdev->priv);
+
   notify_absolute_motion (pointer_device, ms2us(time_), x, y);
+
+  unlock_input (manager_evdev->priv);
 }
@@ -57,6 +57,9 @@ void  clutter_evdev_set_device_callbacks (ClutterOpenDeviceCallback  open_callba
                                           ClutterCloseDeviceCallback close_callback,
                                           gpointer                   user_data);
 
+CLUTTER_AVAILABLE_IN_1_28
+void  clutter_evdev_set_input_thread_enabled (gboolean enabled);
+
 CLUTTER_AVAILABLE_IN_1_10
 void  clutter_evdev_release_devices (void);
 CLUTTER_AVAILABLE_IN_1_10
@@ -583,6 +583,33 @@ clutter_master_clock_gdk_set_paused (ClutterMasterClock *clock,
      clock is paused or not. */
 }
 
+static void
+clutter_master_clock_gdk_get_frame_times (ClutterMasterClock *clock,
+                                          ClutterStage       *stage,
+                                          gint64             *frame_time,
+                                          gint64             *presentation_time)
+{
+  ClutterMasterClockGdk *master_clock = (ClutterMasterClockGdk *) clock;
+  GdkFrameClock *frame_clock;
+
+  frame_clock = g_hash_table_lookup (master_clock->stage_to_clock, stage);
+  if (frame_clock == NULL)
+    {
+      *frame_time = g_get_monotonic_time ();
+      *presentation_time = -1;
+      return;
+    }
+
+  /* the frame clock predicts the presentation of its frames */
+  *frame_time = gdk_frame_clock_get_frame_time (frame_clock);
+  gdk_frame_clock_get_refresh_info (frame_clock, *frame_time,
+                                    NULL,
+                                    presentation_time);
+
+  if (*presentation_time == 0)
+    *presentation_time = -1;
+}
+
 static void
 clutter_master_clock_iface_init (ClutterMasterClockIface *iface)
 {
@@ -591,4 +618,5 @@ clutter_master_clock_iface_init (ClutterMasterClockIface *iface)
   iface->start_running = clutter_master_clock_gdk_start_running;
   iface->ensure_next_iteration = clutter_master_clock_gdk_ensure_next_iteration;
   iface->set_paused = clutter_master_clock_gdk_set_paused;
+  iface->get_frame_times = clutter_master_clock_gdk_get_frame_times;
 }
@@ -0,0 +1,118 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/* The headless backend paints every stage into an offscreen framebuffer,
+ * and does not need a display server; it is meant for running the test
+ * suites and benchmarks on machines without one.
+ *
+ * The rendering is done by whatever Cogl driver is available, typically a
+ * software rasterizer; setting CLUTTER_DRIVER=nop selects Cogl's no-op
+ * driver, which skips rendering altogether and is only useful to measure
+ * layout and event handling, as picking needs to read back the stage
+ * contents.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "clutter-backend-headless.h"
+#include "clutter-device-manager-headless.h"
+#include "clutter-event-headless.h"
+#include "clutter-stage-headless.h"
+
+#include "clutter-debug.h"
+#include "clutter-private.h"
+
+G_DEFINE_TYPE (ClutterBackendHeadless, _clutter_backend_headless, CLUTTER_TYPE_BACKEND);
+
+static void
+clutter_backend_headless_dispose (GObject *gobject)
+{
+  ClutterBackendHeadless *backend_headless = CLUTTER_BACKEND_HEADLESS (gobject);
+
+  if (backend_headless->event_source != NULL)
+    {
+      g_source_destroy (backend_headless->event_source);
+      g_clear_pointer (&backend_headless->event_source, g_source_unref);
+    }
+
+  G_OBJECT_CLASS (_clutter_backend_headless_parent_class)->dispose (gobject);
+}
+
+static ClutterFeatureFlags
+clutter_backend_headless_get_features (ClutterBackend *backend)
+{
+  ClutterFeatureFlags flags;
+
+  flags = CLUTTER_BACKEND_CLASS (_clutter_backend_headless_parent_class)->get_features (backend);
+
+  /* the winsys features describe its onscreen framebuffers, which the
+   * stages do not use: there is no buffer swap to throttle or to be
+   * notified about, and the offscreen framebuffers can have any size
+   */
+  flags &= ~(CLUTTER_FEATURE_STAGE_STATIC |
+             CLUTTER_FEATURE_SYNC_TO_VBLANK |
+             CLUTTER_FEATURE_SWAP_EVENTS);
+
+  /* every stage has its own offscreen framebuffer, so the number of
+   * stages is not limited by the onscreen framebuffers of the winsys
+   */
+  flags |= CLUTTER_FEATURE_STAGE_MULTIPLE;
+
+  return flags;
+}
+
+void
+_clutter_events_headless_init (ClutterBackend *backend)
+{
+  ClutterBackendHeadless *backend_headless = CLUTTER_BACKEND_HEADLESS (backend);
+
+  CLUTTER_NOTE (EVENT, "Creating the headless device manager");
+
+  backend->device_manager = _clutter_device_manager_headless_new (backend);
+
+  /* nothing else dispatches the events put in the queue */
+  backend_headless->event_source = _clutter_event_source_headless_new ();
+}
+
+static void
+_clutter_backend_headless_class_init (ClutterBackendHeadlessClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  ClutterBackendClass *backend_class = CLUTTER_BACKEND_CLASS (klass);
+
+  gobject_class->dispose = clutter_backend_headless_dispose;
+
+  backend_class->stage_window_type = CLUTTER_TYPE_STAGE_HEADLESS;
+
+  backend_class->get_features = clutter_backend_headless_get_features;
+}
+
+static void
+_clutter_backend_headless_init (ClutterBackendHeadless *backend_headless)
+{
+}
+
+ClutterBackend *
+clutter_backend_headless_new (void)
+{
+  return g_object_new (CLUTTER_TYPE_BACKEND_HEADLESS, NULL);
+}
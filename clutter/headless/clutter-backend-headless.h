@@ -0,0 +1,61 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __CLUTTER_BACKEND_HEADLESS_H__
+#define __CLUTTER_BACKEND_HEADLESS_H__
+
+#include <glib-object.h>
+#include <clutter/clutter-backend.h>
+
+#include "clutter-backend-private.h"
+
+G_BEGIN_DECLS
+
+#define CLUTTER_TYPE_BACKEND_HEADLESS                (_clutter_backend_headless_get_type ())
+#define CLUTTER_BACKEND_HEADLESS(obj)                (G_TYPE_CHECK_INSTANCE_CAST ((obj), CLUTTER_TYPE_BACKEND_HEADLESS, ClutterBackendHeadless))
+#define CLUTTER_IS_BACKEND_HEADLESS(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), CLUTTER_TYPE_BACKEND_HEADLESS))
+#define CLUTTER_BACKEND_HEADLESS_CLASS(klass)        (G_TYPE_CHECK_CLASS_CAST ((klass), CLUTTER_TYPE_BACKEND_HEADLESS, ClutterBackendHeadlessClass))
+#define CLUTTER_IS_BACKEND_HEADLESS_CLASS(klass)     (G_TYPE_CHECK_CLASS_TYPE ((klass), CLUTTER_TYPE_BACKEND_HEADLESS))
+#define CLUTTER_BACKEND_HEADLESS_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj), CLUTTER_TYPE_BACKEND_HEADLESS, ClutterBackendHeadlessClass))
+
+typedef struct _ClutterBackendHeadless       ClutterBackendHeadless;
+typedef struct _ClutterBackendHeadlessClass  ClutterBackendHeadlessClass;
+
+struct _ClutterBackendHeadless
+{
+  ClutterBackend parent_instance;
+
+  GSource *event_source;
+};
+
+struct _ClutterBackendHeadlessClass
+{
+  ClutterBackendClass parent_class;
+};
+
+GType _clutter_backend_headless_get_type (void) G_GNUC_CONST;
+
+ClutterBackend *clutter_backend_headless_new (void);
+
+void _clutter_events_headless_init (ClutterBackend *backend);
+
+G_END_DECLS
+
+#endif /* __CLUTTER_BACKEND_HEADLESS_H__ */
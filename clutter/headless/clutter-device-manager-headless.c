@@ -0,0 +1,197 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "clutter-device-manager-private.h"
+#include "clutter-device-manager-headless.h"
+
+/* The headless backend has no input hardware; the device manager only
+ * exposes a core pointer and a core keyboard, so that synthetic events
+ * injected with clutter_event_put() can be routed like real ones.
+ */
+
+static guint device_counter;
+
+G_DEFINE_TYPE (ClutterDeviceManagerHeadless, _clutter_device_manager_headless, CLUTTER_TYPE_DEVICE_MANAGER);
+
+static void
+clutter_device_manager_headless_add_device (ClutterDeviceManager *manager,
+                                            ClutterInputDevice   *device)
+{
+  ClutterDeviceManagerHeadless *manager_headless =
+    CLUTTER_DEVICE_MANAGER_HEADLESS (manager);
+
+  manager_headless->devices = g_slist_prepend (manager_headless->devices, device);
+}
+
+static void
+clutter_device_manager_headless_remove_device (ClutterDeviceManager *manager,
+                                               ClutterInputDevice   *device)
+{
+  ClutterDeviceManagerHeadless *manager_headless =
+    CLUTTER_DEVICE_MANAGER_HEADLESS (manager);
+
+  manager_headless->devices = g_slist_remove (manager_headless->devices, device);
+}
+
+static const GSList *
+clutter_device_manager_headless_get_devices (ClutterDeviceManager *manager)
+{
+  return CLUTTER_DEVICE_MANAGER_HEADLESS (manager)->devices;
+}
+
+static ClutterInputDevice *
+clutter_device_manager_headless_get_core_device (ClutterDeviceManager   *manager,
+                                                 ClutterInputDeviceType  type)
+{
+  ClutterDeviceManagerHeadless *manager_headless;
+
+  manager_headless = CLUTTER_DEVICE_MANAGER_HEADLESS (manager);
+
+  switch (type)
+    {
+    case CLUTTER_POINTER_DEVICE:
+      return manager_headless->core_pointer;
+
+    case CLUTTER_KEYBOARD_DEVICE:
+      return manager_headless->core_keyboard;
+
+    default:
+      return NULL;
+    }
+
+  return NULL;
+}
+
+static ClutterInputDevice *
+clutter_device_manager_headless_get_device (ClutterDeviceManager *manager,
+                                            gint                  id)
+{
+  ClutterDeviceManagerHeadless *manager_headless =
+    CLUTTER_DEVICE_MANAGER_HEADLESS (manager);
+  GSList *l;
+
+  for (l = manager_headless->devices; l != NULL; l = l->next)
+    {
+      ClutterInputDevice *device = l->data;
+
+      if (clutter_input_device_get_device_id (device) == id)
+        return device;
+    }
+
+  return NULL;
+}
+
+static void
+clutter_device_manager_headless_constructed (GObject *gobject)
+{
+  ClutterDeviceManagerHeadless *manager_headless;
+  ClutterDeviceManager *manager;
+  ClutterBackend *backend;
+  ClutterInputDevice *device;
+
+  manager = CLUTTER_DEVICE_MANAGER (gobject);
+  manager_headless = CLUTTER_DEVICE_MANAGER_HEADLESS (manager);
+
+  g_object_get (manager, "backend", &backend, NULL);
+
+  device = g_object_new (CLUTTER_TYPE_INPUT_DEVICE,
+                         "id", device_counter++,
+                         "backend", backend,
+                         "device-manager", manager,
+                         "device-type", CLUTTER_POINTER_DEVICE,
+                         "device-mode", CLUTTER_INPUT_MODE_MASTER,
+                         "name", "Headless pointer",
+                         "enabled", TRUE,
+                         "has-cursor", TRUE,
+                         NULL);
+
+  manager_headless->core_pointer = device;
+  _clutter_device_manager_add_device (manager, device);
+
+  device = g_object_new (CLUTTER_TYPE_INPUT_DEVICE,
+                         "id", device_counter++,
+                         "backend", backend,
+                         "device-manager", manager,
+                         "device-type", CLUTTER_KEYBOARD_DEVICE,
+                         "device-mode", CLUTTER_INPUT_MODE_MASTER,
+                         "name", "Headless keyboard",
+                         "enabled", TRUE,
+                         "has-cursor", FALSE,
+                         NULL);
+
+  manager_headless->core_keyboard = device;
+  _clutter_device_manager_add_device (manager, device);
+
+  _clutter_input_device_set_associated_device (manager_headless->core_pointer,
+                                               manager_headless->core_keyboard);
+  _clutter_input_device_set_associated_device (manager_headless->core_keyboard,
+                                               manager_headless->core_pointer);
+
+  g_object_unref (backend);
+
+  if (G_OBJECT_CLASS (_clutter_device_manager_headless_parent_class)->constructed)
+    G_OBJECT_CLASS (_clutter_device_manager_headless_parent_class)->constructed (gobject);
+}
+
+static void
+clutter_device_manager_headless_finalize (GObject *gobject)
+{
+  ClutterDeviceManagerHeadless *manager_headless;
+
+  manager_headless = CLUTTER_DEVICE_MANAGER_HEADLESS (gobject);
+  g_slist_free_full (manager_headless->devices, g_object_unref);
+
+  G_OBJECT_CLASS (_clutter_device_manager_headless_parent_class)->finalize (gobject);
+}
+
+static void
+_clutter_device_manager_headless_class_init (ClutterDeviceManagerHeadlessClass *klass)
+{
+  ClutterDeviceManagerClass *manager_class;
+  GObjectClass *gobject_class;
+
+  gobject_class = G_OBJECT_CLASS (klass);
+  gobject_class->constructed = clutter_device_manager_headless_constructed;
+  gobject_class->finalize = clutter_device_manager_headless_finalize;
+
+  manager_class = CLUTTER_DEVICE_MANAGER_CLASS (klass);
+  manager_class->add_device = clutter_device_manager_headless_add_device;
+  manager_class->remove_device = clutter_device_manager_headless_remove_device;
+  manager_class->get_devices = clutter_device_manager_headless_get_devices;
+  manager_class->get_core_device = clutter_device_manager_headless_get_core_device;
+  manager_class->get_device = clutter_device_manager_headless_get_device;
+}
+
+static void
+_clutter_device_manager_headless_init (ClutterDeviceManagerHeadless *self)
+{
+}
+
+ClutterDeviceManager *
+_clutter_device_manager_headless_new (ClutterBackend *backend)
+{
+  return g_object_new (CLUTTER_TYPE_DEVICE_MANAGER_HEADLESS,
+                       "backend", backend,
+                       NULL);
+}
@@ -0,0 +1,110 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* The headless backend has no windowing system delivering events, so the
+ * only events are the ones put in the queue by clutter_event_put(); this
+ * source drains the queue and hands the events over to their stage.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "clutter-event.h"
+#include "clutter-main.h"
+#include "clutter-private.h"
+#include "clutter-stage-private.h"
+
+#include "clutter-event-headless.h"
+
+static gboolean
+clutter_event_source_headless_prepare (GSource *base,
+                                       gint    *timeout)
+{
+  gboolean retval;
+
+  _clutter_threads_acquire_lock ();
+
+  *timeout = -1;
+
+  retval = clutter_events_pending ();
+
+  _clutter_threads_release_lock ();
+
+  return retval;
+}
+
+static gboolean
+clutter_event_source_headless_check (GSource *base)
+{
+  gboolean retval;
+
+  _clutter_threads_acquire_lock ();
+
+  retval = clutter_events_pending ();
+
+  _clutter_threads_release_lock ();
+
+  return retval;
+}
+
+static gboolean
+clutter_event_source_headless_dispatch (GSource     *base,
+                                        GSourceFunc  callback,
+                                        gpointer     data)
+{
+  ClutterEvent *event;
+
+  _clutter_threads_acquire_lock ();
+
+  event = clutter_event_get ();
+
+  if (event != NULL)
+    {
+      /* events without a stage cannot be delivered anywhere */
+      if (event->any.stage != NULL)
+        _clutter_stage_queue_event (event->any.stage, event, FALSE);
+      else
+        clutter_event_free (event);
+    }
+
+  _clutter_threads_release_lock ();
+
+  return TRUE;
+}
+
+static GSourceFuncs clutter_event_source_headless_funcs = {
+  clutter_event_source_headless_prepare,
+  clutter_event_source_headless_check,
+  clutter_event_source_headless_dispatch,
+  NULL
+};
+
+GSource *
+_clutter_event_source_headless_new (void)
+{
+  GSource *source;
+
+  source = g_source_new (&clutter_event_source_headless_funcs, sizeof (GSource));
+  g_source_set_name (source, "Clutter headless events");
+  g_source_set_priority (source, CLUTTER_PRIORITY_EVENTS);
+  g_source_attach (source, NULL);
+
+  return source;
+}
@@ -0,0 +1,245 @@
+/*
+ * Clutter.
+ *
+ * An OpenGL based 'interactive canvas' library.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <glib.h>
+#include <cogl/cogl.h>
+
+#include "clutter-stage-headless.h"
+
+#include "clutter-backend-private.h"
+#include "clutter-debug.h"
+#include "clutter-stage-private.h"
+#include "clutter-stage-window.h"
+
+static void clutter_stage_window_iface_init (ClutterStageWindowIface *iface);
+
+#define clutter_stage_headless_get_type _clutter_stage_headless_get_type
+
+G_DEFINE_TYPE_WITH_CODE (ClutterStageHeadless,
+                         clutter_stage_headless,
+                         CLUTTER_TYPE_STAGE_COGL,
+                         G_IMPLEMENT_INTERFACE (CLUTTER_TYPE_STAGE_WINDOW,
+                                                clutter_stage_window_iface_init));
+
+static void
+clutter_stage_headless_free_offscreen (ClutterStageHeadless *stage_headless)
+{
+  if (stage_headless->offscreen != COGL_INVALID_HANDLE)
+    {
+      cogl_handle_unref (stage_headless->offscreen);
+      stage_headless->offscreen = COGL_INVALID_HANDLE;
+    }
+}
+
+static gboolean
+clutter_stage_headless_allocate_offscreen (ClutterStageHeadless *stage_headless)
+{
+  CoglFramebuffer *framebuffer;
+  CoglHandle texture;
+  GError *error = NULL;
+
+  clutter_stage_headless_free_offscreen (stage_headless);
+
+  texture = cogl_texture_new_with_size (MAX (stage_headless->width, 1),
+                                        MAX (stage_headless->height, 1),
+                                        COGL_TEXTURE_NO_SLICING,
+                                        COGL_PIXEL_FORMAT_RGBA_8888_PRE);
+  if (texture == COGL_INVALID_HANDLE)
+    {
+      g_warning ("Failed to allocate a %dx%d texture for the headless stage",
+                 stage_headless->width,
+                 stage_headless->height);
+      return FALSE;
+    }
+
+  stage_headless->offscreen = cogl_offscreen_new_to_texture (texture);
+  cogl_handle_unref (texture);
+
+  if (stage_headless->offscreen == COGL_INVALID_HANDLE)
+    {
+      g_warning ("Failed to create the offscreen framebuffer of the "
+                 "headless stage");
+      return FALSE;
+    }
+
+  framebuffer = COGL_FRAMEBUFFER (stage_headless->offscreen);
+  if (!cogl_framebuffer_allocate (framebuffer, &error))
+    {
+      g_warning ("Failed to allocate stage: %s", error->message);
+      g_error_free (error);
+      clutter_stage_headless_free_offscreen (stage_headless);
+      return FALSE;
+    }
+
+  CLUTTER_NOTE (BACKEND, "Allocated a %dx%d offscreen for stage [%p]",
+                stage_headless->width,
+                stage_headless->height,
+                stage_headless);
+
+  return TRUE;
+}
+
+static gboolean
+clutter_stage_headless_realize (ClutterStageWindow *stage_window)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+
+  CLUTTER_NOTE (BACKEND, "Realizing headless stage [%p]", stage_headless);
+
+  if (clutter_get_default_backend ()->cogl_context == NULL)
+    {
+      g_warning ("Failed to realize stage: missing Cogl context");
+      return FALSE;
+    }
+
+  return clutter_stage_headless_allocate_offscreen (stage_headless);
+}
+
+static void
+clutter_stage_headless_unrealize (ClutterStageWindow *stage_window)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+
+  CLUTTER_NOTE (BACKEND, "Unrealizing headless stage [%p]", stage_headless);
+
+  clutter_stage_headless_free_offscreen (stage_headless);
+}
+
+static void
+clutter_stage_headless_get_geometry (ClutterStageWindow    *stage_window,
+                                     cairo_rectangle_int_t *geometry)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+
+  if (geometry != NULL)
+    {
+      geometry->x = geometry->y = 0;
+      geometry->width = stage_headless->width;
+      geometry->height = stage_headless->height;
+    }
+}
+
+static void
+clutter_stage_headless_resize (ClutterStageWindow *stage_window,
+                               gint                width,
+                               gint                height)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+
+  if (width == stage_headless->width && height == stage_headless->height)
+    return;
+
+  stage_headless->width = width;
+  stage_headless->height = height;
+
+  /* the contents are lost, but resizing the stage queues a full
+   * redraw anyway
+   */
+  if (stage_headless->offscreen != COGL_INVALID_HANDLE)
+    clutter_stage_headless_allocate_offscreen (stage_headless);
+}
+
+static void
+clutter_stage_headless_redraw (ClutterStageWindow *stage_window)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+  ClutterStageCogl *stage_cogl = CLUTTER_STAGE_COGL (stage_window);
+
+  if (stage_headless->offscreen == COGL_INVALID_HANDLE)
+    return;
+
+  _clutter_stage_do_paint (stage_cogl->wrapper, NULL);
+
+  /* there is no buffer swap to throttle us, so wait for the frame to
+   * be rendered; otherwise the master clock would queue frames faster
+   * than the renderer can process them
+   */
+  cogl_framebuffer_finish (COGL_FRAMEBUFFER (stage_headless->offscreen));
+
+  stage_cogl->initialized_redraw_clip = FALSE;
+  stage_cogl->dirty_backbuffer = FALSE;
+  stage_cogl->frame_count++;
+}
+
+static CoglFramebuffer *
+clutter_stage_headless_get_active_framebuffer (ClutterStageWindow *stage_window)
+{
+  ClutterStageHeadless *stage_headless = CLUTTER_STAGE_HEADLESS (stage_window);
+
+  return COGL_FRAMEBUFFER (stage_headless->offscreen);
+}
+
+static gboolean
+clutter_stage_headless_can_clip_redraws (ClutterStageWindow *stage_window)
+{
+  return FALSE;
+}
+
+static void
+clutter_stage_headless_get_dirty_pixel (ClutterStageWindow *stage_window,
+                                        int                *x,
+                                        int                *y)
+{
+  *x = 0;
+  *y = 0;
+}
+
+static void
+clutter_stage_headless_dispose (GObject *gobject)
+{
+  clutter_stage_headless_free_offscreen (CLUTTER_STAGE_HEADLESS (gobject));
+
+  G_OBJECT_CLASS (clutter_stage_headless_parent_class)->dispose (gobject);
+}
+
+static void
+clutter_stage_headless_class_init (ClutterStageHeadlessClass *klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->dispose = clutter_stage_headless_dispose;
+}
+
+static void
+clutter_stage_headless_init (ClutterStageHeadless *stage_headless)
+{
+  stage_headless->offscreen = COGL_INVALID_HANDLE;
+
+  /* same default size as the other Cogl stages */
+  stage_headless->width = 800;
+  stage_headless->height = 600;
+}
+
+static void
+clutter_stage_window_iface_init (ClutterStageWindowIface *iface)
+{
+  iface->realize = clutter_stage_headless_realize;
+  iface->unrealize = clutter_stage_headless_unrealize;
+  iface->get_geometry = clutter_stage_headless_get_geometry;
+  iface->resize = clutter_stage_headless_resize;
+  iface->redraw = clutter_stage_headless_redraw;
+  iface->get_active_framebuffer = clutter_stage_headless_get_active_framebuffer;
+  iface->can_clip_redraws = clutter_stage_headless_can_clip_redraws;
+  iface->get_dirty_pixel = clutter_stage_headless_get_dirty_pixel;
+}
@@ -269,6 +269,7 @@ clutter_backend_x11_create_device_manager (ClutterBackendX11 *backend_x11)
                               NULL);
 
               backend_x11->xi_minor = minor;
+              backend_x11->xi_opcode = event_base;
             }
         }
     }
@@ -660,6 +661,25 @@ clutter_backend_x11_translate_event (ClutterBackend *backend,
    */
   update_last_event_time (backend_x11, xevent);
 
+#ifdef HAVE_XINPUT_2
+  /* XI2 events are only consumed by the device manager, so we can
+   * skip the other translators, which are more likely to be at the
+   * head of the list
+   */
+  if (backend_x11->has_xinput &&
+      xevent->xcookie.type == GenericEvent &&
+      xevent->xcookie.extension == backend_x11->xi_opcode)
+    {
+      ClutterEventTranslator *translator;
+
+      translator = CLUTTER_EVENT_TRANSLATOR (backend_x11->device_manager);
+
+      return _clutter_event_translator_translate_event (translator,
+                                                        native,
+                                                        event) == CLUTTER_TRANSLATE_QUEUE;
+    }
+#endif
+
   /* chain up to the parent implementation, which will handle
    * event translators
    */
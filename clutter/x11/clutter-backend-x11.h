@@ -101,6 +101,13 @@ struct _ClutterBackendX11
   ClutterDeviceManager *device_manager;
   gboolean has_xinput;
   int xi_minor;
+  int xi_opcode;
+
+  /* counters of the X events translated into ClutterEvents, and of
+   * the translated motion events coalesced before reaching a stage
+   */
+  guint64 n_translated_events;
+  guint64 n_dropped_events;
 
   XSettingsClient *xsettings;
   Window xsettings_xwin;
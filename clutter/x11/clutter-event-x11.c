@@ -63,6 +63,12 @@
 static Window ParentEmbedderWin = None;
 #endif
 
+/* The maximum number of X events translated, and of events forwarded
+ * to the stages, for each dispatch of the event source; the remaining
+ * events are handled on the next iteration of the main loop.
+ */
+#define MAX_EVENTS_PER_DISPATCH 256
+
 typedef struct _ClutterEventSource      ClutterEventSource;
 
 struct _ClutterEventSource
@@ -72,6 +78,11 @@ struct _ClutterEventSource
   ClutterBackendX11 *backend;
 
   GPollFD event_poll_fd;
+
+  /* motion events held back while translating a batch, so that
+   * they can be coalesced with the following ones
+   */
+  GPtrArray *pending_motion;
 };
 
 ClutterEventX11 *
@@ -102,12 +113,13 @@ static gboolean clutter_event_check    (GSource     *source);
 static gboolean clutter_event_dispatch (GSource     *source,
                                         GSourceFunc  callback,
                                         gpointer     user_data);
+static void     clutter_event_finalize (GSource     *source);
 
 static GSourceFuncs event_funcs = {
   clutter_event_prepare,
   clutter_event_check,
   clutter_event_dispatch,
-  NULL
+  clutter_event_finalize
 };
 
 GSource *
@@ -132,6 +144,7 @@ _clutter_x11_event_source_new (ClutterBackendX11 *backend_x11)
   event_source->backend = backend_x11;
   event_source->event_poll_fd.fd = connection_number;
   event_source->event_poll_fd.events = G_IO_IN;
+  event_source->pending_motion = g_ptr_array_new ();
 
   g_source_add_poll (source, &event_source->event_poll_fd);
   g_source_set_can_recurse (source, TRUE);
@@ -273,14 +286,111 @@ clutter_event_check (GSource *source)
 }
 
 static void
-events_queue (ClutterBackendX11 *backend_x11)
+clutter_event_finalize (GSource *source)
+{
+  ClutterEventSource *event_source = (ClutterEventSource *) source;
+
+  g_ptr_array_foreach (event_source->pending_motion,
+                       (GFunc) clutter_event_free,
+                       NULL);
+  g_ptr_array_free (event_source->pending_motion, TRUE);
+}
+
+/* mirrors the motion compression of the stage, which would drop
+ * the same events once queued
+ */
+static gboolean
+event_is_compressible (const ClutterEvent *event)
+{
+  if (event->type != CLUTTER_MOTION && event->type != CLUTTER_TOUCH_UPDATE)
+    return FALSE;
+
+  if (event->any.stage == NULL)
+    return FALSE;
+
+  return clutter_stage_get_throttle_motion_events (event->any.stage);
+}
+
+static gboolean
+events_share_source (const ClutterEvent *a,
+                     const ClutterEvent *b)
+{
+  return a->type == b->type &&
+         a->any.stage == b->any.stage &&
+         clutter_event_get_device (a) == clutter_event_get_device (b) &&
+         clutter_event_get_event_sequence (a) == clutter_event_get_event_sequence (b);
+}
+
+static void
+flush_pending_motion (ClutterEventSource *event_source)
+{
+  GPtrArray *pending = event_source->pending_motion;
+  guint i;
+
+  for (i = 0; i < pending->len; i++)
+    _clutter_event_push (g_ptr_array_index (pending, i), FALSE);
+
+  g_ptr_array_set_size (pending, 0);
+}
+
+static void
+push_translated_event (ClutterEventSource *event_source,
+                       ClutterEvent       *event)
+{
+  GPtrArray *pending = event_source->pending_motion;
+  guint i;
+
+  if (!event_is_compressible (event))
+    {
+      /* keep the ordering of the motion and the other events */
+      flush_pending_motion (event_source);
+      _clutter_event_push (event, FALSE);
+      return;
+    }
+
+  for (i = 0; i < pending->len; i++)
+    {
+      ClutterEvent *previous = g_ptr_array_index (pending, i);
+
+      if (!events_share_source (previous, event))
+        continue;
+
+      /* the samples of the superseded event are kept in the history
+       * of the new one, like the stage does when compressing; the
+       * new event takes the place of the old one, so the events of
+       * the other devices held back are not moved before it
+       */
+      _clutter_event_coalesce (event, previous);
+      clutter_event_free (previous);
+      g_ptr_array_index (pending, i) = event;
+
+      event_source->backend->n_dropped_events += 1;
+      return;
+    }
+
+  g_ptr_array_add (pending, event);
+}
+
+static void
+events_queue (ClutterEventSource *event_source)
 {
+  ClutterBackendX11 *backend_x11 = event_source->backend;
   ClutterBackend *backend = CLUTTER_BACKEND (backend_x11);
   Display *xdisplay = backend_x11->xdpy;
   ClutterEvent *event;
   XEvent xevent;
+  guint n_events;
+  int n_queued;
+
+  /* drain the X events in one batch, flushing the output buffer
+   * and reading the connection only once; XNextEvent() would
+   * otherwise be preceded by a call to XPending() for each event.
+   * The events arriving during the batch are left to the next
+   * dispatch, which the poll on the connection wakes up
+   */
+  n_queued = XPending (xdisplay);
 
-  while (!clutter_events_pending () && XPending (xdisplay))
+  for (n_events = 0; n_queued > 0 && n_events < MAX_EVENTS_PER_DISPATCH; n_events++)
     {
       XNextEvent (xdisplay, &xevent);
 
@@ -291,14 +401,28 @@ events_queue (ClutterBackendX11 *backend_x11)
 #endif
 
       if (_clutter_backend_translate_event (backend, &xevent, event))
-        _clutter_event_push (event, FALSE);
+        {
+          backend_x11->n_translated_events += 1;
+          push_translated_event (event_source, event);
+        }
       else
         clutter_event_free (event);
 
 #ifdef HAVE_XGE
       XFreeEventData (xdisplay, &xevent.xcookie);
 #endif
+
+      /* the translators can read ahead, e.g. to detect the key
+       * repeats, so the events already queued are counted again
+       * without reading the connection
+       */
+      if (--n_queued == 0)
+        n_queued = XEventsQueued (xdisplay, QueuedAlready);
     }
+
+  flush_pending_motion (event_source);
+
+  CLUTTER_NOTE (EVENT, "Translated %u X events", n_events);
 }
 
 static gboolean
@@ -306,20 +430,33 @@ clutter_event_dispatch (GSource     *source,
                         GSourceFunc  callback,
                         gpointer     user_data)
 {
-  ClutterBackendX11 *backend = ((ClutterEventSource *) source)->backend;
+  ClutterEventSource *event_source = (ClutterEventSource *) source;
   ClutterEvent *event;
+  guint n_events;
 
   _clutter_threads_acquire_lock ();
 
-  /*  Grab the event(s), translate and figure out double click.
-   *  The push onto queue (stack) if valid.
-  */
-  events_queue (backend);
+  /* Don't translate more events if we haven't finished handling
+   * the previous batch
+   */
+  if (!clutter_events_pending ())
+    events_queue (event_source);
 
-  /* Pop an event off the queue if any */
-  event = clutter_event_get ();
-  if (event != NULL)
+  /* forward the whole batch to the stages in one go, instead of one
+   * event per main loop iteration
+   */
+  for (n_events = 0; n_events < MAX_EVENTS_PER_DISPATCH; n_events++)
     {
+      event = clutter_event_get ();
+      if (event == NULL)
+        break;
+
+      if (event->any.stage == NULL)
+        {
+          clutter_event_free (event);
+          continue;
+        }
+
       /* forward the event into clutter for emission etc. */
       _clutter_stage_queue_event (event->any.stage, event, FALSE);
     }
@@ -349,6 +486,42 @@ clutter_x11_get_current_event_time (void)
   return CLUTTER_BACKEND_X11 (backend)->last_event_time;
 }
 
+/**
+ * clutter_x11_get_event_counters:
+ * @n_translated: (out) (optional): return location for the number of
+ *   X events translated into #ClutterEvent<!-- -->s
+ * @n_dropped: (out) (optional): return location for the number of
+ *   translated motion events coalesced into a following one before
+ *   reaching a stage
+ *
+ * Retrieves the counters of the events handled by the X11 event
+ * source since the initialization of Clutter; this can be used to
+ * measure the effect of the motion event compression.
+ *
+ * Since: 1.28
+ */
+void
+clutter_x11_get_event_counters (guint64 *n_translated,
+                                guint64 *n_dropped)
+{
+  ClutterBackend *backend = clutter_get_default_backend ();
+  ClutterBackendX11 *backend_x11;
+
+  if (!CLUTTER_IS_BACKEND_X11 (backend))
+    {
+      g_critical ("The Clutter backend is not a X11 backend.");
+      return;
+    }
+
+  backend_x11 = CLUTTER_BACKEND_X11 (backend);
+
+  if (n_translated != NULL)
+    *n_translated = backend_x11->n_translated_events;
+
+  if (n_dropped != NULL)
+    *n_dropped = backend_x11->n_dropped_events;
+}
+
 /**
  * clutter_x11_event_get_key_group:
  * @event: a #ClutterEvent of type %CLUTTER_KEY_PRESS or %CLUTTER_KEY_RELEASE
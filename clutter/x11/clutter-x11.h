@@ -155,6 +155,10 @@ gboolean clutter_x11_get_use_stereo_stage (void);
 CLUTTER_AVAILABLE_IN_ALL
 Time clutter_x11_get_current_event_time (void);
 
+CLUTTER_AVAILABLE_IN_1_28
+void clutter_x11_get_event_counters (guint64 *n_translated,
+                                     guint64 *n_dropped);
+
 CLUTTER_AVAILABLE_IN_ALL
 gint clutter_x11_event_get_key_group (const ClutterEvent *event);
 
@@ -0,0 +1,270 @@
+#include <clutter/clutter.h>
+
+/* the actions track the pointer during a gesture through event
+ * handlers on the stage, which are called after the handlers of the
+ * ClutterActor::captured-event signal of the stage
+ */
+
+typedef struct {
+  ClutterActor *stage;
+  ClutterActor *actor;
+
+  ClutterAction *gesture;
+  ClutterAction *first_drag;
+  ClutterAction *second_drag;
+
+  GString *emissions;
+  gboolean destroy_on_motion;
+} ActionsData;
+
+static gboolean
+stage_captured_event_cb (ClutterActor *stage,
+                         ClutterEvent *event,
+                         ActionsData  *data)
+{
+  const gchar *name;
+
+  switch (clutter_event_type (event))
+    {
+    case CLUTTER_BUTTON_PRESS:
+      name = "press";
+      break;
+
+    case CLUTTER_MOTION:
+      name = "motion";
+      break;
+
+    case CLUTTER_BUTTON_RELEASE:
+      name = "release";
+      break;
+
+    case CLUTTER_SCROLL:
+      name = "scroll";
+      break;
+
+    default:
+      return CLUTTER_EVENT_PROPAGATE;
+    }
+
+  g_string_append_printf (data->emissions, "stage:%s ", name);
+
+  return CLUTTER_EVENT_PROPAGATE;
+}
+
+static gboolean
+gesture_begin_cb (ClutterGestureAction *action,
+                  ClutterActor         *actor,
+                  ActionsData          *data)
+{
+  g_string_append (data->emissions, "gesture-begin ");
+
+  return TRUE;
+}
+
+static gboolean
+gesture_progress_cb (ClutterGestureAction *action,
+                     ClutterActor         *actor,
+                     ActionsData          *data)
+{
+  g_string_append (data->emissions, "gesture-progress ");
+
+  return TRUE;
+}
+
+static void
+gesture_end_cb (ClutterGestureAction *action,
+                ClutterActor         *actor,
+                ActionsData          *data)
+{
+  g_string_append (data->emissions, "gesture-end ");
+}
+
+static void
+drag_begin_cb (ClutterDragAction   *action,
+               ClutterActor        *actor,
+               gfloat               event_x,
+               gfloat               event_y,
+               ClutterModifierType  modifiers,
+               ActionsData         *data)
+{
+  g_string_append_printf (data->emissions, "drag-begin:%s ",
+                          clutter_actor_meta_get_name (CLUTTER_ACTOR_META (action)));
+}
+
+static void
+drag_motion_cb (ClutterDragAction *action,
+                ClutterActor      *actor,
+                gfloat             delta_x,
+                gfloat             delta_y,
+                ActionsData       *data)
+{
+  g_string_append_printf (data->emissions, "drag-motion:%s ",
+                          clutter_actor_meta_get_name (CLUTTER_ACTOR_META (action)));
+
+  /* the handlers of the actions of the actor, including the ones
+   * not called yet for this event, go away with it
+   */
+  if (data->destroy_on_motion)
+    clutter_actor_destroy (actor);
+}
+
+static void
+drag_end_cb (ClutterDragAction   *action,
+             ClutterActor        *actor,
+             gfloat               event_x,
+             gfloat               event_y,
+             ClutterModifierType  modifiers,
+             ActionsData         *data)
+{
+  g_string_append_printf (data->emissions, "drag-end:%s ",
+                          clutter_actor_meta_get_name (CLUTTER_ACTOR_META (action)));
+}
+
+static void
+add_drag_action (ActionsData    *data,
+                 const gchar    *name,
+                 ClutterAction **action_p)
+{
+  ClutterAction *action = clutter_drag_action_new ();
+
+  clutter_actor_meta_set_name (CLUTTER_ACTOR_META (action), name);
+  clutter_drag_action_set_drag_threshold (CLUTTER_DRAG_ACTION (action), 0, 0);
+  g_signal_connect (action, "drag-begin", G_CALLBACK (drag_begin_cb), data);
+  g_signal_connect (action, "drag-motion", G_CALLBACK (drag_motion_cb), data);
+  g_signal_connect (action, "drag-end", G_CALLBACK (drag_end_cb), data);
+  clutter_actor_add_action (data->actor, action);
+
+  *action_p = action;
+  g_object_add_weak_pointer (G_OBJECT (action), (gpointer *) action_p);
+}
+
+static void
+actions_data_init (ActionsData *data)
+{
+  data->stage = clutter_test_get_stage ();
+  data->emissions = g_string_new (NULL);
+
+  data->actor = clutter_actor_new ();
+  clutter_actor_set_size (data->actor, 100, 100);
+  clutter_actor_set_reactive (data->actor, TRUE);
+  clutter_actor_add_child (data->stage, data->actor);
+
+  /* the gesture registers its handler from the captured-event signal
+   * of the actor, before the drags do from the button-press-event one
+   */
+  data->gesture = clutter_gesture_action_new ();
+  g_signal_connect (data->gesture, "gesture-begin", G_CALLBACK (gesture_begin_cb), data);
+  g_signal_connect (data->gesture, "gesture-progress", G_CALLBACK (gesture_progress_cb), data);
+  g_signal_connect (data->gesture, "gesture-end", G_CALLBACK (gesture_end_cb), data);
+  clutter_actor_add_action (data->actor, data->gesture);
+  g_object_add_weak_pointer (G_OBJECT (data->gesture), (gpointer *) &data->gesture);
+
+  add_drag_action (data, "first", &data->first_drag);
+  add_drag_action (data, "second", &data->second_drag);
+
+  g_signal_connect (data->stage, "captured-event",
+                    G_CALLBACK (stage_captured_event_cb), data);
+
+  clutter_actor_show (data->stage);
+  clutter_test_run_frames (1);
+}
+
+static void
+actions_data_clear (ActionsData *data)
+{
+  g_signal_handlers_disconnect_by_func (data->stage, stage_captured_event_cb, data);
+  g_string_free (data->emissions, TRUE);
+
+  if (data->actor != NULL)
+    clutter_actor_destroy (data->actor);
+}
+
+static void
+put_event (ActionsData      *data,
+           ClutterEventType  type,
+           gfloat            x)
+{
+  /* the press is on the actor; the other events are captured by the
+   * stage whatever their source
+   */
+  clutter_test_put_pointer_event (data->stage,
+                                  type == CLUTTER_BUTTON_PRESS ? data->actor : data->stage,
+                                  type, CLUTTER_CURRENT_TIME, x, 50);
+
+  /* the queued events are only processed by the next frame */
+  clutter_test_run_frames (1);
+}
+
+static void
+actions_event_handlers_dispatch (void)
+{
+  ActionsData data = { NULL, };
+
+  actions_data_init (&data);
+
+  put_event (&data, CLUTTER_BUTTON_PRESS, 10);
+  put_event (&data, CLUTTER_MOTION, 20);
+  put_event (&data, CLUTTER_SCROLL, 20);
+  put_event (&data, CLUTTER_MOTION, 30);
+  put_event (&data, CLUTTER_BUTTON_RELEASE, 30);
+
+  /* the handlers are gone once the gestures are over */
+  put_event (&data, CLUTTER_MOTION, 40);
+
+  if (g_test_verbose ())
+    g_print ("Emissions: %s\n", data.emissions->str);
+
+  /* the handlers are called in the order they were added, only for
+   * the types of events they track, and after the signal handlers
+   */
+  g_assert_cmpstr (data.emissions->str, ==,
+                   "stage:press gesture-begin drag-begin:first drag-begin:second "
+                   "stage:motion gesture-progress drag-motion:first drag-motion:second "
+                   "stage:scroll "
+                   "stage:motion gesture-progress drag-motion:first drag-motion:second "
+                   "stage:release gesture-end drag-end:first drag-end:second "
+                   "stage:motion ");
+
+  actions_data_clear (&data);
+}
+
+static void
+actions_event_handlers_destroy (void)
+{
+  ActionsData data = { NULL, };
+
+  actions_data_init (&data);
+  g_object_add_weak_pointer (G_OBJECT (data.actor), (gpointer *) &data.actor);
+
+  data.destroy_on_motion = TRUE;
+
+  put_event (&data, CLUTTER_BUTTON_PRESS, 10);
+  put_event (&data, CLUTTER_MOTION, 20);
+  put_event (&data, CLUTTER_MOTION, 30);
+  put_event (&data, CLUTTER_BUTTON_RELEASE, 30);
+
+  if (g_test_verbose ())
+    g_print ("Emissions: %s\n", data.emissions->str);
+
+  /* the second drag is not called for the event that destroyed the
+   * actor, and none of the actions is called afterwards
+   */
+  g_assert_cmpstr (data.emissions->str, ==,
+                   "stage:press gesture-begin drag-begin:first drag-begin:second "
+                   "stage:motion gesture-progress drag-motion:first "
+                   "stage:motion "
+                   "stage:release ");
+
+  g_assert_null (data.actor);
+  g_assert_null (data.gesture);
+  g_assert_null (data.first_drag);
+  g_assert_null (data.second_drag);
+
+  actions_data_clear (&data);
+}
+
+/* the frames, and with them the events, are processed on demand */
+CLUTTER_TEST_SUITE_MANUAL_CLOCK (
+  CLUTTER_TEST_UNIT ("/actions/event-handlers/dispatch", actions_event_handlers_dispatch)
+  CLUTTER_TEST_UNIT ("/actions/event-handlers/destroy-during-emission", actions_event_handlers_destroy)
+)
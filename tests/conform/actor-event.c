@@ -0,0 +1,268 @@
+#include <clutter/clutter.h>
+
+typedef struct {
+  ClutterActor *stage;
+  ClutterActor *parent;
+  ClutterActor *child;
+
+  GString *emissions;
+  gboolean destroy_parent;
+  gboolean hook_destroyed;
+  gboolean done;
+} EventData;
+
+static gboolean
+record_captured_event (ClutterActor *actor,
+                       ClutterEvent *event,
+                       EventData    *data)
+{
+  g_string_append_printf (data->emissions, "%s:captured ",
+                          clutter_actor_get_name (actor));
+
+  return CLUTTER_EVENT_PROPAGATE;
+}
+
+static gboolean
+record_event (ClutterActor *actor,
+              ClutterEvent *event,
+              EventData    *data)
+{
+  g_string_append_printf (data->emissions, "%s:event ",
+                          clutter_actor_get_name (actor));
+
+  if (actor == data->stage)
+    data->done = TRUE;
+
+  return CLUTTER_EVENT_PROPAGATE;
+}
+
+static gboolean
+record_key_press (ClutterActor *actor,
+                  ClutterEvent *event,
+                  EventData    *data)
+{
+  g_string_append_printf (data->emissions, "%s:key-press ",
+                          clutter_actor_get_name (actor));
+
+  /* the actors of the chain must survive the emission */
+  if (data->destroy_parent)
+    clutter_actor_destroy (data->parent);
+
+  return CLUTTER_EVENT_PROPAGATE;
+}
+
+static gboolean
+stop_waiting (gpointer user_data)
+{
+  EventData *data = user_data;
+
+  data->done = TRUE;
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+send_key_press (EventData *data)
+{
+  ClutterEvent *event;
+  guint timeout_id;
+
+  event = clutter_event_new (CLUTTER_KEY_PRESS);
+  clutter_event_set_stage (event, CLUTTER_STAGE (data->stage));
+  clutter_event_set_key_symbol (event, CLUTTER_KEY_a);
+
+  clutter_do_event (event);
+  clutter_event_free (event);
+
+  data->done = FALSE;
+  timeout_id = g_timeout_add_seconds (5, stop_waiting, data);
+
+  while (!data->done)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_source_remove (timeout_id);
+}
+
+static void
+setup_event_chain (EventData *data)
+{
+  data->stage = clutter_test_get_stage ();
+  clutter_actor_set_name (data->stage, "stage");
+
+  /* the parent has no handlers, so the event is not emitted on it */
+  data->parent = clutter_actor_new ();
+  clutter_actor_set_name (data->parent, "parent");
+  clutter_actor_set_reactive (data->parent, TRUE);
+  clutter_actor_add_child (data->stage, data->parent);
+
+  data->child = clutter_actor_new ();
+  clutter_actor_set_name (data->child, "child");
+  clutter_actor_set_reactive (data->child, TRUE);
+  clutter_actor_add_child (data->parent, data->child);
+
+  g_signal_connect (data->stage, "captured-event",
+                    G_CALLBACK (record_captured_event), data);
+  g_signal_connect (data->stage, "event",
+                    G_CALLBACK (record_event), data);
+  g_signal_connect (data->child, "key-press-event",
+                    G_CALLBACK (record_key_press), data);
+
+  clutter_actor_show (data->stage);
+  clutter_stage_set_key_focus (CLUTTER_STAGE (data->stage), data->child);
+
+  data->emissions = g_string_new (NULL);
+}
+
+static void
+actor_event_propagation (void)
+{
+  EventData data = { NULL, };
+
+  setup_event_chain (&data);
+
+  send_key_press (&data);
+
+  if (g_test_verbose ())
+    g_print ("Emissions: %s\n", data.emissions->str);
+
+  g_assert_cmpstr (data.emissions->str, ==,
+                   "stage:captured child:key-press stage:event ");
+
+  /* connecting a handler on the parent adds it to the chain */
+  g_string_truncate (data.emissions, 0);
+  g_signal_connect (data.parent, "captured-event",
+                    G_CALLBACK (record_captured_event), &data);
+  g_signal_connect (data.parent, "event",
+                    G_CALLBACK (record_event), &data);
+
+  send_key_press (&data);
+
+  g_assert_cmpstr (data.emissions->str, ==,
+                   "stage:captured parent:captured child:key-press "
+                   "parent:event stage:event ");
+
+  g_string_free (data.emissions, TRUE);
+  clutter_actor_destroy (data.parent);
+}
+
+static void
+actor_event_destroy_during_emission (void)
+{
+  EventData data = { NULL, };
+
+  setup_event_chain (&data);
+
+  g_signal_connect (data.parent, "event",
+                    G_CALLBACK (record_event), &data);
+  g_object_add_weak_pointer (G_OBJECT (data.parent),
+                             (gpointer *) &data.parent);
+
+  data.destroy_parent = TRUE;
+  send_key_press (&data);
+
+  if (g_test_verbose ())
+    g_print ("Emissions: %s\n", data.emissions->str);
+
+  /* the parent is still notified after being destroyed, and the
+   * event reaches the stage
+   */
+  g_assert_cmpstr (data.emissions->str, ==,
+                   "stage:captured child:key-press parent:event stage:event ");
+  g_assert_null (data.parent);
+
+  g_string_free (data.emissions, TRUE);
+}
+
+static gboolean
+record_emission_hook (GSignalInvocationHint *ihint,
+                      guint                  n_param_values,
+                      const GValue          *param_values,
+                      gpointer               user_data)
+{
+  EventData *data = user_data;
+  ClutterActor *actor = g_value_get_object (&param_values[0]);
+
+  if (actor == data->parent)
+    g_string_append (data->emissions, "parent:hook ");
+
+  return TRUE;
+}
+
+static void
+hook_data_destroy (gpointer user_data)
+{
+  EventData *data = user_data;
+
+  data->hook_destroyed = TRUE;
+}
+
+static void
+actor_event_emission_hook (void)
+{
+  EventData data = { NULL, };
+  guint signal_id;
+  gulong hook_id;
+
+  setup_event_chain (&data);
+
+  /* the events are not emitted on the parent, which has no handlers,
+   * so a hook added directly through GObject does not see them
+   */
+  signal_id = g_signal_lookup ("captured-event", CLUTTER_TYPE_ACTOR);
+  hook_id = g_signal_add_emission_hook (signal_id, 0,
+                                        record_emission_hook,
+                                        &data,
+                                        NULL);
+
+  send_key_press (&data);
+
+  if (g_test_verbose ())
+    g_print ("Emissions: %s\n", data.emissions->str);
+
+  g_assert_cmpstr (data.emissions->str, ==,
+                   "stage:captured child:key-press stage:event ");
+
+  g_signal_remove_emission_hook (signal_id, hook_id);
+
+  /* a hook added through Clutter makes the events go to every actor */
+  g_string_truncate (data.emissions, 0);
+  hook_id = clutter_actor_add_event_emission_hook (signal_id, 0,
+                                                   record_emission_hook,
+                                                   &data,
+                                                   hook_data_destroy);
+  g_assert_cmpuint (hook_id, !=, 0);
+
+  send_key_press (&data);
+
+  if (g_test_verbose ())
+    g_print ("Emissions: %s\n", data.emissions->str);
+
+  g_assert_cmpstr (data.emissions->str, ==,
+                   "stage:captured parent:hook child:key-press stage:event ");
+
+  /* once it is removed, the parent is skipped again */
+  g_signal_remove_emission_hook (signal_id, hook_id);
+  g_assert_true (data.hook_destroyed);
+
+  g_string_truncate (data.emissions, 0);
+  hook_id = g_signal_add_emission_hook (signal_id, 0,
+                                        record_emission_hook,
+                                        &data,
+                                        NULL);
+
+  send_key_press (&data);
+
+  g_assert_cmpstr (data.emissions->str, ==,
+                   "stage:captured child:key-press stage:event ");
+
+  g_signal_remove_emission_hook (signal_id, hook_id);
+
+  g_string_free (data.emissions, TRUE);
+  clutter_actor_destroy (data.parent);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/actor/event/propagation", actor_event_propagation)
+  CLUTTER_TEST_UNIT ("/actor/event/destroy-during-emission", actor_event_destroy_during_emission)
+  CLUTTER_TEST_UNIT ("/actor/event/emission-hook", actor_event_emission_hook)
+)
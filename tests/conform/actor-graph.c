@@ -470,6 +470,267 @@ actor_container_signals (void)
   g_assert (actor == NULL);
 }
 
+static void
+count_signal (ClutterContainer *container,
+              ClutterActor     *child,
+              gpointer          data)
+{
+  int *counter = data;
+
+  *counter += 1;
+}
+
+static void
+count_children_changed (ClutterActor *actor,
+                        guint         n_added,
+                        guint         n_removed,
+                        gpointer      data)
+{
+  int *counter = data;
+
+  g_assert_cmpuint (n_added == 0, !=, n_removed == 0);
+
+  counter[0] += n_added;
+  counter[1] += n_removed;
+  counter[2] += 1;
+}
+
+static void
+remove_on_parent_set (ClutterActor *child,
+                      ClutterActor *old_parent,
+                      gpointer      data)
+{
+  ClutterActor *parent = clutter_actor_get_parent (child);
+  int *add_count = data;
+
+  if (parent == NULL)
+    return;
+
+  /* the child was reported as added before ::parent-set */
+  g_assert_cmpint (*add_count, ==, 2);
+
+  clutter_actor_remove_child (parent, child);
+}
+
+static void
+actor_add_remove_children (void)
+{
+  ClutterActor *actor = clutter_actor_new ();
+  ClutterActor *children[4];
+  ClutterActor *iter;
+  int add_count, remove_count;
+  int changed[3] = { 0, };
+  int i;
+
+  g_object_ref_sink (actor);
+  g_object_add_weak_pointer (G_OBJECT (actor), (gpointer *) &actor);
+
+  add_count = remove_count = 0;
+  g_signal_connect (actor,
+                    "actor-added", G_CALLBACK (count_signal),
+                    &add_count);
+  g_signal_connect (actor,
+                    "actor-removed", G_CALLBACK (count_signal),
+                    &remove_count);
+  g_signal_connect (actor,
+                    "children-changed", G_CALLBACK (count_children_changed),
+                    changed);
+
+  clutter_actor_add_child (actor, g_object_new (CLUTTER_TYPE_ACTOR,
+                                                "name", "existing",
+                                                "z-position", 1.f,
+                                                NULL));
+
+  children[0] = g_object_new (CLUTTER_TYPE_ACTOR,
+                              "name", "foo",
+                              "z-position", 2.f,
+                              NULL);
+  children[1] = g_object_new (CLUTTER_TYPE_ACTOR,
+                              "name", "bar",
+                              NULL);
+  children[2] = g_object_new (CLUTTER_TYPE_ACTOR,
+                              "name", "baz",
+                              "z-position", 1.f,
+                              NULL);
+  children[3] = g_object_new (CLUTTER_TYPE_ACTOR,
+                              "name", "qux",
+                              NULL);
+
+  clutter_actor_add_children (actor, children, 4);
+
+  g_assert_cmpint (add_count, ==, 5);
+  g_assert_cmpint (clutter_actor_get_n_children (actor), ==, 5);
+
+  /* a single batched notification */
+  g_assert_cmpint (changed[0], ==, 4);
+  g_assert_cmpint (changed[2], ==, 1);
+
+  /* the children are sorted by depth, and the children at the same
+   * depth keep the insertion order
+   */
+  iter = clutter_actor_get_first_child (actor);
+  g_assert_cmpstr (clutter_actor_get_name (iter), ==, "bar");
+  iter = clutter_actor_get_next_sibling (iter);
+  g_assert_cmpstr (clutter_actor_get_name (iter), ==, "qux");
+  iter = clutter_actor_get_next_sibling (iter);
+  g_assert_cmpstr (clutter_actor_get_name (iter), ==, "existing");
+  iter = clutter_actor_get_next_sibling (iter);
+  g_assert_cmpstr (clutter_actor_get_name (iter), ==, "baz");
+  iter = clutter_actor_get_next_sibling (iter);
+  g_assert_cmpstr (clutter_actor_get_name (iter), ==, "foo");
+  g_assert (iter == clutter_actor_get_last_child (actor));
+
+  for (i = 0; i < 4; i++)
+    g_assert (clutter_actor_get_parent (children[i]) == actor);
+
+  children[0] = clutter_actor_get_first_child (actor);
+  children[1] = clutter_actor_get_last_child (actor);
+
+  clutter_actor_remove_children (actor, children, 2);
+
+  g_assert_cmpint (remove_count, ==, 2);
+  g_assert_cmpint (clutter_actor_get_n_children (actor), ==, 3);
+  g_assert_cmpint (changed[1], ==, 2);
+  g_assert_cmpint (changed[2], ==, 2);
+
+  iter = clutter_actor_get_first_child (actor);
+  g_assert_cmpstr (clutter_actor_get_name (iter), ==, "qux");
+  iter = clutter_actor_get_last_child (actor);
+  g_assert_cmpstr (clutter_actor_get_name (iter), ==, "baz");
+
+  /* a child removed by a handler while it is added is reported as
+   * added, then as removed
+   */
+  add_count = remove_count = 0;
+  children[0] = clutter_actor_new ();
+  children[1] = g_object_ref_sink (clutter_actor_new ());
+  g_signal_connect (children[1], "parent-set",
+                    G_CALLBACK (remove_on_parent_set),
+                    &add_count);
+
+  clutter_actor_add_children (actor, children, 2);
+
+  g_assert_cmpint (add_count, ==, 2);
+  g_assert_cmpint (remove_count, ==, 1);
+  g_assert_cmpint (changed[0], ==, 6);
+  g_assert_cmpint (changed[1], ==, 3);
+  g_assert_cmpint (clutter_actor_get_n_children (actor), ==, 4);
+  g_assert (clutter_actor_get_parent (children[1]) == NULL);
+  clutter_actor_destroy (children[1]);
+  g_object_unref (children[1]);
+
+  g_signal_handlers_disconnect_by_func (actor, G_CALLBACK (count_children_changed),
+                                        changed);
+  g_signal_handlers_disconnect_by_func (actor, G_CALLBACK (count_signal),
+                                        &add_count);
+  g_signal_handlers_disconnect_by_func (actor, G_CALLBACK (count_signal),
+                                        &remove_count);
+
+  clutter_actor_destroy (actor);
+  g_assert (actor == NULL);
+}
+
+static void
+actor_child_index (void)
+{
+  ClutterActor *actor = clutter_actor_new ();
+  ClutterActor *child;
+  GPtrArray *snapshot;
+  int position;
+  int i;
+
+  g_object_ref_sink (actor);
+  g_object_add_weak_pointer (G_OBJECT (actor), (gpointer *) &actor);
+
+  for (i = 0; i < 100; i++)
+    {
+      child = clutter_actor_new ();
+      g_object_set_data (G_OBJECT (child), "position", GINT_TO_POINTER (i));
+      clutter_actor_add_child (actor, child);
+
+      /* appending keeps the index valid */
+      g_assert (clutter_actor_get_child_at_index (actor, i) == child);
+    }
+
+  for (i = 0; i < 100; i++)
+    {
+      child = clutter_actor_get_child_at_index (actor, i);
+      g_assert_cmpint (GPOINTER_TO_INT (g_object_get_data (G_OBJECT (child), "position")), ==, i);
+    }
+
+  g_assert (clutter_actor_get_child_at_index (actor, 100) == NULL);
+
+  /* moving the last child to the front */
+  child = clutter_actor_get_last_child (actor);
+  clutter_actor_set_child_at_index (actor, child, 0);
+  g_assert (clutter_actor_get_first_child (actor) == child);
+  g_assert (clutter_actor_get_child_at_index (actor, 0) == child);
+  g_assert (clutter_actor_get_next_sibling (child) == clutter_actor_get_child_at_index (actor, 1));
+
+  /* and back to the end */
+  clutter_actor_set_child_at_index (actor, child, -1);
+  g_assert (clutter_actor_get_last_child (actor) == child);
+  g_assert (clutter_actor_get_child_at_index (actor, 99) == child);
+
+  clutter_actor_set_child_at_index (actor, child, 50);
+  g_assert (clutter_actor_get_child_at_index (actor, 50) == child);
+  g_assert (clutter_actor_get_previous_sibling (child) == clutter_actor_get_child_at_index (actor, 49));
+  g_assert (clutter_actor_get_next_sibling (child) == clutter_actor_get_child_at_index (actor, 51));
+
+  /* the snapshot does not change with the children */
+  snapshot = clutter_actor_get_children_snapshot (actor);
+  g_assert_cmpuint (snapshot->len, ==, 100);
+  g_assert (g_ptr_array_index (snapshot, 50) == child);
+
+  g_object_ref (child);
+  clutter_actor_remove_child (actor, child);
+  g_assert_cmpuint (snapshot->len, ==, 100);
+  g_assert (g_ptr_array_index (snapshot, 50) == child);
+  g_assert (clutter_actor_get_child_at_index (actor, 50) == g_ptr_array_index (snapshot, 51));
+
+  clutter_actor_insert_child_at_index (actor, child, 10);
+  g_assert (clutter_actor_get_child_at_index (actor, 10) == child);
+  g_object_unref (child);
+
+  g_ptr_array_unref (snapshot);
+
+  /* consecutive insertions in the middle, from both ends of the list,
+   * without indexed reads in between
+   */
+  for (i = 0; i < 4; i++)
+    {
+      child = clutter_actor_new ();
+      g_object_set_data (G_OBJECT (child), "position", GINT_TO_POINTER (-1 - i));
+      clutter_actor_insert_child_at_index (actor, child, i % 2 == 0 ? 20 : 80);
+    }
+
+  g_assert_cmpint (clutter_actor_get_n_children (actor), ==, 104);
+
+  for (child = clutter_actor_get_first_child (actor), i = 0;
+       child != NULL;
+       child = clutter_actor_get_next_sibling (child), i += 1)
+    {
+      g_assert (clutter_actor_get_child_at_index (actor, i) == child);
+
+      position = GPOINTER_TO_INT (g_object_get_data (G_OBJECT (child), "position"));
+
+      /* each insertion shifts the children inserted after it */
+      if (i == 20)
+        g_assert_cmpint (position, ==, -3);
+      else if (i == 21)
+        g_assert_cmpint (position, ==, -1);
+      else if (i == 80)
+        g_assert_cmpint (position, ==, -4);
+      else if (i == 82)
+        g_assert_cmpint (position, ==, -2);
+      else
+        g_assert_cmpint (position, >=, 0);
+    }
+
+  clutter_actor_destroy (actor);
+  g_assert (actor == NULL);
+}
+
 static void
 actor_contains (void)
 {
@@ -545,5 +806,7 @@ CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/actor/graph/replace-child", actor_replace_child)
   CLUTTER_TEST_UNIT ("/actor/graph/remove-all", actor_remove_all)
   CLUTTER_TEST_UNIT ("/actor/graph/container-signals", actor_container_signals)
+  CLUTTER_TEST_UNIT ("/actor/graph/add-remove-children", actor_add_remove_children)
+  CLUTTER_TEST_UNIT ("/actor/graph/child-index", actor_child_index)
   CLUTTER_TEST_UNIT ("/actor/graph/contains", actor_contains)
 )
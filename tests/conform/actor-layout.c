@@ -86,7 +86,535 @@ actor_margin_layout (void)
   clutter_test_assert_actor_at_point (stage, &p, flower[2]);
 }
 
+static void
+actor_flow_reflow_layout (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *vase;
+  ClutterActor *flower[3];
+  ClutterPoint p;
+
+  vase = clutter_actor_new ();
+  clutter_actor_set_name (vase, "Vase");
+  clutter_actor_set_layout_manager (vase, clutter_flow_layout_new (CLUTTER_FLOW_HORIZONTAL));
+  clutter_actor_set_width (vase, 250);
+  clutter_actor_add_child (stage, vase);
+
+  flower[0] = clutter_actor_new ();
+  clutter_actor_set_background_color (flower[0], CLUTTER_COLOR_Red);
+  clutter_actor_set_size (flower[0], 100, 100);
+  clutter_actor_set_name (flower[0], "Red Flower");
+  clutter_actor_add_child (vase, flower[0]);
+
+  flower[1] = clutter_actor_new ();
+  clutter_actor_set_background_color (flower[1], CLUTTER_COLOR_Yellow);
+  clutter_actor_set_size (flower[1], 100, 100);
+  clutter_actor_set_name (flower[1], "Yellow Flower");
+  clutter_actor_add_child (vase, flower[1]);
+
+  flower[2] = clutter_actor_new ();
+  clutter_actor_set_background_color (flower[2], CLUTTER_COLOR_Green);
+  clutter_actor_set_size (flower[2], 100, 100);
+  clutter_actor_set_name (flower[2], "Green Flower");
+  clutter_actor_add_child (vase, flower[2]);
+
+  clutter_point_init (&p, 50, 150);
+  clutter_test_assert_actor_at_point (stage, &p, flower[2]);
+
+  /* the lines are computed again when the children change */
+  clutter_actor_hide (flower[1]);
+
+  clutter_point_init (&p, 150, 50);
+  clutter_test_assert_actor_at_point (stage, &p, flower[2]);
+
+  clutter_actor_show (flower[1]);
+
+  clutter_point_init (&p, 50, 150);
+  clutter_test_assert_actor_at_point (stage, &p, flower[2]);
+
+  /* and when the container is resized */
+  clutter_actor_set_width (vase, 100);
+
+  clutter_point_init (&p, 25, 225);
+  clutter_test_assert_actor_at_point (stage, &p, flower[2]);
+}
+
+static void
+actor_grid_relayout (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterLayoutManager *layout;
+  ClutterActor *grid;
+  ClutterActor *cell[4];
+  ClutterPoint p;
+  int i;
+
+  layout = clutter_grid_layout_new ();
+
+  grid = clutter_actor_new ();
+  clutter_actor_set_name (grid, "Grid");
+  clutter_actor_set_layout_manager (grid, layout);
+  clutter_actor_add_child (stage, grid);
+
+  for (i = 0; i < 3; i++)
+    {
+      cell[i] = clutter_actor_new ();
+      clutter_actor_set_size (cell[i], 100, 100);
+      clutter_actor_add_child (grid, cell[i]);
+    }
+
+  clutter_point_init (&p, 250, 50);
+  clutter_test_assert_actor_at_point (stage, &p, cell[2]);
+
+  /* the lines are computed again when a child changes size */
+  clutter_actor_set_width (cell[0], 150);
+
+  clutter_point_init (&p, 300, 50);
+  clutter_test_assert_actor_at_point (stage, &p, cell[2]);
+
+  /* or is hidden, which leaves its column empty */
+  clutter_actor_hide (cell[1]);
+
+  clutter_point_init (&p, 200, 50);
+  clutter_test_assert_actor_at_point (stage, &p, cell[2]);
+
+  /* and when a child is attached to a new row */
+  cell[3] = clutter_actor_new ();
+  clutter_actor_set_size (cell[3], 100, 100);
+  clutter_grid_layout_attach (CLUTTER_GRID_LAYOUT (layout), cell[3], 0, 1, 1, 1);
+
+  clutter_point_init (&p, 50, 150);
+  clutter_test_assert_actor_at_point (stage, &p, cell[3]);
+}
+
+static void
+actor_constraint_chain_layout (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *actors[3];
+  ClutterActorBox box;
+  int i;
+
+  /* each actor is bound to the next one, which is allocated after it */
+  for (i = 0; i < 3; i++)
+    {
+      actors[i] = clutter_actor_new ();
+      clutter_actor_set_size (actors[i], 50, 50);
+      clutter_actor_add_child (stage, actors[i]);
+    }
+
+  clutter_actor_set_position (actors[2], 10, 10);
+  clutter_actor_add_constraint (actors[1], clutter_bind_constraint_new (actors[2], CLUTTER_BIND_X, 60));
+  clutter_actor_add_constraint (actors[0], clutter_bind_constraint_new (actors[1], CLUTTER_BIND_X, 60));
+
+  /* the whole chain settles within a single relayout */
+  clutter_actor_get_allocation_box (actors[0], &box);
+  g_assert_cmpfloat (box.x1, ==, 130);
+
+  clutter_actor_set_x (actors[2], 20);
+
+  clutter_actor_get_allocation_box (actors[0], &box);
+  g_assert_cmpfloat (box.x1, ==, 140);
+
+  clutter_actor_get_allocation_box (actors[1], &box);
+  g_assert_cmpfloat (box.x1, ==, 80);
+
+  for (i = 0; i < 3; i++)
+    clutter_actor_destroy (actors[i]);
+}
+
+static void
+actor_box_distribute_layout (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *box;
+  ClutterActor *children[3];
+  ClutterActorBox allocation;
+  int i;
+
+  box = clutter_actor_new ();
+  clutter_actor_set_layout_manager (box, clutter_box_layout_new ());
+  clutter_actor_set_width (box, 300);
+  clutter_actor_add_child (stage, box);
+
+  for (i = 0; i < 3; i++)
+    {
+      children[i] = clutter_actor_new ();
+      clutter_actor_set_min_width (children[i], 50);
+      clutter_actor_set_natural_width (children[i], 50 + 25 * i);
+      clutter_actor_set_height (children[i], 50);
+      clutter_actor_add_child (box, children[i]);
+    }
+
+  /* every child gets its natural width */
+  clutter_actor_get_allocation_box (children[2], &allocation);
+  g_assert_cmpfloat (allocation.x1, ==, 125);
+  g_assert_cmpfloat (allocation.x2, ==, 225);
+
+  /* the space left is shared, and the widest child is shrunk */
+  clutter_actor_set_width (box, 200);
+
+  clutter_actor_get_allocation_box (children[1], &allocation);
+  g_assert_cmpfloat (allocation.x1, ==, 50);
+  g_assert_cmpfloat (allocation.x2, ==, 125);
+
+  clutter_actor_get_allocation_box (children[2], &allocation);
+  g_assert_cmpfloat (allocation.x1, ==, 125);
+  g_assert_cmpfloat (allocation.x2, ==, 200);
+
+  /* the space left is given to the expanding children */
+  clutter_actor_set_width (box, 300);
+  clutter_actor_set_x_expand (children[0], TRUE);
+
+  clutter_actor_get_allocation_box (children[0], &allocation);
+  g_assert_cmpfloat (allocation.x2, ==, 125);
+
+  clutter_actor_get_allocation_box (children[2], &allocation);
+  g_assert_cmpfloat (allocation.x1, ==, 200);
+
+  clutter_actor_destroy (box);
+}
+
+static void
+count_layout_changed (ClutterLayoutManager *manager,
+                      gpointer              data)
+{
+  guint *n_changed = data;
+
+  *n_changed += 1;
+}
+
+static void
+actor_child_properties_layout (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterLayoutManager *layout;
+  ClutterActor *box;
+  ClutterActor *children[4];
+  GParamSpec *pspec;
+  GValue value = G_VALUE_INIT;
+  guint n_changed = 0;
+  gboolean expand;
+  int i;
+
+  layout = clutter_box_layout_new ();
+
+  box = clutter_actor_new ();
+  clutter_actor_set_layout_manager (box, layout);
+  clutter_actor_add_child (stage, box);
+
+  for (i = 0; i < 4; i++)
+    {
+      children[i] = clutter_actor_new ();
+      clutter_actor_set_size (children[i], 50, 50);
+      clutter_actor_add_child (box, children[i]);
+    }
+
+  g_signal_connect (layout, "layout-changed",
+                    G_CALLBACK (count_layout_changed),
+                    &n_changed);
+
+  /* the property is resolved once, and set on all the children in a batch */
+  pspec = clutter_layout_manager_find_child_property (layout, "expand");
+  g_assert_nonnull (pspec);
+
+  g_value_init (&value, G_TYPE_BOOLEAN);
+  g_value_set_boolean (&value, TRUE);
+  clutter_layout_manager_children_set_property (layout, CLUTTER_CONTAINER (box),
+                                                children, 4,
+                                                pspec, &value);
+  g_value_unset (&value);
+
+  g_assert_cmpuint (n_changed, ==, 1);
+
+  for (i = 0; i < 4; i++)
+    {
+      clutter_layout_manager_child_get (layout, CLUTTER_CONTAINER (box), children[i],
+                                        "expand", &expand,
+                                        NULL);
+      g_assert_true (expand);
+    }
+
+  /* changes are coalesced until the last thaw */
+  n_changed = 0;
+  clutter_layout_manager_freeze_layout_changed (layout);
+  clutter_layout_manager_freeze_layout_changed (layout);
+
+  for (i = 0; i < 4; i++)
+    clutter_layout_manager_child_set (layout, CLUTTER_CONTAINER (box), children[i],
+                                      "expand", FALSE,
+                                      "x-fill", FALSE,
+                                      NULL);
+
+  clutter_layout_manager_thaw_layout_changed (layout);
+  g_assert_cmpuint (n_changed, ==, 0);
+
+  clutter_layout_manager_thaw_layout_changed (layout);
+  g_assert_cmpuint (n_changed, ==, 1);
+
+  /* nothing is emitted if nothing changed */
+  n_changed = 0;
+  clutter_layout_manager_freeze_layout_changed (layout);
+  clutter_layout_manager_thaw_layout_changed (layout);
+  g_assert_cmpuint (n_changed, ==, 0);
+
+  clutter_actor_destroy (box);
+}
+
+static void
+on_allocation_changed (ClutterActor           *actor,
+                       const ClutterActorBox  *box,
+                       ClutterAllocationFlags  flags,
+                       gpointer                data)
+{
+  guint *n_changed = data;
+
+  *n_changed += 1;
+}
+
+static void
+on_transition_stopped (ClutterActor *actor,
+                       const gchar  *name,
+                       gboolean      is_finished,
+                       gpointer      data)
+{
+  gboolean *stopped = data;
+
+  *stopped = TRUE;
+}
+
+static void
+actor_layout_only_animation (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterLayoutManager *layout;
+  ClutterActor *box, *child, *content;
+  ClutterActorBox allocation;
+  guint n_changed = 0;
+  gboolean stopped = FALSE;
+
+  layout = clutter_box_layout_new ();
+  clutter_layout_manager_set_layout_only_animations (layout, TRUE);
+  g_assert_true (clutter_layout_manager_get_layout_only_animations (layout));
+
+  box = clutter_actor_new ();
+  clutter_actor_set_layout_manager (box, layout);
+  clutter_actor_set_width (box, 100);
+  clutter_actor_add_child (stage, box);
+
+  child = clutter_actor_new ();
+  clutter_actor_set_layout_manager (child, clutter_bin_layout_new (CLUTTER_BIN_ALIGNMENT_FILL,
+                                                                   CLUTTER_BIN_ALIGNMENT_FILL));
+  clutter_actor_set_x_expand (child, TRUE);
+  clutter_actor_add_child (box, child);
+
+  content = clutter_actor_new ();
+  clutter_actor_set_height (content, 10);
+  clutter_actor_set_x_expand (content, TRUE);
+  clutter_actor_add_child (child, content);
+
+  clutter_actor_show (stage);
+
+  clutter_actor_get_allocation_box (content, &allocation);
+  g_assert_cmpfloat (allocation.x2 - allocation.x1, ==, 100);
+
+  g_signal_connect (content, "allocation-changed",
+                    G_CALLBACK (on_allocation_changed),
+                    &n_changed);
+  g_signal_connect (child, "transition-stopped::allocation",
+                    G_CALLBACK (on_transition_stopped),
+                    &stopped);
+
+  /* the allocation of the child is animated, but its content is only
+   * laid out once the animation is complete
+   */
+  clutter_actor_save_easing_state (child);
+  clutter_actor_set_easing_duration (child, 200);
+
+  clutter_actor_set_width (box, 200);
+
+  while (!stopped)
+    {
+      clutter_stage_ensure_redraw (CLUTTER_STAGE (stage));
+      g_main_context_iteration (NULL, TRUE);
+    }
+
+  clutter_actor_restore_easing_state (child);
+
+  g_assert_cmpuint (n_changed, ==, 1);
+
+  clutter_actor_get_allocation_box (child, &allocation);
+  g_assert_cmpfloat (allocation.x2 - allocation.x1, ==, 200);
+
+  clutter_actor_get_allocation_box (content, &allocation);
+  g_assert_cmpfloat (allocation.x2 - allocation.x1, ==, 200);
+
+  clutter_actor_destroy (box);
+}
+
+static void
+count_queue_relayout (ClutterActor *actor,
+                      gpointer      data)
+{
+  guint *n_queued = data;
+
+  *n_queued += 1;
+}
+
+static void
+actor_relayout_boundary (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *container, *card, *child;
+  guint64 n_boundaries, n_boundaries_after;
+  ClutterActorBox allocation;
+  guint n_queued = 0;
+
+  container = clutter_actor_new ();
+  clutter_actor_set_layout_manager (container, clutter_box_layout_new ());
+  clutter_actor_add_child (stage, container);
+
+  /* the card has a fixed size, but it is not a relayout boundary
+   * unless it is set as one
+   */
+  card = clutter_actor_new ();
+  clutter_actor_set_layout_manager (card, clutter_box_layout_new ());
+  clutter_actor_set_size (card, 200, 100);
+  clutter_actor_add_child (container, card);
+  g_assert_false (clutter_actor_get_relayout_boundary (card));
+
+  child = clutter_actor_new ();
+  clutter_actor_set_size (child, 50, 20);
+  clutter_actor_add_child (card, child);
+
+  clutter_actor_show (stage);
+
+  clutter_actor_get_allocation_box (child, &allocation);
+  g_assert_cmpfloat (allocation.x2 - allocation.x1, ==, 50);
+
+  g_signal_connect (container, "queue-relayout",
+                    G_CALLBACK (count_queue_relayout),
+                    &n_queued);
+
+  /* the relayout reaches the container */
+  clutter_actor_set_width (child, 80);
+  g_assert_cmpuint (n_queued, ==, 1);
+
+  clutter_actor_get_allocation_box (child, &allocation);
+  g_assert_cmpfloat (allocation.x2 - allocation.x1, ==, 80);
+
+  clutter_actor_get_allocation_box (card, &allocation);
+  g_assert_cmpfloat (allocation.x2 - allocation.x1, ==, 200);
+
+  /* the relayout stops at the card once it is a relayout boundary */
+  clutter_actor_set_relayout_boundary (card, TRUE);
+  g_assert_true (clutter_actor_get_relayout_boundary (card));
+
+  clutter_stage_get_invalidation_counters (CLUTTER_STAGE (stage),
+                                           NULL, NULL, &n_boundaries);
+
+  n_queued = 0;
+  clutter_actor_set_width (child, 60);
+  g_assert_cmpuint (n_queued, ==, 0);
+
+  clutter_actor_get_allocation_box (child, &allocation);
+  g_assert_cmpfloat (allocation.x2 - allocation.x1, ==, 60);
+
+  clutter_actor_get_allocation_box (card, &allocation);
+  g_assert_cmpfloat (allocation.x2 - allocation.x1, ==, 200);
+
+  /* only the children of the card were allocated again */
+  clutter_stage_get_invalidation_counters (CLUTTER_STAGE (stage),
+                                           NULL, NULL, &n_boundaries_after);
+  g_assert_cmpuint (n_boundaries_after, ==, n_boundaries + 1);
+
+  /* without a fixed size, the card is allocated with the size of its
+   * children by the container, and still stops the relayouts
+   */
+  clutter_actor_set_size (card, -1, -1);
+  clutter_actor_get_allocation_box (card, &allocation);
+  g_assert_cmpfloat (allocation.x2 - allocation.x1, ==, 60);
+
+  n_queued = 0;
+  clutter_actor_set_width (child, 40);
+  g_assert_cmpuint (n_queued, ==, 0);
+
+  clutter_actor_get_allocation_box (child, &allocation);
+  g_assert_cmpfloat (allocation.x2 - allocation.x1, ==, 40);
+
+  clutter_actor_destroy (container);
+}
+
+static void
+actor_constraint_cycle_layout (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterConstraint *constraint;
+  guint64 n_updates, n_cycles;
+  guint64 old_updates, old_cycles;
+  ClutterActor *actors[2];
+  ClutterActorBox box;
+  int i;
+
+  for (i = 0; i < 2; i++)
+    {
+      actors[i] = clutter_actor_new ();
+      clutter_actor_set_size (actors[i], 50, 50);
+      clutter_actor_add_child (stage, actors[i]);
+    }
+
+  clutter_stage_get_relayout_counters (CLUTTER_STAGE (stage), NULL,
+                                       &old_updates, &old_cycles);
+
+  /* the actors are bound to each other */
+  constraint = clutter_bind_constraint_new (actors[1], CLUTTER_BIND_X, 60);
+  clutter_actor_add_constraint (actors[0], constraint);
+  clutter_actor_add_constraint (actors[1], clutter_bind_constraint_new (actors[0], CLUTTER_BIND_X, 60));
+
+  g_test_expect_message ("Clutter", G_LOG_LEVEL_WARNING, "*cycle*");
+  clutter_actor_get_allocation_box (actors[0], &box);
+  g_test_assert_expected_messages ();
+
+  /* the constraints are applied again a bounded number of times */
+  clutter_stage_get_relayout_counters (CLUTTER_STAGE (stage), NULL,
+                                       &n_updates, &n_cycles);
+  g_assert_cmpuint (n_cycles, ==, old_cycles + 1);
+  g_assert_cmpuint (n_updates, >, old_updates);
+  g_assert_cmpuint (n_updates, <=, old_updates + 8);
+
+  /* the same cycle is only reported once; the cycle is detected
+   * between the actors allocated by the relayout
+   */
+  clutter_actor_queue_relayout (actors[0]);
+  clutter_actor_queue_relayout (actors[1]);
+  clutter_actor_get_allocation_box (actors[0], &box);
+
+  clutter_stage_get_relayout_counters (CLUTTER_STAGE (stage), NULL,
+                                       NULL, &n_cycles);
+  g_assert_cmpuint (n_cycles, ==, old_cycles + 2);
+
+  /* a cycle formed by a new constraint is reported again */
+  clutter_actor_remove_constraint (actors[0], constraint);
+  clutter_actor_add_constraint (actors[0], clutter_bind_constraint_new (actors[1], CLUTTER_BIND_Y, 0));
+  clutter_actor_queue_relayout (actors[1]);
+
+  g_test_expect_message ("Clutter", G_LOG_LEVEL_WARNING, "*cycle*");
+  clutter_actor_get_allocation_box (actors[0], &box);
+  g_test_assert_expected_messages ();
+
+  for (i = 0; i < 2; i++)
+    clutter_actor_destroy (actors[i]);
+}
+
 CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/actor/layout/basic", actor_basic_layout)
   CLUTTER_TEST_UNIT ("/actor/layout/margin", actor_margin_layout)
+  CLUTTER_TEST_UNIT ("/actor/layout/flow-reflow", actor_flow_reflow_layout)
+  CLUTTER_TEST_UNIT ("/actor/layout/grid-relayout", actor_grid_relayout)
+  CLUTTER_TEST_UNIT ("/actor/layout/constraint-chain", actor_constraint_chain_layout)
+  CLUTTER_TEST_UNIT ("/actor/layout/constraint-cycle", actor_constraint_cycle_layout)
+  CLUTTER_TEST_UNIT ("/actor/layout/box-distribute", actor_box_distribute_layout)
+  CLUTTER_TEST_UNIT ("/actor/layout/child-properties", actor_child_properties_layout)
+  CLUTTER_TEST_UNIT ("/actor/layout/layout-only-animation", actor_layout_only_animation)
+  CLUTTER_TEST_UNIT ("/actor/layout/relayout-boundary", actor_relayout_boundary)
 )
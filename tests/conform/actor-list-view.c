@@ -0,0 +1,327 @@
+#include <clutter/clutter.h>
+
+#define N_ROWS          100000
+#define ROW_HEIGHT      20.f
+#define VIEW_SIZE       100.f
+
+static ClutterActor *
+create_row (ClutterListView *view,
+            gpointer         data)
+{
+  guint *n_created = data;
+
+  *n_created += 1;
+
+  return clutter_actor_new ();
+}
+
+static void
+bind_row (ClutterListView *view,
+          ClutterActor    *row_actor,
+          guint            row,
+          gpointer         data)
+{
+  gfloat height = ROW_HEIGHT;
+
+  /* odd rows are taller than the estimate in the variable test */
+  if (clutter_list_view_get_estimated_row_height (view) != ROW_HEIGHT)
+    height = row % 2 == 0 ? 10.f : 30.f;
+
+  clutter_actor_set_height (row_actor, height);
+  g_object_set_data (G_OBJECT (row_actor), "row", GUINT_TO_POINTER (row));
+}
+
+static gboolean
+count_frame (gpointer data)
+{
+  guint *n_frames = data;
+
+  *n_frames += 1;
+
+  return TRUE;
+}
+
+static void
+wait_frames (ClutterActor *stage,
+             guint         n_frames)
+{
+  guint frames = 0;
+  guint id;
+
+  id = clutter_threads_add_repaint_func_full (CLUTTER_REPAINT_FLAGS_POST_PAINT,
+                                              count_frame,
+                                              &frames,
+                                              NULL);
+
+  while (frames < n_frames)
+    {
+      clutter_stage_ensure_redraw (CLUTTER_STAGE (stage));
+      g_main_context_iteration (NULL, TRUE);
+    }
+
+  clutter_threads_remove_repaint_func (id);
+}
+
+static ClutterActor *
+create_list_view (ClutterActor *stage,
+                  guint        *n_created)
+{
+  ClutterActor *scroll, *view;
+
+  scroll = clutter_scroll_actor_new ();
+  clutter_scroll_actor_set_scroll_mode (CLUTTER_SCROLL_ACTOR (scroll),
+                                        CLUTTER_SCROLL_VERTICALLY);
+  clutter_actor_set_size (scroll, VIEW_SIZE, VIEW_SIZE);
+  clutter_actor_set_clip_to_allocation (scroll, TRUE);
+  clutter_actor_add_child (stage, scroll);
+
+  view = clutter_list_view_new ();
+  clutter_actor_set_width (view, VIEW_SIZE);
+  clutter_list_view_set_overscan (CLUTTER_LIST_VIEW (view), 0.f);
+  clutter_list_view_set_row_factory (CLUTTER_LIST_VIEW (view),
+                                     create_row,
+                                     bind_row,
+                                     n_created,
+                                     NULL);
+  clutter_list_view_set_n_rows (CLUTTER_LIST_VIEW (view), N_ROWS);
+  clutter_actor_add_child (scroll, view);
+
+  clutter_actor_show (stage);
+
+  return view;
+}
+
+static guint
+get_row_at_point (ClutterActor *stage,
+                  gfloat        x,
+                  gfloat        y)
+{
+  ClutterActor *actor;
+
+  actor = clutter_stage_get_actor_at_pos (CLUTTER_STAGE (stage),
+                                          CLUTTER_PICK_REACTIVE,
+                                          x, y);
+
+  return GPOINTER_TO_UINT (g_object_get_data (G_OBJECT (actor), "row"));
+}
+
+static void
+actor_list_view_recycle (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *view, *scroll;
+  ClutterPoint point;
+  guint n_created = 0;
+  guint n_rows_visible;
+  gfloat y;
+
+  view = create_list_view (stage, &n_created);
+  scroll = clutter_actor_get_parent (view);
+
+  clutter_list_view_set_estimated_row_height (CLUTTER_LIST_VIEW (view), ROW_HEIGHT);
+
+  wait_frames (stage, 2);
+
+  n_rows_visible = (guint) (VIEW_SIZE / ROW_HEIGHT) + 1;
+
+  g_assert_cmpfloat (clutter_actor_get_height (view), ==, N_ROWS * ROW_HEIGHT);
+  g_assert_cmpuint (clutter_actor_get_n_children (view), <=, n_rows_visible);
+  g_assert_nonnull (clutter_list_view_get_row_actor (CLUTTER_LIST_VIEW (view), 0));
+  g_assert_null (clutter_list_view_get_row_actor (CLUTTER_LIST_VIEW (view), n_rows_visible + 1));
+
+  /* scrolling reuses the actors of the rows scrolled out */
+  for (y = 0; y < 2000.f; y += 7.f)
+    {
+      clutter_point_init (&point, 0.f, y);
+      clutter_scroll_actor_scroll_to_point (CLUTTER_SCROLL_ACTOR (scroll), &point);
+      wait_frames (stage, 1);
+    }
+
+  clutter_point_init (&point, 0.f, 2000.f);
+  clutter_scroll_actor_scroll_to_point (CLUTTER_SCROLL_ACTOR (scroll), &point);
+  wait_frames (stage, 1);
+
+  g_assert_cmpuint (n_created, <=, n_rows_visible + 1);
+  g_assert_cmpuint (clutter_actor_get_n_children (view), <=, 2 * n_rows_visible);
+  g_assert_null (clutter_list_view_get_row_actor (CLUTTER_LIST_VIEW (view), 0));
+  g_assert_nonnull (clutter_list_view_get_row_actor (CLUTTER_LIST_VIEW (view), 100));
+
+  clutter_actor_set_reactive (clutter_list_view_get_row_actor (CLUTTER_LIST_VIEW (view), 100), TRUE);
+  g_assert_cmpuint (get_row_at_point (stage, 10.f, 10.f), ==, 100);
+
+  clutter_actor_destroy (scroll);
+}
+
+static void
+actor_list_view_variable_height (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *view;
+  guint n_created = 0;
+  gfloat y, height;
+
+  view = create_list_view (stage, &n_created);
+
+  /* the rows are 10 and 30 pixels tall, and 20 on average */
+  clutter_list_view_set_estimated_row_height (CLUTTER_LIST_VIEW (view), 21.f);
+
+  wait_frames (stage, 4);
+
+  g_assert_true (clutter_list_view_get_row_area (CLUTTER_LIST_VIEW (view), 1, &y, &height));
+  g_assert_cmpfloat (y, ==, 10.f);
+  g_assert_cmpfloat (height, ==, 30.f);
+
+  g_assert_true (clutter_list_view_get_row_area (CLUTTER_LIST_VIEW (view), 3, &y, &height));
+  g_assert_cmpfloat (y, ==, 50.f);
+
+  /* the rows that were not displayed use the estimate */
+  g_assert_true (clutter_list_view_get_row_area (CLUTTER_LIST_VIEW (view), 1000, NULL, &height));
+  g_assert_cmpfloat (height, ==, 21.f);
+
+  g_assert_false (clutter_list_view_get_row_area (CLUTTER_LIST_VIEW (view), N_ROWS, NULL, NULL));
+
+  /* the measured heights are forgotten once the rows are invalidated */
+  clutter_list_view_invalidate_rows (CLUTTER_LIST_VIEW (view), 0, 2);
+  clutter_list_view_set_n_rows (CLUTTER_LIST_VIEW (view), 2);
+
+  g_assert_true (clutter_list_view_get_row_area (CLUTTER_LIST_VIEW (view), 1, &y, &height));
+  g_assert_cmpfloat (y, ==, 21.f);
+
+  wait_frames (stage, 2);
+
+  g_assert_cmpfloat (clutter_actor_get_height (view), ==, 40.f);
+
+  clutter_actor_destroy (clutter_actor_get_parent (view));
+}
+
+static void
+actor_list_view_shrink (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterActor *view, *scroll;
+  ClutterActorBox box;
+  ClutterPoint point;
+  guint n_created = 0;
+
+  view = create_list_view (stage, &n_created);
+  scroll = clutter_actor_get_parent (view);
+
+  clutter_list_view_set_estimated_row_height (CLUTTER_LIST_VIEW (view), ROW_HEIGHT);
+
+  clutter_point_init (&point, 0.f, 2000.f);
+  clutter_scroll_actor_scroll_to_point (CLUTTER_SCROLL_ACTOR (scroll), &point);
+  wait_frames (stage, 2);
+
+  g_assert_nonnull (clutter_list_view_get_row_actor (CLUTTER_LIST_VIEW (view), 100));
+
+  /* the realized rows are past the end once the view shrinks, and the
+   * allocation must not reach them before the rows are updated
+   */
+  clutter_list_view_set_n_rows (CLUTTER_LIST_VIEW (view), 2);
+  clutter_actor_get_allocation_box (view, &box);
+
+  g_assert_cmpfloat (clutter_actor_box_get_height (&box), ==, 2 * ROW_HEIGHT);
+  g_assert_null (clutter_list_view_get_row_actor (CLUTTER_LIST_VIEW (view), 100));
+
+  /* the rows that are still in range keep their actors */
+  clutter_point_init (&point, 0.f, 0.f);
+  clutter_scroll_actor_scroll_to_point (CLUTTER_SCROLL_ACTOR (scroll), &point);
+  wait_frames (stage, 2);
+
+  g_assert_nonnull (clutter_list_view_get_row_actor (CLUTTER_LIST_VIEW (view), 1));
+  g_assert_null (clutter_list_view_get_row_actor (CLUTTER_LIST_VIEW (view), 2));
+
+  clutter_list_view_set_n_rows (CLUTTER_LIST_VIEW (view), 1);
+  clutter_actor_get_allocation_box (view, &box);
+
+  g_assert_cmpfloat (clutter_actor_box_get_height (&box), ==, ROW_HEIGHT);
+  g_assert_nonnull (clutter_list_view_get_row_actor (CLUTTER_LIST_VIEW (view), 0));
+  g_assert_null (clutter_list_view_get_row_actor (CLUTTER_LIST_VIEW (view), 1));
+
+  clutter_actor_destroy (scroll);
+}
+
+static void
+actor_list_layout_allocate (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ClutterLayoutManager *manager;
+  ClutterListLayout *layout;
+  ClutterActor *container, *children[3];
+  ClutterActorBox box;
+  gfloat y, height;
+  guint i;
+
+  manager = clutter_list_layout_new ();
+  layout = CLUTTER_LIST_LAYOUT (manager);
+  clutter_list_layout_set_n_rows (layout, N_ROWS);
+  clutter_list_layout_set_estimated_row_height (layout, ROW_HEIGHT);
+  clutter_list_layout_set_first_row (layout, 5000);
+
+  container = clutter_actor_new ();
+  clutter_actor_set_layout_manager (container, manager);
+  clutter_actor_set_width (container, VIEW_SIZE);
+  clutter_actor_add_child (stage, container);
+
+  /* the children are 10, 30 and 50 pixels tall */
+  for (i = 0; i < G_N_ELEMENTS (children); i++)
+    {
+      children[i] = clutter_actor_new ();
+      clutter_actor_set_height (children[i], 10.f + i * 20.f);
+      clutter_actor_add_child (container, children[i]);
+    }
+
+  clutter_actor_show (stage);
+
+  /* the children are stacked from the first row, as wide as the container */
+  clutter_actor_get_allocation_box (children[0], &box);
+  g_assert_cmpfloat (box.y1, ==, 5000 * ROW_HEIGHT);
+  g_assert_cmpfloat (box.y2, ==, 5000 * ROW_HEIGHT + 10.f);
+  g_assert_cmpfloat (clutter_actor_box_get_width (&box), ==, VIEW_SIZE);
+
+  clutter_actor_get_allocation_box (children[2], &box);
+  g_assert_cmpfloat (box.y1, ==, 5000 * ROW_HEIGHT + 40.f);
+  g_assert_cmpfloat (box.y2, ==, 5000 * ROW_HEIGHT + 90.f);
+
+  /* the measured heights move the rows below them */
+  g_assert_true (clutter_list_layout_get_row_area (layout, 5003, &y, &height));
+  g_assert_cmpfloat (y, ==, 5000 * ROW_HEIGHT + 90.f);
+  g_assert_cmpfloat (height, ==, ROW_HEIGHT);
+
+  g_assert_cmpfloat (clutter_list_layout_get_total_height (layout), ==,
+                     N_ROWS * ROW_HEIGHT + 30.f);
+
+  /* the rows at an offset, within and around the measured rows */
+  g_assert_cmpuint (clutter_list_layout_get_row_at_offset (layout, -5.f), ==, 0);
+  g_assert_cmpuint (clutter_list_layout_get_row_at_offset (layout, 10 * ROW_HEIGHT + 5.f), ==, 10);
+  g_assert_cmpuint (clutter_list_layout_get_row_at_offset (layout, 5000 * ROW_HEIGHT + 15.f), ==, 5001);
+  g_assert_cmpuint (clutter_list_layout_get_row_at_offset (layout, 5000 * ROW_HEIGHT + 89.f), ==, 5002);
+  g_assert_cmpuint (clutter_list_layout_get_row_at_offset (layout, 5000 * ROW_HEIGHT + 90.f), ==, 5003);
+  g_assert_cmpuint (clutter_list_layout_get_row_at_offset (layout, 6000 * ROW_HEIGHT + 29.f), ==, 5999);
+  g_assert_cmpuint (clutter_list_layout_get_row_at_offset (layout, 6000 * ROW_HEIGHT + 30.f), ==, 6000);
+  g_assert_cmpuint (clutter_list_layout_get_row_at_offset (layout, N_ROWS * ROW_HEIGHT * 2), ==, N_ROWS - 1);
+
+  /* the hidden children do not display a row */
+  clutter_actor_hide (children[1]);
+
+  clutter_actor_get_allocation_box (children[2], &box);
+  g_assert_cmpfloat (box.y1, ==, 5000 * ROW_HEIGHT + 10.f);
+
+  g_assert_true (clutter_list_layout_get_row_area (layout, 5001, NULL, &height));
+  g_assert_cmpfloat (height, ==, 50.f);
+
+  /* the invalidated rows go back to the estimate */
+  clutter_list_layout_invalidate_rows (layout, 5000, 3);
+  g_assert_true (clutter_list_layout_get_row_area (layout, 5003, &y, NULL));
+  g_assert_cmpfloat (y, ==, 5003 * ROW_HEIGHT);
+  g_assert_cmpfloat (clutter_list_layout_get_total_height (layout), ==, N_ROWS * ROW_HEIGHT);
+
+  clutter_actor_destroy (container);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/actor/list-view/recycle", actor_list_view_recycle)
+  CLUTTER_TEST_UNIT ("/actor/list-view/variable-height", actor_list_view_variable_height)
+  CLUTTER_TEST_UNIT ("/actor/list-view/shrink", actor_list_view_shrink)
+  CLUTTER_TEST_UNIT ("/actor/list-layout/allocate", actor_list_layout_allocate)
+)
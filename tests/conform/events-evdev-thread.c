@@ -0,0 +1,178 @@
+#define CLUTTER_ENABLE_COMPOSITOR_API
+#include <clutter/clutter.h>
+#include <clutter/evdev/clutter-evdev.h>
+
+/* the tests in this file use the evdev input backend with its input
+ * thread, on top of the headless backend so that they do not need a
+ * display; the pointer warps are queued by the evdev backend like the
+ * events coming from libinput
+ */
+
+#define TIMEOUT_SECONDS 5
+
+/* less than the size of the event ring, which is not drained while
+ * the warps are queued
+ */
+#define N_WARPS         200
+
+typedef struct {
+  ClutterActor *stage;
+
+  GArray *coords;
+  gboolean timed_out;
+} ThreadData;
+
+static gboolean
+stage_motion_cb (ClutterActor *stage,
+                 ClutterEvent *event,
+                 ThreadData   *data)
+{
+  ClutterPoint point;
+
+  clutter_event_get_coords (event, &point.x, &point.y);
+  g_array_append_val (data->coords, point);
+
+  return CLUTTER_EVENT_STOP;
+}
+
+static gboolean
+timeout_cb (gpointer user_data)
+{
+  ThreadData *data = user_data;
+
+  data->timed_out = TRUE;
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+thread_data_init (ThreadData *data)
+{
+  ClutterActorBox box;
+
+  data->stage = clutter_test_get_stage ();
+  data->coords = g_array_new (FALSE, FALSE, sizeof (ClutterPoint));
+  data->timed_out = FALSE;
+
+  g_signal_connect (data->stage, "motion-event",
+                    G_CALLBACK (stage_motion_cb), data);
+  clutter_stage_set_throttle_motion_events (CLUTTER_STAGE (data->stage), FALSE);
+  clutter_actor_show (data->stage);
+
+  /* the input thread clamps the pointer to the allocation of the stage */
+  clutter_actor_get_allocation_box (data->stage, &box);
+  g_assert_cmpfloat (clutter_actor_box_get_width (&box), >, N_WARPS);
+}
+
+static void
+thread_data_clear (ThreadData *data)
+{
+  g_signal_handlers_disconnect_by_func (data->stage, stage_motion_cb, data);
+  clutter_stage_set_throttle_motion_events (CLUTTER_STAGE (data->stage), TRUE);
+  g_array_free (data->coords, TRUE);
+}
+
+static void
+queue_warps (ThreadData *data,
+             guint       n_warps)
+{
+  ClutterDeviceManager *manager = clutter_device_manager_get_default ();
+  ClutterInputDevice *pointer;
+  guint i;
+
+  pointer = clutter_device_manager_get_core_device (manager,
+                                                    CLUTTER_POINTER_DEVICE);
+
+  g_array_set_size (data->coords, 0);
+
+  for (i = 0; i < n_warps; i++)
+    clutter_evdev_warp_pointer (pointer, i, i, i / 2);
+}
+
+static void
+wait_warps (ThreadData *data,
+            guint       n_warps)
+{
+  guint i, id;
+
+  id = g_timeout_add_seconds (TIMEOUT_SECONDS, timeout_cb, data);
+
+  while (data->coords->len < n_warps && !data->timed_out)
+    g_main_context_iteration (NULL, TRUE);
+
+  if (!data->timed_out)
+    g_source_remove (id);
+
+  g_assert_false (data->timed_out);
+  g_assert_cmpuint (data->coords->len, ==, n_warps);
+
+  /* the events are delivered once each, in the order they were queued */
+  for (i = 0; i < n_warps; i++)
+    {
+      const ClutterPoint *point = &g_array_index (data->coords, ClutterPoint, i);
+
+      g_assert_cmpfloat (point->x, ==, i);
+      g_assert_cmpfloat (point->y, ==, i / 2);
+    }
+}
+
+static void
+events_evdev_thread_warp (void)
+{
+  ThreadData data = { NULL, };
+
+  thread_data_init (&data);
+
+  /* the warps go through the event ring shared with the input thread */
+  queue_warps (&data, N_WARPS);
+  wait_warps (&data, N_WARPS);
+
+  thread_data_clear (&data);
+}
+
+static void
+events_evdev_thread_release (void)
+{
+  ThreadData data = { NULL, };
+  guint i;
+
+  thread_data_init (&data);
+
+  /* releasing and reclaiming the devices synchronizes with the input
+   * thread; this must neither deadlock nor lose the queued events
+   */
+  for (i = 0; i < 3; i++)
+    {
+      clutter_evdev_release_devices ();
+      clutter_evdev_reclaim_devices ();
+    }
+
+  queue_warps (&data, N_WARPS);
+  wait_warps (&data, N_WARPS);
+
+  /* the events still in the ring survive the synchronization */
+  queue_warps (&data, N_WARPS);
+
+  clutter_evdev_release_devices ();
+  clutter_evdev_reclaim_devices ();
+
+  wait_warps (&data, N_WARPS);
+
+  thread_data_clear (&data);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  g_setenv ("CLUTTER_INPUT_BACKEND", CLUTTER_INPUT_EVDEV, TRUE);
+  clutter_set_windowing_backend (CLUTTER_WINDOWING_HEADLESS);
+  clutter_evdev_set_input_thread_enabled (TRUE);
+
+  clutter_test_init (&argc, &argv);
+
+  clutter_test_add ("/events/evdev/thread/warp", events_evdev_thread_warp);
+  clutter_test_add ("/events/evdev/thread/release", events_evdev_thread_release);
+
+  return clutter_test_run ();
+}
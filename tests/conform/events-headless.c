@@ -0,0 +1,223 @@
+#include <unistd.h>
+#include <glib/gstdio.h>
+#include <clutter/clutter.h>
+
+/* the tests in this file need the headless backend, which is selected
+ * before initializing the test suite
+ */
+
+#define TIMEOUT_SECONDS 5
+
+typedef struct {
+  ClutterActor *stage;
+
+  GString *received;
+  guint n_received;
+  gboolean timed_out;
+  gboolean finished;
+} HeadlessData;
+
+static gboolean
+stage_event_cb (ClutterActor *stage,
+                ClutterEvent *event,
+                HeadlessData *data)
+{
+  gfloat x, y;
+
+  switch (clutter_event_type (event))
+    {
+    case CLUTTER_KEY_PRESS:
+      g_string_append_printf (data->received, "key:%u ",
+                              clutter_event_get_key_symbol (event));
+      break;
+
+    case CLUTTER_MOTION:
+    case CLUTTER_BUTTON_PRESS:
+    case CLUTTER_BUTTON_RELEASE:
+      clutter_event_get_coords (event, &x, &y);
+      g_string_append_printf (data->received, "%d:%.0f,%.0f ",
+                              clutter_event_type (event),
+                              x, y);
+      break;
+
+    default:
+      return CLUTTER_EVENT_PROPAGATE;
+    }
+
+  data->n_received += 1;
+
+  return CLUTTER_EVENT_PROPAGATE;
+}
+
+static gboolean
+timeout_cb (gpointer user_data)
+{
+  HeadlessData *data = user_data;
+
+  data->timed_out = TRUE;
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+wait_events (HeadlessData *data,
+             guint         n_events)
+{
+  guint id;
+
+  data->timed_out = FALSE;
+
+  id = g_timeout_add_seconds (TIMEOUT_SECONDS, timeout_cb, data);
+
+  while (data->n_received < n_events && !data->timed_out)
+    g_main_context_iteration (NULL, TRUE);
+
+  if (!data->timed_out)
+    g_source_remove (id);
+
+  g_assert_false (data->timed_out);
+}
+
+static void
+headless_data_init (HeadlessData *data)
+{
+  data->stage = clutter_test_get_stage ();
+  data->received = g_string_new (NULL);
+  data->n_received = 0;
+
+  g_signal_connect (data->stage, "event", G_CALLBACK (stage_event_cb), data);
+  clutter_actor_show (data->stage);
+}
+
+static void
+headless_data_clear (HeadlessData *data)
+{
+  g_signal_handlers_disconnect_by_func (data->stage, stage_event_cb, data);
+  g_string_free (data->received, TRUE);
+}
+
+static void
+events_headless_put (void)
+{
+  HeadlessData data = { NULL, };
+  gchar *expected;
+
+  g_assert_true (clutter_check_windowing_backend (CLUTTER_WINDOWING_HEADLESS));
+
+  headless_data_init (&data);
+
+  /* the events put in the queue are dispatched without any windowing
+   * system event source
+   */
+  clutter_test_put_key_event (data.stage, CLUTTER_KEY_a);
+  clutter_test_put_pointer_event (data.stage, NULL, CLUTTER_MOTION,
+                                  CLUTTER_CURRENT_TIME, 10, 20);
+  clutter_test_put_pointer_event (data.stage, NULL, CLUTTER_BUTTON_PRESS,
+                                  CLUTTER_CURRENT_TIME, 30, 40);
+
+  wait_events (&data, 3);
+
+  g_assert_cmpuint (data.n_received, ==, 3);
+  g_assert_false (clutter_events_pending ());
+
+  expected = g_strdup_printf ("key:%u %d:10,20 %d:30,40 ",
+                              CLUTTER_KEY_a,
+                              CLUTTER_MOTION,
+                              CLUTTER_BUTTON_PRESS);
+  g_assert_cmpstr (data.received->str, ==, expected);
+
+  g_free (expected);
+  headless_data_clear (&data);
+}
+
+static void
+player_finished_cb (ClutterEventPlayer *player,
+                    HeadlessData       *data)
+{
+  data->finished = TRUE;
+}
+
+static void
+events_headless_replay (void)
+{
+  HeadlessData data = { NULL, };
+  ClutterEventRecorder *recorder;
+  ClutterEventPlayer *player;
+  GError *error = NULL;
+  gchar *filename, *recorded;
+  guint id;
+  gint fd;
+
+  g_assert_true (clutter_check_windowing_backend (CLUTTER_WINDOWING_HEADLESS));
+
+  fd = g_file_open_tmp ("clutter-events-XXXXXX", &filename, &error);
+  g_assert_no_error (error);
+  close (fd);
+
+  headless_data_init (&data);
+
+  recorder = clutter_event_recorder_new ();
+  clutter_event_recorder_start (recorder, filename, &error);
+  g_assert_no_error (error);
+
+  clutter_test_put_key_event (data.stage, CLUTTER_KEY_b);
+  clutter_test_put_pointer_event (data.stage, NULL, CLUTTER_MOTION,
+                                  CLUTTER_CURRENT_TIME, 10, 20);
+  clutter_test_put_pointer_event (data.stage, NULL, CLUTTER_BUTTON_PRESS,
+                                  CLUTTER_CURRENT_TIME, 30, 40);
+  clutter_test_put_pointer_event (data.stage, NULL, CLUTTER_BUTTON_RELEASE,
+                                  CLUTTER_CURRENT_TIME, 50, 60);
+
+  wait_events (&data, 4);
+
+  clutter_event_recorder_stop (recorder, &error);
+  g_assert_no_error (error);
+  g_assert_cmpuint (clutter_event_recorder_get_n_events (recorder), ==, 4);
+
+  recorded = g_strdup (data.received->str);
+  g_string_truncate (data.received, 0);
+  data.n_received = 0;
+
+  /* the player injects the events through clutter_event_put(), so they
+   * go through the same queue as the ones put by the test
+   */
+  player = clutter_event_player_new ();
+  clutter_event_player_load (player, filename, &error);
+  g_assert_no_error (error);
+
+  g_signal_connect (player, "finished", G_CALLBACK (player_finished_cb), &data);
+  clutter_event_player_play (player, CLUTTER_STAGE (data.stage), 0);
+
+  id = g_timeout_add_seconds (TIMEOUT_SECONDS, timeout_cb, &data);
+
+  while (!data.finished && !data.timed_out)
+    g_main_context_iteration (NULL, TRUE);
+
+  if (!data.timed_out)
+    g_source_remove (id);
+
+  g_assert_false (data.timed_out);
+  g_assert_cmpuint (data.n_received, ==, 4);
+  g_assert_cmpstr (data.received->str, ==, recorded);
+
+  g_object_unref (player);
+  g_object_unref (recorder);
+  g_free (recorded);
+  g_unlink (filename);
+  g_free (filename);
+  headless_data_clear (&data);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  clutter_set_windowing_backend (CLUTTER_WINDOWING_HEADLESS);
+
+  clutter_test_init (&argc, &argv);
+
+  clutter_test_add ("/events/headless/put", events_headless_put);
+  clutter_test_add ("/events/headless/replay", events_headless_replay);
+
+  return clutter_test_run ();
+}
@@ -0,0 +1,177 @@
+#include <clutter/clutter.h>
+
+#define N_MOTIONS       5
+#define MOTION_TIME     100
+#define MOTION_INTERVAL 3
+
+/* the number of samples kept by the events */
+#define HISTORY_SIZE    32
+
+typedef struct {
+  guint n_motions;
+
+  guint32 time;
+  gfloat x, y;
+
+  GArray *history_times;
+  GArray *history_coords;
+} HistoryData;
+
+static gboolean
+stage_motion_cb (ClutterActor *stage,
+                 ClutterEvent *event,
+                 HistoryData  *data)
+{
+  guint i, n_history;
+
+  data->n_motions += 1;
+
+  data->time = clutter_event_get_time (event);
+  clutter_event_get_coords (event, &data->x, &data->y);
+
+  g_array_set_size (data->history_times, 0);
+  g_array_set_size (data->history_coords, 0);
+
+  n_history = clutter_event_get_history_size (event);
+  for (i = 0; i < n_history; i++)
+    {
+      guint32 time_ = clutter_event_get_history_time (event, i);
+      ClutterPoint point;
+
+      clutter_event_get_history_coords (event, i, &point.x, &point.y);
+
+      g_array_append_val (data->history_times, time_);
+      g_array_append_val (data->history_coords, point);
+    }
+
+  return CLUTTER_EVENT_STOP;
+}
+
+static void
+put_motions (ClutterActor *stage,
+             guint         n_motions)
+{
+  guint i;
+
+  for (i = 0; i < n_motions; i++)
+    clutter_test_put_pointer_event (stage, stage, CLUTTER_MOTION,
+                                    MOTION_TIME + i * MOTION_INTERVAL,
+                                    10.f * i, 20.f * i);
+
+  /* the stage only processes the events on the next frame */
+  clutter_test_run_frames (1);
+}
+
+static void
+history_data_init (HistoryData  *data,
+                   ClutterActor *stage)
+{
+  data->n_motions = 0;
+  data->history_times = g_array_new (FALSE, FALSE, sizeof (guint32));
+  data->history_coords = g_array_new (FALSE, FALSE, sizeof (ClutterPoint));
+
+  g_signal_connect (stage, "motion-event", G_CALLBACK (stage_motion_cb), data);
+  clutter_actor_show (stage);
+}
+
+static void
+history_data_clear (HistoryData  *data,
+                    ClutterActor *stage)
+{
+  g_signal_handlers_disconnect_by_func (stage, stage_motion_cb, data);
+
+  g_array_free (data->history_times, TRUE);
+  g_array_free (data->history_coords, TRUE);
+}
+
+static void
+events_history_compressed (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  HistoryData data = { 0, };
+  guint i;
+
+  history_data_init (&data, stage);
+  clutter_stage_set_throttle_motion_events (CLUTTER_STAGE (stage), TRUE);
+
+  put_motions (stage, N_MOTIONS);
+
+  /* a single event is delivered, with the last position */
+  g_assert_cmpuint (data.n_motions, ==, 1);
+  g_assert_cmpuint (data.time, ==, MOTION_TIME + (N_MOTIONS - 1) * MOTION_INTERVAL);
+  g_assert_cmpfloat (data.x, ==, 10.f * (N_MOTIONS - 1));
+  g_assert_cmpfloat (data.y, ==, 20.f * (N_MOTIONS - 1));
+
+  /* and the samples of the other ones, from the oldest to the newest */
+  g_assert_cmpuint (data.history_times->len, ==, N_MOTIONS - 1);
+
+  for (i = 0; i < N_MOTIONS - 1; i++)
+    {
+      const ClutterPoint *point = &g_array_index (data.history_coords, ClutterPoint, i);
+
+      g_assert_cmpuint (g_array_index (data.history_times, guint32, i), ==,
+                        MOTION_TIME + i * MOTION_INTERVAL);
+      g_assert_cmpfloat (point->x, ==, 10.f * i);
+      g_assert_cmpfloat (point->y, ==, 20.f * i);
+    }
+
+  history_data_clear (&data, stage);
+}
+
+static void
+events_history_overflow (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  HistoryData data = { 0, };
+  guint n_motions = HISTORY_SIZE + 8;
+  guint i, first;
+
+  history_data_init (&data, stage);
+  clutter_stage_set_throttle_motion_events (CLUTTER_STAGE (stage), TRUE);
+
+  put_motions (stage, n_motions);
+
+  /* only the most recent samples are kept */
+  g_assert_cmpuint (data.n_motions, ==, 1);
+  g_assert_cmpuint (data.history_times->len, ==, HISTORY_SIZE);
+
+  first = n_motions - 1 - HISTORY_SIZE;
+  for (i = 0; i < HISTORY_SIZE; i++)
+    {
+      const ClutterPoint *point = &g_array_index (data.history_coords, ClutterPoint, i);
+
+      g_assert_cmpuint (g_array_index (data.history_times, guint32, i), ==,
+                        MOTION_TIME + (first + i) * MOTION_INTERVAL);
+      g_assert_cmpfloat (point->x, ==, 10.f * (first + i));
+    }
+
+  history_data_clear (&data, stage);
+}
+
+static void
+events_history_unthrottled (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  HistoryData data = { 0, };
+
+  history_data_init (&data, stage);
+  clutter_stage_set_throttle_motion_events (CLUTTER_STAGE (stage), FALSE);
+
+  put_motions (stage, N_MOTIONS);
+
+  /* every event is delivered, without any history */
+  g_assert_cmpuint (data.n_motions, ==, N_MOTIONS);
+  g_assert_cmpuint (data.time, ==, MOTION_TIME + (N_MOTIONS - 1) * MOTION_INTERVAL);
+  g_assert_cmpuint (data.history_times->len, ==, 0);
+
+  clutter_stage_set_throttle_motion_events (CLUTTER_STAGE (stage), TRUE);
+
+  history_data_clear (&data, stage);
+}
+
+/* the events are only compressed if they are queued in the same frame */
+CLUTTER_TEST_SUITE_MANUAL_CLOCK (
+  CLUTTER_TEST_UNIT ("/events/history/compressed", events_history_compressed)
+  CLUTTER_TEST_UNIT ("/events/history/overflow", events_history_overflow)
+  CLUTTER_TEST_UNIT ("/events/history/unthrottled", events_history_unthrottled)
+)
@@ -0,0 +1,166 @@
+#include <unistd.h>
+#include <glib/gstdio.h>
+#include <clutter/clutter.h>
+
+#define N_EVENTS        4
+
+typedef struct {
+  ClutterActor *stage;
+
+  GString *received;
+  guint n_received;
+  gboolean finished;
+} ReplayData;
+
+static gboolean
+stage_event_cb (ClutterActor *stage,
+                ClutterEvent *event,
+                ReplayData   *data)
+{
+  gfloat x, y;
+
+  switch (clutter_event_type (event))
+    {
+    case CLUTTER_KEY_PRESS:
+      g_string_append_printf (data->received, "key:%u ",
+                              clutter_event_get_key_symbol (event));
+      break;
+
+    case CLUTTER_MOTION:
+    case CLUTTER_BUTTON_PRESS:
+    case CLUTTER_BUTTON_RELEASE:
+      clutter_event_get_coords (event, &x, &y);
+      g_string_append_printf (data->received, "%d:%.0f,%.0f ",
+                              clutter_event_type (event),
+                              x, y);
+      break;
+
+    default:
+      return CLUTTER_EVENT_PROPAGATE;
+    }
+
+  data->n_received += 1;
+
+  return CLUTTER_EVENT_PROPAGATE;
+}
+
+static void
+put_events (ReplayData *data)
+{
+  clutter_test_put_key_event (data->stage, CLUTTER_KEY_a);
+  clutter_test_put_pointer_event (data->stage, NULL, CLUTTER_MOTION,
+                                  CLUTTER_CURRENT_TIME, 10, 20);
+  clutter_test_put_pointer_event (data->stage, NULL, CLUTTER_BUTTON_PRESS,
+                                  CLUTTER_CURRENT_TIME, 30, 40);
+  clutter_test_put_pointer_event (data->stage, NULL, CLUTTER_BUTTON_RELEASE,
+                                  CLUTTER_CURRENT_TIME, 50, 60);
+}
+
+static void
+player_finished_cb (ClutterEventPlayer *player,
+                    ReplayData         *data)
+{
+  data->finished = TRUE;
+}
+
+static void
+events_replay_round_trip (void)
+{
+  ReplayData data = { NULL, };
+  ClutterEventRecorder *recorder;
+  ClutterEventPlayer *player;
+  GError *error = NULL;
+  gchar *filename, *recorded;
+  gint fd;
+  guint i;
+
+  fd = g_file_open_tmp ("clutter-events-XXXXXX", &filename, &error);
+  g_assert_no_error (error);
+  close (fd);
+
+  data.stage = clutter_test_get_stage ();
+  data.received = g_string_new (NULL);
+  g_signal_connect (data.stage, "event", G_CALLBACK (stage_event_cb), &data);
+  clutter_actor_show (data.stage);
+
+  /* record the events injected by the test */
+  recorder = clutter_event_recorder_new ();
+  clutter_event_recorder_start (recorder, filename, &error);
+  g_assert_no_error (error);
+  g_assert_true (clutter_event_recorder_is_recording (recorder));
+
+  put_events (&data);
+
+  while (data.n_received < N_EVENTS)
+    g_main_context_iteration (NULL, TRUE);
+
+  clutter_event_recorder_stop (recorder, &error);
+  g_assert_no_error (error);
+  g_assert_cmpuint (clutter_event_recorder_get_n_events (recorder), ==, N_EVENTS);
+
+  recorded = g_string_free (data.received, FALSE);
+  data.received = g_string_new (NULL);
+  data.n_received = 0;
+
+  if (g_test_verbose ())
+    g_print ("Recorded: %s\n", recorded);
+
+  /* replay them, and check that the stage receives the same events */
+  player = clutter_event_player_new ();
+  clutter_event_player_load (player, filename, &error);
+  g_assert_no_error (error);
+  g_assert_cmpuint (clutter_event_player_get_n_events (player), ==, N_EVENTS);
+
+  g_signal_connect (player, "finished", G_CALLBACK (player_finished_cb), &data);
+  clutter_event_player_play (player, CLUTTER_STAGE (data.stage), 0);
+  g_assert_true (clutter_event_player_is_playing (player));
+
+  while (!data.finished)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_false (clutter_event_player_is_playing (player));
+  g_assert_cmpstr (data.received->str, ==, recorded);
+
+  for (i = 0; i < N_EVENTS; i++)
+    {
+      gint64 processing_time;
+
+      g_assert_true (clutter_event_player_get_timings (player, i, &processing_time, NULL));
+      g_assert_cmpint (processing_time, >=, 0);
+    }
+
+  g_assert_false (clutter_event_player_get_timings (player, N_EVENTS, NULL, NULL));
+
+  g_signal_handlers_disconnect_by_func (data.stage, stage_event_cb, &data);
+
+  g_object_unref (player);
+  g_object_unref (recorder);
+  g_string_free (data.received, TRUE);
+  g_free (recorded);
+  g_unlink (filename);
+  g_free (filename);
+}
+
+static void
+events_replay_invalid_file (void)
+{
+  ClutterEventPlayer *player;
+  GError *error = NULL;
+  gchar *filename;
+
+  filename = g_test_build_filename (G_TEST_DIST, "scripts", "test-script-single.json", NULL);
+
+  player = clutter_event_player_new ();
+  g_assert_false (clutter_event_player_load (player, filename, &error));
+  g_assert_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA);
+  g_assert_cmpuint (clutter_event_player_get_n_events (player), ==, 0);
+
+  g_error_free (error);
+  g_object_unref (player);
+  g_free (filename);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/events/replay/round-trip", events_replay_round_trip)
+  CLUTTER_TEST_UNIT ("/events/replay/invalid-file", events_replay_invalid_file)
+)
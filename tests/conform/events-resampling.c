@@ -0,0 +1,178 @@
+#include <clutter/clutter.h>
+
+typedef struct {
+  guint time;
+  gfloat x, y;
+} MotionSample;
+
+/* the times are relative to the start of the frame interval; the
+ * frame is presented at its end, and the motion is resampled 5ms
+ * before that, at 11ms
+ */
+static const MotionSample interpolated_samples[] = {
+  {  4,   0.f,  0.f },
+  {  8,  40.f, 20.f },
+  { 12,  80.f, 40.f },
+  { 16, 120.f, 60.f },
+};
+
+/* samples ending before the resampling time, 6ms apart, so the
+ * motion can only be extrapolated by 3ms
+ */
+static const MotionSample extrapolated_samples[] = {
+  { 0,  0.f,  0.f },
+  { 6, 60.f, 30.f },
+};
+
+typedef struct {
+  guint n_motions;
+
+  gfloat x, y;
+  guint n_history;
+} ResamplingData;
+
+static gboolean
+stage_motion_cb (ClutterActor   *stage,
+                 ClutterEvent   *event,
+                 ResamplingData *data)
+{
+  data->n_motions += 1;
+
+  clutter_event_get_coords (event, &data->x, &data->y);
+  data->n_history = clutter_event_get_history_size (event);
+
+  return CLUTTER_EVENT_STOP;
+}
+
+static void
+put_motions (ClutterActor       *stage,
+             const MotionSample *samples,
+             guint               n_samples)
+{
+  guint32 frame_start;
+  guint i;
+
+  /* the timestamps follow the manual master clock, from the start of
+   * the interval of the next frame
+   */
+  frame_start = clutter_master_clock_get_time () / 1000;
+
+  for (i = 0; i < n_samples; i++)
+    clutter_test_put_pointer_event (stage, stage, CLUTTER_MOTION,
+                                    frame_start + samples[i].time,
+                                    samples[i].x, samples[i].y);
+
+  /* the stage compresses the events into a single one, and processes
+   * it on the next frame
+   */
+  clutter_test_run_frames (1);
+}
+
+static void
+resampling_data_init (ResamplingData *data,
+                      ClutterActor   *stage,
+                      gboolean        resample)
+{
+  data->n_motions = 0;
+
+  g_signal_connect (stage, "motion-event", G_CALLBACK (stage_motion_cb), data);
+  clutter_stage_set_throttle_motion_events (CLUTTER_STAGE (stage), TRUE);
+  clutter_stage_set_motion_resampling (CLUTTER_STAGE (stage), resample);
+  clutter_actor_show (stage);
+
+  /* run the first frame of the stage before putting any event */
+  clutter_test_run_frames (1);
+}
+
+static void
+resampling_data_clear (ResamplingData *data,
+                       ClutterActor   *stage)
+{
+  g_signal_handlers_disconnect_by_func (stage, stage_motion_cb, data);
+  clutter_stage_set_motion_resampling (CLUTTER_STAGE (stage), FALSE);
+}
+
+static void
+events_resampling_interpolate (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ResamplingData data = { 0, };
+  ClutterInputDevice *device;
+  ClutterPoint point;
+
+  resampling_data_init (&data, stage, TRUE);
+  g_assert_true (clutter_stage_get_motion_resampling (CLUTTER_STAGE (stage)));
+
+  put_motions (stage, interpolated_samples, G_N_ELEMENTS (interpolated_samples));
+
+  g_assert_cmpuint (data.n_motions, ==, 1);
+  g_assert_cmpuint (data.n_history, ==, G_N_ELEMENTS (interpolated_samples) - 1);
+
+  /* the position is the one at the resampling time, three quarters
+   * of the way between the second and the third sample
+   */
+  g_assert_cmpfloat (data.x, ==, 70.f);
+  g_assert_cmpfloat (data.y, ==, 35.f);
+
+  /* the pointer itself stays at the position of the last sample */
+  device = clutter_device_manager_get_core_device (clutter_device_manager_get_default (),
+                                                   CLUTTER_POINTER_DEVICE);
+  clutter_input_device_get_coords (device, NULL, &point);
+  g_assert_cmpfloat (point.x, ==, 120.f);
+  g_assert_cmpfloat (point.y, ==, 60.f);
+
+  resampling_data_clear (&data, stage);
+}
+
+static void
+events_resampling_extrapolate (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ResamplingData data = { 0, };
+
+  resampling_data_init (&data, stage, TRUE);
+
+  put_motions (stage, extrapolated_samples, G_N_ELEMENTS (extrapolated_samples));
+
+  g_assert_cmpuint (data.n_motions, ==, 1);
+
+  /* the resampling time is 5ms after the last sample, but the motion
+   * is only extrapolated by half the interval between the samples
+   */
+  g_assert_cmpfloat (data.x, ==, 90.f);
+  g_assert_cmpfloat (data.y, ==, 45.f);
+
+  resampling_data_clear (&data, stage);
+}
+
+static void
+events_resampling_disabled (void)
+{
+  ClutterActor *stage = clutter_test_get_stage ();
+  ResamplingData data = { 0, };
+  const MotionSample *last;
+
+  resampling_data_init (&data, stage, FALSE);
+  g_assert_false (clutter_stage_get_motion_resampling (CLUTTER_STAGE (stage)));
+
+  put_motions (stage, interpolated_samples, G_N_ELEMENTS (interpolated_samples));
+
+  /* the last sample is delivered as-is */
+  last = &interpolated_samples[G_N_ELEMENTS (interpolated_samples) - 1];
+
+  g_assert_cmpuint (data.n_motions, ==, 1);
+  g_assert_cmpuint (data.n_history, ==, G_N_ELEMENTS (interpolated_samples) - 1);
+  g_assert_cmpfloat (data.x, ==, last->x);
+  g_assert_cmpfloat (data.y, ==, last->y);
+
+  resampling_data_clear (&data, stage);
+}
+
+/* the frames are presented at the time of the manual master clock,
+ * which the timestamps of the events follow
+ */
+CLUTTER_TEST_SUITE_MANUAL_CLOCK (
+  CLUTTER_TEST_UNIT ("/events/resampling/interpolate", events_resampling_interpolate)
+  CLUTTER_TEST_UNIT ("/events/resampling/extrapolate", events_resampling_extrapolate)
+  CLUTTER_TEST_UNIT ("/events/resampling/disabled", events_resampling_disabled)
+)
@@ -0,0 +1,239 @@
+#include <X11/Xlib.h>
+#include <clutter/clutter.h>
+#include <clutter/x11/clutter-x11.h>
+
+/* the tests in this file send core X events to the window of the
+ * stage, so they disable XInput, which would otherwise ignore them
+ */
+
+#define TIMEOUT_SECONDS 5
+#define N_MOTIONS       10
+
+typedef struct {
+  ClutterActor *stage;
+
+  Display *xdisplay;
+  Window xwindow;
+  Time time;
+
+  GString *events;
+  gboolean done;
+  gboolean timed_out;
+} X11Data;
+
+static gboolean
+stage_captured_event_cb (ClutterActor *stage,
+                         ClutterEvent *event,
+                         X11Data      *data)
+{
+  gfloat x, y;
+
+  switch (clutter_event_type (event))
+    {
+    case CLUTTER_MOTION:
+      clutter_event_get_coords (event, &x, &y);
+      g_string_append_printf (data->events, "motion:%.0f:%u ",
+                              x, clutter_event_get_history_size (event));
+      break;
+
+    case CLUTTER_BUTTON_PRESS:
+      g_string_append (data->events, "press ");
+      break;
+
+    case CLUTTER_BUTTON_RELEASE:
+      g_string_append (data->events, "release ");
+      data->done = TRUE;
+      break;
+
+    default:
+      break;
+    }
+
+  return CLUTTER_EVENT_PROPAGATE;
+}
+
+static gboolean
+timeout_cb (gpointer user_data)
+{
+  X11Data *data = user_data;
+
+  data->timed_out = TRUE;
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+send_event (X11Data *data,
+            int      type,
+            int      x)
+{
+  XEvent xevent = { 0, };
+
+  data->time += 1;
+
+  xevent.type = type;
+  xevent.xany.display = data->xdisplay;
+  xevent.xany.window = data->xwindow;
+
+  switch (type)
+    {
+    case EnterNotify:
+      xevent.xcrossing.time = data->time;
+      xevent.xcrossing.x = x;
+      xevent.xcrossing.mode = NotifyNormal;
+      xevent.xcrossing.detail = NotifyAncestor;
+      break;
+
+    case MotionNotify:
+      xevent.xmotion.time = data->time;
+      xevent.xmotion.x = x;
+      break;
+
+    case ButtonPress:
+    case ButtonRelease:
+      xevent.xbutton.time = data->time;
+      xevent.xbutton.x = x;
+      xevent.xbutton.button = 1;
+      break;
+    }
+
+  /* without an event mask, the event goes to the creator of the
+   * window, that is to Clutter
+   */
+  XSendEvent (data->xdisplay, data->xwindow, False, 0, &xevent);
+}
+
+static void
+x11_data_init (X11Data *data)
+{
+  data->stage = clutter_test_get_stage ();
+  data->xdisplay = clutter_x11_get_default_display ();
+  data->events = g_string_new (NULL);
+
+  clutter_stage_set_throttle_motion_events (CLUTTER_STAGE (data->stage), TRUE);
+  clutter_actor_show (data->stage);
+
+  data->xwindow = clutter_x11_get_stage_window (CLUTTER_STAGE (data->stage));
+  g_assert_cmpuint (data->xwindow, !=, None);
+
+  /* let the events of the mapping through before counting */
+  XSync (data->xdisplay, False);
+  while (g_main_context_pending (NULL))
+    g_main_context_iteration (NULL, FALSE);
+
+  g_signal_connect (data->stage, "captured-event",
+                    G_CALLBACK (stage_captured_event_cb), data);
+}
+
+static void
+wait_for_release (X11Data *data)
+{
+  guint id;
+
+  /* queue all the sent events in Xlib, so that the event source
+   * translates them in a single batch
+   */
+  XSync (data->xdisplay, False);
+
+  data->done = FALSE;
+  id = g_timeout_add_seconds (TIMEOUT_SECONDS, timeout_cb, data);
+
+  while (!data->done && !data->timed_out)
+    g_main_context_iteration (NULL, TRUE);
+
+  if (!data->timed_out)
+    g_source_remove (id);
+
+  g_assert_false (data->timed_out);
+}
+
+static void
+events_x11_batch (void)
+{
+  X11Data data = { NULL, };
+  guint64 n_translated, n_dropped;
+  guint64 n_translated_before, n_dropped_before;
+  gint i;
+
+  x11_data_init (&data);
+
+  clutter_x11_get_event_counters (&n_translated_before, &n_dropped_before);
+
+  send_event (&data, EnterNotify, 0);
+
+  for (i = 1; i <= N_MOTIONS; i++)
+    send_event (&data, MotionNotify, i);
+
+  send_event (&data, ButtonPress, N_MOTIONS);
+
+  for (i = 1; i <= N_MOTIONS; i++)
+    send_event (&data, MotionNotify, N_MOTIONS + i);
+
+  send_event (&data, ButtonRelease, 2 * N_MOTIONS);
+
+  wait_for_release (&data);
+
+  if (g_test_verbose ())
+    g_print ("Events: %s\n", data.events->str);
+
+  /* each run of motions reaches the stage as a single event, keeping
+   * the other ones in its history, and the button events stay in place
+   */
+  g_assert_cmpstr (data.events->str, ==,
+                   "motion:10:9 press motion:20:9 release ");
+
+  clutter_x11_get_event_counters (&n_translated, &n_dropped);
+
+  g_assert_cmpuint (n_translated - n_translated_before, >=, 2 * N_MOTIONS + 3);
+  g_assert_cmpuint (n_dropped - n_dropped_before, ==, 2 * (N_MOTIONS - 1));
+
+  g_string_free (data.events, TRUE);
+}
+
+static void
+events_x11_unthrottled (void)
+{
+  X11Data data = { NULL, };
+  guint64 n_dropped, n_dropped_before;
+  gint i;
+
+  x11_data_init (&data);
+
+  /* without motion compression on the stage, every motion is kept */
+  clutter_stage_set_throttle_motion_events (CLUTTER_STAGE (data.stage), FALSE);
+
+  clutter_x11_get_event_counters (NULL, &n_dropped_before);
+
+  send_event (&data, EnterNotify, 0);
+
+  for (i = 1; i <= 3; i++)
+    send_event (&data, MotionNotify, i);
+
+  send_event (&data, ButtonRelease, 3);
+
+  wait_for_release (&data);
+
+  g_assert_cmpstr (data.events->str, ==,
+                   "motion:1:0 motion:2:0 motion:3:0 release ");
+
+  clutter_x11_get_event_counters (NULL, &n_dropped);
+  g_assert_cmpuint (n_dropped, ==, n_dropped_before);
+
+  clutter_stage_set_throttle_motion_events (CLUTTER_STAGE (data.stage), TRUE);
+  g_string_free (data.events, TRUE);
+}
+
+int
+main (int   argc,
+      char *argv[])
+{
+  g_setenv ("CLUTTER_DISABLE_XINPUT", "1", TRUE);
+  clutter_set_windowing_backend (CLUTTER_WINDOWING_X11);
+
+  clutter_test_init (&argc, &argv);
+
+  clutter_test_add ("/events/x11/batch", events_x11_batch);
+  clutter_test_add ("/events/x11/unthrottled", events_x11_unthrottled);
+
+  return clutter_test_run ();
+}
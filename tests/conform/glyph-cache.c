@@ -0,0 +1,132 @@
+#include <unistd.h>
+#include <glib/gstdio.h>
+#include <clutter/clutter.h>
+
+static void
+run_warm_up (void)
+{
+  /* the glyphs are rasterised from a low priority idle source */
+  while (g_main_context_pending (NULL))
+    g_main_context_iteration (NULL, FALSE);
+}
+
+static gchar *
+create_manifest_file (void)
+{
+  GError *error = NULL;
+  gchar *filename;
+  gint fd;
+
+  fd = g_file_open_tmp ("clutter-glyphs-XXXXXX", &filename, &error);
+  g_assert_no_error (error);
+  close (fd);
+
+  return filename;
+}
+
+static void
+assert_manifest_characters (GKeyFile    *keyfile,
+                            const gchar *font,
+                            const gchar *expected)
+{
+  GError *error = NULL;
+  gchar *characters;
+  const gchar *p;
+
+  characters = g_key_file_get_string (keyfile, font, "characters", &error);
+  g_assert_no_error (error);
+
+  /* the characters are stored once each, in no particular order */
+  g_assert_cmpint (g_utf8_strlen (characters, -1), ==, g_utf8_strlen (expected, -1));
+
+  for (p = expected; *p != '\0'; p = g_utf8_next_char (p))
+    g_assert_nonnull (g_utf8_strchr (characters, -1, g_utf8_get_char (p)));
+
+  g_free (characters);
+}
+
+static void
+glyph_cache_save_manifest (void)
+{
+  PangoFontDescription *font_desc;
+  GKeyFile *keyfile;
+  GError *error = NULL;
+  gchar *filename;
+
+  font_desc = pango_font_description_from_string ("Sans 10");
+  clutter_glyph_cache_warm_up (font_desc, "abcabc");
+  pango_font_description_free (font_desc);
+
+  font_desc = pango_font_description_from_string ("Sans Bold 12");
+  clutter_glyph_cache_warm_up (font_desc, "xyz\303\251");
+  pango_font_description_free (font_desc);
+
+  run_warm_up ();
+
+  filename = create_manifest_file ();
+  clutter_glyph_cache_save_manifest (filename, &error);
+  g_assert_no_error (error);
+
+  keyfile = g_key_file_new ();
+  g_key_file_load_from_file (keyfile, filename, G_KEY_FILE_NONE, &error);
+  g_assert_no_error (error);
+
+  assert_manifest_characters (keyfile, "Sans 10", "abc");
+  assert_manifest_characters (keyfile, "Sans Bold 12", "xyz\303\251");
+
+  g_key_file_free (keyfile);
+  g_unlink (filename);
+  g_free (filename);
+}
+
+static void
+glyph_cache_load_manifest (void)
+{
+  GKeyFile *keyfile;
+  GError *error = NULL;
+  gchar *filename;
+
+  /* a manifest saved on a previous run */
+  filename = create_manifest_file ();
+
+  keyfile = g_key_file_new ();
+  g_key_file_set_string (keyfile, "Serif 9", "characters", "qrs");
+  g_key_file_set_string (keyfile, "Sans 10", "characters", "de");
+  g_key_file_save_to_file (keyfile, filename, &error);
+  g_assert_no_error (error);
+  g_key_file_free (keyfile);
+
+  clutter_glyph_cache_load_manifest (filename, &error);
+  g_assert_no_error (error);
+
+  run_warm_up ();
+
+  /* the loaded characters are warmed up, and recorded together with
+   * the ones warmed up before
+   */
+  clutter_glyph_cache_save_manifest (filename, &error);
+  g_assert_no_error (error);
+
+  keyfile = g_key_file_new ();
+  g_key_file_load_from_file (keyfile, filename, G_KEY_FILE_NONE, &error);
+  g_assert_no_error (error);
+
+  assert_manifest_characters (keyfile, "Serif 9", "qrs");
+  assert_manifest_characters (keyfile, "Sans 10", "abcde");
+  assert_manifest_characters (keyfile, "Sans Bold 12", "xyz\303\251");
+
+  g_key_file_free (keyfile);
+
+  /* a missing file is reported */
+  g_unlink (filename);
+  g_assert_false (clutter_glyph_cache_load_manifest (filename, &error));
+  g_assert_error (error, G_FILE_ERROR, G_FILE_ERROR_NOENT);
+  g_clear_error (&error);
+
+  g_free (filename);
+}
+
+CLUTTER_TEST_SUITE (
+  CLUTTER_TEST_UNIT ("/glyph-cache/save-manifest", glyph_cache_save_manifest)
+  CLUTTER_TEST_UNIT ("/glyph-cache/load-manifest", glyph_cache_load_manifest)
+)
@@ -0,0 +1,114 @@
+#include <clutter/clutter.h>
+
+#define FRAME_INTERVAL  (100 * 1000)
+
+typedef struct {
+  GArray *elapsed;
+  gboolean completed;
+} TimelineData;
+
+static void
+timeline_new_frame (ClutterTimeline *timeline,
+                    gint             msecs,
+                    TimelineData    *data)
+{
+  g_array_append_val (data->elapsed, msecs);
+}
+
+static void
+timeline_completed (ClutterTimeline *timeline,
+                    TimelineData    *data)
+{
+  data->completed = TRUE;
+}
+
+static void
+master_clock_manual_timeline (void)
+{
+  TimelineData data = { NULL, };
+  ClutterTimeline *timeline;
+  gint64 start_time;
+  guint i;
+
+  data.elapsed = g_array_new (FALSE, FALSE, sizeof (gint));
+
+  timeline = clutter_timeline_new (1000);
+  g_signal_connect (timeline, "new-frame",
+                    G_CALLBACK (timeline_new_frame), &data);
+  g_signal_connect (timeline, "completed",
+                    G_CALLBACK (timeline_completed), &data);
+  clutter_timeline_start (timeline);
+
+  start_time = clutter_master_clock_get_time ();
+
+  /* the main loop does not advance the timeline */
+  while (g_main_context_pending (NULL))
+    g_main_context_iteration (NULL, FALSE);
+
+  g_assert_cmpuint (data.elapsed->len, ==, 0);
+
+  /* the first frame starts the timeline */
+  clutter_master_clock_step (1, FRAME_INTERVAL);
+
+  g_assert_cmpuint (data.elapsed->len, ==, 1);
+  g_assert_cmpint (g_array_index (data.elapsed, gint, 0), ==, 0);
+
+  /* every following frame advances it by the frame interval */
+  clutter_master_clock_step (5, FRAME_INTERVAL);
+
+  g_assert_cmpuint (data.elapsed->len, ==, 6);
+  for (i = 0; i < data.elapsed->len; i++)
+    g_assert_cmpint (g_array_index (data.elapsed, gint, i), ==, i * 100);
+
+  g_assert (!data.completed);
+
+  clutter_master_clock_step (5, FRAME_INTERVAL);
+
+  g_assert (data.completed);
+  g_assert_cmpint (g_array_index (data.elapsed, gint, data.elapsed->len - 1), ==, 1000);
+
+  g_assert_cmpint (clutter_master_clock_get_time () - start_time, ==, 11 * FRAME_INTERVAL);
+
+  g_array_free (data.elapsed, TRUE);
+  g_object_unref (timeline);
+}
+
+static gboolean
+stage_key_press (ClutterActor *stage,
+                 ClutterEvent *event,
+                 guint        *n_events)
+{
+  *n_events += 1;
+
+  return CLUTTER_EVENT_STOP;
+}
+
+static void
+master_clock_manual_events (void)
+{
+  ClutterActor *stage;
+  guint n_events = 0;
+
+  stage = clutter_test_get_stage ();
+  g_signal_connect (stage, "key-press-event",
+                    G_CALLBACK (stage_key_press), &n_events);
+  clutter_actor_show (stage);
+
+  clutter_test_put_key_event (stage, CLUTTER_KEY_a);
+  clutter_test_put_key_event (stage, CLUTTER_KEY_a);
+
+  /* the queued events are only processed by the next frame */
+  while (g_main_context_pending (NULL))
+    g_main_context_iteration (NULL, FALSE);
+
+  g_assert_cmpuint (n_events, ==, 0);
+
+  clutter_master_clock_step (1, FRAME_INTERVAL);
+
+  g_assert_cmpuint (n_events, ==, 2);
+}
+
+CLUTTER_TEST_SUITE_MANUAL_CLOCK (
+  CLUTTER_TEST_UNIT ("/master-clock/manual/timeline", master_clock_manual_timeline)
+  CLUTTER_TEST_UNIT ("/master-clock/manual/events", master_clock_manual_events)
+)
@@ -0,0 +1,240 @@
+#include <math.h>
+#include <clutter/clutter.h>
+
+#define VIEW_SIZE       100.f
+#define CONTENT_SIZE    1000.f
+
+/* the pointer is dragged up by DRAG_STEP pixels every DRAG_INTERVAL
+ * milliseconds, so the content scrolls down at 1 pixel per millisecond
+ */
+#define DRAG_START      90.f
+#define DRAG_STEP       10.f
+#define DRAG_INTERVAL   10
+#define N_DRAG_STEPS    8
+
+#define SNAP_INTERVAL   50.f
+
+typedef struct {
+  ClutterActor *stage;
+  ClutterActor *scroll;
+  ClutterAction *action;
+
+  GArray *offsets;
+  gboolean stopped;
+} PanData;
+
+static gfloat
+get_scroll_offset (ClutterActor *scroll)
+{
+  ClutterMatrix transform;
+
+  /* the scroll actor translates its children by the scroll offset */
+  clutter_actor_get_child_transform (scroll, &transform);
+
+  return -transform.yw;
+}
+
+static void
+put_pointer_event (PanData          *data,
+                   ClutterEventType  type,
+                   guint32           time_,
+                   gfloat            y)
+{
+  clutter_test_put_pointer_event (data->stage, data->scroll, type,
+                                  time_, VIEW_SIZE / 2, y);
+
+  /* the queued events are only processed by the next frame */
+  clutter_test_run_frames (1);
+}
+
+static void
+pan_stopped_cb (ClutterPanAction *action,
+                ClutterActor     *actor,
+                PanData          *data)
+{
+  data->stopped = TRUE;
+}
+
+static void
+pan_data_init (PanData *data,
+               gfloat   snap_interval)
+{
+  ClutterActor *content;
+
+  data->stage = clutter_test_get_stage ();
+  data->offsets = g_array_new (FALSE, FALSE, sizeof (gfloat));
+  data->stopped = FALSE;
+
+  data->scroll = clutter_scroll_actor_new ();
+  clutter_scroll_actor_set_scroll_mode (CLUTTER_SCROLL_ACTOR (data->scroll),
+                                        CLUTTER_SCROLL_VERTICALLY);
+  clutter_actor_set_size (data->scroll, VIEW_SIZE, VIEW_SIZE);
+  clutter_actor_set_reactive (data->scroll, TRUE);
+  clutter_actor_add_child (data->stage, data->scroll);
+
+  content = clutter_actor_new ();
+  clutter_actor_set_size (content, VIEW_SIZE, CONTENT_SIZE);
+  clutter_actor_add_child (data->scroll, content);
+
+  data->action = clutter_pan_action_new ();
+  clutter_pan_action_set_pan_axis (CLUTTER_PAN_ACTION (data->action),
+                                   CLUTTER_PAN_Y_AXIS);
+  clutter_pan_action_set_interpolate (CLUTTER_PAN_ACTION (data->action), TRUE);
+  clutter_gesture_action_set_threshold_trigger_distance (CLUTTER_GESTURE_ACTION (data->action),
+                                                         1.f, 1.f);
+  clutter_pan_action_set_scroll_actor (CLUTTER_PAN_ACTION (data->action),
+                                       CLUTTER_SCROLL_ACTOR (data->scroll));
+  clutter_pan_action_set_snap_interval (CLUTTER_PAN_ACTION (data->action),
+                                        0.f, snap_interval);
+  g_signal_connect (data->action, "pan-stopped",
+                    G_CALLBACK (pan_stopped_cb), data);
+  clutter_actor_add_action (data->scroll, data->action);
+
+  g_assert_true (clutter_pan_action_get_scroll_actor (CLUTTER_PAN_ACTION (data->action)) ==
+                 CLUTTER_SCROLL_ACTOR (data->scroll));
+
+  clutter_actor_show (data->stage);
+
+  /* allocate the children, which bound the scroll */
+  clutter_test_run_frames (1);
+}
+
+static void
+pan_data_clear (PanData *data)
+{
+  g_array_free (data->offsets, TRUE);
+  clutter_actor_destroy (data->scroll);
+}
+
+static void
+fling (PanData *data)
+{
+  guint32 time_ = 1000;
+  gfloat y = DRAG_START;
+  guint i;
+
+  put_pointer_event (data, CLUTTER_BUTTON_PRESS, time_, y);
+
+  for (i = 0; i < N_DRAG_STEPS; i++)
+    {
+      time_ += DRAG_INTERVAL;
+      y -= DRAG_STEP;
+      put_pointer_event (data, CLUTTER_MOTION, time_, y);
+    }
+
+  /* the scroll follows the pointer during the drag */
+  g_assert_cmpfloat (get_scroll_offset (data->scroll), ==, N_DRAG_STEPS * DRAG_STEP);
+
+  put_pointer_event (data, CLUTTER_BUTTON_RELEASE, time_ + DRAG_INTERVAL / 2, y);
+
+  /* record the offset of each frame until the motion stops */
+  for (i = 0; i < 200 && !data->stopped; i++)
+    {
+      gfloat offset = get_scroll_offset (data->scroll);
+
+      g_array_append_val (data->offsets, offset);
+      clutter_test_run_frames (1);
+    }
+
+  g_assert_true (data->stopped);
+}
+
+static void
+assert_decelerates (PanData *data,
+                    guint    n_frames)
+{
+  gfloat prev_step = G_MAXFLOAT;
+  guint i;
+
+  g_assert_cmpuint (data->offsets->len, >, n_frames);
+
+  /* the content keeps moving the same way, slower on every frame */
+  for (i = 1; i < n_frames; i++)
+    {
+      gfloat step = g_array_index (data->offsets, gfloat, i)
+                  - g_array_index (data->offsets, gfloat, i - 1);
+
+      g_assert_cmpfloat (step, >=, 0.f);
+      g_assert_cmpfloat (step, <=, prev_step);
+
+      prev_step = step;
+    }
+}
+
+static gfloat
+get_natural_end (gdouble deceleration)
+{
+  gdouble tau, velocity;
+
+  /* the velocity decays by the deceleration rate every 60th of a
+   * second, until it is down to a tenth of a pixel per millisecond
+   */
+  tau = 1000.0 / (60.0 * -log (deceleration));
+  velocity = DRAG_STEP / DRAG_INTERVAL;
+
+  return N_DRAG_STEPS * DRAG_STEP + velocity * tau * (1.0 - 0.1 / velocity);
+}
+
+static void
+pan_action_kinetic (void)
+{
+  PanData data = { NULL, };
+  gfloat natural_end, final_offset;
+
+  pan_data_init (&data, 0.f);
+  fling (&data);
+
+  /* the motion started from the release position, and the frames are
+   * 16ms apart, so the first half second is well before the end
+   */
+  g_assert_cmpfloat (g_array_index (data.offsets, gfloat, 0), >=, N_DRAG_STEPS * DRAG_STEP);
+  assert_decelerates (&data, 500 * 1000 / CLUTTER_TEST_FRAME_INTERVAL);
+
+  natural_end = get_natural_end (clutter_pan_action_get_deceleration (CLUTTER_PAN_ACTION (data.action)));
+  final_offset = get_scroll_offset (data.scroll);
+
+  if (g_test_verbose ())
+    g_print ("Final offset: %.2f, expected: %.2f, after %u frames\n",
+             final_offset, natural_end, data.offsets->len);
+
+  g_assert_cmpfloat (fabsf (final_offset - natural_end), <, 1.f);
+
+  pan_data_clear (&data);
+}
+
+static void
+pan_action_kinetic_snap (void)
+{
+  PanData data = { NULL, };
+  gfloat natural_end, final_offset;
+  gfloat interval_x, interval_y;
+
+  pan_data_init (&data, SNAP_INTERVAL);
+
+  clutter_pan_action_get_snap_interval (CLUTTER_PAN_ACTION (data.action),
+                                        &interval_x, &interval_y);
+  g_assert_cmpfloat (interval_x, ==, 0.f);
+  g_assert_cmpfloat (interval_y, ==, SNAP_INTERVAL);
+
+  fling (&data);
+
+  assert_decelerates (&data, 500 * 1000 / CLUTTER_TEST_FRAME_INTERVAL);
+
+  /* the motion ends on the snap point closest to its natural end */
+  natural_end = get_natural_end (clutter_pan_action_get_deceleration (CLUTTER_PAN_ACTION (data.action)));
+  final_offset = get_scroll_offset (data.scroll);
+
+  if (g_test_verbose ())
+    g_print ("Final offset: %.2f, natural end: %.2f, after %u frames\n",
+             final_offset, natural_end, data.offsets->len);
+
+  g_assert_cmpfloat (final_offset, ==, floorf (natural_end / SNAP_INTERVAL + 0.5f) * SNAP_INTERVAL);
+
+  pan_data_clear (&data);
+}
+
+/* the frames follow the manual master clock */
+CLUTTER_TEST_SUITE_MANUAL_CLOCK (
+  CLUTTER_TEST_UNIT ("/pan-action/kinetic", pan_action_kinetic)
+  CLUTTER_TEST_UNIT ("/pan-action/kinetic/snap", pan_action_kinetic_snap)
+)
@@ -325,6 +325,64 @@ text_password_char (void)
   clutter_actor_destroy (CLUTTER_ACTOR (text));
 }
 
+static void
+assert_masked_text (ClutterText *text,
+                    gunichar     password_char,
+                    int          n_chars)
+{
+  PangoLayout *layout = clutter_text_get_layout (text);
+  const char *masked = pango_layout_get_text (layout);
+  char bytes[6];
+  int nbytes, i;
+
+  nbytes = g_unichar_to_utf8 (password_char, bytes);
+
+  g_assert_cmpint (strlen (masked), ==, n_chars * nbytes);
+  for (i = 0; i < n_chars; i++)
+    g_assert (memcmp (masked + i * nbytes, bytes, nbytes) == 0);
+}
+
+static void
+text_password_typing (void)
+{
+  ClutterText *text = CLUTTER_TEXT (clutter_text_new ());
+  int i;
+
+  g_object_ref_sink (text);
+
+  clutter_text_set_editable (text, TRUE);
+  clutter_text_set_password_char (text, 0x25cf); /* BLACK CIRCLE */
+
+  /* the masked text is updated in place while typing */
+  for (i = 0; i < G_N_ELEMENTS (test_text_data); i++)
+    {
+      const TestData *t = &test_text_data[i];
+
+      insert_unichar (text, t->unichar, DONT_MOVE_CURSOR);
+      assert_masked_text (text, 0x25cf, i + 1);
+    }
+
+  insert_unichar (text, 'a', 0);
+  assert_masked_text (text, 0x25cf, G_N_ELEMENTS (test_text_data) + 1);
+
+  clutter_text_delete_chars (text, 1);
+  assert_masked_text (text, 0x25cf, G_N_ELEMENTS (test_text_data));
+
+  /* changing the password character replaces the whole text */
+  clutter_text_set_password_char (text, '*');
+  assert_masked_text (text, '*', G_N_ELEMENTS (test_text_data));
+
+  clutter_text_set_text (text, "");
+  assert_masked_text (text, '*', 0);
+
+  clutter_text_set_text (text, "hello");
+  assert_masked_text (text, '*', 5);
+
+  g_assert_cmpstr (clutter_text_get_text (text), ==, "hello");
+
+  clutter_actor_destroy (CLUTTER_ACTOR (text));
+}
+
 static ClutterEvent *
 init_event (void)
 {
@@ -544,6 +602,7 @@ CLUTTER_TEST_SUITE (
   CLUTTER_TEST_UNIT ("/text/get-chars", text_get_chars)
   CLUTTER_TEST_UNIT ("/text/delete-text", text_delete_text)
   CLUTTER_TEST_UNIT ("/text/password-char", text_password_char)
+  CLUTTER_TEST_UNIT ("/text/password-typing", text_password_typing)
   CLUTTER_TEST_UNIT ("/text/cursor", text_cursor)
   CLUTTER_TEST_UNIT ("/text/event", text_event)
   CLUTTER_TEST_UNIT ("/text/idempotent-use-markup", text_idempotent_use_markup)
@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <clutter/clutter.h>
+
+#define N_CHILDREN      10000
+
+static gint n_children = N_CHILDREN;
+static gint n_iterations = 10;
+
+static GOptionEntry entries[] = {
+  {
+    "num-children", 'n',
+    0,
+    G_OPTION_ARG_INT, &n_children,
+    "Number of children to add", "CHILDREN"
+  },
+  {
+    "num-iterations", 'i',
+    0,
+    G_OPTION_ARG_INT, &n_iterations,
+    "Number of times each test is run", "ITERATIONS"
+  },
+  { NULL }
+};
+
+static ClutterActor **
+create_children (void)
+{
+  ClutterActor **children;
+  gint i;
+
+  children = g_new (ClutterActor *, n_children);
+
+  for (i = 0; i < n_children; i++)
+    {
+      children[i] = clutter_actor_new ();
+      g_object_ref_sink (children[i]);
+
+      /* a few different depths, so that the children need sorting */
+      clutter_actor_set_z_position (children[i], (gfloat) (i % 5));
+      clutter_actor_set_size (children[i], 16, 16);
+    }
+
+  return children;
+}
+
+static void
+destroy_children (ClutterActor **children)
+{
+  gint i;
+
+  for (i = 0; i < n_children; i++)
+    {
+      clutter_actor_destroy (children[i]);
+      g_object_unref (children[i]);
+    }
+
+  g_free (children);
+}
+
+static void
+print_timings (const gchar *name,
+               gint64       total)
+{
+  printf ("%s: %d children, mean %.3f ms\n",
+          name,
+          n_children,
+          total / 1000.0 / n_iterations);
+}
+
+int
+main (int argc, char *argv[])
+{
+  ClutterActor *stage, *box;
+  ClutterActor **children;
+  gint64 add_one, add_all, remove_one, remove_all, start;
+  gint i, j;
+
+  if (clutter_init_with_args (&argc, &argv,
+                              NULL,
+                              entries,
+                              NULL,
+                              NULL) != CLUTTER_INIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (n_iterations < 1)
+    n_iterations = 1;
+
+  if (n_children < 1)
+    n_children = 1;
+
+  stage = clutter_stage_new ();
+  clutter_actor_set_size (stage, 800, 600);
+
+  box = clutter_actor_new ();
+  clutter_actor_set_layout_manager (box, clutter_flow_layout_new (CLUTTER_FLOW_HORIZONTAL));
+  clutter_actor_add_child (stage, box);
+
+  clutter_actor_show (stage);
+
+  add_one = add_all = remove_one = remove_all = 0;
+
+  for (i = 0; i < n_iterations; i++)
+    {
+      children = create_children ();
+
+      /* one child at a time, into a mapped container */
+      start = g_get_monotonic_time ();
+      for (j = 0; j < n_children; j++)
+        clutter_actor_add_child (box, children[j]);
+      add_one += g_get_monotonic_time () - start;
+
+      start = g_get_monotonic_time ();
+      for (j = 0; j < n_children; j++)
+        clutter_actor_remove_child (box, children[j]);
+      remove_one += g_get_monotonic_time () - start;
+
+      /* all the children at once */
+      start = g_get_monotonic_time ();
+      clutter_actor_add_children (box, children, n_children);
+      add_all += g_get_monotonic_time () - start;
+
+      start = g_get_monotonic_time ();
+      clutter_actor_remove_children (box, children, n_children);
+      remove_all += g_get_monotonic_time () - start;
+
+      destroy_children (children);
+    }
+
+  print_timings ("clutter_actor_add_child", add_one);
+  print_timings ("clutter_actor_add_children", add_all);
+  print_timings ("clutter_actor_remove_child", remove_one);
+  print_timings ("clutter_actor_remove_children", remove_all);
+
+  clutter_actor_destroy (stage);
+
+  return EXIT_SUCCESS;
+}
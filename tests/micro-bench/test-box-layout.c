@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <clutter/clutter.h>
+
+#define N_CHILDREN      500
+
+static gint n_children = N_CHILDREN;
+static gint n_iterations = 200;
+
+static GOptionEntry entries[] = {
+  {
+    "num-children", 'n',
+    0,
+    G_OPTION_ARG_INT, &n_children,
+    "Number of children of the box layout", "CHILDREN"
+  },
+  {
+    "num-iterations", 'i',
+    0,
+    G_OPTION_ARG_INT, &n_iterations,
+    "Number of relayouts for each test", "ITERATIONS"
+  },
+  { NULL }
+};
+
+/* forces a relayout of the stage, and returns its duration */
+static gint64
+time_relayout (ClutterActor *box)
+{
+  ClutterActorBox allocation;
+  gint64 start;
+
+  start = g_get_monotonic_time ();
+  clutter_actor_get_allocation_box (box, &allocation);
+
+  return g_get_monotonic_time () - start;
+}
+
+static void
+print_timings (const gchar *name,
+               gint64       total)
+{
+  printf ("%s: %d relayouts of %d children, mean %.3f ms\n",
+          name,
+          n_iterations,
+          n_children,
+          total / 1000.0 / n_iterations);
+}
+
+int
+main (int argc, char *argv[])
+{
+  ClutterActor *stage, *box;
+  ClutterLayoutManager *layout;
+  gfloat min_width, natural_width;
+  gint64 total;
+  gint i;
+
+  if (clutter_init_with_args (&argc, &argv,
+                              NULL,
+                              entries,
+                              NULL,
+                              NULL) != CLUTTER_INIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (n_iterations < 1)
+    n_iterations = 1;
+
+  stage = clutter_stage_new ();
+  clutter_actor_set_size (stage, 800, 600);
+
+  layout = clutter_box_layout_new ();
+  clutter_box_layout_set_spacing (CLUTTER_BOX_LAYOUT (layout), 2);
+
+  box = clutter_actor_new ();
+  clutter_actor_set_layout_manager (box, layout);
+  clutter_actor_add_child (stage, box);
+
+  for (i = 0; i < n_children; i++)
+    {
+      ClutterActor *child = clutter_actor_new ();
+
+      /* the items of a toolbar, which can shrink down to an icon */
+      clutter_actor_set_min_width (child, 16);
+      clutter_actor_set_natural_width (child, 24 + (i % 5) * 8);
+      clutter_actor_set_height (child, 24);
+      clutter_actor_set_x_expand (child, i % 10 == 0);
+      clutter_actor_add_child (box, child);
+    }
+
+  clutter_actor_show (stage);
+
+  clutter_actor_get_preferred_width (box, -1, &min_width, &natural_width);
+  time_relayout (box);
+
+  /* the box is wider than its natural width, as when growing a window */
+  total = 0;
+  for (i = 0; i < n_iterations; i++)
+    {
+      clutter_actor_set_width (box, natural_width + (i % 50) * 4);
+      total += time_relayout (box);
+    }
+
+  print_timings ("Resizing above the natural width", total);
+
+  /* the box is narrower, and the children are shrunk */
+  total = 0;
+  for (i = 0; i < n_iterations; i++)
+    {
+      clutter_actor_set_width (box, min_width + (natural_width - min_width) * (i % 50) / 50);
+      total += time_relayout (box);
+    }
+
+  print_timings ("Resizing below the natural width", total);
+
+  /* the box is homogeneous */
+  clutter_box_layout_set_homogeneous (CLUTTER_BOX_LAYOUT (layout), TRUE);
+
+  total = 0;
+  for (i = 0; i < n_iterations; i++)
+    {
+      clutter_actor_set_width (box, natural_width + (i % 50) * 4);
+      total += time_relayout (box);
+    }
+
+  print_timings ("Resizing a homogeneous box", total);
+
+  clutter_actor_destroy (stage);
+
+  return EXIT_SUCCESS;
+}
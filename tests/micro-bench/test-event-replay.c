@@ -0,0 +1,224 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <clutter/clutter.h>
+
+#define N_ACTORS        100
+
+static gchar *record_file = NULL;
+static gchar *replay_file = NULL;
+static gdouble speed = 1.0;
+static gint n_actors = N_ACTORS;
+
+static GOptionEntry entries[] = {
+  {
+    "record", 'r',
+    0,
+    G_OPTION_ARG_FILENAME, &record_file,
+    "Record the input events into FILE until the stage is closed", "FILE"
+  },
+  {
+    "replay", 'p',
+    0,
+    G_OPTION_ARG_FILENAME, &replay_file,
+    "Replay the input events recorded into FILE", "FILE"
+  },
+  {
+    "speed", 's',
+    0,
+    G_OPTION_ARG_DOUBLE, &speed,
+    "Speed of the replay, or 0 to replay one event per frame", "FACTOR"
+  },
+  {
+    "num-actors", 'n',
+    0,
+    G_OPTION_ARG_INT, &n_actors,
+    "Number of reactive actors on the stage", "ACTORS"
+  },
+  { NULL }
+};
+
+static gint
+compare_timings (gconstpointer a,
+                 gconstpointer b)
+{
+  gint64 ta = *(const gint64 *) a;
+  gint64 tb = *(const gint64 *) b;
+
+  return ta < tb ? -1 : ta > tb ? 1 : 0;
+}
+
+static void
+print_timings (const gchar *name,
+               GArray      *timings)
+{
+  gint64 total = 0;
+  guint i;
+
+  if (timings->len == 0)
+    {
+      printf ("%s: no samples\n", name);
+      return;
+    }
+
+  g_array_sort (timings, compare_timings);
+
+  for (i = 0; i < timings->len; i++)
+    total += g_array_index (timings, gint64, i);
+
+  printf ("%s: %u samples, mean %.3f ms, median %.3f ms, "
+          "95th percentile %.3f ms, max %.3f ms\n",
+          name,
+          timings->len,
+          total / 1000.0 / timings->len,
+          g_array_index (timings, gint64, timings->len / 2) / 1000.0,
+          g_array_index (timings, gint64, timings->len * 95 / 100) / 1000.0,
+          g_array_index (timings, gint64, timings->len - 1) / 1000.0);
+}
+
+static void
+player_finished_cb (ClutterEventPlayer *player)
+{
+  GArray *processing, *latency;
+  guint i, n_events;
+
+  n_events = clutter_event_player_get_n_events (player);
+
+  processing = g_array_sized_new (FALSE, FALSE, sizeof (gint64), n_events);
+  latency = g_array_sized_new (FALSE, FALSE, sizeof (gint64), n_events);
+
+  for (i = 0; i < n_events; i++)
+    {
+      gint64 processing_time, latency_time;
+
+      clutter_event_player_get_timings (player, i, &processing_time, &latency_time);
+
+      /* events compressed into a later one, or never presented,
+       * are not sampled
+       */
+      if (processing_time >= 0)
+        g_array_append_val (processing, processing_time);
+
+      if (latency_time >= 0)
+        g_array_append_val (latency, latency_time);
+    }
+
+  printf ("Replayed %u events at speed %.2f\n", n_events, speed);
+
+  print_timings ("Processing time", processing);
+  print_timings ("Input-to-paint latency", latency);
+
+  g_array_unref (processing);
+  g_array_unref (latency);
+
+  clutter_main_quit ();
+}
+
+static gboolean
+stage_event_cb (ClutterActor *stage,
+                ClutterEvent *event)
+{
+  ClutterActor *actor = clutter_event_get_source (event);
+
+  /* give the scene something to repaint */
+  if (clutter_event_type (event) == CLUTTER_MOTION && actor != stage)
+    clutter_actor_set_opacity (actor, g_random_int_range (64, 255));
+
+  return CLUTTER_EVENT_PROPAGATE;
+}
+
+int
+main (int argc, char **argv)
+{
+  ClutterEventRecorder *recorder = NULL;
+  ClutterEventPlayer *player = NULL;
+  ClutterActor *stage;
+  GError *error = NULL;
+  gint i;
+
+  g_setenv ("CLUTTER_VBLANK", "none", FALSE);
+
+  if (clutter_init_with_args (&argc, &argv,
+                              NULL,
+                              entries,
+                              NULL,
+                              &error) != CLUTTER_INIT_SUCCESS)
+    return 1;
+
+  if ((record_file == NULL) == (replay_file == NULL))
+    {
+      g_printerr ("Usage: %s (--record FILE | --replay FILE) [--speed FACTOR]\n",
+                  argv[0]);
+      return EXIT_FAILURE;
+    }
+
+  stage = clutter_stage_new ();
+  clutter_actor_set_size (stage, 512, 512);
+  clutter_stage_set_title (CLUTTER_STAGE (stage), "Event replay");
+  g_signal_connect (stage, "destroy", G_CALLBACK (clutter_main_quit), NULL);
+  g_signal_connect (stage, "event", G_CALLBACK (stage_event_cb), NULL);
+
+  for (i = 0; i < n_actors; i++)
+    {
+      ClutterActor *actor = clutter_actor_new ();
+      ClutterColor color;
+
+      clutter_color_init (&color, g_random_int_range (0, 255),
+                                  g_random_int_range (0, 255),
+                                  g_random_int_range (0, 255),
+                                  255);
+
+      clutter_actor_set_background_color (actor, &color);
+      clutter_actor_set_reactive (actor, TRUE);
+      clutter_actor_set_position (actor,
+                                  g_random_int_range (0, 480),
+                                  g_random_int_range (0, 480));
+      clutter_actor_set_size (actor, 32, 32);
+      clutter_actor_add_child (stage, actor);
+    }
+
+  clutter_actor_show (stage);
+
+  if (record_file != NULL)
+    {
+      recorder = clutter_event_recorder_new ();
+
+      if (!clutter_event_recorder_start (recorder, record_file, &error))
+        {
+          g_printerr ("Unable to record: %s\n", error->message);
+          return EXIT_FAILURE;
+        }
+
+      clutter_main ();
+
+      if (!clutter_event_recorder_stop (recorder, &error))
+        {
+          g_printerr ("Unable to record: %s\n", error->message);
+          return EXIT_FAILURE;
+        }
+
+      printf ("Recorded %u events into '%s'\n",
+              clutter_event_recorder_get_n_events (recorder),
+              record_file);
+
+      g_object_unref (recorder);
+    }
+  else
+    {
+      player = clutter_event_player_new ();
+
+      if (!clutter_event_player_load (player, replay_file, &error))
+        {
+          g_printerr ("Unable to replay: %s\n", error->message);
+          return EXIT_FAILURE;
+        }
+
+      g_signal_connect (player, "finished", G_CALLBACK (player_finished_cb), NULL);
+      clutter_event_player_play (player, CLUTTER_STAGE (stage), speed);
+
+      clutter_main ();
+
+      g_object_unref (player);
+    }
+
+  return EXIT_SUCCESS;
+}
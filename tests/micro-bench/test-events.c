@@ -0,0 +1,529 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <clutter/clutter.h>
+
+#ifdef CLUTTER_INPUT_EVDEV
+#define CLUTTER_ENABLE_COMPOSITOR_API
+#include <clutter/evdev/clutter-evdev.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+#include <linux/uinput.h>
+
+#define UINPUT_DEVICE_NAME      "Clutter benchmark pointer"
+#define UINPUT_TIMEOUT          5
+#endif
+
+#define EVENT_RATE      10000
+#define DURATION        5
+#define N_ALLOCATIONS   1000000
+#define BURST_SIZE      200
+#define N_BURSTS        100
+
+static gint event_rate = EVENT_RATE;
+static gint duration = DURATION;
+static gint n_allocations = N_ALLOCATIONS;
+static gint burst_size = BURST_SIZE;
+static gint n_bursts = N_BURSTS;
+static gboolean use_uinput = FALSE;
+static gboolean use_input_thread = FALSE;
+
+static GOptionEntry entries[] = {
+  {
+    "rate", 'r',
+    0,
+    G_OPTION_ARG_INT, &event_rate,
+    "Number of events injected per second", "EVENTS"
+  },
+  {
+    "duration", 'd',
+    0,
+    G_OPTION_ARG_INT, &duration,
+    "Duration of the injection, in seconds", "SECONDS"
+  },
+  {
+    "num-allocations", 'n',
+    0,
+    G_OPTION_ARG_INT, &n_allocations,
+    "Number of events allocated by each thread", "ALLOCATIONS"
+  },
+  {
+    "burst-size", 'b',
+    0,
+    G_OPTION_ARG_INT, &burst_size,
+    "Number of events injected in each burst", "EVENTS"
+  },
+  {
+    "num-bursts", 'B',
+    0,
+    G_OPTION_ARG_INT, &n_bursts,
+    "Number of bursts", "BURSTS"
+  },
+#ifdef CLUTTER_INPUT_EVDEV
+  {
+    "uinput", 'u',
+    0,
+    G_OPTION_ARG_NONE, &use_uinput,
+    "Inject the bursts through a uinput device, to measure libinput as well",
+    NULL
+  },
+  {
+    "input-thread", 't',
+    0,
+    G_OPTION_ARG_NONE, &use_input_thread,
+    "Translate the input events in the input thread of the evdev backend",
+    NULL
+  },
+#endif
+  { NULL }
+};
+
+typedef struct {
+  ClutterActor *stage;
+
+  gint64 start_time;
+  gint64 n_injected;
+  gint64 n_received;
+
+  gint64 burst_start_time;
+  gint64 burst_time;
+  gint n_bursts;
+  GSourceFunc inject_burst_func;
+
+  gint uinput_fd;
+  gboolean uinput_added;
+} InjectorData;
+
+static gpointer
+allocate_events (gpointer data)
+{
+  gint64 start, end;
+  gint i;
+
+  start = g_get_monotonic_time ();
+
+  for (i = 0; i < n_allocations; i++)
+    {
+      ClutterEvent *event, *copy;
+
+      event = clutter_event_new (CLUTTER_MOTION);
+      clutter_event_set_coords (event, i % 512, i % 512);
+      clutter_event_set_time (event, i);
+
+      copy = clutter_event_copy (event);
+
+      clutter_event_free (event);
+      clutter_event_free (copy);
+    }
+
+  end = g_get_monotonic_time ();
+
+  printf ("%s: %.1f ns per allocation\n",
+          (const char *) data,
+          (end - start) * 1000.0 / (n_allocations * 2.0));
+
+  return NULL;
+}
+
+static gboolean
+stage_motion_cb (ClutterActor *stage,
+                 ClutterEvent *event,
+                 InjectorData *data)
+{
+  data->n_received += 1;
+
+  return CLUTTER_EVENT_PROPAGATE;
+}
+
+static ClutterEvent *
+create_motion_event (InjectorData *data)
+{
+  ClutterDeviceManager *manager = clutter_device_manager_get_default ();
+  ClutterEvent *event;
+
+  event = clutter_event_new (CLUTTER_MOTION);
+  clutter_event_set_stage (event, CLUTTER_STAGE (data->stage));
+  clutter_event_set_device (event,
+                            clutter_device_manager_get_core_device (manager,
+                                                                    CLUTTER_POINTER_DEVICE));
+
+  return event;
+}
+
+static gboolean
+inject_burst (gpointer user_data)
+{
+  InjectorData *data = user_data;
+  ClutterEvent *event;
+  gint i;
+
+  event = create_motion_event (data);
+
+  data->n_received = 0;
+  data->burst_start_time = g_get_monotonic_time ();
+
+  for (i = 0; i < burst_size; i++)
+    {
+      clutter_event_set_coords (event, i % 512, i % 512);
+      clutter_event_set_time (event, data->burst_start_time / 1000);
+
+      clutter_event_put (event);
+    }
+
+  clutter_event_free (event);
+
+  return G_SOURCE_REMOVE;
+}
+
+static gboolean
+stage_burst_motion_cb (ClutterActor *stage,
+                       ClutterEvent *event,
+                       InjectorData *data)
+{
+  data->n_received += 1;
+
+  if (data->n_received == burst_size)
+    {
+      data->burst_time += g_get_monotonic_time () - data->burst_start_time;
+      data->n_bursts += 1;
+
+      if (data->n_bursts == n_bursts)
+        clutter_main_quit ();
+      else
+        clutter_threads_add_idle (data->inject_burst_func, data);
+    }
+
+  return CLUTTER_EVENT_PROPAGATE;
+}
+
+#ifdef CLUTTER_INPUT_EVDEV
+static gboolean
+is_evdev_device_manager (ClutterDeviceManager *manager)
+{
+  GType evdev_type = g_type_from_name ("ClutterDeviceManagerEvdev");
+
+  return evdev_type != G_TYPE_INVALID &&
+         g_type_is_a (G_OBJECT_TYPE (manager), evdev_type);
+}
+
+/* the pointer warps are translated and queued by the evdev backend like
+ * the motion events read from libinput, through the input thread if it
+ * is enabled, and forwarded in batches by the evdev event source; this
+ * measures the evdev dispatch path without any input device
+ */
+static gboolean
+inject_evdev_burst (gpointer user_data)
+{
+  InjectorData *data = user_data;
+  ClutterDeviceManager *manager = clutter_device_manager_get_default ();
+  ClutterInputDevice *pointer;
+  guint32 time_;
+  gint i;
+
+  pointer = clutter_device_manager_get_core_device (manager,
+                                                    CLUTTER_POINTER_DEVICE);
+
+  data->n_received = 0;
+  data->burst_start_time = g_get_monotonic_time ();
+
+  time_ = data->burst_start_time / 1000;
+
+  for (i = 0; i < burst_size; i++)
+    clutter_evdev_warp_pointer (pointer, time_, i % 512, i % 512);
+
+  return G_SOURCE_REMOVE;
+}
+
+/* the events written to a uinput device also go through the kernel and
+ * libinput before reaching the evdev backend
+ */
+static gboolean
+inject_uinput_burst (gpointer user_data)
+{
+  InjectorData *data = user_data;
+  struct input_event *events;
+  gssize size;
+  gint i;
+
+  events = g_new0 (struct input_event, burst_size * 2);
+
+  /* move back and forth, so that the pointer never gets stuck at
+   * the edge of the stage
+   */
+  for (i = 0; i < burst_size; i++)
+    {
+      events[i * 2].type = EV_REL;
+      events[i * 2].code = REL_X;
+      events[i * 2].value = i % 2 == 0 ? 1 : -1;
+
+      events[i * 2 + 1].type = EV_SYN;
+      events[i * 2 + 1].code = SYN_REPORT;
+    }
+
+  data->n_received = 0;
+  data->burst_start_time = g_get_monotonic_time ();
+
+  size = sizeof (struct input_event) * burst_size * 2;
+  if (write (data->uinput_fd, events, size) != size)
+    {
+      g_warning ("Failed to write the burst to the uinput device: %s",
+                 g_strerror (errno));
+      clutter_main_quit ();
+    }
+
+  g_free (events);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+uinput_device_added_cb (ClutterDeviceManager *manager,
+                        ClutterInputDevice   *device,
+                        InjectorData         *data)
+{
+  const gchar *name = clutter_input_device_get_device_name (device);
+
+  if (g_strcmp0 (name, UINPUT_DEVICE_NAME) == 0)
+    data->uinput_added = TRUE;
+}
+
+static gboolean
+create_uinput_device (InjectorData *data)
+{
+  ClutterDeviceManager *manager = clutter_device_manager_get_default ();
+  struct uinput_user_dev dev;
+  gulong added_id;
+  gint64 end_time;
+  gint fd;
+
+  fd = open ("/dev/uinput", O_WRONLY | O_NONBLOCK);
+  if (fd < 0 && errno == ENODEV)
+    fd = open ("/dev/input/uinput", O_WRONLY | O_NONBLOCK);
+  if (fd < 0)
+    {
+      printf ("Could not open the uinput device: %s\n", g_strerror (errno));
+      return FALSE;
+    }
+
+  memset (&dev, 0, sizeof (dev));
+  g_strlcpy (dev.name, UINPUT_DEVICE_NAME, sizeof (dev.name));
+  dev.id.bustype = BUS_VIRTUAL;
+
+  if (ioctl (fd, UI_SET_EVBIT, EV_KEY) < 0 ||
+      ioctl (fd, UI_SET_KEYBIT, BTN_LEFT) < 0 ||
+      ioctl (fd, UI_SET_EVBIT, EV_REL) < 0 ||
+      ioctl (fd, UI_SET_RELBIT, REL_X) < 0 ||
+      ioctl (fd, UI_SET_RELBIT, REL_Y) < 0 ||
+      write (fd, &dev, sizeof (dev)) != sizeof (dev) ||
+      ioctl (fd, UI_DEV_CREATE) < 0)
+    {
+      printf ("Could not create the uinput device: %s\n", g_strerror (errno));
+      close (fd);
+      return FALSE;
+    }
+
+  data->uinput_fd = fd;
+
+  /* wait for the input backend to pick the new device up */
+  added_id = g_signal_connect (manager, "device-added",
+                               G_CALLBACK (uinput_device_added_cb), data);
+
+  end_time = g_get_monotonic_time () + UINPUT_TIMEOUT * G_USEC_PER_SEC;
+  while (!data->uinput_added && g_get_monotonic_time () < end_time)
+    g_main_context_iteration (NULL, FALSE);
+
+  g_signal_handler_disconnect (manager, added_id);
+
+  if (!data->uinput_added)
+    {
+      printf ("The input backend did not add the uinput device; "
+              "is Clutter using the evdev input backend?\n");
+      ioctl (fd, UI_DEV_DESTROY);
+      close (fd);
+      data->uinput_fd = -1;
+      return FALSE;
+    }
+
+  return TRUE;
+}
+
+static void
+destroy_uinput_device (InjectorData *data)
+{
+  if (data->uinput_fd < 0)
+    return;
+
+  ioctl (data->uinput_fd, UI_DEV_DESTROY);
+  close (data->uinput_fd);
+  data->uinput_fd = -1;
+}
+#endif /* CLUTTER_INPUT_EVDEV */
+
+static gboolean
+inject_events (gpointer user_data)
+{
+  InjectorData *data = user_data;
+  gint64 now, n_expected;
+  ClutterEvent *event;
+
+  now = g_get_monotonic_time ();
+
+  if (now - data->start_time >= (gint64) duration * G_USEC_PER_SEC)
+    {
+      clutter_main_quit ();
+      return G_SOURCE_REMOVE;
+    }
+
+  /* catch up with the requested rate, regardless of how late the
+   * timeout was dispatched
+   */
+  n_expected = (now - data->start_time) * event_rate / G_USEC_PER_SEC;
+
+  event = create_motion_event (data);
+
+  while (data->n_injected < n_expected)
+    {
+      clutter_event_set_coords (event,
+                                data->n_injected % 512,
+                                data->n_injected % 512);
+      clutter_event_set_time (event, now / 1000);
+
+      clutter_event_put (event);
+
+      data->n_injected += 1;
+    }
+
+  clutter_event_free (event);
+
+  return G_SOURCE_CONTINUE;
+}
+
+int
+main (int argc, char **argv)
+{
+  InjectorData data = { NULL, };
+  GError *error = NULL;
+  GThread *worker;
+  gdouble elapsed;
+  const gchar *injector;
+#ifdef CLUTTER_INPUT_EVDEV
+  gint i;
+#endif
+
+  g_setenv ("CLUTTER_VBLANK", "none", FALSE);
+  g_setenv ("CLUTTER_DEFAULT_FPS", "1000", FALSE);
+
+#ifdef CLUTTER_INPUT_EVDEV
+  /* the option has to be known before initializing the evdev backend */
+  for (i = 1; i < argc; i++)
+    {
+      if (g_strcmp0 (argv[i], "--input-thread") == 0 ||
+          g_strcmp0 (argv[i], "-t") == 0)
+        clutter_evdev_set_input_thread_enabled (TRUE);
+    }
+#endif
+
+  if (clutter_init_with_args (&argc, &argv,
+                              NULL,
+                              entries,
+                              NULL,
+                              &error) != CLUTTER_INIT_SUCCESS)
+    return 1;
+
+  printf ("Event allocation test with %d allocations per thread\n",
+          n_allocations);
+
+  allocate_events ("main thread");
+
+  worker = g_thread_new ("event-allocator", allocate_events, "worker thread");
+  g_thread_join (worker);
+
+  printf ("Event injection test with %d events per second for %d seconds\n",
+          event_rate,
+          duration);
+
+  data.stage = clutter_stage_new ();
+  clutter_actor_set_size (data.stage, 512, 512);
+  clutter_stage_set_title (CLUTTER_STAGE (data.stage), "Events");
+  clutter_stage_set_motion_events_enabled (CLUTTER_STAGE (data.stage), TRUE);
+  g_signal_connect (data.stage, "motion-event",
+                    G_CALLBACK (stage_motion_cb), &data);
+  clutter_actor_show (data.stage);
+
+  data.start_time = g_get_monotonic_time ();
+
+  clutter_threads_add_timeout (1, inject_events, &data);
+
+  clutter_main ();
+
+  elapsed = (g_get_monotonic_time () - data.start_time) / (gdouble) G_USEC_PER_SEC;
+
+  printf ("Injected %" G_GINT64_FORMAT " events, "
+          "received %" G_GINT64_FORMAT " motion events "
+          "(%.1f events/s)\n",
+          data.n_injected,
+          data.n_received,
+          data.n_received / elapsed);
+
+  /* deliver every event of the bursts, to measure the throughput
+   * of the event sources and of the stage event queue; with the evdev
+   * backend the bursts go through its translation and dispatch path,
+   * otherwise they are put in the queue with clutter_event_put()
+   */
+  data.inject_burst_func = inject_burst;
+  data.uinput_fd = -1;
+  injector = "with clutter_event_put()";
+
+#ifdef CLUTTER_INPUT_EVDEV
+  if (is_evdev_device_manager (clutter_device_manager_get_default ()))
+    {
+      data.inject_burst_func = inject_evdev_burst;
+      injector = use_input_thread
+               ? "through the evdev backend, with the input thread"
+               : "through the evdev backend";
+
+      if (use_uinput)
+        {
+          if (create_uinput_device (&data))
+            {
+              data.inject_burst_func = inject_uinput_burst;
+              injector = "through uinput";
+            }
+          else
+            printf ("Falling back to pointer warps\n");
+        }
+    }
+#endif
+
+  printf ("Event burst test with %d bursts of %d events, injected %s\n",
+          n_bursts,
+          burst_size,
+          injector);
+
+  g_signal_handlers_disconnect_by_func (data.stage, stage_motion_cb, &data);
+  g_signal_connect (data.stage, "motion-event",
+                    G_CALLBACK (stage_burst_motion_cb), &data);
+  clutter_stage_set_throttle_motion_events (CLUTTER_STAGE (data.stage), FALSE);
+
+  clutter_threads_add_idle (data.inject_burst_func, &data);
+
+  clutter_main ();
+
+#ifdef CLUTTER_INPUT_EVDEV
+  destroy_uinput_device (&data);
+#endif
+
+  printf ("Delivered %d bursts in %.3f ms on average "
+          "(%.1f events/s)\n",
+          data.n_bursts,
+          data.burst_time / 1000.0 / data.n_bursts,
+          (gdouble) data.n_bursts * burst_size * G_USEC_PER_SEC / data.burst_time);
+
+  clutter_actor_destroy (data.stage);
+
+  return EXIT_SUCCESS;
+}
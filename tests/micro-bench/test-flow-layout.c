@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <clutter/clutter.h>
+
+#define N_CHILDREN      5000
+
+static gint n_children = N_CHILDREN;
+static gint n_iterations = 100;
+
+static GOptionEntry entries[] = {
+  {
+    "num-children", 'n',
+    0,
+    G_OPTION_ARG_INT, &n_children,
+    "Number of children of the flow layout", "CHILDREN"
+  },
+  {
+    "num-iterations", 'i',
+    0,
+    G_OPTION_ARG_INT, &n_iterations,
+    "Number of relayouts for each test", "ITERATIONS"
+  },
+  { NULL }
+};
+
+/* forces a relayout of the stage, and returns its duration */
+static gint64
+time_relayout (ClutterActor *box)
+{
+  ClutterActorBox allocation;
+  gint64 start;
+
+  start = g_get_monotonic_time ();
+  clutter_actor_get_allocation_box (box, &allocation);
+
+  return g_get_monotonic_time () - start;
+}
+
+static void
+print_timings (const gchar *name,
+               gint64       total)
+{
+  printf ("%s: %d relayouts of %d children, mean %.3f ms\n",
+          name,
+          n_iterations,
+          n_children,
+          total / 1000.0 / n_iterations);
+}
+
+int
+main (int argc, char *argv[])
+{
+  ClutterActor *stage, *box;
+  ClutterLayoutManager *layout;
+  gint64 total;
+  gint i;
+
+  if (clutter_init_with_args (&argc, &argv,
+                              NULL,
+                              entries,
+                              NULL,
+                              NULL) != CLUTTER_INIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (n_iterations < 1)
+    n_iterations = 1;
+
+  stage = clutter_stage_new ();
+  clutter_actor_set_size (stage, 800, 600);
+
+  layout = clutter_flow_layout_new (CLUTTER_FLOW_HORIZONTAL);
+  clutter_flow_layout_set_column_spacing (CLUTTER_FLOW_LAYOUT (layout), 4);
+  clutter_flow_layout_set_row_spacing (CLUTTER_FLOW_LAYOUT (layout), 4);
+
+  box = clutter_actor_new ();
+  clutter_actor_set_layout_manager (box, layout);
+  clutter_actor_add_child (stage, box);
+
+  for (i = 0; i < n_children; i++)
+    {
+      ClutterActor *child = clutter_actor_new ();
+
+      /* thumbnails of a few different sizes */
+      clutter_actor_set_size (child, 32 + (i % 7) * 8, 32 + (i % 3) * 16);
+      clutter_actor_add_child (box, child);
+    }
+
+  clutter_actor_show (stage);
+  time_relayout (box);
+
+  /* the container is resized, while the children do not change: the
+   * lines are computed once for each width
+   */
+  total = 0;
+  for (i = 0; i < n_iterations; i++)
+    {
+      clutter_actor_set_width (box, 600 + (i % 3) * 100);
+      total += time_relayout (box);
+    }
+
+  print_timings ("Resizing the container", total);
+
+  /* the container is moved, which reallocates it at the same size */
+  total = 0;
+  for (i = 0; i < n_iterations; i++)
+    {
+      clutter_actor_set_x (box, i % 2);
+      total += time_relayout (box);
+    }
+
+  print_timings ("Moving the container", total);
+
+  /* a child changes size, which requires computing the lines again */
+  total = 0;
+  for (i = 0; i < n_iterations; i++)
+    {
+      ClutterActor *child = clutter_actor_get_child_at_index (box, i % n_children);
+
+      clutter_actor_set_width (child, 32 + ((i + 1) % 7) * 8);
+      total += time_relayout (box);
+    }
+
+  print_timings ("Resizing a child", total);
+
+  clutter_actor_destroy (stage);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,174 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <clutter/clutter.h>
+
+static gint n_rows = 200;
+static gint n_columns = 20;
+static gint n_iterations = 100;
+
+static GOptionEntry entries[] = {
+  {
+    "num-rows", 'r',
+    0,
+    G_OPTION_ARG_INT, &n_rows,
+    "Number of rows of the grid", "ROWS"
+  },
+  {
+    "num-columns", 'c',
+    0,
+    G_OPTION_ARG_INT, &n_columns,
+    "Number of columns of the grid", "COLUMNS"
+  },
+  {
+    "num-iterations", 'i',
+    0,
+    G_OPTION_ARG_INT, &n_iterations,
+    "Number of relayouts for each test", "ITERATIONS"
+  },
+  { NULL }
+};
+
+/* forces a relayout of the stage, and returns its duration */
+static gint64
+time_relayout (ClutterActor *grid)
+{
+  ClutterActorBox allocation;
+  gint64 start;
+
+  start = g_get_monotonic_time ();
+  clutter_actor_get_allocation_box (grid, &allocation);
+
+  return g_get_monotonic_time () - start;
+}
+
+static void
+print_timings (const gchar *name,
+               gint64       total)
+{
+  printf ("%s: %d relayouts of %d x %d cells, mean %.3f ms\n",
+          name,
+          n_iterations,
+          n_rows,
+          n_columns,
+          total / 1000.0 / n_iterations);
+}
+
+static ClutterActor *
+create_grid (ClutterActor *stage,
+             gboolean      fixed_size)
+{
+  ClutterLayoutManager *layout;
+  ClutterActor *grid;
+  gint row, column;
+
+  layout = clutter_grid_layout_new ();
+  clutter_grid_layout_set_row_spacing (CLUTTER_GRID_LAYOUT (layout), 2);
+  clutter_grid_layout_set_column_spacing (CLUTTER_GRID_LAYOUT (layout), 2);
+
+  grid = clutter_actor_new ();
+  clutter_actor_set_layout_manager (grid, layout);
+  clutter_actor_add_child (stage, grid);
+
+  for (row = 0; row < n_rows; row++)
+    {
+      for (column = 0; column < n_columns; column++)
+        {
+          ClutterActor *cell;
+
+          if (fixed_size)
+            {
+              cell = clutter_actor_new ();
+              clutter_actor_set_size (cell, 40 + (column % 3) * 8, 20);
+            }
+          else
+            {
+              gchar *text = g_strdup_printf ("%d:%d", row, column);
+
+              cell = clutter_text_new_with_text ("Sans 10px", text);
+              g_free (text);
+            }
+
+          clutter_grid_layout_attach (CLUTTER_GRID_LAYOUT (layout), cell,
+                                      column, row,
+                                      1, 1);
+        }
+    }
+
+  return grid;
+}
+
+static void
+run_test (ClutterActor *stage,
+          gboolean      fixed_size)
+{
+  const gchar *kind = fixed_size ? "fixed size cells" : "text cells";
+  ClutterActor *grid;
+  gchar *name;
+  gint64 total;
+  gint i;
+
+  grid = create_grid (stage, fixed_size);
+  time_relayout (grid);
+
+  /* the grid is resized, while the cells do not change */
+  total = 0;
+  for (i = 0; i < n_iterations; i++)
+    {
+      clutter_actor_set_width (grid, 1200 + (i % 3) * 100);
+      total += time_relayout (grid);
+    }
+
+  name = g_strdup_printf ("Resizing the grid, %s", kind);
+  print_timings (name, total);
+  g_free (name);
+
+  /* a cell changes size, which requires measuring the cells again */
+  total = 0;
+  for (i = 0; i < n_iterations; i++)
+    {
+      ClutterActor *cell;
+
+      cell = clutter_actor_get_child_at_index (grid, i % (n_rows * n_columns));
+      clutter_actor_set_width (cell, 40 + ((i + 1) % 3) * 8);
+      total += time_relayout (grid);
+    }
+
+  name = g_strdup_printf ("Resizing a cell, %s", kind);
+  print_timings (name, total);
+  g_free (name);
+
+  clutter_actor_destroy (grid);
+}
+
+int
+main (int argc, char *argv[])
+{
+  ClutterActor *stage;
+
+  if (clutter_init_with_args (&argc, &argv,
+                              NULL,
+                              entries,
+                              NULL,
+                              NULL) != CLUTTER_INIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (n_iterations < 1)
+    n_iterations = 1;
+
+  if (n_rows < 1)
+    n_rows = 1;
+
+  if (n_columns < 1)
+    n_columns = 1;
+
+  stage = clutter_stage_new ();
+  clutter_actor_set_size (stage, 800, 600);
+  clutter_actor_show (stage);
+
+  run_test (stage, TRUE);
+  run_test (stage, FALSE);
+
+  clutter_actor_destroy (stage);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,230 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <clutter/clutter.h>
+
+#define STAGE_WIDTH     400
+#define STAGE_HEIGHT    600
+
+static gint max_rows = 1000000;
+static gint n_frames = 200;
+static gdouble scroll_step = 13.0;
+
+static GOptionEntry entries[] = {
+  {
+    "max-rows", 'm',
+    0,
+    G_OPTION_ARG_INT, &max_rows,
+    "Largest number of rows to test", "ROWS"
+  },
+  {
+    "num-frames", 'f',
+    0,
+    G_OPTION_ARG_INT, &n_frames,
+    "Number of frames scrolled for each number of rows", "FRAMES"
+  },
+  {
+    "step", 's',
+    0,
+    G_OPTION_ARG_DOUBLE, &scroll_step,
+    "Distance scrolled on each frame, in pixels", "PIXELS"
+  },
+  { NULL }
+};
+
+static ClutterActor *
+create_row (ClutterListView *view,
+            gpointer         data)
+{
+  guint *n_created = data;
+
+  *n_created += 1;
+
+  return clutter_actor_new ();
+}
+
+static void
+bind_row (ClutterListView *view,
+          ClutterActor    *row_actor,
+          guint            row,
+          gpointer         data)
+{
+  ClutterColor color = { 0, 0, 0, 255 };
+
+  color.red = (row * 37) % 255;
+  color.green = (row * 91) % 255;
+  color.blue = (row * 13) % 255;
+
+  clutter_actor_set_background_color (row_actor, &color);
+
+  /* rows of different heights, averaging the estimate */
+  clutter_actor_set_height (row_actor, 16 + (row % 5) * 8);
+}
+
+static void
+on_after_paint (ClutterStage *stage,
+                gboolean     *painted)
+{
+  *painted = TRUE;
+}
+
+/* the resident set size of the process, in KiB, or 0 if unknown */
+static gsize
+get_rss (void)
+{
+  gchar *contents = NULL;
+  gsize rss = 0;
+  gulong size, resident;
+
+  if (g_file_get_contents ("/proc/self/statm", &contents, NULL, NULL) &&
+      sscanf (contents, "%lu %lu", &size, &resident) == 2)
+    rss = resident * (sysconf (_SC_PAGESIZE) / 1024);
+
+  g_free (contents);
+
+  return rss;
+}
+
+/* the row actors kept aside for recycling are the hidden children */
+static guint
+get_n_pooled (ClutterActor *view)
+{
+  ClutterActorIter iter;
+  ClutterActor *child;
+  guint n_pooled = 0;
+
+  clutter_actor_iter_init (&iter, view);
+  while (clutter_actor_iter_next (&iter, &child))
+    {
+      if (!clutter_actor_is_visible (child))
+        n_pooled += 1;
+    }
+
+  return n_pooled;
+}
+
+static gint
+compare_timings (gconstpointer a,
+                 gconstpointer b)
+{
+  gint64 ta = *(const gint64 *) a;
+  gint64 tb = *(const gint64 *) b;
+
+  return ta < tb ? -1 : ta > tb ? 1 : 0;
+}
+
+static void
+run_test (guint n_rows)
+{
+  ClutterActor *stage, *scroll, *view;
+  GArray *timings;
+  ClutterPoint point;
+  gboolean painted = FALSE;
+  guint n_created = 0, max_children = 0, max_pooled = 0;
+  gsize rss_before, rss_after;
+  gint64 total;
+  gfloat y = 0.f;
+  guint j;
+  gint i;
+
+  rss_before = get_rss ();
+
+  stage = clutter_stage_new ();
+  clutter_actor_set_size (stage, STAGE_WIDTH, STAGE_HEIGHT);
+  g_signal_connect (stage, "after-paint", G_CALLBACK (on_after_paint), &painted);
+
+  scroll = clutter_scroll_actor_new ();
+  clutter_scroll_actor_set_scroll_mode (CLUTTER_SCROLL_ACTOR (scroll),
+                                        CLUTTER_SCROLL_VERTICALLY);
+  clutter_actor_add_constraint (scroll, clutter_bind_constraint_new (stage, CLUTTER_BIND_SIZE, 0));
+  clutter_actor_add_child (stage, scroll);
+
+  view = clutter_list_view_new ();
+  clutter_actor_set_width (view, STAGE_WIDTH);
+  clutter_list_view_set_estimated_row_height (CLUTTER_LIST_VIEW (view), 32.f);
+  clutter_list_view_set_row_factory (CLUTTER_LIST_VIEW (view),
+                                     create_row,
+                                     bind_row,
+                                     &n_created,
+                                     NULL);
+  clutter_list_view_set_n_rows (CLUTTER_LIST_VIEW (view), n_rows);
+  clutter_actor_add_child (scroll, view);
+
+  clutter_actor_show (stage);
+
+  timings = g_array_sized_new (FALSE, FALSE, sizeof (gint64), n_frames);
+
+  for (i = 0; i < n_frames; i++)
+    {
+      ClutterActorBox box;
+      gint64 start, elapsed;
+
+      start = g_get_monotonic_time ();
+
+      /* the rows are updated when the scroll position changes, and
+       * allocated by the relayout forced by getting the allocation
+       */
+      y += scroll_step;
+      clutter_point_init (&point, 0.f, y);
+      clutter_scroll_actor_scroll_to_point (CLUTTER_SCROLL_ACTOR (scroll), &point);
+      clutter_actor_get_allocation_box (view, &box);
+
+      elapsed = g_get_monotonic_time () - start;
+      g_array_append_val (timings, elapsed);
+
+      max_children = MAX (max_children, clutter_actor_get_n_children (view));
+      max_pooled = MAX (max_pooled, get_n_pooled (view));
+
+      painted = FALSE;
+      clutter_stage_ensure_redraw (CLUTTER_STAGE (stage));
+      while (!painted)
+        g_main_context_iteration (NULL, TRUE);
+    }
+
+  /* the memory used by the list view, its rows and the heights kept
+   * for the rows scrolled through
+   */
+  rss_after = get_rss ();
+
+  g_array_sort (timings, compare_timings);
+
+  total = 0;
+  for (j = 0; j < timings->len; j++)
+    total += g_array_index (timings, gint64, j);
+
+  printf ("%8u rows: %3u actors created, %3u children and %3u pooled at most, "
+          "RSS %+6ld KiB, "
+          "update and allocation mean %.3f ms, median %.3f ms, max %.3f ms\n",
+          n_rows,
+          n_created,
+          max_children,
+          max_pooled,
+          (glong) rss_after - (glong) rss_before,
+          total / 1000.0 / timings->len,
+          g_array_index (timings, gint64, timings->len / 2) / 1000.0,
+          g_array_index (timings, gint64, timings->len - 1) / 1000.0);
+
+  g_array_unref (timings);
+  clutter_actor_destroy (stage);
+}
+
+int
+main (int argc, char *argv[])
+{
+  guint n_rows;
+
+  if (clutter_init_with_args (&argc, &argv,
+                              NULL,
+                              entries,
+                              NULL,
+                              NULL) != CLUTTER_INIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (n_frames < 1)
+    n_frames = 1;
+
+  for (n_rows = 1000; n_rows <= (guint) max_rows; n_rows *= 10)
+    run_test (n_rows);
+
+  return EXIT_SUCCESS;
+}
@@ -5,6 +5,7 @@
 static GTimer *testtimer = NULL;
 static gint testframes = 0;
 static float testmaxtime = 1.0;
+static gboolean testmanualclock = FALSE;
 
 /* initialize environment to be suitable for fps testing */
 void clutter_perf_fps_init (void)
@@ -21,15 +22,28 @@ void clutter_perf_fps_init (void)
   else
     testmaxtime = 10.0;
 
+  /* run the frames back to back with a fixed time step, to measure the
+   * cost of each frame regardless of the load of the system
+   */
+  if (g_getenv ("CLUTTER_PERFORMANCE_MANUAL_CLOCK"))
+    {
+      clutter_enable_manual_master_clock ();
+      testmanualclock = TRUE;
+    }
+
   g_random_set_seed (12345678);
 }
 
 static void perf_stage_paint_cb (ClutterStage *stage, gpointer *data);
 static gboolean perf_fake_mouse_cb (gpointer stage);
+static gboolean perf_step_clock_cb (gpointer data);
 
 void clutter_perf_fps_start (ClutterStage *stage)
 {
   g_signal_connect (stage, "paint", G_CALLBACK (perf_stage_paint_cb), NULL);
+
+  if (testmanualclock)
+    clutter_threads_add_idle (perf_step_clock_cb, NULL);
 }
 
 void clutter_perf_fake_mouse (ClutterStage *stage)
@@ -54,6 +68,13 @@ static void perf_stage_paint_cb (ClutterStage *stage, gpointer *data)
     }
 }
 
+static gboolean perf_step_clock_cb (gpointer data)
+{
+  clutter_master_clock_step (1, G_USEC_PER_SEC / 60);
+
+  return G_SOURCE_CONTINUE;
+}
+
 static void wrap (gfloat *value, gfloat min, gfloat max)
 {
   if (*value > max)